@@ -3,11 +3,19 @@
 #include <time.h>
 #include <string.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
 
 #include "../src/vector.h"
 #include "../src/map.h"
 #include "../src/bigint.h"
 #include "../src/string.h"
+#include "../src/cmap.h"
+#include "../src/omap.h"
+#include "../src/art.h"
+#include "../src/set.h"
+#include "../src/filter.h"
+#include "../src/cache.h"
 
 typedef void (*test_fn_t)(size_t iterations);
 
@@ -28,16 +36,14 @@ void test_vector(size_t iterations) {
 }
 
 void test_map(size_t iterations) {
-    map_t *map = map_new().value.map;
+    map_t *map = map_new_sized(sizeof(int)).value.map;
     char key[64];
 
     for (size_t idx = 0; idx < iterations; idx++) {
         snprintf(key, sizeof(key), "key_%zu", idx);
 
-        int *value = malloc(sizeof(int));
-        *value = (int)idx;
-
-        map_add(map, key, (void*)value);
+        int value = (int)idx;
+        map_add(map, key, &value);
     }
 
     volatile uint64_t sum = 0; // prevent the compiler from optimizing away the sum
@@ -48,73 +54,85 @@ void test_map(size_t iterations) {
         sum += *val;
     }
 
-    // Cleanup values
-    for (size_t idx = 0; idx < map->capacity; idx++) {
-        snprintf(key, sizeof(key), "key_%zu", idx);
+    // Values are owned by the map
+    map_destroy(map);
+}
 
-        int *val = (int *)map_get(map, key).value.element;
-        free(val);
+void test_intmap(size_t iterations) {
+    intmap_t *map = intmap_new_sized(sizeof(int)).value.intmap;
 
-        map_remove(map, key);
+    for (size_t idx = 0; idx < iterations; idx++) {
+        int value = (int)idx;
+        intmap_add(map, idx, &value);
     }
 
-    map_destroy(map);
+    volatile uint64_t sum = 0; // prevent the compiler from optimizing away the sum
+    for (size_t idx = 0; idx < iterations; idx++) {
+        const int *val = (const int*)intmap_get(map, idx).value.element;
+        sum += *val;
+    }
+
+    intmap_destroy(map);
+}
+
+// Number of limbs of a big integer, an inline one having a single limb
+static size_t bench_bigint_size(const bigint_t *number) {
+    return number->digits != NULL ? vector_size(number->digits) : 1;
+}
+
+// Least significant limb of a big integer
+static bigint_limb_t bench_bigint_low(const bigint_t *number) {
+    return number->digits != NULL ? *(const bigint_limb_t *)number->digits->elements : number->inline_limb;
 }
 
 void test_bigint(size_t iterations) {
     volatile uint64_t accumulator = 0;
 
-    for (size_t idx = 1; idx <= iterations; idx++) {
-        long long a_val = (long long)idx * 123456789LL;
-        long long b_val = (long long)idx * 17777LL;
-
-        bigint_result_t a_res = bigint_from_int(a_val);
-        bigint_result_t b_res = bigint_from_int(b_val);
+    // Operands and results live across the iterations and are updated in place
+    bigint_t *a = bigint_from_int(0).value.number;
+    bigint_t *b = bigint_from_int(0).value.number;
+    bigint_t *a_step = bigint_from_int(123456789LL).value.number;
+    bigint_t *b_step = bigint_from_int(17777LL).value.number;
+    bigint_t *sum = bigint_from_int(0).value.number;
+    bigint_t *difference = bigint_from_int(0).value.number;
+    bigint_t *product = bigint_from_int(0).value.number;
+    const bool allocated = a != NULL && b != NULL && a_step != NULL && b_step != NULL &&
+                           sum != NULL && difference != NULL && product != NULL;
 
-        if (a_res.status != BIGINT_OK || b_res.status != BIGINT_OK) {
-            bigint_destroy(a_res.value.number);
-            bigint_destroy(b_res.value.number);
-            continue;
+    for (size_t idx = 1; allocated && idx <= iterations; idx++) {
+        // a = idx * 123456789, b = idx * 17777
+        if (bigint_add_inplace(a, a_step).status != BIGINT_OK ||
+            bigint_add_inplace(b, b_step).status != BIGINT_OK) {
+            break;
         }
 
-        bigint_t *a = a_res.value.number;
-        bigint_t *b = b_res.value.number;
-
         // Addition
-        bigint_result_t add_res = bigint_add(a, b);
-        if (add_res.status == BIGINT_OK) {
-            vector_result_t v = vector_get(add_res.value.number->digits, 0);
-            if (v.status == VECTOR_OK) { accumulator += *(int *)v.value.element; }
-            bigint_destroy(add_res.value.number);
+        if (bigint_add_inplace(sum, a).status == BIGINT_OK) {
+            accumulator += bench_bigint_low(sum);
         }
 
         // Substraction
-        bigint_result_t sub_res = bigint_sub(a, b);
-        if (sub_res.status == BIGINT_OK) {
-            vector_result_t v = vector_get(sub_res.value.number->digits, 0);
-            if (v.status == VECTOR_OK) { accumulator += *(int *)v.value.element; }
-            bigint_destroy(sub_res.value.number);
+        if (bigint_sub_from(difference, b).status == BIGINT_OK) {
+            accumulator += bench_bigint_low(difference);
         }
 
         // Multiplication
-        bigint_result_t mul_res = bigint_prod(a, b);
-        if (mul_res.status == BIGINT_OK) {
-            vector_result_t v = vector_get(mul_res.value.number->digits, 0);
-            if (v.status == VECTOR_OK) { accumulator += *(int *)v.value.element; }
-            bigint_destroy(mul_res.value.number);
+        if (bigint_mul_into(product, a, b).status == BIGINT_OK) {
+            accumulator += bench_bigint_low(product);
         }
 
         // Division
         bigint_result_t div_res = bigint_divmod(a, b);
         if (div_res.status == BIGINT_OK) {
-            vector_result_t v = vector_get(div_res.value.division.quotient->digits, 0);
-            if (v.status == VECTOR_OK) { accumulator += *(int *)v.value.element; }
+            accumulator += bench_bigint_low(div_res.value.division.quotient);
             bigint_destroy(div_res.value.division.quotient);
             bigint_destroy(div_res.value.division.remainder);
         }
-
-        bigint_destroy(a); bigint_destroy(b);
     }
+
+    bigint_destroy(product); bigint_destroy(difference); bigint_destroy(sum);
+    bigint_destroy(b_step); bigint_destroy(a_step);
+    bigint_destroy(b); bigint_destroy(a);
 }
 
 void test_string(size_t iterations) {
@@ -142,6 +160,31 @@ void test_string(size_t iterations) {
     }
 }
 
+/*
+ * Heap allocations made by the bigint module. The Makefile renames the allocator calls
+ * of the bigint object of the benchmark to these wrappers, so the other modules keep
+ * calling the allocator directly
+ */
+static size_t bench_allocations = 0;
+
+void *bench_malloc(size_t size) {
+    bench_allocations++;
+
+    return malloc(size);
+}
+
+void *bench_calloc(size_t count, size_t size) {
+    bench_allocations++;
+
+    return calloc(count, size);
+}
+
+void *bench_realloc(void *ptr, size_t size) {
+    bench_allocations++;
+
+    return realloc(ptr, size);
+}
+
 static inline uint64_t now_ns(void) {
     struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC, &ts);
@@ -149,6 +192,1021 @@ static inline uint64_t now_ns(void) {
     return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
 }
 
+static inline uint64_t xorshift64(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+
+    return *state = x;
+}
+
+#define KEY_SIZE 32
+
+void bench_map_batch(size_t keys) {
+    const size_t batch_sizes[] = { 1, 8, 32, 128 };
+    const size_t chunk = 1024;
+    const size_t queries = keys < (1 << 20) ? keys : (1 << 20);
+
+    map_t *map = map_new_sized(sizeof(uint64_t)).value.map;
+    char *key_buf = malloc(chunk * KEY_SIZE);
+    const char **key_ptrs = malloc(chunk * sizeof(char*));
+    uint64_t *numbers = malloc(chunk * sizeof(uint64_t));
+    void **value_ptrs = malloc(chunk * sizeof(void*));
+
+    // Build the map using batched insertions
+    printf("Building a map of %zu keys...", keys);
+    fflush(stdout);
+    uint64_t start = now_ns();
+    for (size_t base = 0; base < keys; base += chunk) {
+        const size_t count = (keys - base) < chunk ? (keys - base) : chunk;
+
+        for (size_t idx = 0; idx < count; idx++) {
+            snprintf(key_buf + (idx * KEY_SIZE), KEY_SIZE, "key_%zu", base + idx);
+            key_ptrs[idx] = key_buf + (idx * KEY_SIZE);
+            numbers[idx] = base + idx;
+            value_ptrs[idx] = &numbers[idx];
+        }
+
+        map_add_batch(map, key_ptrs, value_ptrs, count, NULL);
+    }
+    printf("done in %llu ms\n", (unsigned long long)((now_ns() - start) / 1000000));
+
+    free(key_buf); free(key_ptrs); free(numbers); free(value_ptrs);
+
+    // Generate a pool of random queries
+    char *query_buf = malloc(queries * KEY_SIZE);
+    const char **query_ptrs = malloc(queries * sizeof(char*));
+    void **out = malloc(queries * sizeof(void*));
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    for (size_t idx = 0; idx < queries; idx++) {
+        snprintf(query_buf + (idx * KEY_SIZE), KEY_SIZE, "key_%zu", (size_t)(xorshift64(&rng) % keys));
+        query_ptrs[idx] = query_buf + (idx * KEY_SIZE);
+    }
+
+    for (size_t b = 0; b < sizeof(batch_sizes) / sizeof(batch_sizes[0]); b++) {
+        const size_t batch = batch_sizes[b];
+        volatile uint64_t sum = 0;
+
+        start = now_ns();
+        for (size_t base = 0; base + batch <= queries; base += batch) {
+            map_get_batch(map, query_ptrs + base, batch, out, NULL);
+            for (size_t idx = 0; idx < batch; idx++) { sum += *(const uint64_t*)out[idx]; }
+        }
+        const uint64_t elapsed = now_ns() - start;
+
+        printf("Batch size %3zu: %.2f M lookups/s\n", batch,
+               (double)(queries - queries % batch) * 1e3 / (double)elapsed);
+    }
+
+    free(query_buf); free(query_ptrs); free(out);
+    map_destroy(map);
+}
+
+void bench_map_load(size_t keys) {
+    const char *path = "datum_bench.map";
+    char key[KEY_SIZE];
+    volatile uint64_t sum = 0;
+
+    printf("Loading a map of %zu keys\n", keys);
+
+    uint64_t start = now_ns();
+    map_t *map = map_new_sized(sizeof(uint64_t)).value.map;
+    for (size_t idx = 0; idx < keys; idx++) {
+        snprintf(key, sizeof(key), "key_%zu", idx);
+        const uint64_t value = idx;
+        map_add(map, key, (void*)&value);
+    }
+    printf("Rebuild with map_add: %llu ms\n", (unsigned long long)((now_ns() - start) / 1000000));
+
+    start = now_ns();
+    if (map_save(map, path).status != MAP_OK) {
+        printf("Failed to save the map\n");
+        map_destroy(map);
+
+        return;
+    }
+    printf("map_save:             %llu ms\n", (unsigned long long)((now_ns() - start) / 1000000));
+    map_destroy(map);
+
+    start = now_ns();
+    map_t *mapped = map_open_mmap(path).value.map;
+    printf("map_open_mmap:        %.3f ms\n", (double)(now_ns() - start) / 1e6);
+
+    // Pages are loaded lazily, on the first lookup that touches them
+    start = now_ns();
+    for (size_t idx = 0; idx < keys; idx++) {
+        snprintf(key, sizeof(key), "key_%zu", idx);
+        sum += *(const uint64_t*)map_get(mapped, key).value.element;
+    }
+    printf("Lookup of every key:  %llu ms\n", (unsigned long long)((now_ns() - start) / 1000000));
+
+    map_destroy(mapped);
+    remove(path);
+}
+
+void bench_map_freeze(size_t keys) {
+    const size_t queries = keys < (1 << 20) ? keys : (1 << 20);
+    char key[KEY_SIZE];
+
+    map_t *map = map_new_sized(sizeof(uint64_t)).value.map;
+    for (size_t idx = 0; idx < keys; idx++) {
+        snprintf(key, sizeof(key), "key_%zu", idx);
+        const uint64_t value = idx;
+        map_add(map, key, (void*)&value);
+    }
+
+    uint64_t start = now_ns();
+    map_result_t res = map_freeze(map);
+    if (res.status != MAP_OK) {
+        printf("Failed to freeze the map: %s\n", (const char*)res.message);
+        map_destroy(map);
+
+        return;
+    }
+    frozen_map_t *frozen = res.value.frozen;
+    printf("Freezing %zu keys: %llu ms\n", keys, (unsigned long long)((now_ns() - start) / 1000000));
+
+    printf("Perfect hash: %.2f bits/key, frozen slots: %.2f bits/key, map slots: %.2f bits/key\n",
+           (double)(frozen->bucket_count * 16) / (double)keys,
+           (double)(frozen->table_size * frozen->slot_size * 8) / (double)keys,
+           (double)(map_capacity(map) * (sizeof(map_element_t) + 1 + sizeof(uint64_t)) * 8) / (double)keys);
+
+    char *query_buf = malloc(queries * KEY_SIZE);
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+    for (size_t idx = 0; idx < queries; idx++) {
+        snprintf(query_buf + (idx * KEY_SIZE), KEY_SIZE, "key_%zu", (size_t)(xorshift64(&rng) % keys));
+    }
+
+    volatile uint64_t sum = 0;
+    start = now_ns();
+    for (size_t idx = 0; idx < queries; idx++) {
+        sum += *(const uint64_t*)map_get(map, query_buf + (idx * KEY_SIZE)).value.element;
+    }
+    printf("Map lookups:    %.2f M lookups/s\n", (double)queries * 1e3 / (double)(now_ns() - start));
+
+    start = now_ns();
+    for (size_t idx = 0; idx < queries; idx++) {
+        sum += *(const uint64_t*)frozen_map_get(frozen, query_buf + (idx * KEY_SIZE)).value.element;
+    }
+    printf("Frozen lookups: %.2f M lookups/s\n", (double)queries * 1e3 / (double)(now_ns() - start));
+
+    free(query_buf);
+    frozen_map_destroy(frozen);
+    map_destroy(map);
+}
+
+#define LATENCY_BUCKETS 40
+
+// Returns the upper bound (in ns) of the latency bucket containing percentile @pct
+static uint64_t latency_percentile(const uint64_t *histogram, size_t total, double pct) {
+    const double target = (double)total * pct / 100.0;
+    uint64_t seen = 0;
+
+    for (size_t bucket = 0; bucket < LATENCY_BUCKETS; bucket++) {
+        seen += histogram[bucket];
+        if ((double)seen >= target) {
+            return (uint64_t)1 << bucket;
+        }
+    }
+
+    return (uint64_t)1 << (LATENCY_BUCKETS - 1);
+}
+
+void bench_map_latency(size_t keys) {
+    char key[KEY_SIZE];
+
+    printf("Insert latency over %zu keys (log2 buckets, upper bounds)\n", keys);
+
+    for (int incremental = 0; incremental < 2; incremental++) {
+        map_t *map = map_new_sized(sizeof(uint64_t)).value.map;
+        uint64_t histogram[LATENCY_BUCKETS] = {0};
+        uint64_t max_latency = 0;
+
+        map_set_incremental(map, incremental);
+
+        const uint64_t start = now_ns();
+        for (size_t idx = 0; idx < keys; idx++) {
+            snprintf(key, sizeof(key), "key_%zu", idx);
+            const uint64_t value = idx;
+
+            const uint64_t before = now_ns();
+            map_add(map, key, (void*)&value);
+            const uint64_t latency = now_ns() - before;
+
+            size_t bucket = 0;
+            while (bucket < LATENCY_BUCKETS - 1 && ((uint64_t)1 << bucket) < latency) { bucket++; }
+            histogram[bucket]++;
+            if (latency > max_latency) { max_latency = latency; }
+        }
+        const uint64_t elapsed = now_ns() - start;
+
+        printf("%s: total %llu ms, p50 <= %llu ns, p99 <= %llu ns, p99.9 <= %llu ns, max %.3f ms\n",
+               incremental ? "Incremental resize" : "Full resize       ",
+               (unsigned long long)(elapsed / 1000000),
+               (unsigned long long)latency_percentile(histogram, keys, 50.0),
+               (unsigned long long)latency_percentile(histogram, keys, 99.0),
+               (unsigned long long)latency_percentile(histogram, keys, 99.9),
+               (double)max_latency / 1e6);
+
+        map_destroy(map);
+    }
+}
+
+#define CMAP_MAX_THREADS 32
+
+typedef struct {
+    cmap_t *map;
+    const char *keys;
+    size_t key_count;
+    size_t ops;
+    unsigned read_pct;
+    uint64_t seed;
+} cmap_worker_t;
+
+static void *cmap_worker(void *arg) {
+    cmap_worker_t *worker = arg;
+    static uint64_t value = 0;
+    volatile uint64_t hits = 0;
+
+    for (size_t idx = 0; idx < worker->ops; idx++) {
+        const uint64_t rnd = xorshift64(&worker->seed);
+        const char *key = worker->keys + ((rnd >> 8) % worker->key_count) * KEY_SIZE;
+
+        if ((rnd & 0xFF) % 100 < worker->read_pct) {
+            hits += cmap_get(worker->map, key).status == MAP_OK;
+        } else {
+            cmap_add(worker->map, key, &value);
+        }
+    }
+
+    return NULL;
+}
+
+void bench_cmap(size_t keys) {
+    const size_t thread_counts[] = { 1, 2, 4, 8, 16, 32 };
+    const unsigned read_ratios[] = { 50, 90, 99 };
+    const size_t shard_counts[] = { 1, CMAP_DEFAULT_SHARDS };
+    const size_t ops = keys < (1 << 18) ? keys : (1 << 18);
+    char *key_buf = malloc(keys * KEY_SIZE);
+    static uint64_t value = 0;
+
+    for (size_t idx = 0; idx < keys; idx++) {
+        snprintf(key_buf + (idx * KEY_SIZE), KEY_SIZE, "key_%zu", idx);
+    }
+
+    printf("Concurrent map, %zu keys, %zu ops per thread\n", keys, ops);
+
+    // A single shard behaves like a map behind one global lock
+    for (size_t s = 0; s < sizeof(shard_counts) / sizeof(shard_counts[0]); s++) {
+        cmap_t *map = cmap_new(shard_counts[s]).value.map;
+
+        for (size_t idx = 0; idx < keys; idx++) {
+            cmap_add(map, key_buf + (idx * KEY_SIZE), &value);
+        }
+
+        for (size_t r = 0; r < sizeof(read_ratios) / sizeof(read_ratios[0]); r++) {
+            printf("%2zu shard(s), %2u%% reads:", shard_counts[s], read_ratios[r]);
+
+            for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+                const size_t threads = thread_counts[t];
+                pthread_t tids[CMAP_MAX_THREADS];
+                cmap_worker_t workers[CMAP_MAX_THREADS];
+
+                const uint64_t start = now_ns();
+                for (size_t idx = 0; idx < threads; idx++) {
+                    workers[idx] = (cmap_worker_t) {
+                        .map = map, .keys = key_buf, .key_count = keys, .ops = ops,
+                        .read_pct = read_ratios[r], .seed = 0x9E3779B97F4A7C15ULL + idx
+                    };
+                    pthread_create(&tids[idx], NULL, cmap_worker, &workers[idx]);
+                }
+                for (size_t idx = 0; idx < threads; idx++) { pthread_join(tids[idx], NULL); }
+                const uint64_t elapsed = now_ns() - start;
+
+                printf(" %zuT %.2f", threads, (double)(threads * ops) * 1e3 / (double)elapsed);
+            }
+            printf(" (M ops/s)\n");
+        }
+
+        cmap_destroy(map);
+    }
+
+    free(key_buf);
+}
+
+#define RMAP_WRITES 8
+
+typedef struct {
+    cmap_t *cmap;
+    rmap_t *rmap;
+    const char *keys;
+    size_t key_count;
+    size_t ops;
+    bool writer;
+    uint64_t seed;
+} rmap_worker_t;
+
+static void *rmap_worker(void *arg) {
+    rmap_worker_t *worker = arg;
+    static uint64_t value = 0;
+    volatile uint64_t hits = 0;
+    const size_t reader = worker->rmap ? rmap_register(worker->rmap).value.reader : 0;
+
+    for (size_t idx = 0; idx < worker->ops; idx++) {
+        const char *key = worker->keys + (xorshift64(&worker->seed) % worker->key_count) * KEY_SIZE;
+
+        // A single thread rewrites a key a few times during the run
+        if (worker->writer && idx % (worker->ops / RMAP_WRITES + 1) == 0) {
+            if (worker->rmap) { rmap_add(worker->rmap, key, &value); }
+            else { cmap_add(worker->cmap, key, &value); }
+        }
+
+        if (worker->rmap) {
+            hits += rmap_get(worker->rmap, reader, key).status == MAP_OK;
+        } else {
+            hits += cmap_get(worker->cmap, key).status == MAP_OK;
+        }
+    }
+
+    if (worker->rmap) { rmap_unregister(worker->rmap, reader); }
+
+    return NULL;
+}
+
+void bench_rmap(size_t keys) {
+    const size_t thread_counts[] = { 1, 2, 4, 8, 16, 32 };
+    const size_t ops = keys < (1 << 18) ? keys : (1 << 18);
+    char *key_buf = malloc(keys * KEY_SIZE);
+    const char **key_ptrs = malloc(keys * sizeof(char*));
+    void **value_ptrs = malloc(keys * sizeof(void*));
+    static uint64_t value = 0;
+
+    cmap_t *cmap = cmap_new(0).value.map;
+    rmap_t *rmap = rmap_new().value.rmap;
+
+    for (size_t idx = 0; idx < keys; idx++) {
+        snprintf(key_buf + (idx * KEY_SIZE), KEY_SIZE, "key_%zu", idx);
+        key_ptrs[idx] = key_buf + (idx * KEY_SIZE);
+        value_ptrs[idx] = &value;
+        cmap_add(cmap, key_ptrs[idx], &value);
+    }
+    rmap_add_batch(rmap, key_ptrs, value_ptrs, keys);
+
+    printf("Read-mostly map, %zu keys, %zu lookups per thread, %d writes\n", keys, ops, RMAP_WRITES);
+
+    for (size_t mode = 0; mode < 2; mode++) {
+        printf("%s:", mode == 0 ? "Sharded rwlock" : "Epoch-based   ");
+
+        for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+            const size_t threads = thread_counts[t];
+            pthread_t tids[CMAP_MAX_THREADS];
+            rmap_worker_t workers[CMAP_MAX_THREADS];
+
+            const uint64_t start = now_ns();
+            for (size_t idx = 0; idx < threads; idx++) {
+                workers[idx] = (rmap_worker_t) {
+                    .cmap = mode == 0 ? cmap : NULL, .rmap = mode == 1 ? rmap : NULL,
+                    .keys = key_buf, .key_count = keys, .ops = ops,
+                    .writer = idx == 0, .seed = 0x9E3779B97F4A7C15ULL + idx
+                };
+                pthread_create(&tids[idx], NULL, rmap_worker, &workers[idx]);
+            }
+            for (size_t idx = 0; idx < threads; idx++) { pthread_join(tids[idx], NULL); }
+            const uint64_t elapsed = now_ns() - start;
+
+            printf(" %zuT %.2f", threads, (double)(threads * ops) * 1e3 / (double)elapsed);
+        }
+        printf(" (M lookups/s)\n");
+    }
+
+    cmap_destroy(cmap);
+    rmap_destroy(rmap);
+    free(key_buf); free(key_ptrs); free(value_ptrs);
+}
+
+#define OMAP_SCANS 10000
+#define OMAP_SCAN_LEN 100
+
+static int compare_key_ptrs(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+static void count_visit(const char *key, size_t key_len, void *value, void *env) {
+    (void)key; (void)key_len; (void)value;
+    (*(size_t *)env)++;
+}
+
+void bench_omap(size_t keys) {
+    const size_t queries = keys < (1 << 20) ? keys : (1 << 20);
+    char *key_buf = malloc(keys * KEY_SIZE);
+    char **sorted = malloc(keys * sizeof(char *));
+    void **values = malloc(keys * sizeof(void *));
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    // Hierarchical keys, in random order
+    for (size_t idx = 0; idx < keys; idx++) {
+        const uint64_t rnd = xorshift64(&rng);
+        snprintf(key_buf + (idx * KEY_SIZE), KEY_SIZE, "tenant/%03u/metric/%010llu",
+                 (unsigned)(rnd % 100), (unsigned long long)((rnd >> 20) % 10000000000ULL));
+        values[idx] = key_buf + (idx * KEY_SIZE);
+    }
+
+    // Baseline: a hash map plus a sorted copy of its keys
+    uint64_t start = now_ns();
+    map_t *map = map_new().value.map;
+    for (size_t idx = 0; idx < keys; idx++) {
+        map_add(map, key_buf + (idx * KEY_SIZE), values[idx]);
+        sorted[idx] = key_buf + (idx * KEY_SIZE);
+    }
+    qsort(sorted, keys, sizeof(char *), compare_key_ptrs);
+    printf("Map + sorted keys build: %llu ms\n", (unsigned long long)((now_ns() - start) / 1000000));
+
+    start = now_ns();
+    omap_t *omap = omap_new().value.map;
+    for (size_t idx = 0; idx < keys; idx++) {
+        omap_add(omap, key_buf + (idx * KEY_SIZE), values[idx]);
+    }
+    printf("OMap insertions:        %llu ms (%zu levels, %.1f bytes/key)\n",
+           (unsigned long long)((now_ns() - start) / 1000000), omap_height(omap),
+           (double)(omap->node_count * OMAP_NODE_SIZE) / (double)omap_size(omap));
+
+    // Duplicated keys are dropped from the sorted input
+    size_t unique = 0;
+    for (size_t idx = 0; idx < keys; idx++) {
+        if (unique == 0 || strcmp(sorted[unique - 1], sorted[idx])) { sorted[unique++] = sorted[idx]; }
+    }
+
+    omap_t *bulk = omap_new().value.map;
+    start = now_ns();
+    omap_bulk_load(bulk, (const char *const *)sorted, values, unique);
+    printf("OMap bulk load:         %llu ms (%zu levels, %.1f bytes/key)\n",
+           (unsigned long long)((now_ns() - start) / 1000000), omap_height(bulk),
+           (double)(bulk->node_count * OMAP_NODE_SIZE) / (double)omap_size(bulk));
+
+    volatile uint64_t sum = 0;
+    start = now_ns();
+    for (size_t idx = 0; idx < queries; idx++) {
+        sum += (uintptr_t)map_get(map, sorted[xorshift64(&rng) % unique]).value.element;
+    }
+    printf("Map lookups:  %.2f M lookups/s\n", (double)queries * 1e3 / (double)(now_ns() - start));
+
+    start = now_ns();
+    for (size_t idx = 0; idx < queries; idx++) {
+        sum += (uintptr_t)omap_get(bulk, sorted[xorshift64(&rng) % unique]).value.element;
+    }
+    printf("OMap lookups: %.2f M lookups/s\n", (double)queries * 1e3 / (double)(now_ns() - start));
+
+    // Range scans of OMAP_SCAN_LEN keys
+    size_t visited = 0;
+    start = now_ns();
+    for (size_t idx = 0; idx < OMAP_SCANS; idx++) {
+        const size_t first = xorshift64(&rng) % unique;
+        const size_t last = first + OMAP_SCAN_LEN < unique ? first + OMAP_SCAN_LEN : unique - 1;
+        omap_range(bulk, sorted[first], sorted[last], count_visit, &visited);
+    }
+    printf("OMap range scans: %.2f M keys/s\n", (double)visited * 1e3 / (double)(now_ns() - start));
+
+    sum += visited;
+    omap_destroy(omap);
+    omap_destroy(bulk);
+    map_destroy(map);
+    free(key_buf); free(sorted); free(values);
+}
+
+void bench_art(size_t keys) {
+    const size_t queries = keys < (1 << 20) ? keys : (1 << 20);
+    char *key_buf = malloc(keys * KEY_SIZE);
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    // Hierarchical keys sharing long prefixes
+    for (size_t idx = 0; idx < keys; idx++) {
+        const uint64_t rnd = xorshift64(&rng);
+        snprintf(key_buf + (idx * KEY_SIZE), KEY_SIZE, "/srv/%02u/data/%u/%08llu",
+                 (unsigned)(rnd % 64), (unsigned)((rnd >> 8) % 1000), (unsigned long long)((rnd >> 20) % 100000000ULL));
+    }
+
+    uint64_t start = now_ns();
+    map_t *map = map_new().value.map;
+    for (size_t idx = 0; idx < keys; idx++) {
+        map_add(map, key_buf + (idx * KEY_SIZE), key_buf + (idx * KEY_SIZE));
+    }
+    const size_t map_bytes = map->capacity * (1 + sizeof(map_element_t) + map->value_size) + map->arena_size;
+    printf("Map insertions: %llu ms (%.1f bytes/key)\n", (unsigned long long)((now_ns() - start) / 1000000),
+           (double)map_bytes / (double)map_size(map));
+
+    start = now_ns();
+    art_t *tree = art_new().value.tree;
+    for (size_t idx = 0; idx < keys; idx++) {
+        art_add(tree, key_buf + (idx * KEY_SIZE), key_buf + (idx * KEY_SIZE));
+    }
+    printf("ART insertions: %llu ms (%.1f bytes/key)\n", (unsigned long long)((now_ns() - start) / 1000000),
+           (double)art_memory(tree) / (double)art_size(tree));
+
+    volatile uint64_t sum = 0;
+    start = now_ns();
+    for (size_t idx = 0; idx < queries; idx++) {
+        sum += (uintptr_t)map_get(map, key_buf + ((xorshift64(&rng) % keys) * KEY_SIZE)).value.element;
+    }
+    printf("Map lookups: %.2f M lookups/s\n", (double)queries * 1e3 / (double)(now_ns() - start));
+
+    start = now_ns();
+    for (size_t idx = 0; idx < queries; idx++) {
+        sum += (uintptr_t)art_get(tree, key_buf + ((xorshift64(&rng) % keys) * KEY_SIZE)).value.element;
+    }
+    printf("ART lookups: %.2f M lookups/s\n", (double)queries * 1e3 / (double)(now_ns() - start));
+
+    // Longest prefix match of keys extended with a random suffix
+    char query[KEY_SIZE + 16];
+    size_t matched = 0;
+    start = now_ns();
+    for (size_t idx = 0; idx < queries; idx++) {
+        snprintf(query, sizeof(query), "%s/%u", key_buf + ((xorshift64(&rng) % keys) * KEY_SIZE), (unsigned)idx);
+        matched += art_longest_prefix(tree, query, NULL).status == MAP_OK;
+    }
+    printf("ART longest prefix: %.2f M lookups/s (%zu matched)\n",
+           (double)queries * 1e3 / (double)(now_ns() - start), matched);
+
+    size_t visited = 0;
+    start = now_ns();
+    art_prefix(tree, "/srv/07/", count_visit, &visited);
+    printf("ART prefix scan: %zu keys in %llu ms\n", visited, (unsigned long long)((now_ns() - start) / 1000000));
+
+    sum += visited;
+    art_destroy(tree);
+    map_destroy(map);
+    free(key_buf);
+}
+
+void bench_set(size_t keys) {
+    char *key_buf = malloc(keys * KEY_SIZE);
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    // Half of the keys are duplicates
+    for (size_t idx = 0; idx < keys; idx++) {
+        snprintf(key_buf + (idx * KEY_SIZE), KEY_SIZE, "key_%llu",
+                 (unsigned long long)(xorshift64(&rng) % (keys / 2 + 1)));
+    }
+
+    // Baseline: a map with a dummy value for each key
+    uint64_t start = now_ns();
+    map_t *map = map_new().value.map;
+    for (size_t idx = 0; idx < keys; idx++) {
+        map_add(map, key_buf + (idx * KEY_SIZE), map);
+    }
+    printf("Map dedupe: %llu ms (%zu keys, %zu bytes/slot)\n", (unsigned long long)((now_ns() - start) / 1000000),
+           map_size(map), 1 + sizeof(map_element_t) + map_value_size(map));
+
+    start = now_ns();
+    set_t *set = set_new().value.set;
+    for (size_t idx = 0; idx < keys; idx++) {
+        set_add(set, key_buf + (idx * KEY_SIZE));
+    }
+    printf("Set dedupe: %llu ms (%zu keys, %zu bytes/slot)\n", (unsigned long long)((now_ns() - start) / 1000000),
+           set_size(set), 1 + sizeof(map_element_t) + map_value_size(set->map));
+
+    // Distinct integers of a vector
+    vector_t *vector = vector_new(keys, sizeof(uint64_t)).value.vector;
+    for (size_t idx = 0; idx < keys; idx++) {
+        uint64_t value = xorshift64(&rng) % (keys / 2 + 1);
+        vector_push(vector, &value);
+    }
+
+    start = now_ns();
+    set_t *unique = set_from_vector(vector).value.set;
+    printf("Set from vector: %llu ms (%zu distinct elements)\n",
+           (unsigned long long)((now_ns() - start) / 1000000), set_size(unique));
+
+    set_destroy(unique);
+    vector_destroy(vector);
+    set_destroy(set);
+    map_destroy(map);
+    free(key_buf);
+}
+
+// Queries per second on absent keys and measured false positive rate
+static void report_filter(const char *name, const void *filter, bool (*contains)(const void*, const char*),
+                          const char *absent, size_t keys, size_t memory) {
+    size_t positives = 0;
+
+    const uint64_t start = now_ns();
+    for (size_t idx = 0; idx < keys; idx++) {
+        positives += contains(filter, absent + (idx * KEY_SIZE));
+    }
+    const uint64_t elapsed = now_ns() - start;
+
+    printf("%s: %.2f M queries/s, FPR %.4f%%, %.2f bits/key\n", name,
+           (double)keys * 1000.0 / (double)(elapsed ? elapsed : 1),
+           100.0 * (double)positives / (double)keys, 8.0 * (double)memory / (double)keys);
+}
+
+static bool bench_map_contains(const void *filter, const char *key) {
+    return map_get(filter, key).status == MAP_OK;
+}
+
+static bool bench_bloom_contains(const void *filter, const char *key) {
+    return bloom_contains(filter, key);
+}
+
+static bool bench_fuse_contains(const void *filter, const char *key) {
+    return fuse_contains(filter, key);
+}
+
+void bench_filter(size_t keys) {
+    char *key_buf = malloc(keys * KEY_SIZE);
+    char *absent_buf = malloc(keys * KEY_SIZE);
+
+    for (size_t idx = 0; idx < keys; idx++) {
+        snprintf(key_buf + (idx * KEY_SIZE), KEY_SIZE, "key_%zu", idx);
+        snprintf(absent_buf + (idx * KEY_SIZE), KEY_SIZE, "key_%zu", keys + idx);
+    }
+
+    map_t *map = map_new_keys().value.map;
+    for (size_t idx = 0; idx < keys; idx++) {
+        map_add(map, key_buf + (idx * KEY_SIZE), NULL);
+    }
+    report_filter("Map (exact)", map, bench_map_contains, absent_buf, keys,
+                  map_capacity(map) * (1 + sizeof(map_element_t)));
+
+    const double fprs[] = { 0.01, 0.001 };
+    for (size_t fpr = 0; fpr < 2; fpr++) {
+        uint64_t start = now_ns();
+        bloom_t *bloom = bloom_new(keys, bloom_bits_for_fpr(fprs[fpr])).value.bloom;
+        for (size_t idx = 0; idx < keys; idx++) {
+            bloom_add(bloom, key_buf + (idx * KEY_SIZE));
+        }
+        printf("Bloom %.1f%% build: %llu ms\n", 100.0 * fprs[fpr], (unsigned long long)((now_ns() - start) / 1000000));
+        report_filter("Bloom", bloom, bench_bloom_contains, absent_buf, keys, bloom_memory(bloom));
+        bloom_destroy(bloom);
+    }
+
+    for (uint32_t bits = 8; bits <= 16; bits += 8) {
+        uint64_t start = now_ns();
+        fuse_t *fuse = fuse_from_map(map, bits).value.fuse;
+        printf("Fuse %u-bit build: %llu ms\n", bits, (unsigned long long)((now_ns() - start) / 1000000));
+        report_filter("Fuse", fuse, bench_fuse_contains, absent_buf, keys, fuse_memory(fuse));
+        fuse_destroy(fuse);
+    }
+
+    map_destroy(map);
+    free(absent_buf);
+    free(key_buf);
+}
+
+// Exact LRU with a doubly linked list of the entries, the baseline of cache_t
+typedef struct {
+    uint32_t prev, next, item;
+} lru_node_t;
+
+static size_t bench_list_lru(const char *key_buf, const uint32_t *trace, size_t length, size_t capacity) {
+    map_t *map = map_new().value.map;
+    lru_node_t *nodes = malloc(capacity * sizeof(lru_node_t));
+    uint32_t head = UINT32_MAX, tail = UINT32_MAX, used = 0;
+    size_t hits = 0;
+
+    for (size_t idx = 0; idx < length; idx++) {
+        const char *key = key_buf + ((size_t)trace[idx] * KEY_SIZE);
+        map_result_t res = map_get(map, key);
+        uint32_t node;
+
+        if (res.status == MAP_OK) {
+            hits++;
+            node = (uint32_t)((uintptr_t)res.value.element - 1);
+            if (node == head) { continue; }
+
+            // Unlink the node
+            nodes[nodes[node].prev].next = nodes[node].next;
+            if (node == tail) { tail = nodes[node].prev; } else { nodes[nodes[node].next].prev = nodes[node].prev; }
+        } else {
+            if (used < capacity) {
+                node = used++;
+            } else {
+                node = tail;
+                tail = nodes[node].prev;
+                nodes[tail].next = UINT32_MAX;
+                map_remove(map, key_buf + ((size_t)nodes[node].item * KEY_SIZE));
+            }
+
+            nodes[node].item = trace[idx];
+            map_add(map, key, (void *)(uintptr_t)(node + 1));
+            if (tail == UINT32_MAX) { tail = node; }
+        }
+
+        // Move the node in front of the list
+        nodes[node].prev = UINT32_MAX;
+        nodes[node].next = head;
+        if (head != UINT32_MAX && head != node) { nodes[head].prev = node; }
+        head = node;
+    }
+
+    free(nodes);
+    map_destroy(map);
+
+    return hits;
+}
+
+void bench_cache(size_t length) {
+    const size_t items = length / 10 > 1000 ? length / 10 : 1000;
+    char *key_buf = malloc(items * KEY_SIZE);
+    uint32_t *trace = malloc(length * sizeof(uint32_t));
+    double *cdf = malloc(items * sizeof(double));
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    for (size_t idx = 0; idx < items; idx++) {
+        snprintf(key_buf + (idx * KEY_SIZE), KEY_SIZE, "object_%zu", idx);
+    }
+
+    // Zipf(1.0) trace: the item of rank i is requested with probability 1 / (i * H)
+    double total = 0.0;
+    for (size_t idx = 0; idx < items; idx++) {
+        total += 1.0 / (double)(idx + 1);
+        cdf[idx] = total;
+    }
+
+    for (size_t idx = 0; idx < length; idx++) {
+        const double draw = (double)(xorshift64(&rng) >> 11) / 9007199254740992.0 * total;
+        size_t low = 0, high = items - 1;
+        while (low < high) {
+            const size_t mid = (low + high) / 2;
+            if (cdf[mid] < draw) { low = mid + 1; } else { high = mid; }
+        }
+        trace[idx] = (uint32_t)low;
+    }
+
+    const char *names[] = { "LRU (sampled)", "CLOCK", "S3-FIFO" };
+    const cache_policy_t policies[] = { CACHE_LRU, CACHE_CLOCK, CACHE_S3FIFO };
+    const size_t ratios[] = { 100, 10 };
+
+    for (size_t ratio = 0; ratio < 2; ratio++) {
+        const size_t capacity = items / ratios[ratio];
+        printf("Zipf 1.0, %zu requests over %zu objects, cache of %zu entries:\n", length, items, capacity);
+
+        uint64_t start = now_ns();
+        size_t hits = bench_list_lru(key_buf, trace, length, capacity);
+        uint64_t elapsed = now_ns() - start;
+        printf("  %-14s hit rate %.2f%%, %.2f M ops/s\n", "LRU (list)", 100.0 * (double)hits / (double)length,
+               (double)length * 1000.0 / (double)(elapsed ? elapsed : 1));
+
+        for (size_t policy = 0; policy < 3; policy++) {
+            cache_t *cache = cache_new(policies[policy], capacity, 0).value.cache;
+
+            start = now_ns();
+            for (size_t idx = 0; idx < length; idx++) {
+                const char *key = key_buf + ((size_t)trace[idx] * KEY_SIZE);
+                if (cache_get(cache, key).status != MAP_OK) {
+                    cache_put(cache, key, (void *)key, 1);
+                }
+            }
+            elapsed = now_ns() - start;
+
+            printf("  %-14s hit rate %.2f%%, %.2f M ops/s\n", names[policy],
+                   100.0 * (double)cache_hits(cache) / (double)length,
+                   (double)length * 1000.0 / (double)(elapsed ? elapsed : 1));
+            cache_destroy(cache);
+        }
+    }
+
+    free(cdf);
+    free(trace);
+    free(key_buf);
+}
+
+// Random non-negative big integer of about @limbs limbs, a limb holds 64 * log10(2) ~ 19.27 decimal digits
+static bigint_t *bench_random_bigint(size_t limbs, uint64_t *rng) {
+    const size_t digits = limbs * 19;
+    char *buf = malloc(digits + 1);
+
+    for (size_t idx = 0; idx < digits; idx++) {
+        buf[idx] = (char)('0' + (xorshift64(rng) % 10));
+    }
+    buf[0] = (char)('1' + (xorshift64(rng) % 9));
+    buf[digits] = '\0';
+
+    bigint_t *number = bigint_from_string(buf).value.number;
+    free(buf);
+
+    return number;
+}
+
+typedef bigint_result_t (*bigint_op_fn)(const bigint_t *x, const bigint_t *y);
+
+/*
+ * Average time in microseconds of @op over a run of at least @min_ms milliseconds,
+ * @allocations (if not NULL) receives the average number of heap allocations per call
+ */
+static double bench_bigint_op(bigint_op_fn op, const bigint_t *x, const bigint_t *y, uint64_t min_ms, double *allocations) {
+    const size_t start_allocations = bench_allocations;
+    const uint64_t start = now_ns();
+    uint64_t elapsed = 0;
+    size_t ops = 0;
+
+    do {
+        bigint_result_t res = op(x, y);
+        if (op == bigint_divmod) {
+            bigint_destroy(res.value.division.quotient);
+            bigint_destroy(res.value.division.remainder);
+        } else {
+            bigint_destroy(res.value.number);
+        }
+        ops++;
+        elapsed = now_ns() - start;
+    } while (elapsed < min_ms * 1000000ULL);
+
+    if (allocations != NULL) {
+        *allocations = (double)(bench_allocations - start_allocations) / (double)ops;
+    }
+
+    return (double)elapsed / (double)ops / 1000.0;
+}
+
+// Modular exponentiation by squaring with bigint_prod and bigint_mod, i.e. without a reduction context
+static bigint_t *bench_modpow_naive(const bigint_t *base, const bigint_t *exponent, const bigint_t *modulus) {
+    char *bits = bigint_to_string_base(exponent, 2).value.string_num;
+    bigint_t *power = bigint_from_int(1).value.number;
+
+    for (const char *bit = bits; bit != NULL && *bit != '\0'; bit++) {
+        for (int step = 0; step < (*bit == '1' ? 2 : 1); step++) {
+            bigint_t *product = bigint_prod(power, step == 0 ? power : base).value.number;
+            bigint_destroy(power);
+            power = bigint_mod(product, modulus).value.number;
+            bigint_destroy(product);
+        }
+    }
+    free(bits);
+
+    return power;
+}
+
+void bench_bigint(size_t max_limbs) {
+    uint64_t rng = 0x9E3779B97F4A7C15ULL;
+
+    for (size_t limbs = 10; limbs <= max_limbs; limbs *= 10) {
+        bigint_t *x = bench_random_bigint(limbs, &rng);
+        bigint_t *y = bench_random_bigint(limbs, &rng);
+        bigint_t *dividend = bench_random_bigint(2 * limbs, &rng);
+
+        double mul_allocations;
+        const double add = bench_bigint_op(bigint_add, x, y, 50, NULL);
+        const double mul = bench_bigint_op(bigint_prod, x, y, 50, &mul_allocations);
+        const double div = bench_bigint_op(bigint_divmod, dividend, y, 50, NULL);
+        printf("%6zu limbs: add %10.2f us, mul %12.2f us (%8.1f allocations), div (2n / n) %12.2f us\n",
+               limbs, add, mul, mul_allocations, div);
+
+        bigint_destroy(dividend);
+        bigint_destroy(y);
+        bigint_destroy(x);
+    }
+
+    // Unbalanced product, as in a reduction by a modulus of a tenth of the limbs
+    bigint_t *x = bench_random_bigint(max_limbs * 10, &rng);
+    bigint_t *y = bench_random_bigint(max_limbs / 10, &rng);
+    printf("%6zu x %zu limbs: mul %12.2f us\n", max_limbs * 10, max_limbs / 10,
+           bench_bigint_op(bigint_prod, x, y, 50, NULL));
+    bigint_destroy(y);
+    bigint_destroy(x);
+
+    // Decimal conversion, both ways, of a number of a thousand digits per limb
+    const size_t digits = max_limbs * 1000;
+    char *buf = malloc(digits + 1);
+    for (size_t idx = 0; idx < digits; idx++) {
+        buf[idx] = (char)('0' + (xorshift64(&rng) % 10));
+    }
+    buf[0] = (char)('1' + (xorshift64(&rng) % 9));
+    buf[digits] = '\0';
+
+    uint64_t start = now_ns();
+    bigint_t *number = bigint_from_string(buf).value.number;
+    const uint64_t parse = now_ns() - start;
+
+    start = now_ns();
+    char *str = bigint_to_string(number).value.string_num;
+    const uint64_t print = now_ns() - start;
+
+    printf("%8zu digits: from_string %10.2f ms, to_string %10.2f ms%s\n", digits, (double)parse / 1e6,
+           (double)print / 1e6, (str != NULL && strcmp(str, buf) == 0) ? "" : " (mismatch)");
+    free(str);
+    bigint_destroy(number);
+    free(buf);
+
+    // Modular exponentiation with a modulus, base and exponent of about 2048 bits, as in RSA-2048
+    bigint_t *modulus = bench_random_bigint(32, &rng);
+    bigint_t *base = bench_random_bigint(32, &rng);
+    bigint_t *exponent = bench_random_bigint(32, &rng);
+    bigint_t *one = bigint_from_int(1).value.number;
+    if ((bench_bigint_low(modulus) & 1) == 0) {
+        bigint_add_inplace(modulus, one);
+    }
+    bigint_mont_ctx_t *mont = bigint_mont_ctx_new(modulus).value.mont_ctx;
+    bigint_barrett_ctx_t *barrett = bigint_barrett_ctx_new(modulus).value.barrett_ctx;
+
+    uint64_t elapsed[4];
+    bigint_t *powers[4];
+    start = now_ns();
+    powers[0] = bench_modpow_naive(base, exponent, modulus);
+    elapsed[0] = now_ns() - start;
+    start = now_ns();
+    powers[1] = bigint_modpow(base, exponent, modulus).value.number;
+    elapsed[1] = now_ns() - start;
+    start = now_ns();
+    powers[2] = bigint_mont_modpow(mont, base, exponent, true).value.number;
+    elapsed[2] = now_ns() - start;
+    start = now_ns();
+    powers[3] = bigint_barrett_modpow(barrett, base, exponent).value.number;
+    elapsed[3] = now_ns() - start;
+
+    bool match = true;
+    for (size_t idx = 1; idx < 4; idx++) {
+        match = match && bigint_compare(powers[0], powers[idx]).value.compare_status == 0;
+    }
+    printf("%6zu bits modpow: prod + mod %8.2f ms, Montgomery %8.2f ms (constant time %8.2f ms), Barrett %8.2f ms%s\n",
+           bench_bigint_size(modulus) * BIGINT_LIMB_BITS, (double)elapsed[0] / 1e6, (double)elapsed[1] / 1e6,
+           (double)elapsed[2] / 1e6, (double)elapsed[3] / 1e6, match ? "" : " (mismatch)");
+
+    for (size_t idx = 0; idx < 4; idx++) {
+        bigint_destroy(powers[idx]);
+    }
+    bigint_barrett_ctx_destroy(barrett);
+    bigint_mont_ctx_destroy(mont);
+    bigint_destroy(one);
+    bigint_destroy(exponent);
+    bigint_destroy(base);
+    bigint_destroy(modulus);
+}
+
+/*
+ * Time of a multiplication of about @limbs limbs below and above the threshold @tier
+ * of @base, i.e. with the threshold right after and right at the length of the operands
+ */
+static void bench_bigint_pair(size_t limbs, bigint_thresholds_t *base, size_t *tier,
+                              double *slow_us, double *fast_us) {
+    uint64_t rng = 0x9E3779B97F4A7C15ULL ^ limbs;
+    bigint_t *x = bench_random_bigint(limbs, &rng);
+    bigint_t *y = bench_random_bigint(limbs, &rng);
+    const size_t length = bench_bigint_size(y) < bench_bigint_size(x) ? bench_bigint_size(y) : bench_bigint_size(x);
+
+    *tier = length + 1;
+    bigint_set_thresholds(base);
+    *slow_us = bench_bigint_op(bigint_prod, x, y, 10, NULL);
+    *tier = length;
+    bigint_set_thresholds(base);
+    *fast_us = bench_bigint_op(bigint_prod, x, y, 10, NULL);
+
+    bigint_destroy(y);
+    bigint_destroy(x);
+}
+
+typedef enum { BENCH_TIER_KARATSUBA, BENCH_TIER_TOOM3, BENCH_TIER_NTT } bench_tier_t;
+
+static size_t *bench_tier_threshold(bigint_thresholds_t *thresholds, bench_tier_t tier) {
+    switch (tier) {
+        case BENCH_TIER_KARATSUBA: return &thresholds->karatsuba;
+        case BENCH_TIER_TOOM3: return &thresholds->toom3;
+        default: return &thresholds->ntt;
+    }
+}
+
+/*
+ * Smallest size in [@first, @max_limbs] from which the algorithm enabled by
+ * @tier wins twice in a row, @max_limbs + 1 if it never does
+ */
+static size_t bench_bigint_crossover(const char *name, bigint_thresholds_t base, bench_tier_t tier,
+                                     size_t first, size_t max_limbs) {
+    size_t wins = 0, previous = first;
+
+    for (size_t limbs = first; limbs <= max_limbs; limbs += (limbs / 8) + 1) {
+        double slow_us, fast_us;
+
+        bench_bigint_pair(limbs, &base, bench_tier_threshold(&base, tier), &slow_us, &fast_us);
+        printf("%-10s %6zu limbs: below %12.2f us, above %12.2f us\n", name, limbs, slow_us, fast_us);
+
+        wins = fast_us < slow_us ? wins + 1 : 0;
+        if (wins == 2) {
+            return previous;
+        }
+        previous = limbs;
+    }
+
+    return max_limbs + 1;
+}
+
+/*
+ * Calibrates the multiplication thresholds on this host, one tier at a time:
+ * each size n is multiplied with the tier's threshold set to n + 1 and to n
+ */
+void bench_bigint_tune(size_t max_limbs) {
+    bigint_thresholds_t base = { max_limbs + 1, max_limbs + 1, max_limbs + 1 };
+
+    base.karatsuba = bench_bigint_crossover("karatsuba", base, BENCH_TIER_KARATSUBA, 8, max_limbs);
+    base.toom3 = base.karatsuba;
+    base.toom3 = bench_bigint_crossover("toom3", base, BENCH_TIER_TOOM3, base.karatsuba, max_limbs);
+    base.ntt = bench_bigint_crossover("ntt", base, BENCH_TIER_NTT, base.toom3, max_limbs);
+    bigint_set_thresholds(NULL);
+
+    printf("\nSuggested flags: -DBIGINT_KARATSUBA_THRESHOLD=%zu -DBIGINT_TOOM3_THRESHOLD=%zu -DBIGINT_NTT_THRESHOLD=%zu\n",
+           base.karatsuba, base.toom3, base.ntt);
+}
+
 long long benchmark(test_fn_t fun, size_t iterations, size_t runs) {
     long long total = 0;
 
@@ -163,10 +1221,57 @@ long long benchmark(test_fn_t fun, size_t iterations, size_t runs) {
     return (long long)(total / runs / 1000000);
 }
 
-int main(void) {
+typedef void (*suite_fn_t)(size_t size);
+
+typedef struct {
+    const char *name;
+    suite_fn_t fun;
+    size_t default_size;
+} suite_t;
+
+static const suite_t suites[] = {
+    { "map-batch", bench_map_batch, 100000000 },
+    { "map-latency", bench_map_latency, 20000000 },
+    { "map-load", bench_map_load, 30000000 },
+    { "map-freeze", bench_map_freeze, 10000000 },
+    { "cmap", bench_cmap, 1000000 },
+    { "rmap", bench_rmap, 1000000 },
+    { "omap", bench_omap, 10000000 },
+    { "art", bench_art, 10000000 },
+    { "set", bench_set, 10000000 },
+    { "filter", bench_filter, 10000000 },
+    { "cache", bench_cache, 10000000 },
+    { "bigint", bench_bigint, 10000 },
+    { "bigint-tune", bench_bigint_tune, 16384 },
+};
+
+/*
+ * Usage: ./benchmark_datum [suite [size]]
+ * Without arguments, runs the quick benchmarks followed by each suite on a reduced size
+ */
+int main(int argc, char **argv) {
+    const size_t suites_count = sizeof(suites) / sizeof(suites[0]);
+
+    if (argc > 1) {
+        for (size_t idx = 0; idx < suites_count; idx++) {
+            if (!strcmp(argv[1], suites[idx].name)) {
+                suites[idx].fun(argc > 2 ? (size_t)strtoull(argv[2], NULL, 10) : suites[idx].default_size);
+
+                return 0;
+            }
+        }
+
+        fprintf(stderr, "Unknown suite '%s'. Available suites:", argv[1]);
+        for (size_t idx = 0; idx < suites_count; idx++) { fprintf(stderr, " %s", suites[idx].name); }
+        fputc('\n', stderr);
+
+        return 1;
+    }
+
     // Do a warmup run
     test_vector(1000);
     test_map(1000);
+    test_intmap(1000);
     test_bigint(1000);
 
     printf("Computing Vector average time...");
@@ -177,6 +1282,10 @@ int main(void) {
     fflush(stdout);
     printf("average time: %lld ms\n", benchmark(test_map, 1e5, 30));
 
+    printf("Computing IntMap average time...");
+    fflush(stdout);
+    printf("average time: %lld ms\n", benchmark(test_intmap, 1e5, 30));
+
     printf("Computing BigInt average time...");
     fflush(stdout);
     printf("average time: %lld ms\n", benchmark(test_bigint, 1e5, 30));
@@ -185,5 +1294,30 @@ int main(void) {
     fflush(stdout);
     printf("average time: %lld ms\n", benchmark(test_string, 1e5, 30));
 
+    putchar('\n');
+    bench_map_batch(1000000);
+    putchar('\n');
+    bench_map_latency(1000000);
+    putchar('\n');
+    bench_map_load(1000000);
+    putchar('\n');
+    bench_map_freeze(1000000);
+    putchar('\n');
+    bench_cmap(10000);
+    putchar('\n');
+    bench_rmap(10000);
+    putchar('\n');
+    bench_omap(1000000);
+    putchar('\n');
+    bench_art(1000000);
+    putchar('\n');
+    bench_set(1000000);
+    putchar('\n');
+    bench_filter(1000000);
+    putchar('\n');
+    bench_cache(1000000);
+    putchar('\n');
+    bench_bigint(1000);
+
     return 0;
 }
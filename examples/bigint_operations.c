@@ -106,6 +106,32 @@ int main(void) {
     \nmod result = %B\n",
         quotient, remainder);
 
+    // Accumulate in place, sum = sum + x * y, reusing the limbs of sum and prod
+    bigint_result_t acc_res = bigint_mul_into(prod, x, y);
+    if (acc_res.status == BIGINT_OK) {
+        acc_res = bigint_add_inplace(sum, prod);
+    }
+    if (acc_res.status != BIGINT_OK) {
+        printf("Error while accumulating a product: %s\n", acc_res.message);
+        return 1;
+    }
+
+    // Print result
+    bigint_printf("accumulated result = %B\n", sum);
+
+    // Modular exponentiation, x^y mod (2^127 - 1)
+    bigint_t *modulus = bigint_from_string("170141183460469231731687303715884105727").value.number;
+    bigint_result_t pow_res = bigint_modpow(x, y, modulus);
+    bigint_destroy(modulus);
+    if (pow_res.status != BIGINT_OK) {
+        printf("Error while computing a modular exponentiation: %s\n", pow_res.message);
+        return 1;
+    }
+
+    // Print result
+    bigint_printf("modpow result = %B\n", pow_res.value.number);
+    bigint_destroy(pow_res.value.number);
+
     // Destroy big numbers and strings
     bigint_destroy(x); bigint_destroy(y);
     bigint_destroy(a); bigint_destroy(b);
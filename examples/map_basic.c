@@ -69,6 +69,13 @@ int main(void) {
         printf("Key 'x' (should be updated to 'C0FFEE'): %X\n\n", *val);
     }
 
+    // Iterate over the map
+    map_iter_t iter = map_iter_begin(map);
+    while (map_iter_next(&iter)) {
+        printf("Found key '%s'\n", iter.key);
+    }
+    putchar('\n');
+
     // Remove an element
     map_result_t rm_res = map_remove(map, "y");
     if (rm_res.status != MAP_OK) {
@@ -0,0 +1,1479 @@
+#define SET_MSG(result, msg) \
+    do { \
+        snprintf((char *)(result).message, RESULT_MSG_SIZE, "%s", (const char *)msg); \
+    } while (0)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "art.h"
+
+// Node sizes below which an inner node is replaced by a smaller type
+#define ART_SHRINK_NODE256 37
+#define ART_SHRINK_NODE48 12
+#define ART_SHRINK_NODE16 3
+
+// A leaf stores the value, the length of the suffix and the suffix, i.e.
+// the key bytes not already spelled by the path to the leaf
+#define ART_LEAF_HEADER (sizeof(void*) + sizeof(uint32_t))
+
+typedef struct {
+    art_node_t n;
+    uint8_t keys[4];
+    void *children[4];
+} art_node4_t;
+
+typedef struct {
+    art_node_t n;
+    uint8_t keys[16];
+    void *children[16];
+} art_node16_t;
+
+typedef struct {
+    art_node_t n;
+    uint8_t index[256]; // Slot of each byte plus one, 0 if absent
+    void *children[48];
+} art_node48_t;
+
+typedef struct {
+    art_node_t n;
+    void *children[256];
+} art_node256_t;
+
+// Key rebuilt while walking the tree
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    size_t capacity;
+} art_buffer_t;
+
+static const size_t art_capacity[] = { 4, 16, 48, 256 };
+
+/*
+ * Children are either inner nodes or leaves. Leaves live in the leaf area
+ * of their parent: the child slot holds the offset of the leaf, shifted
+ * left and tagged in the lowest bit to tell it apart from a node address
+ */
+static inline bool art_is_leaf(const void *ptr) {
+    return ((uintptr_t)ptr & 1) != 0;
+}
+
+static inline size_t art_leaf_offset(const void *ptr) {
+    return (size_t)((uintptr_t)ptr >> 1);
+}
+
+static inline void *art_tag_leaf(size_t offset) {
+    return (void*)(((uintptr_t)offset << 1) | 1);
+}
+
+/**
+ * art_node_size
+ *  @type: an inner node type
+ *
+ *  Returns the size of a node of @type, without its compressed path and leaves
+ */
+static inline size_t art_node_size(uint8_t type) {
+    switch (type) {
+        case ART_NODE4: return sizeof(art_node4_t);
+        case ART_NODE16: return sizeof(art_node16_t);
+        case ART_NODE48: return sizeof(art_node48_t);
+        default: return sizeof(art_node256_t);
+    }
+}
+
+/**
+ * art_node_bytes
+ *  @node: a non-null inner node
+ *
+ *  Returns the number of bytes allocated for @node
+ */
+static inline size_t art_node_bytes(const art_node_t *node) {
+    return art_node_size(node->type) + node->prefix_len + node->leaf_size;
+}
+
+/**
+ * art_prefix_of
+ *  @node: a non-null inner node
+ *
+ *  Returns the compressed path of @node, stored right after its children
+ */
+static inline uint8_t *art_prefix_of(const art_node_t *node) {
+    return (uint8_t*)node + art_node_size(node->type);
+}
+
+/**
+ * art_leaf_at
+ *  @node: a non-null inner node
+ *  @offset: the offset of a leaf in the leaf area of @node
+ *
+ *  Returns the leaf, stored after the compressed path of @node
+ */
+static inline uint8_t *art_leaf_at(const art_node_t *node, size_t offset) {
+    return art_prefix_of(node) + node->prefix_len + offset;
+}
+
+// Leaves are packed back to back, so their fields are not aligned
+static inline void *art_leaf_value(const uint8_t *leaf) {
+    void *value;
+    memcpy(&value, leaf, sizeof(void*));
+
+    return value;
+}
+
+static inline void art_set_leaf_value(uint8_t *leaf, void *value) {
+    memcpy(leaf, &value, sizeof(void*));
+}
+
+static inline size_t art_leaf_len(const uint8_t *leaf) {
+    uint32_t len;
+    memcpy(&len, leaf + sizeof(void*), sizeof(uint32_t));
+
+    return len;
+}
+
+static inline const uint8_t *art_leaf_suffix(const uint8_t *leaf) {
+    return leaf + ART_LEAF_HEADER;
+}
+
+/**
+ * art_new_node
+ *  @tree: a non-null tree
+ *  @type: the type of the node
+ *  @prefix: the compressed path of the node
+ *  @prefix_len: length of @prefix
+ *
+ *  Returns a new inner node without children nor leaves or NULL on allocation failure
+ */
+static art_node_t *art_new_node(art_t *tree, uint8_t type, const uint8_t *prefix, size_t prefix_len) {
+    art_node_t *node = calloc(1, art_node_size(type) + prefix_len);
+
+    if (node != NULL) {
+        node->type = type;
+        node->prefix_len = (uint32_t)prefix_len;
+        if (prefix_len > 0) {
+            memcpy(art_prefix_of(node), prefix, prefix_len);
+        }
+        tree->memory += art_node_size(type) + prefix_len;
+    }
+
+    return node;
+}
+
+/**
+ * art_free_node
+ *  @tree: a non-null tree
+ *  @node: an inner node, its children are not freed
+ */
+static void art_free_node(art_t *tree, art_node_t *node) {
+    tree->memory -= art_node_bytes(node);
+    free(node);
+}
+
+/**
+ * art_append_leaf
+ *  @tree: a non-null tree
+ *  @ref: the slot holding a non-null inner node
+ *  @suffix: the key bytes stored in the leaf, outside of the node at @ref
+ *  @len: length of @suffix
+ *  @value: the value of the key
+ *  @offset: receives the offset of the new leaf
+ *
+ *  Appends a leaf to the leaf area of the node at @ref. The node may
+ *  move, so pointers to its children are no longer valid
+ *
+ *  Returns MAP_OK on success, MAP_ERR_OVERFLOW if the leaf area is full or MAP_ERR_ALLOCATE otherwise
+ */
+static map_status_t art_append_leaf(art_t *tree, void **ref, const uint8_t *suffix, size_t len,
+                                    void *value, size_t *offset) {
+    art_node_t *node = *ref;
+
+    if (len > UINT32_MAX - ART_LEAF_HEADER || node->leaf_size > UINT32_MAX - ART_LEAF_HEADER - len) {
+        return MAP_ERR_OVERFLOW;
+    }
+
+    const size_t leaf_bytes = ART_LEAF_HEADER + len;
+    node = realloc(node, art_node_bytes(node) + leaf_bytes);
+    if (node == NULL) {
+        return MAP_ERR_ALLOCATE;
+    }
+
+    uint8_t *leaf = art_leaf_at(node, node->leaf_size);
+    const uint32_t len32 = (uint32_t)len;
+    art_set_leaf_value(leaf, value);
+    memcpy(leaf + sizeof(void*), &len32, sizeof(uint32_t));
+    if (len > 0) {
+        memcpy(leaf + ART_LEAF_HEADER, suffix, len);
+    }
+
+    *offset = node->leaf_size;
+    node->leaf_size += (uint32_t)leaf_bytes;
+    tree->memory += leaf_bytes;
+    *ref = node;
+
+    return MAP_OK;
+}
+
+/**
+ * art_drop_leaf
+ *  @node: a non-null inner node
+ *  @offset: the offset of a leaf of @node that is no longer referenced
+ *
+ *  Counts the leaf as garbage, reclaimed the next time @node is rebuilt
+ */
+static void art_drop_leaf(art_node_t *node, size_t offset) {
+    node->garbage += (uint32_t)(ART_LEAF_HEADER + art_leaf_len(art_leaf_at(node, offset)));
+}
+
+/**
+ * art_trim_prefix
+ *  @tree: a non-null tree
+ *  @node: a non-null inner node
+ *  @count: number of leading bytes to drop from the compressed path of @node
+ */
+static void art_trim_prefix(art_t *tree, art_node_t *node, size_t count) {
+    uint8_t *prefix = art_prefix_of(node);
+
+    // The leaf area moves along with the end of the path
+    memmove(prefix, prefix + count, node->prefix_len - count + node->leaf_size);
+    node->prefix_len -= (uint32_t)count;
+    tree->memory -= count;
+}
+
+/**
+ * art_find_child
+ *  @node: a non-null inner node
+ *  @byte: the next byte of the key
+ *
+ *  Returns a pointer to the child slot of @byte or NULL if @byte has no child
+ */
+static void **art_find_child(const art_node_t *node, uint8_t byte) {
+    switch (node->type) {
+        case ART_NODE4: {
+            art_node4_t *n4 = (art_node4_t*)node;
+            for (size_t idx = 0; idx < node->count; idx++) {
+                if (n4->keys[idx] == byte) { return &n4->children[idx]; }
+            }
+            return NULL;
+        }
+        case ART_NODE16: {
+            art_node16_t *n16 = (art_node16_t*)node;
+            for (size_t idx = 0; idx < node->count; idx++) {
+                if (n16->keys[idx] == byte) { return &n16->children[idx]; }
+            }
+            return NULL;
+        }
+        case ART_NODE48: {
+            art_node48_t *n48 = (art_node48_t*)node;
+            return n48->index[byte] ? &n48->children[n48->index[byte] - 1] : NULL;
+        }
+        default: {
+            art_node256_t *n256 = (art_node256_t*)node;
+            return n256->children[byte] ? &n256->children[byte] : NULL;
+        }
+    }
+}
+
+/**
+ * art_insert_sorted
+ *  @keys: the sorted bytes of a Node4 or Node16
+ *  @children: the children of the same node
+ *  @count: number of children
+ *  @byte: the byte of the new child
+ *  @child: the new child
+ */
+static void art_insert_sorted(uint8_t *keys, void **children, size_t count, uint8_t byte, void *child) {
+    size_t pos = 0;
+
+    while (pos < count && keys[pos] < byte) {
+        pos++;
+    }
+
+    memmove(keys + pos + 1, keys + pos, count - pos);
+    memmove(children + pos + 1, children + pos, (count - pos) * sizeof(void*));
+    keys[pos] = byte;
+    children[pos] = child;
+}
+
+/**
+ * art_put_child
+ *  @node: a non-null inner node with a free slot
+ *  @byte: the byte of the new child
+ *  @child: the new child
+ */
+static void art_put_child(art_node_t *node, uint8_t byte, void *child) {
+    switch (node->type) {
+        case ART_NODE4: {
+            art_node4_t *n4 = (art_node4_t*)node;
+            art_insert_sorted(n4->keys, n4->children, node->count, byte, child);
+            break;
+        }
+        case ART_NODE16: {
+            art_node16_t *n16 = (art_node16_t*)node;
+            art_insert_sorted(n16->keys, n16->children, node->count, byte, child);
+            break;
+        }
+        case ART_NODE48: {
+            art_node48_t *n48 = (art_node48_t*)node;
+            size_t slot = 0;
+            while (n48->children[slot] != NULL) {
+                slot++;
+            }
+            n48->children[slot] = child;
+            n48->index[byte] = (uint8_t)(slot + 1);
+            break;
+        }
+        default:
+            ((art_node256_t*)node)->children[byte] = child;
+            break;
+    }
+
+    node->count++;
+}
+
+/**
+ * art_child_at
+ *  @node: a non-null inner node
+ *  @byte: receives the byte of the child
+ *  @cursor: the position to scan from, updated past the returned child
+ *
+ *  Enumerates the children of @node in increasing byte order
+ *
+ *  Returns the next child or NULL when there are no more children
+ */
+static void *art_child_at(const art_node_t *node, uint8_t *byte, size_t *cursor) {
+    switch (node->type) {
+        case ART_NODE4:
+        case ART_NODE16: {
+            const uint8_t *keys = node->type == ART_NODE4 ? ((const art_node4_t*)node)->keys
+                                                          : ((const art_node16_t*)node)->keys;
+            void *const *children = node->type == ART_NODE4 ? ((const art_node4_t*)node)->children
+                                                            : ((const art_node16_t*)node)->children;
+            if (*cursor >= node->count) {
+                return NULL;
+            }
+            *byte = keys[*cursor];
+            return children[(*cursor)++];
+        }
+        case ART_NODE48: {
+            const art_node48_t *n48 = (const art_node48_t*)node;
+            while (*cursor < 256) {
+                const size_t idx = (*cursor)++;
+                if (n48->index[idx]) {
+                    *byte = (uint8_t)idx;
+                    return n48->children[n48->index[idx] - 1];
+                }
+            }
+            return NULL;
+        }
+        default: {
+            const art_node256_t *n256 = (const art_node256_t*)node;
+            while (*cursor < 256) {
+                const size_t idx = (*cursor)++;
+                if (n256->children[idx] != NULL) {
+                    *byte = (uint8_t)idx;
+                    return n256->children[idx];
+                }
+            }
+            return NULL;
+        }
+    }
+}
+
+/**
+ * art_copy_leaf
+ *  @dest: the leaf area receiving the leaf
+ *  @leaf: a non-null leaf
+ *
+ *  Returns the number of bytes copied
+ */
+static size_t art_copy_leaf(uint8_t *dest, const uint8_t *leaf) {
+    const size_t leaf_bytes = ART_LEAF_HEADER + art_leaf_len(leaf);
+
+    memcpy(dest, leaf, leaf_bytes);
+
+    return leaf_bytes;
+}
+
+/**
+ * art_rebuild
+ *  @tree: a non-null tree
+ *  @node: a non-null inner node
+ *  @type: the new type, large enough for the children of @node
+ *
+ *  Returns a copy of @node with the given type and without the garbage of
+ *  its leaf area, or NULL on allocation failure. @node is freed on success
+ */
+static art_node_t *art_rebuild(art_t *tree, art_node_t *node, uint8_t type) {
+    const size_t leaf_size = node->leaf_size - node->garbage;
+    art_node_t *rebuilt = calloc(1, art_node_size(type) + node->prefix_len + leaf_size);
+
+    if (rebuilt == NULL) {
+        return NULL;
+    }
+
+    rebuilt->type = type;
+    rebuilt->prefix_len = node->prefix_len;
+    memcpy(art_prefix_of(rebuilt), art_prefix_of(node), node->prefix_len);
+
+    uint8_t *leaves = art_leaf_at(rebuilt, 0);
+    size_t used = 0;
+    if (node->end != 0) {
+        used += art_copy_leaf(leaves, art_leaf_at(node, node->end - 1));
+        rebuilt->end = 1;
+    }
+
+    uint8_t byte = 0;
+    size_t cursor = 0;
+    void *child;
+    while ((child = art_child_at(node, &byte, &cursor)) != NULL) {
+        if (art_is_leaf(child)) {
+            const size_t offset = used;
+            used += art_copy_leaf(leaves + offset, art_leaf_at(node, art_leaf_offset(child)));
+            child = art_tag_leaf(offset);
+        }
+        art_put_child(rebuilt, byte, child);
+    }
+
+    rebuilt->leaf_size = (uint32_t)used;
+    tree->memory += art_node_bytes(rebuilt);
+    art_free_node(tree, node);
+
+    return rebuilt;
+}
+
+/**
+ * art_repack
+ *  @tree: a non-null tree
+ *  @ref: the slot holding a non-null inner node
+ *
+ *  Rebuilds the node at @ref once removed leaves take most of its leaf area
+ */
+static void art_repack(art_t *tree, void **ref) {
+    art_node_t *node = *ref;
+
+    if ((size_t)node->garbage * 2 > node->leaf_size) {
+        art_node_t *packed = art_rebuild(tree, node, node->type);
+        if (packed != NULL) {
+            *ref = packed;
+        }
+    }
+}
+
+/**
+ * art_put_key
+ *  @tree: a non-null tree
+ *  @ref: the slot holding a non-null inner node
+ *  @rest: the key bytes past the compressed path of the node
+ *  @rest_len: length of @rest
+ *  @value: the value of the key
+ *
+ *  Adds a key that is not in the node at @ref, either as its end or as a
+ *  leaf child. The node grows to the next type if it is full
+ *
+ *  Returns MAP_OK on success, MAP_ERR_OVERFLOW or MAP_ERR_ALLOCATE otherwise
+ */
+static map_status_t art_put_key(art_t *tree, void **ref, const uint8_t *rest, size_t rest_len, void *value) {
+    art_node_t *node = *ref;
+    size_t offset = 0;
+    map_status_t status;
+
+    if (rest_len == 0) {
+        if ((status = art_append_leaf(tree, ref, NULL, 0, value, &offset)) == MAP_OK) {
+            ((art_node_t*)*ref)->end = (uint32_t)offset + 1;
+        }
+
+        return status;
+    }
+
+    if (node->count == art_capacity[node->type]) {
+        node = art_rebuild(tree, node, (uint8_t)(node->type + 1));
+        if (node == NULL) {
+            return MAP_ERR_ALLOCATE;
+        }
+        *ref = node;
+    }
+
+    if ((status = art_append_leaf(tree, ref, rest + 1, rest_len - 1, value, &offset)) == MAP_OK) {
+        art_put_child(*ref, rest[0], art_tag_leaf(offset));
+    }
+
+    return status;
+}
+
+/**
+ * art_single
+ *  @tree: a non-null tree
+ *  @ref: the slot receiving the node
+ *  @key: the bytes spelled by the node
+ *  @key_len: length of @key
+ *  @value: the value of the key
+ *
+ *  Stores a Node4 whose path is @key and whose end holds @value at @ref
+ *
+ *  Returns MAP_OK on success, MAP_ERR_OVERFLOW or MAP_ERR_ALLOCATE otherwise
+ */
+static map_status_t art_single(art_t *tree, void **ref, const uint8_t *key, size_t key_len, void *value) {
+    void *node = art_new_node(tree, ART_NODE4, key, key_len);
+
+    if (node == NULL) {
+        return MAP_ERR_ALLOCATE;
+    }
+
+    const map_status_t status = art_put_key(tree, &node, NULL, 0, value);
+    if (status != MAP_OK) {
+        art_free_node(tree, node);
+
+        return status;
+    }
+
+    *ref = node;
+
+    return MAP_OK;
+}
+
+/**
+ * art_split_path
+ *  @tree: a non-null tree
+ *  @ref: the slot holding the inner node to split
+ *  @rest: the bytes of the new key from the start of the node path
+ *  @rest_len: length of @rest
+ *  @shared: number of bytes shared by @rest and the path of the node, less than its length
+ *  @value: the value of the new key
+ *
+ *  Replaces the node at @ref with a Node4 spelling the shared bytes, with
+ *  the old node and the new key below it
+ *
+ *  Returns MAP_OK on success, MAP_ERR_OVERFLOW or MAP_ERR_ALLOCATE otherwise
+ */
+static map_status_t art_split_path(art_t *tree, void **ref, const uint8_t *rest, size_t rest_len,
+                                   size_t shared, void *value) {
+    art_node_t *node = *ref;
+    void *split = art_new_node(tree, ART_NODE4, rest, shared);
+
+    if (split == NULL) {
+        return MAP_ERR_ALLOCATE;
+    }
+
+    // A node holding a single key (the root of a one key tree) becomes a leaf
+    const bool single = (node->count == 0);
+    map_status_t status = MAP_OK;
+    if (single) {
+        status = art_put_key(tree, &split, art_prefix_of(node) + shared, node->prefix_len - shared,
+                             art_leaf_value(art_leaf_at(node, node->end - 1)));
+    } else {
+        art_put_child(split, art_prefix_of(node)[shared], node);
+    }
+
+    if (status == MAP_OK) {
+        status = art_put_key(tree, &split, rest + shared, rest_len - shared, value);
+    }
+
+    if (status != MAP_OK) {
+        art_free_node(tree, split);
+
+        return status;
+    }
+
+    if (single) {
+        art_free_node(tree, node);
+    } else {
+        art_trim_prefix(tree, node, shared + 1);
+    }
+    *ref = split;
+
+    return MAP_OK;
+}
+
+/**
+ * art_split_leaf
+ *  @tree: a non-null tree
+ *  @ref: the slot holding a non-null inner node
+ *  @child: the slot of a leaf child of that node
+ *  @rest: the bytes of the new key past the byte of the child
+ *  @rest_len: length of @rest
+ *  @value: the value of the new key
+ *  @added: set to false if the leaf already holds the key
+ *
+ *  Updates the leaf if it holds the new key, otherwise replaces it with
+ *  a Node4 spelling the bytes shared by both keys, with both keys below it
+ *
+ *  Returns MAP_OK on success, MAP_ERR_OVERFLOW or MAP_ERR_ALLOCATE otherwise
+ */
+static map_status_t art_split_leaf(art_t *tree, void **ref, void **child, const uint8_t *rest,
+                                   size_t rest_len, void *value, bool *added) {
+    art_node_t *node = *ref;
+    const size_t offset = art_leaf_offset(*child);
+    uint8_t *leaf = art_leaf_at(node, offset);
+    const size_t leaf_len = art_leaf_len(leaf);
+    const uint8_t *suffix = art_leaf_suffix(leaf);
+    const size_t limit = leaf_len < rest_len ? leaf_len : rest_len;
+    size_t shared = 0;
+
+    while (shared < limit && suffix[shared] == rest[shared]) {
+        shared++;
+    }
+
+    if (shared == leaf_len && shared == rest_len) {
+        art_set_leaf_value(leaf, value);
+        *added = false;
+
+        return MAP_OK;
+    }
+
+    void *split = art_new_node(tree, ART_NODE4, rest, shared);
+    if (split == NULL) {
+        return MAP_ERR_ALLOCATE;
+    }
+
+    // The split node is a new allocation, so the old leaf stays in place meanwhile
+    map_status_t status = art_put_key(tree, &split, suffix + shared, leaf_len - shared, art_leaf_value(leaf));
+    if (status == MAP_OK) {
+        status = art_put_key(tree, &split, rest + shared, rest_len - shared, value);
+    }
+
+    if (status != MAP_OK) {
+        art_free_node(tree, split);
+
+        return status;
+    }
+
+    *child = split;
+    art_drop_leaf(node, offset);
+    art_repack(tree, ref);
+
+    return MAP_OK;
+}
+
+/**
+ * art_lift_key
+ *  @tree: a non-null tree
+ *  @ref: the slot holding an inner node left with a single key
+ *  @parent: the slot holding the parent of that node
+ *  @byte: the byte leading from the parent to the node
+ *  @key: the bytes of the key below @byte
+ *  @key_len: length of @key
+ *  @value: the value of the key
+ *
+ *  Replaces the node at @ref with a leaf of its parent
+ */
+static void art_lift_key(art_t *tree, void **ref, void **parent, uint8_t byte,
+                         const uint8_t *key, size_t key_len, void *value) {
+    art_node_t *node = *ref;
+    size_t offset = 0;
+
+    if (art_append_leaf(tree, parent, key, key_len, value, &offset) != MAP_OK) {
+        return;
+    }
+
+    // The parent may have moved, and @ref with it
+    *art_find_child(*parent, byte) = art_tag_leaf(offset);
+    art_free_node(tree, node);
+}
+
+/**
+ * art_compact
+ *  @tree: a non-null tree
+ *  @ref: the slot holding a non-null inner node that lost a child or its end
+ *  @parent: the slot holding the parent of that node, NULL for the root
+ *  @byte: the byte leading from the parent to the node
+ *
+ *  Frees the root once it is empty, replaces a node left with a single key
+ *  with a leaf of its parent, merges a node left with a single inner child
+ *  with it, and otherwise shrinks the node to a smaller type or drops its
+ *  removed leaves. Allocation failures only leave the node larger than needed
+ */
+static void art_compact(art_t *tree, void **ref, void **parent, uint8_t byte) {
+    art_node_t *node = *ref;
+    const size_t prefix_len = node->prefix_len;
+
+    // Other nodes keep at least two keys or children, only the root is emptied
+    if (node->count == 0 && node->end == 0) {
+        art_free_node(tree, node);
+        *ref = NULL;
+
+        return;
+    }
+
+    if (node->count == 0 && parent != NULL) {
+        // The key ending here becomes a leaf spelling the whole path
+        art_lift_key(tree, ref, parent, byte, art_prefix_of(node), prefix_len,
+                     art_leaf_value(art_leaf_at(node, node->end - 1)));
+
+        return;
+    }
+
+    if (node->count == 1 && node->end == 0) {
+        uint8_t child_byte = 0;
+        size_t cursor = 0;
+        void *child = art_child_at(node, &child_byte, &cursor);
+
+        if (art_is_leaf(child) && parent != NULL) {
+            // The leaf moves to the parent, prepending the path of the node and the byte
+            const uint8_t *leaf = art_leaf_at(node, art_leaf_offset(child));
+            const size_t leaf_len = art_leaf_len(leaf);
+            uint8_t *key = malloc(prefix_len + 1 + leaf_len);
+            if (key == NULL) {
+                return;
+            }
+
+            memcpy(key, art_prefix_of(node), prefix_len);
+            key[prefix_len] = child_byte;
+            memcpy(key + prefix_len + 1, art_leaf_suffix(leaf), leaf_len);
+            art_lift_key(tree, ref, parent, byte, key, prefix_len + 1 + leaf_len, art_leaf_value(leaf));
+            free(key);
+
+            return;
+        }
+
+        if (!art_is_leaf(child)) {
+            // Prepend the path of the node and the byte to the path of the child
+            art_node_t *inner = child;
+            const size_t merged_len = prefix_len + 1 + inner->prefix_len;
+            art_node_t *merged = malloc(art_node_size(inner->type) + merged_len + inner->leaf_size);
+            if (merged == NULL) {
+                return;
+            }
+
+            memcpy(merged, inner, art_node_size(inner->type));
+            uint8_t *prefix = art_prefix_of(merged);
+            memcpy(prefix, art_prefix_of(node), prefix_len);
+            prefix[prefix_len] = child_byte;
+            memcpy(prefix + prefix_len + 1, art_prefix_of(inner), inner->prefix_len);
+            merged->prefix_len = (uint32_t)merged_len;
+            memcpy(art_leaf_at(merged, 0), art_leaf_at(inner, 0), inner->leaf_size);
+            tree->memory += art_node_bytes(merged);
+
+            art_free_node(tree, inner);
+            art_free_node(tree, node);
+            *ref = merged;
+
+            return;
+        }
+    }
+
+    const uint8_t shrink_to[] = { ART_NODE4, ART_NODE4, ART_NODE16, ART_NODE48 };
+    const size_t shrink_at[] = { 0, ART_SHRINK_NODE16, ART_SHRINK_NODE48, ART_SHRINK_NODE256 };
+
+    if (node->type != ART_NODE4 && node->count <= shrink_at[node->type]) {
+        art_node_t *smaller = art_rebuild(tree, node, shrink_to[node->type]);
+        if (smaller != NULL) {
+            *ref = smaller;
+        }
+    } else {
+        art_repack(tree, ref);
+    }
+}
+
+/**
+ * art_remove_child
+ *  @node: a non-null inner node
+ *  @byte: the byte of the child to remove
+ */
+static void art_remove_child(art_node_t *node, uint8_t byte) {
+    void **child = art_find_child(node, byte);
+
+    if (art_is_leaf(*child)) {
+        art_drop_leaf(node, art_leaf_offset(*child));
+    }
+
+    switch (node->type) {
+        case ART_NODE4:
+        case ART_NODE16: {
+            uint8_t *keys = node->type == ART_NODE4 ? ((art_node4_t*)node)->keys : ((art_node16_t*)node)->keys;
+            void **children = node->type == ART_NODE4 ? ((art_node4_t*)node)->children : ((art_node16_t*)node)->children;
+            const size_t pos = (size_t)(child - children);
+            memmove(keys + pos, keys + pos + 1, node->count - pos - 1);
+            memmove(children + pos, children + pos + 1, (node->count - pos - 1) * sizeof(void*));
+            break;
+        }
+        case ART_NODE48: {
+            art_node48_t *n48 = (art_node48_t*)node;
+            n48->children[n48->index[byte] - 1] = NULL;
+            n48->index[byte] = 0;
+            break;
+        }
+        default:
+            ((art_node256_t*)node)->children[byte] = NULL;
+            break;
+    }
+
+    node->count--;
+}
+
+/**
+ * art_free_subtree
+ *  @tree: a non-null tree
+ *  @node: an inner node or NULL
+ */
+static void art_free_subtree(art_t *tree, art_node_t *node) {
+    if (node == NULL) {
+        return;
+    }
+
+    uint8_t byte = 0;
+    size_t cursor = 0;
+    void *child;
+    while ((child = art_child_at(node, &byte, &cursor)) != NULL) {
+        if (!art_is_leaf(child)) {
+            art_free_subtree(tree, child);
+        }
+    }
+
+    art_free_node(tree, node);
+}
+
+/**
+ * art_common_prefix
+ *  @a: a sequence of bytes
+ *  @b: a sequence of bytes
+ *  @len: number of bytes to compare
+ *
+ *  Returns the number of leading bytes shared by @a and @b, at most @len
+ */
+static inline size_t art_common_prefix(const uint8_t *a, const uint8_t *b, size_t len) {
+    size_t idx = 0;
+
+    while (idx < len && a[idx] == b[idx]) {
+        idx++;
+    }
+
+    return idx;
+}
+
+/**
+ * art_new
+ *
+ *  Returns an art_result_t data type containing a new empty tree
+ */
+art_result_t art_new(void) {
+    art_result_t result = {0};
+
+    art_t *tree = malloc(sizeof(art_t));
+    if (tree == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for tree");
+
+        return result;
+    }
+
+    tree->root = NULL;
+    tree->size = 0;
+    tree->memory = 0;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Tree successfully created");
+    result.value.tree = tree;
+
+    return result;
+}
+
+/**
+ * art_add_bytes
+ *  @tree: a non-null tree
+ *  @key: a sequence of @key_len bytes
+ *  @key_len: length of @key
+ *  @value: a generic value to add to the tree
+ *
+ *  Adds (@key, @value) to @tree, replacing the value of an existing key.
+ *  Values are stored by reference
+ *
+ *  Returns an art_result_t data type containing the status
+ */
+art_result_t art_add_bytes(art_t *tree, const void *key, size_t key_len, void *value) {
+    art_result_t result = {0};
+
+    if (tree == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid tree or key");
+
+        return result;
+    }
+
+    if (key_len > UINT32_MAX - ART_LEAF_HEADER) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Key is too long");
+
+        return result;
+    }
+
+    const uint8_t *bytes = key;
+    void **ref = &tree->root;
+    size_t depth = 0;
+    map_status_t status = MAP_OK;
+    bool added = true;
+
+    if (*ref == NULL) {
+        // The first key is the end of a root spelling it
+        status = art_single(tree, ref, bytes, key_len, value);
+    } else {
+        for (;;) {
+            art_node_t *node = *ref;
+            const uint8_t *rest = bytes + depth;
+            const size_t rest_len = key_len - depth;
+            const size_t limit = node->prefix_len < rest_len ? node->prefix_len : rest_len;
+            const size_t shared = art_common_prefix(art_prefix_of(node), rest, limit);
+
+            if (shared < node->prefix_len) {
+                // The new key leaves the compressed path halfway
+                status = art_split_path(tree, ref, rest, rest_len, shared, value);
+                break;
+            }
+
+            depth += node->prefix_len;
+
+            if (depth == key_len) {
+                if (node->end != 0) {
+                    art_set_leaf_value(art_leaf_at(node, node->end - 1), value);
+                    added = false;
+                } else {
+                    status = art_put_key(tree, ref, NULL, 0, value);
+                }
+                break;
+            }
+
+            void **child = art_find_child(node, bytes[depth]);
+            if (child == NULL) {
+                status = art_put_key(tree, ref, bytes + depth, key_len - depth, value);
+                break;
+            }
+
+            depth++;
+            if (art_is_leaf(*child)) {
+                status = art_split_leaf(tree, ref, child, bytes + depth, key_len - depth, value, &added);
+                break;
+            }
+
+            ref = child;
+        }
+    }
+
+    if (status != MAP_OK) {
+        result.status = status;
+        SET_MSG(result, (status == MAP_ERR_OVERFLOW ?
+                "Too many keys below a tree node" : "Failed to allocate memory for tree nodes"));
+
+        return result;
+    }
+
+    if (added) {
+        tree->size++;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Key successfully added");
+
+    return result;
+}
+
+/**
+ * art_add
+ *  @tree: a non-null tree
+ *  @key: a string representing the index key
+ *  @value: a generic value to add to the tree
+ *
+ *  Returns an art_result_t data type containing the status
+ */
+art_result_t art_add(art_t *tree, const char *key, void *value) {
+    if (key == NULL) {
+        return art_add_bytes(tree, NULL, 0, value);
+    }
+
+    return art_add_bytes(tree, key, strlen(key), value);
+}
+
+/**
+ * art_get_bytes
+ *  @tree: a non-null tree
+ *  @key: a sequence of @key_len bytes
+ *  @key_len: length of @key
+ *
+ *  Returns an art_result_t data type containing the element indexed by @key if available
+ */
+art_result_t art_get_bytes(const art_t *tree, const void *key, size_t key_len) {
+    art_result_t result = {0};
+
+    if (tree == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid tree or key");
+
+        return result;
+    }
+
+    const uint8_t *bytes = key;
+    const art_node_t *node = tree->root;
+    const uint8_t *found = NULL;
+    size_t depth = 0;
+
+    while (node != NULL) {
+        if (node->prefix_len > key_len - depth || memcmp(art_prefix_of(node), bytes + depth, node->prefix_len)) {
+            break;
+        }
+
+        depth += node->prefix_len;
+        if (depth == key_len) {
+            found = node->end ? art_leaf_at(node, node->end - 1) : NULL;
+            break;
+        }
+
+        void **child = art_find_child(node, bytes[depth++]);
+        if (child == NULL) {
+            break;
+        }
+
+        // The leaf is stored in the same allocation as its parent
+        if (art_is_leaf(*child)) {
+            const uint8_t *leaf = art_leaf_at(node, art_leaf_offset(*child));
+            if (art_leaf_len(leaf) == key_len - depth && !memcmp(art_leaf_suffix(leaf), bytes + depth, key_len - depth)) {
+                found = leaf;
+            }
+            break;
+        }
+
+        node = *child;
+    }
+
+    if (found == NULL) {
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Value successfully retrieved");
+    result.value.element = art_leaf_value(found);
+
+    return result;
+}
+
+/**
+ * art_get
+ *  @tree: a non-null tree
+ *  @key: a string representing the index key
+ *
+ *  Returns an art_result_t data type containing the element indexed by @key if available
+ */
+art_result_t art_get(const art_t *tree, const char *key) {
+    if (key == NULL) {
+        return art_get_bytes(tree, NULL, 0);
+    }
+
+    return art_get_bytes(tree, key, strlen(key));
+}
+
+/**
+ * art_remove_bytes
+ *  @tree: a non-null tree
+ *  @key: a sequence of @key_len bytes
+ *  @key_len: length of @key
+ *
+ *  Removes @key from @tree. Nodes are shrunk, and nodes left with a
+ *  single child are merged with it
+ *
+ *  Returns an art_result_t data type containing the status
+ */
+art_result_t art_remove_bytes(art_t *tree, const void *key, size_t key_len) {
+    art_result_t result = {0};
+
+    if (tree == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid tree or key");
+
+        return result;
+    }
+
+    const uint8_t *bytes = key;
+    void **ref = &tree->root;
+    void **parent = NULL;
+    uint8_t parent_byte = 0;
+    size_t depth = 0;
+    bool removed = false;
+
+    while (*ref != NULL) {
+        art_node_t *node = *ref;
+        if (node->prefix_len > key_len - depth || memcmp(art_prefix_of(node), bytes + depth, node->prefix_len)) {
+            break;
+        }
+
+        depth += node->prefix_len;
+        if (depth == key_len) {
+            if (node->end != 0) {
+                art_drop_leaf(node, node->end - 1);
+                node->end = 0;
+                art_compact(tree, ref, parent, parent_byte);
+                removed = true;
+            }
+            break;
+        }
+
+        const uint8_t byte = bytes[depth++];
+        void **child = art_find_child(node, byte);
+        if (child == NULL) {
+            break;
+        }
+
+        if (art_is_leaf(*child)) {
+            const uint8_t *leaf = art_leaf_at(node, art_leaf_offset(*child));
+            if (art_leaf_len(leaf) == key_len - depth && !memcmp(art_leaf_suffix(leaf), bytes + depth, key_len - depth)) {
+                art_remove_child(node, byte);
+                art_compact(tree, ref, parent, parent_byte);
+                removed = true;
+            }
+            break;
+        }
+
+        parent = ref;
+        parent_byte = byte;
+        ref = child;
+    }
+
+    if (!removed) {
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    tree->size--;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Key successfully removed");
+
+    return result;
+}
+
+/**
+ * art_remove
+ *  @tree: a non-null tree
+ *  @key: a string representing the index key
+ *
+ *  Returns an art_result_t data type containing the status
+ */
+art_result_t art_remove(art_t *tree, const char *key) {
+    if (key == NULL) {
+        return art_remove_bytes(tree, NULL, 0);
+    }
+
+    return art_remove_bytes(tree, key, strlen(key));
+}
+
+/**
+ * art_longest_prefix
+ *  @tree: a non-null tree
+ *  @key: a string
+ *  @match_len: if not NULL, receives the length of the matched key
+ *
+ *  Finds the longest key of @tree that is a prefix of @key
+ *
+ *  Returns an art_result_t data type containing the element of the matched key if available
+ */
+art_result_t art_longest_prefix(const art_t *tree, const char *key, size_t *match_len) {
+    art_result_t result = {0};
+
+    if (tree == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid tree or key");
+
+        return result;
+    }
+
+    const uint8_t *bytes = (const uint8_t*)key;
+    const size_t key_len = strlen(key);
+    const art_node_t *node = tree->root;
+    const uint8_t *best = NULL;
+    size_t best_len = 0, depth = 0;
+
+    while (node != NULL) {
+        if (node->prefix_len > key_len - depth || memcmp(art_prefix_of(node), bytes + depth, node->prefix_len)) {
+            break;
+        }
+
+        depth += node->prefix_len;
+        if (node->end != 0) {
+            best = art_leaf_at(node, node->end - 1);
+            best_len = depth;
+        }
+
+        if (depth == key_len) {
+            break;
+        }
+
+        void **child = art_find_child(node, bytes[depth++]);
+        if (child == NULL) {
+            break;
+        }
+
+        if (art_is_leaf(*child)) {
+            const uint8_t *leaf = art_leaf_at(node, art_leaf_offset(*child));
+            const size_t leaf_len = art_leaf_len(leaf);
+            if (leaf_len <= key_len - depth && !memcmp(art_leaf_suffix(leaf), bytes + depth, leaf_len)) {
+                best = leaf;
+                best_len = depth + leaf_len;
+            }
+            break;
+        }
+
+        node = *child;
+    }
+
+    if (best == NULL) {
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    if (match_len != NULL) {
+        *match_len = best_len;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Value successfully retrieved");
+    result.value.element = art_leaf_value(best);
+
+    return result;
+}
+
+/**
+ * art_buffer_push
+ *  @buffer: a non-null key buffer
+ *  @bytes: the bytes to append
+ *  @len: number of bytes to append
+ *
+ *  Returns true on success, false on allocation failure
+ */
+static bool art_buffer_push(art_buffer_t *buffer, const uint8_t *bytes, size_t len) {
+    // One more byte for the NUL terminator
+    if (buffer->len + len + 1 > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 64;
+        while (capacity < buffer->len + len + 1) {
+            capacity *= 2;
+        }
+
+        uint8_t *data = realloc(buffer->data, capacity);
+        if (data == NULL) {
+            return false;
+        }
+
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->data + buffer->len, bytes, len);
+    buffer->len += len;
+
+    return true;
+}
+
+/**
+ * art_visit_leaf
+ *  @buffer: the key bytes above the leaf
+ *  @leaf: a non-null leaf
+ *  @callback: the function called on the key
+ *  @env: an optional environment passed to @callback
+ *
+ *  Returns true on success, false on allocation failure
+ */
+static bool art_visit_leaf(art_buffer_t *buffer, const uint8_t *leaf, art_visit_fn callback, void *env) {
+    const size_t len = buffer->len;
+
+    if (!art_buffer_push(buffer, art_leaf_suffix(leaf), art_leaf_len(leaf))) {
+        return false;
+    }
+
+    buffer->data[buffer->len] = '\0';
+    callback((const char*)buffer->data, buffer->len, art_leaf_value(leaf), env);
+    buffer->len = len;
+
+    return true;
+}
+
+/**
+ * art_visit
+ *  @node: a non-null inner node
+ *  @buffer: the key bytes above @node
+ *  @callback: the function called on each key
+ *  @env: an optional environment passed to @callback
+ *
+ *  Visits the keys below @node in increasing order
+ *
+ *  Returns true on success, false on allocation failure
+ */
+static bool art_visit(const art_node_t *node, art_buffer_t *buffer, art_visit_fn callback, void *env) {
+    const size_t len = buffer->len;
+
+    if (!art_buffer_push(buffer, art_prefix_of(node), node->prefix_len)) {
+        return false;
+    }
+
+    // A key ending at the node sorts before the keys that extend it
+    if (node->end != 0 && !art_visit_leaf(buffer, art_leaf_at(node, node->end - 1), callback, env)) {
+        return false;
+    }
+
+    uint8_t byte = 0;
+    size_t cursor = 0;
+    const void *child;
+    while ((child = art_child_at(node, &byte, &cursor)) != NULL) {
+        if (!art_buffer_push(buffer, &byte, 1)) {
+            return false;
+        }
+
+        const bool ok = art_is_leaf(child) ?
+                        art_visit_leaf(buffer, art_leaf_at(node, art_leaf_offset(child)), callback, env) :
+                        art_visit(child, buffer, callback, env);
+        if (!ok) {
+            return false;
+        }
+        buffer->len--;
+    }
+
+    buffer->len = len;
+
+    return true;
+}
+
+/**
+ * art_prefix
+ *  @tree: a non-null tree
+ *  @prefix: a string
+ *  @callback: the function called on each key, in increasing order
+ *  @env: an optional environment passed to @callback
+ *
+ *  Calls @callback on every key starting with @prefix. Keys are
+ *  rebuilt in a buffer that is only valid during the callback
+ *
+ *  Returns an art_result_t data type containing the status
+ */
+art_result_t art_prefix(const art_t *tree, const char *prefix, art_visit_fn callback, void *env) {
+    art_result_t result = {0};
+
+    if (tree == NULL || prefix == NULL || callback == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid tree, prefix or callback");
+
+        return result;
+    }
+
+    const uint8_t *bytes = (const uint8_t*)prefix;
+    const size_t prefix_len = strlen(prefix);
+    art_buffer_t buffer = { NULL, 0, 0 };
+    const art_node_t *node = tree->root;
+    size_t depth = 0;
+    bool ok = true;
+
+    while (node != NULL) {
+        const size_t rest_len = prefix_len - depth;
+        const size_t limit = node->prefix_len < rest_len ? node->prefix_len : rest_len;
+        if (memcmp(art_prefix_of(node), bytes + depth, limit)) {
+            break;
+        }
+
+        // The prefix ends within the path of the node: every key below matches
+        if (node->prefix_len >= rest_len) {
+            ok = art_visit(node, &buffer, callback, env);
+            break;
+        }
+
+        depth += node->prefix_len;
+        void **child = art_find_child(node, bytes[depth]);
+        if (child == NULL) {
+            break;
+        }
+
+        ok = art_buffer_push(&buffer, art_prefix_of(node), node->prefix_len) &&
+             art_buffer_push(&buffer, &bytes[depth], 1);
+        if (!ok) {
+            break;
+        }
+
+        depth++;
+        if (art_is_leaf(*child)) {
+            const uint8_t *leaf = art_leaf_at(node, art_leaf_offset(*child));
+            if (art_leaf_len(leaf) >= prefix_len - depth && !memcmp(art_leaf_suffix(leaf), bytes + depth, prefix_len - depth)) {
+                ok = art_visit_leaf(&buffer, leaf, callback, env);
+            }
+            break;
+        }
+
+        node = *child;
+    }
+
+    free(buffer.data);
+
+    if (!ok) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for keys");
+
+        return result;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Prefix successfully visited");
+
+    return result;
+}
+
+/**
+ * art_foreach
+ *  @tree: a non-null tree
+ *  @callback: the function called on each key, in increasing order
+ *  @env: an optional environment passed to @callback
+ *
+ *  Returns an art_result_t data type containing the status
+ */
+art_result_t art_foreach(const art_t *tree, art_visit_fn callback, void *env) {
+    return art_prefix(tree, "", callback, env);
+}
+
+/**
+ * art_clear
+ *  @tree: a non-null tree
+ *
+ *  Returns an art_result_t data type containing the status
+ */
+art_result_t art_clear(art_t *tree) {
+    art_result_t result = {0};
+
+    if (tree == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid tree");
+
+        return result;
+    }
+
+    art_free_subtree(tree, tree->root);
+    tree->root = NULL;
+    tree->size = 0;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Tree successfully cleared");
+
+    return result;
+}
+
+/**
+ * art_destroy
+ *  @tree: a tree
+ *
+ *  Returns an art_result_t data type containing the status
+ */
+art_result_t art_destroy(art_t *tree) {
+    art_result_t result = {0};
+
+    if (tree == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid tree");
+
+        return result;
+    }
+
+    art_free_subtree(tree, tree->root);
+    free(tree);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Tree successfully deleted");
+
+    return result;
+}
@@ -0,0 +1,79 @@
+#ifndef ART_H
+#define ART_H
+
+#define RESULT_MSG_SIZE 64
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "map.h"
+
+// Inner node types, chosen by the number of children
+typedef enum {
+    ART_NODE4 = 0x0,
+    ART_NODE16,
+    ART_NODE48,
+    ART_NODE256
+} art_node_type_t;
+
+// Common header of the inner nodes. The children layout depends on the type,
+// the compressed path (prefix_len bytes) follows the children and the leaves
+// of the children (leaf_size bytes) follow the compressed path
+typedef struct {
+    uint8_t type;
+    uint16_t count; // Number of children
+    uint32_t prefix_len;
+    uint32_t end; // Offset of the leaf of the key ending at this node plus one, 0 if none
+    uint32_t leaf_size; // Bytes of the leaf area, removed leaves included
+    uint32_t garbage; // Bytes of the removed leaves
+} art_node_t;
+
+typedef struct {
+    void *root; // Root inner node, NULL when the tree is empty
+    size_t size;
+    size_t memory; // Bytes used by nodes and leaves
+} art_t;
+
+typedef struct {
+    map_status_t status;
+    uint8_t message[RESULT_MSG_SIZE];
+    union {
+        art_t *tree;
+        void *element;
+    } value;
+} art_result_t;
+
+// Callback functions
+typedef void (*art_visit_fn)(const char *key, size_t key_len, void *value, void *env);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+art_result_t art_new(void);
+art_result_t art_add(art_t *tree, const char *key, void *value);
+art_result_t art_add_bytes(art_t *tree, const void *key, size_t key_len, void *value);
+art_result_t art_get(const art_t *tree, const char *key);
+art_result_t art_get_bytes(const art_t *tree, const void *key, size_t key_len);
+art_result_t art_remove(art_t *tree, const char *key);
+art_result_t art_remove_bytes(art_t *tree, const void *key, size_t key_len);
+art_result_t art_longest_prefix(const art_t *tree, const char *key, size_t *match_len);
+art_result_t art_prefix(const art_t *tree, const char *prefix, art_visit_fn callback, void *env);
+art_result_t art_foreach(const art_t *tree, art_visit_fn callback, void *env);
+art_result_t art_clear(art_t *tree);
+art_result_t art_destroy(art_t *tree);
+
+// Inline methods
+static inline size_t art_size(const art_t *tree) {
+    return tree ? tree->size : 0;
+}
+
+static inline size_t art_memory(const art_t *tree) {
+    return tree ? tree->memory : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,10 +9,6 @@
         (result).message[RESULT_MSG_SIZE - 1] = '\0'; \
     } while (0)
 
-#define REMOVE(ptr) \
-    free(ptr); \
-    ptr = NULL
-
 #define IS_DIGIT(c) ((c) >= '0') && ((c) <= '9')
 
 #include <stdio.h>
@@ -23,1811 +19,4108 @@
 #include "bigint.h"
 #include "vector.h"
 
-/**
- * bigint_trim_zeros
- *  @number: a non-null big integer
- * 
- *  Helper function to remove leading zeros
- * 
- *  Returns a bigint_result_t data type
+// Decimal conversion works by chunks of 19 digits, 10^19 being the largest power of ten that fits a limb
+#define BIGINT_DECIMAL_DIGITS 19
+#define BIGINT_DECIMAL_BASE 10000000000000000000ULL
+// Numbers shorter than this (in limbs) are converted with the quadratic algorithms
+#define BIGINT_RADIX_THRESHOLD 64
+#define BIGINT_RADIX_LEVELS 64
+// Powers at least this long are divided through their reciprocal
+#define BIGINT_RADIX_MU_THRESHOLD 1024
+// Squares shorter than this (in limbs) are computed with bigint_mpn_sqr_basecase by the exponentiation
+#define BIGINT_SQR_THRESHOLD 64
+// Reciprocals shorter than this (in limbs) are computed by a division rather than by Newton's iteration
+#define BIGINT_INVERT_THRESHOLD 512
+
+// Double limb holding the full product of two limbs
+__extension__ typedef unsigned __int128 bigint_dlimb_t;
+// Signed double limb holding the sum or the difference of two single limb numbers
+__extension__ typedef __int128 bigint_sdlimb_t;
+
+/*
+ * Low-level layer: the following functions work on raw spans of base 2^64
+ * limbs (least significant first) with explicit lengths and never allocate,
+ * unless stated otherwise. Spans may contain leading zeros.
  */
-static bigint_result_t bigint_trim_zeros(bigint_t *number) {
-    bigint_result_t result = {0};
 
-    size_t number_len = vector_size(number->digits);
-
-    while (number_len > 1) {
-        vector_result_t get_res = vector_get(number->digits, number_len - 1);
-        if (get_res.status != VECTOR_OK) {
-            vector_destroy(number->digits);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, get_res.message);
-
-            return result;
-        }
+/**
+ * bigint_mpn_normalize
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *
+ *  Returns the length of @xp without its leading zeros
+ */
+static size_t bigint_mpn_normalize(const bigint_limb_t *xp, size_t xn) {
+    while (xn > 0 && xp[xn - 1] == 0) {
+        xn--;
+    }
 
-        int *last = (int*)get_res.value.element;
-        if (*last != 0) {
-            break;
-        }
+    return xn;
+}
 
-        vector_result_t pop_res = vector_pop(number->digits);
-        if (pop_res.status != VECTOR_OK) {
-            vector_destroy(number->digits);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, get_res.message);
+/**
+ * bigint_mpn_cmp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp
+ *
+ *  Compares two spans, leading zeros are ignored
+ *
+ *  Returns -1, 0 or 1 if @xp is less than, equal to or greater than @yp
+ */
+static int bigint_mpn_cmp(const bigint_limb_t *xp, size_t xn, const bigint_limb_t *yp, size_t yn) {
+    xn = bigint_mpn_normalize(xp, xn);
+    yn = bigint_mpn_normalize(yp, yn);
 
-            return result;
-        }
-        number_len--;
+    if (xn != yn) {
+        return xn > yn ? 1 : -1;
     }
 
-    if (number_len == 1) {
-        vector_result_t get_res = vector_get(number->digits, number_len - 1);
-        if (get_res.status != VECTOR_OK) {
-            vector_destroy(number->digits);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, get_res.message);
-
-            return result;
-        }
-
-        int *first = (int*)get_res.value.element;
-        if (*first == 0) {
-            number->is_negative = false;
+    // Start to compare from the MSB
+    while (xn-- > 0) {
+        if (xp[xn] != yp[xn]) {
+            return xp[xn] > yp[xn] ? 1 : -1;
         }
     }
 
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Big integer successfully trimmed");
+    return 0;
+}
 
-    return result;
+/**
+ * bigint_mpn_add_1
+ *  @rp: output span of @xn limbs, it may alias @xp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @y: a single limb
+ *
+ *  Computes @rp = @xp + @y
+ *
+ *  Returns the carry out of the most significant limb
+ */
+static bigint_limb_t bigint_mpn_add_1(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn, bigint_limb_t y) {
+    for (size_t idx = 0; idx < xn; idx++) {
+        rp[idx] = xp[idx] + y;
+        y = rp[idx] < y;
+    }
 
+    return y;
 }
 
 /**
- * bigint_compare_abs
- *  @x: a non-null big integer
- *  @y: a non-null big integer
+ * bigint_mpn_add
+ *  @rp: output span of @xn limbs, it may alias @xp or @yp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp, at most @xn
  *
- *  Compares absolute value of two big integers
- *  if |x| <  |y| => -1
- *  if |x| == |y| => 0
- *  if |x| >  |y| => 1
+ *  Computes @rp = @xp + @yp
  *
- *  Returns a bigint_result_t data type
+ *  Returns the carry out of the most significant limb
  */
-static bigint_result_t bigint_compare_abs(const bigint_t *x, const bigint_t *y) {
-    bigint_result_t result = {0};
+static bigint_limb_t bigint_mpn_add(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                                    const bigint_limb_t *yp, size_t yn) {
+    bigint_limb_t carry = 0;
+
+    for (size_t idx = 0; idx < yn; idx++) {
+        bigint_limb_t sum;
+        const bool overflow = __builtin_add_overflow(xp[idx], yp[idx], &sum);
+        const bool carry_overflow = __builtin_add_overflow(sum, carry, &rp[idx]);
+        carry = overflow | carry_overflow;
+    }
 
-    const size_t x_size = vector_size(x->digits);
-    const size_t y_size = vector_size(y->digits);
+    return bigint_mpn_add_1(rp + yn, xp + yn, xn - yn, carry);
+}
 
-    if (x_size != y_size) {
-        result.value.compare_status = (x_size > y_size) ? 1 : -1;
-        result.status = BIGINT_OK;
-        SET_MSG(result, "Big integer comparison was successful");
+/**
+ * bigint_mpn_sub
+ *  @rp: output span of @xn limbs, it may alias @xp or @yp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp, at most @xn
+ *
+ *  Computes @rp = @xp - @yp
+ *
+ *  Returns the borrow out of the most significant limb, that is 1 if @yp > @xp
+ */
+static bigint_limb_t bigint_mpn_sub(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                                    const bigint_limb_t *yp, size_t yn) {
+    bigint_limb_t borrow = 0;
+    size_t idx = 0;
 
-        return result;
+    for (; idx < yn; idx++) {
+        bigint_limb_t diff;
+        const bool underflow = __builtin_sub_overflow(xp[idx], yp[idx], &diff);
+        const bool borrow_underflow = __builtin_sub_overflow(diff, borrow, &rp[idx]);
+        borrow = underflow | borrow_underflow;
     }
 
-    // Start to compare from the MSB
-    for (int idx = (int)(x_size - 1); idx >= 0; idx--) {
-        vector_result_t x_get = vector_get(x->digits, idx);
-        if (x_get.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, x_get.message);
+    for (; idx < xn; idx++) {
+        const bigint_limb_t x_limb = xp[idx];
+        rp[idx] = x_limb - borrow;
+        borrow = x_limb < borrow;
+    }
 
-            return result;
-        }
+    return borrow;
+}
 
-        vector_result_t y_get = vector_get(y->digits, idx);
-        if (y_get.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, y_get.message);
+/**
+ * bigint_mpn_mul_1
+ *  @rp: output span of @xn limbs, it may alias @xp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @factor: a single limb
+ *
+ *  Computes @rp = @xp * @factor
+ *
+ *  Returns the limb carried out of the most significant position
+ */
+static bigint_limb_t bigint_mpn_mul_1(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn, bigint_limb_t factor) {
+    bigint_limb_t carry = 0;
 
-            return result;
-        }
+    for (size_t idx = 0; idx < xn; idx++) {
+        const bigint_dlimb_t product = (bigint_dlimb_t)xp[idx] * factor + carry;
+        rp[idx] = (bigint_limb_t)product;
+        carry = (bigint_limb_t)(product >> BIGINT_LIMB_BITS);
+    }
 
-        int *x_digit = (int*)x_get.value.element;
-        int *y_digit = (int*)y_get.value.element;
+    return carry;
+}
 
-        if (*x_digit != *y_digit) {
-            result.value.compare_status = (*x_digit > *y_digit) ? 1 : -1;
-            result.status = BIGINT_OK;
-            SET_MSG(result, "Big integer comparison was successful");
+/**
+ * bigint_mpn_addmul_1
+ *  @rp: a span of @xn limbs, either disjoint from @xp or equal to it
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @factor: a single limb
+ *
+ *  Computes @rp = @rp + @xp * @factor. The partial sum fits 128 bits
+ *  since (2^64 - 1)^2 + 2 * (2^64 - 1) = 2^128 - 1
+ *
+ *  Returns the limb carried out of the most significant position
+ */
+static bigint_limb_t bigint_mpn_addmul_1(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn, bigint_limb_t factor) {
+    bigint_limb_t carry = 0;
 
-            return result;
-        }
+    for (size_t idx = 0; idx < xn; idx++) {
+        const bigint_dlimb_t product = (bigint_dlimb_t)xp[idx] * factor + rp[idx] + carry;
+        rp[idx] = (bigint_limb_t)product;
+        carry = (bigint_limb_t)(product >> BIGINT_LIMB_BITS);
     }
 
-    result.value.compare_status = 0;
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Big integer comparison was successful");
-
-    return result;
+    return carry;
 }
 
 /**
- * bigint_add_abs
- *  @x: a non-null big integer
- *  @y: a non-null big integer
- * 
- *  Adds two absolute values together
- * 
- *  Returns a bigint_result_t data type
+ * bigint_mpn_submul_1
+ *  @rp: a span of @xn limbs, either disjoint from @xp or equal to it
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @factor: a single limb
+ *
+ *  Computes @rp = @rp - @xp * @factor
+ *
+ *  Returns the limb borrowed from the most significant position
  */
-static bigint_result_t bigint_add_abs(const bigint_t *x, const bigint_t *y) {
-    bigint_result_t result = {0};
+static bigint_limb_t bigint_mpn_submul_1(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn, bigint_limb_t factor) {
+    bigint_limb_t borrow = 0;
 
-    bigint_t *sum = malloc(sizeof(bigint_t));
-    if (sum == NULL) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Cannot allocate memory for big integer");
+    for (size_t idx = 0; idx < xn; idx++) {
+        const bigint_dlimb_t product = (bigint_dlimb_t)xp[idx] * factor + borrow;
+        const bigint_limb_t low = (bigint_limb_t)product;
+        const bigint_limb_t r_limb = rp[idx];
 
-        return result;
+        rp[idx] = r_limb - low;
+        borrow = (bigint_limb_t)(product >> BIGINT_LIMB_BITS) + (r_limb < low);
     }
 
-    const size_t max_size = vector_size(x->digits) > vector_size(y->digits) ?
-                            vector_size(x->digits) : vector_size(y->digits);
+    return borrow;
+}
 
-    vector_result_t vec_res = vector_new(max_size + 1, sizeof(int));
-    if (vec_res.status != VECTOR_OK) {
-        free(sum);
-        result.status = BIGINT_ERR_INVALID;
-        COPY_MSG(result, vec_res.message);
+/**
+ * bigint_mpn_lshift
+ *  @rp: output span of @xn limbs, it may alias @xp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @shift: number of bits, less than BIGINT_LIMB_BITS
+ *
+ *  Computes @rp = @xp << @shift
+ *
+ *  Returns the bits shifted out of the most significant limb
+ */
+static bigint_limb_t bigint_mpn_lshift(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn, unsigned shift) {
+    if (shift == 0) {
+        memmove(rp, xp, xn * sizeof(bigint_limb_t));
 
-        return result;
+        return 0;
     }
 
-    sum->digits = vec_res.value.vector;
-    sum->is_negative = false;
-
-    long long carry = 0;
-    size_t idx = 0;
+    bigint_limb_t out = 0;
+    for (size_t idx = 0; idx < xn; idx++) {
+        const bigint_limb_t x_limb = xp[idx];
+        rp[idx] = (x_limb << shift) | out;
+        out = x_limb >> (BIGINT_LIMB_BITS - shift);
+    }
 
-    const size_t x_size = vector_size(x->digits);
-    const size_t y_size = vector_size(y->digits);
-    while (idx < x_size || idx < y_size || carry) {
-        long long partial_sum = carry;
+    return out;
+}
 
-        if (idx < x_size) {
-            vector_result_t get_res = vector_get(x->digits, idx);
-            if (get_res.status != VECTOR_OK) {
-                vector_destroy(sum->digits);
-                free(sum);
-                result.status = BIGINT_ERR_INVALID;
-                COPY_MSG(result, get_res.message);
+/**
+ * bigint_mpn_rshift
+ *  @rp: output span of @xn limbs, it may alias @xp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @shift: number of bits, less than BIGINT_LIMB_BITS
+ *
+ *  Computes @rp = @xp >> @shift
+ */
+static void bigint_mpn_rshift(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn, unsigned shift) {
+    if (shift == 0) {
+        memmove(rp, xp, xn * sizeof(bigint_limb_t));
 
-                return result;
-            }
+        return;
+    }
 
-            int *x_digit = (int*)get_res.value.element;
-            partial_sum += *x_digit;
-        }
+    for (size_t idx = 0; idx < xn; idx++) {
+        const bigint_limb_t high = idx + 1 < xn ? xp[idx + 1] << (BIGINT_LIMB_BITS - shift) : 0;
+        rp[idx] = (xp[idx] >> shift) | high;
+    }
+}
 
-        if (idx < y_size) {
-            vector_result_t get_res = vector_get(y->digits, idx);
-            if (get_res.status != VECTOR_OK) {
-                vector_destroy(sum->digits);
-                free(sum);
-                result.status = BIGINT_ERR_INVALID;
-                COPY_MSG(result, get_res.message);
+/**
+ * bigint_limb_reciprocal
+ *  @divisor: a limb with the most significant bit set
+ *
+ *  Returns floor((2^128 - 1) / @divisor) - 2^64, the reciprocal used by bigint_div_2by1
+ */
+static inline bigint_limb_t bigint_limb_reciprocal(bigint_limb_t divisor) {
+    return (bigint_limb_t)(~(bigint_dlimb_t)0 / divisor);
+}
 
-                return result;
-            }
+/**
+ * bigint_div_2by1
+ *  @remainder: output remainder
+ *  @high: high limb of the dividend, less than @divisor
+ *  @low: low limb of the dividend
+ *  @divisor: a limb with the most significant bit set
+ *  @reciprocal: result of bigint_limb_reciprocal(@divisor)
+ *
+ *  Divides a two-limb number by a limb with two multiplications instead of
+ *  a 128-bit division. See Moller and Granlund, "Improved division by
+ *  invariant integers", IEEE Transactions on Computers, 2011
+ *
+ *  Returns the quotient
+ */
+static inline bigint_limb_t bigint_div_2by1(bigint_limb_t *remainder, bigint_limb_t high, bigint_limb_t low,
+                                            bigint_limb_t divisor, bigint_limb_t reciprocal) {
+    const bigint_dlimb_t estimate = (bigint_dlimb_t)reciprocal * high + (((bigint_dlimb_t)high << BIGINT_LIMB_BITS) | low);
+    bigint_limb_t quotient = (bigint_limb_t)(estimate >> BIGINT_LIMB_BITS) + 1;
+    bigint_limb_t rem = low - quotient * divisor;
+
+    // The first correction is taken about half of the time, apply it with a mask rather than a branch
+    const bigint_limb_t mask = -(bigint_limb_t)(rem > (bigint_limb_t)estimate);
+    quotient += mask;
+    rem += mask & divisor;
+
+    if (rem >= divisor) {
+        quotient++;
+        rem -= divisor;
+    }
 
-            int *y_digit = (int*)get_res.value.element;
-            partial_sum += *y_digit;
-        }
+    *remainder = rem;
 
-        int digit = partial_sum % BIGINT_BASE;
-        carry = partial_sum / BIGINT_BASE;
+    return quotient;
+}
 
-        vector_result_t push_res = vector_push(sum->digits, &digit);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy(sum->digits);
-            free(sum);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
+/**
+ * bigint_mpn_divrem_1
+ *  @qp: output span of @xn limbs, it may alias @xp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @divisor: a non-zero single limb
+ *
+ *  Computes @qp = @xp / @divisor in O(n)
+ *
+ *  Returns the remainder of the division
+ */
+static bigint_limb_t bigint_mpn_divrem_1(bigint_limb_t *qp, const bigint_limb_t *xp, size_t xn, bigint_limb_t divisor) {
+    // Normalize the divisor and shift the dividend on the fly
+    const unsigned shift = (unsigned)__builtin_clzll(divisor);
+    const bigint_limb_t norm_divisor = divisor << shift;
+    const bigint_limb_t reciprocal = bigint_limb_reciprocal(norm_divisor);
+
+    if (xn == 0) {
+        return 0;
+    }
 
-            return result;
+    if (shift == 0) {
+        bigint_limb_t remainder = 0;
+        while (xn-- > 0) {
+            qp[xn] = bigint_div_2by1(&remainder, remainder, xp[xn], norm_divisor, reciprocal);
         }
-        idx++;
-    }
 
-    bigint_result_t trim_res = bigint_trim_zeros(sum);
-    if (trim_res.status != BIGINT_OK) {
-        vector_destroy(sum->digits);
-        free(sum);
-        
-        return trim_res;
+        return remainder;
     }
 
-    result.value.number = sum;
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Big integers successfully added");
+    bigint_limb_t remainder = xp[xn - 1] >> (BIGINT_LIMB_BITS - shift);
+    while (xn-- > 0) {
+        const bigint_limb_t low = (xp[xn] << shift) | (xn > 0 ? xp[xn - 1] >> (BIGINT_LIMB_BITS - shift) : 0);
+        qp[xn] = bigint_div_2by1(&remainder, remainder, low, norm_divisor, reciprocal);
+    }
 
-    return result;
+    return remainder >> shift;
 }
 
 /**
- * bigint_sub_abs
- *  @x: a non-null big integer
- *  @y: a non-null big integer
- * 
- *  Subtracts two absolute values assuming that |x| >= |y|
- * 
- *  Returns a bigint_result_t data type
+ * bigint_mpn_mul_basecase
+ *  @rp: output span of @xn + @yn limbs, disjoint from the operands
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp
+ *
+ *  Computes @rp = @xp * @yp using the "grade school" multiplication in O(n * m)
  */
-static bigint_result_t bigint_sub_abs(const bigint_t *x, const bigint_t *y) {
-    bigint_result_t result = {0};
-
-    bigint_t *difference = malloc(sizeof(bigint_t));
-    if (difference == NULL) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Cannot allocate memory for big integer");
+static void bigint_mpn_mul_basecase(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                                    const bigint_limb_t *yp, size_t yn) {
+    if (yn == 0) {
+        memset(rp, 0, xn * sizeof(bigint_limb_t));
 
-        return result;
+        return;
     }
 
-    vector_result_t vec_res = vector_new(vector_size(x->digits), sizeof(int));
-    if (vec_res.status != VECTOR_OK) {
-        free(difference);
-        result.status = BIGINT_ERR_INVALID;
-        COPY_MSG(result, vec_res.message);
-
-        return result;
+    rp[xn] = bigint_mpn_mul_1(rp, xp, xn, yp[0]);
+    for (size_t idx = 1; idx < yn; idx++) {
+        rp[idx + xn] = bigint_mpn_addmul_1(rp + idx, xp, xn, yp[idx]);
     }
+}
 
-    difference->digits = vec_res.value.vector;
-    difference->is_negative = false;
-
-    long long borrow = 0;
+/**
+ * bigint_mpn_sqr_basecase
+ *  @rp: output span of 2 * @xn limbs, disjoint from @xp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp, at least 1
+ *
+ *  Computes @rp = @xp^2 with the "grade school" method, computing each product
+ *  x_i * x_j (i < j) once and doubling their sum, then adding the squares x_i^2,
+ *  that is about half of the products of bigint_mpn_mul_basecase
+ */
+static void bigint_mpn_sqr_basecase(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn) {
+    // Products below the diagonal
+    rp[0] = 0;
+    rp[(2 * xn) - 1] = 0;
+    if (xn > 1) {
+        rp[xn] = bigint_mpn_mul_1(rp + 1, xp + 1, xn - 1, xp[0]);
+        for (size_t idx = 1; idx + 1 < xn; idx++) {
+            rp[xn + idx] = bigint_mpn_addmul_1(rp + (2 * idx) + 1, xp + idx + 1, xn - idx - 1, xp[idx]);
+        }
+    }
 
-    const size_t x_size = vector_size(x->digits);
-    const size_t y_size = vector_size(y->digits);
-    for (size_t idx = 0; idx < x_size; idx++) {
-        vector_result_t x_get_res = vector_get(x->digits, idx);
-        if (x_get_res.status != VECTOR_OK) {
-            vector_destroy(difference->digits);
-            free(difference);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, x_get_res.message);
+    // Their sum is less than B^(2 * xn) / 2, so doubling it does not overflow
+    bigint_mpn_lshift(rp, rp, 2 * xn, 1);
 
-            return result;
-        }
+    bigint_limb_t carry = 0;
+    for (size_t idx = 0; idx < xn; idx++) {
+        const bigint_dlimb_t square = (bigint_dlimb_t)xp[idx] * xp[idx];
+        const bigint_dlimb_t low = (bigint_dlimb_t)rp[2 * idx] + (bigint_limb_t)square + carry;
+        const bigint_dlimb_t high = (bigint_dlimb_t)rp[(2 * idx) + 1] + (bigint_limb_t)(square >> BIGINT_LIMB_BITS) +
+                                    (bigint_limb_t)(low >> BIGINT_LIMB_BITS);
 
-        int *x_digit = (int*)x_get_res.value.element;
-        long long partial_difference = *x_digit - borrow;
+        rp[2 * idx] = (bigint_limb_t)low;
+        rp[(2 * idx) + 1] = (bigint_limb_t)high;
+        carry = (bigint_limb_t)(high >> BIGINT_LIMB_BITS);
+    }
+}
 
-        if (idx < y_size) {
-            vector_result_t y_get_res = vector_get(y->digits, idx);
-            if (y_get_res.status != VECTOR_OK) {
-                vector_destroy(difference->digits);
-                free(difference);
-                result.status = BIGINT_ERR_INVALID;
-                COPY_MSG(result, y_get_res.message);
+// Thresholds of the multiplication algorithms, see bigint_set_thresholds
+static bigint_thresholds_t bigint_thresholds = {
+    BIGINT_KARATSUBA_THRESHOLD, BIGINT_TOOM3_THRESHOLD, BIGINT_NTT_THRESHOLD
+};
 
-                return result;
-            }
+static void bigint_mpn_mul_rec(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                               const bigint_limb_t *yp, size_t yn, bigint_limb_t *tp);
 
-            int *y_digit = (int*)y_get_res.value.element;
-            partial_difference -= *y_digit;
-        }
+/**
+ * bigint_mpn_karatsuba
+ *  @rp: output span of @xn + @yn limbs, disjoint from the operands
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp, at most @xn and at least @xn / 2
+ *  @tp: scratch span of bigint_mpn_mul_scratch(@xn) limbs
+ *
+ *  Computes @rp = @xp * @yp using Karatsuba's recursive algorithm
+ *  in O(n^{\log_2 3}) \approx O(n^{1.585}). The halves are views over the
+ *  operands, the sums and the middle product take the first 4 * (ceil(@xn / 2) + 1)
+ *  limbs of @tp and the recursive calls use the rest.
+ */
+static void bigint_mpn_karatsuba(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                                 const bigint_limb_t *yp, size_t yn, bigint_limb_t *tp) {
+    /* Split at half the size of the larger operand:
+     * x = x1 * BASE^m + x0, y = y1 * BASE^m + y0
+     * where y1 is empty when y is not longer than m
+     */
+    const size_t m = xn / 2;
+    const size_t x1n = xn - m;
+    const size_t y0n = yn < m ? yn : m;
+    const size_t y1n = yn - y0n;
+    const size_t sum_n = x1n + 1; // x1n >= m >= y0n, y1n
+
+    bigint_limb_t *x_sum = tp;
+    bigint_limb_t *y_sum = x_sum + sum_n;
+    bigint_limb_t *z1 = y_sum + sum_n;
+    bigint_limb_t *next = z1 + (2 * sum_n);
+
+    // z0 = x0 * y0 and z2 = x1 * y1 go straight to their place in the output
+    memset(rp, 0, (xn + yn) * sizeof(bigint_limb_t));
+    bigint_mpn_mul_rec(rp, xp, m, yp, y0n, next);
+    if (y1n > 0) {
+        bigint_mpn_mul_rec(rp + (2 * m), xp + m, x1n, yp + m, y1n, next);
+    }
 
-        if (partial_difference < 0) {
-            partial_difference += BIGINT_BASE;
-            borrow = 1;
-        } else {
-            borrow = 0;
-        }
+    // z1 = (x0 + x1) * (y0 + y1) - z0 - z2
+    x_sum[x1n] = bigint_mpn_add(x_sum, xp + m, x1n, xp, m);
+    if (y0n >= y1n) {
+        y_sum[y0n] = bigint_mpn_add(y_sum, yp, y0n, yp + m, y1n);
+    } else {
+        y_sum[y1n] = bigint_mpn_add(y_sum, yp + m, y1n, yp, y0n);
+    }
+    const size_t y_sum_n = (y0n > y1n ? y0n : y1n) + 1;
 
-        int digit = partial_difference;
-        vector_result_t push_res = vector_push(difference->digits, &digit);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy(difference->digits);
-            free(difference);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
+    bigint_mpn_mul_rec(z1, x_sum, sum_n, y_sum, y_sum_n, next);
 
-            return result;
-        }
+    size_t z1n = bigint_mpn_normalize(z1, sum_n + y_sum_n);
+    bigint_mpn_sub(z1, z1, z1n, rp, bigint_mpn_normalize(rp, m + y0n));
+    if (y1n > 0) {
+        bigint_mpn_sub(z1, z1, z1n, rp + (2 * m), bigint_mpn_normalize(rp + (2 * m), x1n + y1n));
     }
+    z1n = bigint_mpn_normalize(z1, z1n);
 
-    bigint_result_t trim_res = bigint_trim_zeros(difference);
-    if (trim_res.status != BIGINT_OK) {
-        vector_destroy(difference->digits);
-        free(difference);
-        
-        return trim_res;
+    // Add z1 * BASE^m, the carry cannot exceed the output span
+    bigint_mpn_add(rp + m, rp + m, xn + yn - m, z1, z1n);
+}
+
+/**
+ * bigint_toom3_eval
+ *  @p1: output span of @k + 1 limbs, value at 1
+ *  @m1: output span of @k + 1 limbs, absolute value at -1
+ *  @p2: output span of @k + 1 limbs, value at 2
+ *  @xp: a span of 2 * @k + @x2n limbs
+ *  @k: number of limbs of the two lowest parts
+ *  @x2n: number of limbs of the highest part, at most @k
+ *
+ *  Evaluates x(t) = x2 * t^2 + x1 * t + x0 at t = 1, -1 and 2
+ *
+ *  Returns true if the value at -1 is negative
+ */
+static bool bigint_toom3_eval(bigint_limb_t *p1, bigint_limb_t *m1, bigint_limb_t *p2,
+                              const bigint_limb_t *xp, size_t k, size_t x2n) {
+    const bigint_limb_t *x0 = xp, *x1 = xp + k, *x2 = xp + (2 * k);
+    bool negative = false;
+
+    // p1 = x0 + x2, then m1 = |x0 - x1 + x2| and p1 = x0 + x1 + x2
+    p1[k] = bigint_mpn_add(p1, x0, k, x2, x2n);
+    if (bigint_mpn_cmp(p1, k + 1, x1, k) >= 0) {
+        m1[k] = p1[k] - bigint_mpn_sub(m1, p1, k, x1, k);
+    } else {
+        bigint_mpn_sub(m1, x1, k, p1, k);
+        m1[k] = 0;
+        negative = true;
     }
+    p1[k] += bigint_mpn_add(p1, p1, k, x1, k);
 
-    result.value.number = difference;
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Big integers successfully subtracted");
+    // p2 = x0 + 2 * x1 + 4 * x2 = ((2 * x2 + x1) * 2) + x0
+    memset(p2, 0, (k + 1) * sizeof(bigint_limb_t));
+    memcpy(p2, x2, x2n * sizeof(bigint_limb_t));
+    bigint_mpn_lshift(p2, p2, k + 1, 1);
+    bigint_mpn_add(p2, p2, k + 1, x1, k);
+    bigint_mpn_lshift(p2, p2, k + 1, 1);
+    bigint_mpn_add(p2, p2, k + 1, x0, k);
 
-    return result;
+    return negative;
 }
 
 /**
- * bigint_shift_left
- *  @num: a non-null big integer
- *  @n: number of digits to shift
- * 
- *  Shifts left by @n digits (i.e., multiply by BASE^n)
- * 
- *  Returns a bigint_result_t data type
+ * bigint_mpn_toom3
+ *  @rp: output span of @xn + @yn limbs, disjoint from the operands
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp, at most @xn and more than 2 * ceil(@xn / 3)
+ *  @tp: scratch span of bigint_mpn_mul_scratch(@xn) limbs
+ *
+ *  Computes @rp = @xp * @yp using the Toom-Cook 3-way algorithm in
+ *  O(n^{\log_3 5}) \approx O(n^{1.465}). Both operands are split in three
+ *  parts of k limbs, evaluated at 0, 1, -1, 2 and infinity, multiplied
+ *  pointwise and interpolated back with the sequence of Bodrato and Zanoni.
+ *  The evaluations and the products at 1, -1 and 2 take the first 12 * (k + 1)
+ *  limbs of @tp and the recursive calls use the rest.
  */
-static bigint_result_t bigint_shift_left(const bigint_t *num, size_t n) {
-    bigint_result_t result = {0};
-
-    if (n == 0) {
-        return bigint_clone(num);
+static void bigint_mpn_toom3(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                             const bigint_limb_t *yp, size_t yn, bigint_limb_t *tp) {
+    const size_t k = (xn + 2) / 3;
+    const size_t x2n = xn - (2 * k);
+    const size_t y2n = yn - (2 * k);
+    const size_t eval_n = k + 1;
+    const size_t prod_n = 2 * eval_n;
+
+    bigint_limb_t *x_p1 = tp, *x_m1 = x_p1 + eval_n, *x_p2 = x_m1 + eval_n;
+    bigint_limb_t *y_p1 = x_p2 + eval_n, *y_m1 = y_p1 + eval_n, *y_p2 = y_m1 + eval_n;
+    bigint_limb_t *v1 = y_p2 + eval_n, *vm1 = v1 + prod_n, *v2 = vm1 + prod_n;
+    bigint_limb_t *next = v2 + prod_n;
+
+    const bool vm1_negative = bigint_toom3_eval(x_p1, x_m1, x_p2, xp, k, x2n) !=
+                              bigint_toom3_eval(y_p1, y_m1, y_p2, yp, k, y2n);
+
+    // v0 = x0 * y0 and vinf = x2 * y2 go straight to their place in the output
+    bigint_limb_t *v0 = rp, *vinf = rp + (4 * k);
+    const size_t vinf_n = x2n + y2n;
+    memset(rp + (2 * k), 0, 2 * k * sizeof(bigint_limb_t));
+
+    bigint_mpn_mul_rec(v0, xp, k, yp, k, next);
+    bigint_mpn_mul_rec(vinf, xp + (2 * k), x2n, yp + (2 * k), y2n, next);
+    bigint_mpn_mul_rec(v1, x_p1, eval_n, y_p1, eval_n, next);
+    bigint_mpn_mul_rec(vm1, x_m1, eval_n, y_m1, eval_n, next);
+    bigint_mpn_mul_rec(v2, x_p2, eval_n, y_p2, eval_n, next);
+
+    /* Interpolation, with r(t) = c4 * t^4 + c3 * t^3 + c2 * t^2 + c1 * t + c0
+     * v2 = (v2 - vm1) / 3     = c1 + c2 + 3 * c3 + 5 * c4
+     * vm1 = (v1 - vm1) / 2    = c1 + c3
+     * v1 = v1 - v0            = c1 + c2 + c3 + c4
+     * v2 = (v2 - v1) / 2      = c3 + 2 * c4
+     * v1 = v1 - vm1 - vinf    = c2
+     * v2 = v2 - 2 * vinf      = c3
+     * vm1 = vm1 - v2          = c1
+     */
+    if (vm1_negative) {
+        bigint_mpn_add(v2, v2, prod_n, vm1, prod_n);
+        bigint_mpn_add(vm1, v1, prod_n, vm1, prod_n);
+    } else {
+        bigint_mpn_sub(v2, v2, prod_n, vm1, prod_n);
+        bigint_mpn_sub(vm1, v1, prod_n, vm1, prod_n);
     }
+    bigint_mpn_divrem_1(v2, v2, prod_n, 3);
+    bigint_mpn_rshift(vm1, vm1, prod_n, 1);
+    bigint_mpn_sub(v1, v1, prod_n, v0, 2 * k);
+    bigint_mpn_sub(v2, v2, prod_n, v1, prod_n);
+    bigint_mpn_rshift(v2, v2, prod_n, 1);
+    bigint_mpn_sub(v1, v1, prod_n, vm1, prod_n);
+    bigint_mpn_sub(v1, v1, prod_n, vinf, vinf_n);
+    bigint_mpn_sub(v2, v2, prod_n, vinf, vinf_n);
+    bigint_mpn_sub(v2, v2, prod_n, vinf, vinf_n);
+    bigint_mpn_sub(vm1, vm1, prod_n, v2, prod_n);
+
+    // Add c1 * BASE^k + c2 * BASE^2k + c3 * BASE^3k, the carries cannot exceed the output span
+    const size_t r_n = xn + yn;
+    bigint_mpn_add(rp + k, rp + k, r_n - k, vm1, bigint_mpn_normalize(vm1, prod_n));
+    bigint_mpn_add(rp + (2 * k), rp + (2 * k), r_n - (2 * k), v1, bigint_mpn_normalize(v1, prod_n));
+    bigint_mpn_add(rp + (3 * k), rp + (3 * k), r_n - (3 * k), v2, bigint_mpn_normalize(v2, prod_n));
+}
 
-    bigint_t *shifted = malloc(sizeof(bigint_t));
-    if (shifted == NULL) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for big integer");
+/*
+ * Three-prime number theoretic transform. Each prime has the form c * 2^k + 1
+ * with k >= 55, and their product (about 2^183) bounds every coefficient of the
+ * convolution of two limb spans shorter than 2^55 limbs, i.e. n * (2^64 - 1)^2.
+ * The arithmetic modulo each prime uses Montgomery's representation with R = 2^64.
+ */
+typedef struct {
+    bigint_limb_t modulus;
+    bigint_limb_t generator; // Primitive root modulo the prime
+    bigint_limb_t inverse; // modulus^{-1} mod 2^64
+    bigint_limb_t r2; // 2^128 mod modulus
+} bigint_ntt_prime_t;
+
+#define BIGINT_NTT_PRIMES 3
+#define BIGINT_NTT_MAX_LOG 55
+// Transforms up to this length (32 KiB) run stage by stage
+#define BIGINT_NTT_BLOCK 4096
 
-        return result;
-    }
+/**
+ * bigint_ntt_mul
+ *  @x: a value
+ *  @y: a value such that @x * @y is less than the modulus times 2^64
+ *  @prime: the prime modulus
+ *
+ *  Returns the Montgomery product @x * @y / 2^64 mod @prime
+ */
+static inline bigint_limb_t bigint_ntt_mul(bigint_limb_t x, bigint_limb_t y, const bigint_ntt_prime_t *prime) {
+    const bigint_dlimb_t product = (bigint_dlimb_t)x * y;
+    // factor * modulus agrees with the product on the low limb, so only the high limbs are subtracted
+    const bigint_limb_t factor = (bigint_limb_t)product * prime->inverse;
+    const bigint_limb_t high = (bigint_limb_t)(product >> BIGINT_LIMB_BITS);
+    const bigint_limb_t correction = (bigint_limb_t)(((bigint_dlimb_t)factor * prime->modulus) >> BIGINT_LIMB_BITS);
+
+    // Branch-free corrections, the butterflies would otherwise mispredict half of the time
+    return high - correction + (prime->modulus & -(bigint_limb_t)(high < correction));
+}
 
-    vector_result_t vec_res = vector_new(vector_size(num->digits) + n, sizeof(int));
-    if (vec_res.status != VECTOR_OK) {
-        free(shifted);
-        result.status = BIGINT_ERR_ALLOCATE;
-        COPY_MSG(result, vec_res.message);
+static inline bigint_limb_t bigint_ntt_add(bigint_limb_t x, bigint_limb_t y, const bigint_ntt_prime_t *prime) {
+    // The moduli are below 2^62, so the sum cannot overflow and the sign bit flags a wrap
+    const bigint_limb_t sum = x + y - prime->modulus;
 
-        return result;
-    }
+    return sum + (prime->modulus & -(sum >> (BIGINT_LIMB_BITS - 1)));
+}
 
-    shifted->digits = vec_res.value.vector;
-    shifted->is_negative = num->is_negative;
+static inline bigint_limb_t bigint_ntt_sub(bigint_limb_t x, bigint_limb_t y, const bigint_ntt_prime_t *prime) {
+    return x - y + (prime->modulus & -(bigint_limb_t)(x < y));
+}
 
-    // Add 'n' zeros by starting from the LSB
-    int zero = 0;
-    for (size_t idx = 0; idx < n; idx++) {
-        vector_result_t push_res = vector_push(shifted->digits, &zero);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy(shifted->digits);
-            free(shifted);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
+/*
+ * Lazy variants for the butterflies, after Harvey: the values stay within
+ * 0 and 2 * modulus - 1, which saves most of the corrections since 4 * modulus
+ * still fits a limb.
+ */
+static inline bigint_limb_t bigint_ntt_mul_lazy(bigint_limb_t x, bigint_limb_t y, const bigint_ntt_prime_t *prime) {
+    const bigint_dlimb_t product = (bigint_dlimb_t)x * y;
+    const bigint_limb_t factor = (bigint_limb_t)product * prime->inverse;
+    const bigint_limb_t correction = (bigint_limb_t)(((bigint_dlimb_t)factor * prime->modulus) >> BIGINT_LIMB_BITS);
 
-            return result;
-        }
-    }
+    return (bigint_limb_t)(product >> BIGINT_LIMB_BITS) - correction + prime->modulus;
+}
 
-    // Copy back original digits
-    const size_t num_size = vector_size(num->digits);
-    for (size_t idx = 0; idx < num_size; idx++) {
-        vector_result_t get_res = vector_get(num->digits, idx);
-        if (get_res.status != VECTOR_OK) {
-            vector_destroy(shifted->digits);
-            free(shifted);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, get_res.message);
+static inline bigint_limb_t bigint_ntt_reduce_lazy(bigint_limb_t x, const bigint_ntt_prime_t *prime) {
+    const bigint_limb_t twice = 2 * prime->modulus;
+    const bigint_limb_t reduced = x - twice;
 
-            return result;
-        }
+    return reduced + (twice & -(reduced >> (BIGINT_LIMB_BITS - 1)));
+}
 
-        int *digit = (int*)get_res.value.element;
-        vector_result_t push_res = vector_push(shifted->digits, digit);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy(shifted->digits);
-            free(shifted);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
+/**
+ * bigint_ntt_pow
+ *  @base: a value in Montgomery's representation
+ *  @exponent: the exponent
+ *  @prime: the prime modulus
+ *
+ *  Returns @base^@exponent in Montgomery's representation
+ */
+static bigint_limb_t bigint_ntt_pow(bigint_limb_t base, bigint_limb_t exponent, const bigint_ntt_prime_t *prime) {
+    bigint_limb_t power = bigint_ntt_mul(1, prime->r2, prime);
 
-            return result;
+    while (exponent != 0) {
+        if (exponent & 1) {
+            power = bigint_ntt_mul(power, base, prime);
         }
+        base = bigint_ntt_mul(base, base, prime);
+        exponent >>= 1;
     }
 
-    result.value.number = shifted;
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Big integer shifted successfully");
-    
-    return result;
+    return power;
 }
 
 /**
- * bigint_split
- *  @num: a non-null big integers
- *  @m: the pivot/position where to split
- *  @high: digits \in [0, m)
- *  @low: digits \in [m, size)
- * 
- *  Splits number into @high and @low parts at position @m
- * 
- *  Returns a bigint_result_t data type
+ * bigint_ntt_init
+ *  @prime: the prime, with modulus and generator set
+ *
+ *  Computes the Montgomery constants of @prime
  */
-static bigint_result_t bigint_split(const bigint_t *num, size_t m, bigint_t **high, bigint_t **low) {
-    bigint_result_t result = {0};
-
-    const size_t size = vector_size(num->digits);
-
-    // Low part: digits \in [0, m)
-    *low = malloc(sizeof(bigint_t));
-    if (*low == NULL) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for big integer");
-
-        return result;
+static void bigint_ntt_init(bigint_ntt_prime_t *prime) {
+    // Newton's iteration doubles the correct low bits of the inverse at each step
+    bigint_limb_t inverse = prime->modulus;
+    for (int idx = 0; idx < 5; idx++) {
+        inverse *= 2 - (prime->modulus * inverse);
     }
+    prime->inverse = inverse;
 
-    vector_result_t low_res = vector_new(m ? m : 1, sizeof(int));
-    if (low_res.status != VECTOR_OK) {
-        free(*low);
-        result.status = BIGINT_ERR_ALLOCATE;
-        COPY_MSG(result, low_res.message);
+    const bigint_limb_t r = (bigint_limb_t)(-prime->modulus) % prime->modulus;
+    prime->r2 = (bigint_limb_t)(((bigint_dlimb_t)r * r) % prime->modulus);
+}
 
-        return result;
-    }
+/**
+ * bigint_ntt_transform
+ *  @values: span of @length values in Montgomery's representation, less than twice the modulus
+ *  @length: a power of two
+ *  @roots: table of the roots of unity, see bigint_mpn_mul_ntt
+ *  @prime: the prime modulus
+ *  @inverse: false for the forward transform, true for the inverse one
+ *
+ *  The forward transform (Gentleman-Sande) takes the values in natural order and
+ *  yields them in bit-reversed order, the inverse one (Cooley-Tukey) does the
+ *  opposite, so no permutation is ever needed. The inverse transform expects the
+ *  table of the inverse roots and does not scale the result by 1 / @length.
+ *  Long transforms recurse on their halves, so that the inner stages run on
+ *  spans that fit the cache instead of sweeping the whole array at each stage.
+ *  The results are less than twice the modulus too.
+ */
+static void bigint_ntt_transform(bigint_limb_t *values, size_t length, const bigint_limb_t *roots,
+                                 const bigint_ntt_prime_t *prime, bool inverse) {
+    // A local copy cannot alias the values, so the constants stay in registers
+    const bigint_ntt_prime_t local = *prime;
+
+    if (length > BIGINT_NTT_BLOCK) {
+        const size_t half = length / 2;
+        const bigint_limb_t *stage_roots = roots + half;
+
+        if (!inverse) {
+            for (size_t idx = 0; idx < half; idx++) {
+                const bigint_limb_t u = values[idx];
+                const bigint_limb_t v = values[idx + half];
+
+                values[idx] = bigint_ntt_reduce_lazy(u + v, &local);
+                values[idx + half] = bigint_ntt_mul_lazy(u - v + (2 * local.modulus), stage_roots[idx], &local);
+            }
+        }
 
-    (*low)->digits = low_res.value.vector;
-    (*low)->is_negative = false;
+        bigint_ntt_transform(values, half, roots, prime, inverse);
+        bigint_ntt_transform(values + half, half, roots, prime, inverse);
 
-    for (size_t idx = 0; idx < m && idx < size; idx++) {
-        vector_result_t get_res = vector_get(num->digits, idx);
-        if (get_res.status != VECTOR_OK) {
-            vector_destroy((*low)->digits);
-            free(*low);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, get_res.message);
+        if (inverse) {
+            for (size_t idx = 0; idx < half; idx++) {
+                const bigint_limb_t u = values[idx];
+                const bigint_limb_t v = bigint_ntt_mul_lazy(values[idx + half], stage_roots[idx], &local);
 
-            return result;
+                values[idx] = bigint_ntt_reduce_lazy(u + v, &local);
+                values[idx + half] = bigint_ntt_reduce_lazy(u - v + (2 * local.modulus), &local);
+            }
         }
 
-        int *digit = (int*)get_res.value.element;
-        vector_result_t push_res = vector_push((*low)->digits, digit);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy((*low)->digits);
-            free(*low);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
-
-            return result;
-        }
+        return;
     }
 
-    if (vector_size((*low)->digits) == 0) {
-        int zero = 0;
-        vector_result_t push_res = vector_push((*low)->digits, &zero);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy((*low)->digits);
-            free(*low);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
+    if (!inverse) {
+        for (size_t half = length / 2; half >= 1; half /= 2) {
+            const bigint_limb_t *stage_roots = roots + half;
 
-            return result;
+            for (size_t start = 0; start < length; start += 2 * half) {
+                for (size_t idx = 0; idx < half; idx++) {
+                    const bigint_limb_t u = values[start + idx];
+                    const bigint_limb_t v = values[start + idx + half];
+
+                    values[start + idx] = bigint_ntt_reduce_lazy(u + v, &local);
+                    values[start + idx + half] = bigint_ntt_mul_lazy(u - v + (2 * local.modulus), stage_roots[idx],
+                                                                     &local);
+                }
+            }
         }
-    }
+    } else {
+        for (size_t half = 1; half < length; half *= 2) {
+            const bigint_limb_t *stage_roots = roots + half;
 
-    // First pass of zero trimming
-    bigint_result_t first_trim_res = bigint_trim_zeros(*low);
-    if (first_trim_res.status != BIGINT_OK) {
-        vector_destroy((*low)->digits);
-        free(*low);
+            for (size_t start = 0; start < length; start += 2 * half) {
+                for (size_t idx = 0; idx < half; idx++) {
+                    const bigint_limb_t u = values[start + idx];
+                    const bigint_limb_t v = bigint_ntt_mul_lazy(values[start + idx + half], stage_roots[idx], &local);
 
-        return first_trim_res;
+                    values[start + idx] = bigint_ntt_reduce_lazy(u + v, &local);
+                    values[start + idx + half] = bigint_ntt_reduce_lazy(u - v + (2 * local.modulus), &local);
+                }
+            }
+        }
     }
+}
 
-    // High part: digits \in [m, size)
-    *high = malloc(sizeof(bigint_t));
-    if (*high == NULL) {
-        vector_destroy((*low)->digits);
-        free(*low);
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for big integer");
-
-        return result;
+/**
+ * bigint_mpn_mul_ntt
+ *  @rp: output span of @xn + @yn limbs, disjoint from the operands
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp
+ *
+ *  Computes @rp = @xp * @yp in O(n \log n) by convolving the limbs modulo three
+ *  primes and merging the residues with Garner's algorithm. Squares transform
+ *  a single operand.
+ *
+ *  Returns false if the scratch buffer cannot be allocated or if the operands
+ *  exceed the transform length supported by the primes
+ */
+static bool bigint_mpn_mul_ntt(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                               const bigint_limb_t *yp, size_t yn) {
+    bigint_ntt_prime_t primes[BIGINT_NTT_PRIMES] = {
+        { 4179340454199820289ULL, 3, 0, 0 }, // 29 * 2^57 + 1
+        { 2485986994308513793ULL, 5, 0, 0 }, // 69 * 2^55 + 1
+        { 1945555039024054273ULL, 5, 0, 0 }  // 27 * 2^56 + 1
+    };
+
+    const size_t conv_n = xn + yn - 1;
+    size_t length = 1, log_length = 0;
+    while (length < conv_n) {
+        length *= 2;
+        log_length++;
     }
 
-    vector_result_t high_res = vector_new(size > m ? (size - m) : 1, sizeof(int));
-    if (high_res.status != VECTOR_OK) {
-        vector_destroy((*low)->digits);
-        free(*low);
-        free(*high);
-
-        result.status = BIGINT_ERR_ALLOCATE;
-        COPY_MSG(result, low_res.message);
-
-        return result;
+    if (log_length > BIGINT_NTT_MAX_LOG) {
+        return false;
     }
 
-    (*high)->digits = high_res.value.vector;
-    (*high)->is_negative = false;
+    const bool square = (xp == yp && xn == yn);
+    bigint_limb_t *scratch = malloc(((BIGINT_NTT_PRIMES + 3) * length) * sizeof(bigint_limb_t));
+    if (scratch == NULL) {
+        return false;
+    }
 
-    if (size > m) {
-        for (size_t idx = m; idx < size; idx++) {
-            vector_result_t get_res = vector_get(num->digits, idx);
-            if (get_res.status != VECTOR_OK) {
-                vector_destroy((*low)->digits);
-                vector_destroy((*high)->digits);
-                free(*low);
-                free(*high);
+    /* The roots of a stage whose butterflies span 2 * half values are stored
+     * contiguously at roots[half ... 2 * half), i.e. roots[half + j] = w^j
+     * where w is a primitive (2 * half)-th root of unity
+     */
+    bigint_limb_t *other = scratch + (BIGINT_NTT_PRIMES * length);
+    bigint_limb_t *roots = other + length;
+    bigint_limb_t *inverse_roots = roots + length;
+
+    for (size_t p = 0; p < BIGINT_NTT_PRIMES; p++) {
+        bigint_ntt_prime_t *prime = &primes[p];
+        bigint_limb_t *values = scratch + (p * length);
+        bigint_ntt_init(prime);
+
+        // Powers of a primitive root of unity of order 'length' and of its inverse
+        const bigint_limb_t one = bigint_ntt_mul(1, prime->r2, prime);
+        const bigint_limb_t root = bigint_ntt_pow(bigint_ntt_mul(prime->generator, prime->r2, prime),
+                                                  (prime->modulus - 1) >> log_length, prime);
+        if (length >= 2) {
+            const size_t half = length / 2;
+
+            roots[half] = one;
+            for (size_t idx = 1; idx < half; idx++) {
+                roots[half + idx] = bigint_ntt_mul(roots[half + idx - 1], root, prime);
+            }
 
-                result.status = BIGINT_ERR_INVALID;
-                COPY_MSG(result, get_res.message);
+            // root^-i = -root^(length / 2 - i) since root^(length / 2) = -1
+            inverse_roots[half] = one;
+            for (size_t idx = 1; idx < half; idx++) {
+                inverse_roots[half + idx] = prime->modulus - roots[length - idx];
+            }
 
-                return result;
+            // The roots of the shorter stages are the even powers of the longer ones
+            for (size_t stage = half / 2; stage >= 1; stage /= 2) {
+                for (size_t idx = 0; idx < stage; idx++) {
+                    roots[stage + idx] = roots[(2 * stage) + (2 * idx)];
+                    inverse_roots[stage + idx] = inverse_roots[(2 * stage) + (2 * idx)];
+                }
             }
+        }
 
-            int *digit = (int*)get_res.value.element;
-            vector_result_t push_res = vector_push((*high)->digits, digit);
-            if (push_res.status != VECTOR_OK) {
-                vector_destroy((*low)->digits);
-                vector_destroy((*high)->digits);
-                free(*low);
-                free(*high);
+        // Limbs to Montgomery's representation, x * R^2 / R = x * R
+        for (size_t idx = 0; idx < length; idx++) {
+            values[idx] = idx < xn ? bigint_ntt_mul(xp[idx], prime->r2, prime) : 0;
+        }
+        bigint_ntt_transform(values, length, roots, prime, false);
 
-                result.status = BIGINT_ERR_INVALID;
-                COPY_MSG(result, push_res.message);
+        if (square) {
+            for (size_t idx = 0; idx < length; idx++) {
+                values[idx] = bigint_ntt_mul(values[idx], values[idx], prime);
+            }
+        } else {
+            for (size_t idx = 0; idx < length; idx++) {
+                other[idx] = idx < yn ? bigint_ntt_mul(yp[idx], prime->r2, prime) : 0;
+            }
+            bigint_ntt_transform(other, length, roots, prime, false);
 
-                return result;
+            for (size_t idx = 0; idx < length; idx++) {
+                values[idx] = bigint_ntt_mul(values[idx], other[idx], prime);
             }
         }
-    } else {
-        int zero = 0;
-        vector_result_t push_res = vector_push((*high)->digits, &zero);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy((*low)->digits);
-            vector_destroy((*high)->digits);
-            free(*low);
-            free(*high);
 
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
+        bigint_ntt_transform(values, length, inverse_roots, prime, true);
 
-            return result;
+        // Back from Montgomery's representation while dividing by the length: x * R * length^-1 / R
+        const bigint_limb_t inverse_length = bigint_ntt_mul(bigint_ntt_pow(bigint_ntt_mul(length, prime->r2, prime),
+                                                                           prime->modulus - 2, prime), 1, prime);
+        for (size_t idx = 0; idx < conv_n; idx++) {
+            values[idx] = bigint_ntt_mul(values[idx], inverse_length, prime);
         }
     }
 
-    // Second pass of zero trimming
-    bigint_result_t second_trim_res = bigint_trim_zeros(*high);
-    if (second_trim_res.status != BIGINT_OK) {
-        vector_destroy((*low)->digits);
-        vector_destroy((*high)->digits);
-        free(*low);
-        free(*high);
-
-        return second_trim_res;
+    /* Garner's algorithm: the coefficient is x = a0 + p0 * t1 + p0 * p1 * t2 with
+     * t1 = (a1 - a0) / p0 mod p1 and t2 = (a2 - a0 - p0 * t1) / (p0 * p1) mod p2.
+     * Constants are kept in Montgomery's representation so that a single
+     * Montgomery product yields a plain residue
+     */
+    const bigint_ntt_prime_t *p0 = &primes[0], *p1 = &primes[1], *p2 = &primes[2];
+    const bigint_limb_t p0_mod_p1 = p0->modulus % p1->modulus;
+    const bigint_limb_t p0_mod_p2 = p0->modulus % p2->modulus;
+    const bigint_limb_t p0p1_mod_p2 = (bigint_limb_t)(((bigint_dlimb_t)p0->modulus * p1->modulus) % p2->modulus);
+
+    const bigint_limb_t inv_p0_p1 = bigint_ntt_pow(bigint_ntt_mul(p0_mod_p1, p1->r2, p1), p1->modulus - 2, p1);
+    const bigint_limb_t p0_p2 = bigint_ntt_mul(p0_mod_p2, p2->r2, p2);
+    const bigint_limb_t inv_p0p1_p2 = bigint_ntt_pow(bigint_ntt_mul(p0p1_mod_p2, p2->r2, p2), p2->modulus - 2, p2);
+    const bigint_dlimb_t p0p1 = (bigint_dlimb_t)p0->modulus * p1->modulus;
+
+    // Running sum of the coefficients, three limbs wide
+    bigint_limb_t carry[3] = { 0, 0, 0 };
+    for (size_t idx = 0; idx < conv_n; idx++) {
+        const bigint_limb_t a0 = scratch[idx];
+        const bigint_limb_t a1 = scratch[length + idx];
+        const bigint_limb_t a2 = scratch[(2 * length) + idx];
+
+        const bigint_limb_t a0_p1 = a0 >= p1->modulus ? a0 - p1->modulus : a0;
+        const bigint_limb_t t1 = bigint_ntt_mul(bigint_ntt_sub(a1, a0_p1, p1), inv_p0_p1, p1);
+
+        bigint_limb_t a0_p2 = a0;
+        while (a0_p2 >= p2->modulus) {
+            a0_p2 -= p2->modulus;
+        }
+        const bigint_limb_t x01_p2 = bigint_ntt_add(a0_p2, bigint_ntt_mul(t1, p0_p2, p2), p2);
+        const bigint_limb_t t2 = bigint_ntt_mul(bigint_ntt_sub(a2, x01_p2, p2), inv_p0p1_p2, p2);
+
+        // x = a0 + p0 * t1 + p0p1 * t2 on three limbs
+        const bigint_dlimb_t x01 = (bigint_dlimb_t)p0->modulus * t1 + a0;
+        const bigint_dlimb_t low = (bigint_dlimb_t)(bigint_limb_t)p0p1 * t2 + (bigint_limb_t)x01;
+        const bigint_dlimb_t high = (bigint_dlimb_t)(bigint_limb_t)(p0p1 >> BIGINT_LIMB_BITS) * t2 +
+                                    (bigint_limb_t)(x01 >> BIGINT_LIMB_BITS) + (bigint_limb_t)(low >> BIGINT_LIMB_BITS);
+        const bigint_limb_t coefficient[3] = {
+            (bigint_limb_t)low, (bigint_limb_t)high, (bigint_limb_t)(high >> BIGINT_LIMB_BITS)
+        };
+
+        carry[2] += bigint_mpn_add(carry, carry, 2, coefficient, 2) + coefficient[2];
+        rp[idx] = carry[0];
+        carry[0] = carry[1];
+        carry[1] = carry[2];
+        carry[2] = 0;
     }
+    rp[conv_n] = carry[0];
 
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Big number successfully splitted");
+    free(scratch);
 
-    return result;
+    return true;
 }
 
 /**
- * bigint_karatsuba_base
- *  @x: a non-null big integer
- *  @y: a non-null big integer
- * 
- *  Base case of the Karatsuba recursive algorithm
- *  which uses a "grade school" multiplication.
- *  Its complexity is O(n^2)
- * 
- *  Returns a bigint_result_t data type
+ * bigint_mpn_mul_unbalanced
+ *  @rp: output span of @xn + @yn limbs, disjoint from the operands
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp, more than 2 * @yn
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp
+ *  @tp: scratch span of bigint_mpn_mul_scratch(@xn, @yn) limbs
+ *
+ *  Computes @rp = @xp * @yp slicing @xp into chunks of @yn limbs, so that
+ *  each chunk is a balanced product for the fast algorithms. The products
+ *  overlap by @yn limbs and are accumulated into @rp as they are computed.
  */
-static bigint_result_t bigint_karatsuba_base(const bigint_t *x, const bigint_t *y) {
-    bigint_result_t result = {0};
-
-    bigint_result_t prod_res = bigint_from_int(0);
-    if (prod_res.status != BIGINT_OK) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        COPY_MSG(result, prod_res.message);
-
-        return result;
-    }
-
-    bigint_t *product = prod_res.value.number;
-    const size_t x_size = vector_size(x->digits);
-    const size_t y_size = vector_size(y->digits);
-
-    for (size_t i = 0; i < x_size; i++) {
-        long long carry = 0;
-        
-        vector_result_t get_res = vector_get(x->digits, i);
-        if (get_res.status != VECTOR_OK) {
-            bigint_destroy(product);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, get_res.message);
+static void bigint_mpn_mul_unbalanced(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                                      const bigint_limb_t *yp, size_t yn, bigint_limb_t *tp) {
+    bigint_limb_t *chunk = tp;
+    bigint_limb_t *next = chunk + (2 * yn);
 
-            return result;
-        }
-
-        int *x_digit = (int*)get_res.value.element;
-        for (size_t j = 0; j < y_size || carry; j++) {
-            int *y_digit = NULL;
-            int *curr = NULL;
-
-            if (j < y_size) {
-                vector_result_t y_res = vector_get(y->digits, j);
-                if (y_res.status != VECTOR_OK) {
-                    bigint_destroy(product);
-                    result.status = BIGINT_ERR_INVALID;
-                    COPY_MSG(result, y_res.message);
-
-                    return result;
-                }
-
-                y_digit = (int*)y_res.value.element;
-            }
+    bigint_mpn_mul_rec(rp, xp, yn, yp, yn, next);
 
-            if ((i + j) < vector_size(product->digits)) {
-                vector_result_t curr_res = vector_get(product->digits, i + j);
-                if (curr_res.status != VECTOR_OK) {
-                    bigint_destroy(product);
-                    result.status = BIGINT_ERR_INVALID;
-                    COPY_MSG(result, curr_res.message);
+    for (size_t offset = yn; offset < xn; offset += yn) {
+        const size_t chunk_n = xn - offset < yn ? xn - offset : yn;
 
-                    return result;
-                }
+        /* rp holds the product of the first offset limbs, its top yn limbs
+         * overlap the low half of this chunk product, the rest is fresh
+         */
+        bigint_mpn_mul_rec(chunk, xp + offset, chunk_n, yp, yn, next);
+        memcpy(rp + offset + yn, chunk + yn, chunk_n * sizeof(bigint_limb_t));
 
-                curr = (int*)curr_res.value.element;
-            }
+        const bigint_limb_t carry = bigint_mpn_add(rp + offset, rp + offset, yn, chunk, yn);
+        bigint_mpn_add_1(rp + offset + yn, rp + offset + yn, chunk_n, carry);
+    }
+}
 
-            long long partial_prod = carry;
-            if (curr) { partial_prod += *curr; }
-            if (y_digit) { partial_prod += (long long)(*x_digit) * (*y_digit); }
+/**
+ * bigint_mpn_mul_scratch
+ *  @xn: number of limbs of the longest operand
+ *  @yn: number of limbs of the shortest operand
+ *
+ *  Bounds the scratch space of bigint_mpn_mul_rec: each level takes at most
+ *  max(4 * (ceil(n / 2) + 1), 12 * (ceil(n / 3) + 1)) limbs and recurses on
+ *  operands of at most ceil(n / 2) + 1 limbs, i.e. O(n) limbs overall.
+ *  Unbalanced operands need a product of 2 * @yn limbs on top of the space
+ *  of a balanced @yn by @yn product
+ *
+ *  Returns the number of limbs
+ */
+static size_t bigint_mpn_mul_scratch(size_t xn, size_t yn) {
+    size_t limbs = 0;
 
-            int new_digit =(int)(partial_prod % BIGINT_BASE);
-            carry = partial_prod / BIGINT_BASE;
+    if (yn < bigint_thresholds.karatsuba) {
+        return 0;
+    }
 
-            if (curr) {
-                vector_result_t set_res = vector_set(product->digits, i + j, &new_digit);
-                if (set_res.status != VECTOR_OK) {
-                    bigint_destroy(product);
-                    result.status = BIGINT_ERR_INVALID;
-                    COPY_MSG(result, set_res.message);
+    if (xn / yn > 2) {
+        limbs = 2 * yn;
+        xn = yn;
+    }
 
-                    return result;
-                }
-            } else {
-                vector_result_t push_res = vector_push(product->digits, &new_digit);
-                if (push_res.status != VECTOR_OK) {
-                    bigint_destroy(product);
-                    result.status = BIGINT_ERR_INVALID;
-                    COPY_MSG(result, push_res.message);
+    while (xn >= bigint_thresholds.karatsuba) {
+        const size_t karatsuba = 4 * ((xn - (xn / 2)) + 1);
+        const size_t toom3 = 12 * (((xn + 2) / 3) + 1);
 
-                    return result;
-                }
-            }
-        }
+        limbs += karatsuba > toom3 ? karatsuba : toom3;
+        xn = (xn - (xn / 2)) + 1;
     }
 
-    bigint_result_t trim_res = bigint_trim_zeros(product);
-    if (trim_res.status != BIGINT_OK) {
-        bigint_destroy(product);
+    return limbs;
+}
 
-        return trim_res;
+/**
+ * bigint_mpn_mul_rec
+ *  @rp: output span of @xn + @yn limbs, disjoint from the operands
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp
+ *  @tp: scratch span of bigint_mpn_mul_scratch(@xn, @yn) limbs (operands sorted by length)
+ *
+ *  Computes @rp = @xp * @yp choosing the algorithm from the length of the
+ *  shortest operand: the "grade school" multiplication, Karatsuba or Toom-3,
+ *  according to bigint_thresholds. Operands whose lengths differ by more than
+ *  a factor of 2 are multiplied by bigint_mpn_mul_unbalanced.
+ */
+static void bigint_mpn_mul_rec(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                               const bigint_limb_t *yp, size_t yn, bigint_limb_t *tp) {
+    // Let x be the longest operand
+    if (xn < yn) {
+        const bigint_limb_t *sp = xp; xp = yp; yp = sp;
+        const size_t sn = xn; xn = yn; yn = sn;
     }
 
-    result.value.number = product;
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Product between big integers was successful");
-
-    return result;
+    if (yn < bigint_thresholds.karatsuba) {
+        bigint_mpn_mul_basecase(rp, xp, xn, yp, yn);
+    } else if (xn / yn > 2) {
+        bigint_mpn_mul_unbalanced(rp, xp, xn, yp, yn, tp);
+    } else if (yn >= bigint_thresholds.toom3 && yn > 2 * ((xn + 2) / 3)) {
+        bigint_mpn_toom3(rp, xp, xn, yp, yn, tp);
+    } else {
+        bigint_mpn_karatsuba(rp, xp, xn, yp, yn, tp);
+    }
 }
 
 /**
- * bigint_karatusba
- *  @x: a non-null big integer
- *  @y: a non-null big integer
- * 
- *  Perform a multiplication using Karatsuba recursive algorithm
- *  in O(n^{\log_2 3}) \approx O(n^{1.585})
+ * bigint_mpn_mul
+ *  @rp: output span of @xn + @yn limbs, disjoint from the operands
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs
+ *  @yn: number of limbs of @yp
+ *
+ *  Computes @rp = @xp * @yp. Operands whose shortest one reaches the NTT
+ *  threshold are multiplied with the number theoretic transform, the others
+ *  with bigint_mpn_mul_rec, whose whole recursion runs in a single scratch
+ *  buffer allocated up front.
+ *
+ *  Returns false if the scratch buffer cannot be allocated
  */
-static bigint_result_t bigint_karatsuba(const bigint_t *x, const bigint_t *y) {
-    bigint_result_t result = {0};
-    bigint_result_t tmp_res = {0};
-
-    if (x == NULL || y == NULL) {
-        result.status = BIGINT_ERR_INVALID;
-        SET_MSG(result, "Invalid big integers");
+static bool bigint_mpn_mul(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                           const bigint_limb_t *yp, size_t yn) {
+    const size_t max_n = xn > yn ? xn : yn;
+    const size_t min_n = xn > yn ? yn : xn;
 
-        return result;
+    if (min_n >= bigint_thresholds.ntt) {
+        return bigint_mpn_mul_ntt(rp, xp, xn, yp, yn);
     }
 
-    const size_t x_size = vector_size(x->digits);
-    const size_t y_size = vector_size(y->digits);
-    const size_t min_size = x_size < y_size ? x_size : y_size;
-    const size_t max_size = x_size > y_size ? x_size : y_size;
+    if (min_n < bigint_thresholds.karatsuba) {
+        bigint_mpn_mul_basecase(rp, xn >= yn ? xp : yp, max_n, xn >= yn ? yp : xp, min_n);
+
+        return true;
+    }
 
-    // Base case using "grade school" quadratic algorithm
-    if (min_size <= 32 || max_size / min_size > 2) {
-        return bigint_karatsuba_base(x, y);
+    bigint_limb_t *scratch = malloc(bigint_mpn_mul_scratch(max_n, min_n) * sizeof(bigint_limb_t));
+    if (scratch == NULL) {
+        return false;
     }
 
-    // Split the big integer at approximately half the size of the larger number
-    const size_t pivot = (x_size > y_size ? x_size : y_size) / 2;
+    bigint_mpn_mul_rec(rp, xp, xn, yp, yn, scratch);
+    free(scratch);
 
-    // Results of each step
-    bigint_t *x1 = NULL, *x0 = NULL;
-    bigint_t *y1 = NULL, *y0 = NULL;
-    bigint_t *z0 = NULL, *z2 = NULL;
-    bigint_t *x_sum = NULL, *y_sum = NULL;
-    bigint_t *z1_temp = NULL, *z1_sub1 = NULL, *z1 = NULL;
-    bigint_t *z2_shifted = NULL, *z1_shifted = NULL;
-    bigint_t *temp = NULL, *product = NULL;
+    return true;
+}
 
-    // Split x = x1 * BASE^pivot + x0
-    tmp_res = bigint_split(x, pivot, &x1, &x0);
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
+/**
+ * bigint_mpn_sb_divrem
+ *  @qp: output span of @nn - @dn limbs for the quotient
+ *  @np: a span of @nn limbs acting as a dividend, it receives the remainder in its low @dn limbs
+ *  @nn: number of limbs of @np
+ *  @dp: a span of limbs acting as a divisor, with the most significant bit set
+ *  @dn: number of limbs of @dp, at least 2 and at most @nn
+ *
+ *  Computes the quotient floor(@np / @dp) using Knuth's Algorithm D
+ *  Adapted from p. 273 of Don Knuth's TAoCP Vol. 2
+ *  The complexity is O(n * m) where 'n' and 'm' are the number of limbs
+ *  in the divisor and the quotient, respectively.
+ *
+ *  Returns the most significant limb of the quotient (0 or 1), which
+ *  does not fit @qp
+ */
+static bigint_limb_t bigint_mpn_sb_divrem(bigint_limb_t *qp, bigint_limb_t *np, size_t nn,
+                                          const bigint_limb_t *dp, size_t dn) {
+    /* First, some definitions:
+     * index 0 -> least significant limb;
+     * n -> limb count of divisor d
+     * u[j ... j + n] -> window of the dividend that yields the quotient limb j
+     */
+    const size_t n = dn;
+    bigint_limb_t *u = np;
 
-    // Split y = y1 * BASE^pivot + y0
-    tmp_res = bigint_split(y, pivot, &y1, &y0);
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
+    // The top n limbs may exceed the divisor once, the following windows cannot
+    const bigint_limb_t q_top = bigint_mpn_cmp(u + nn - n, n, dp, n) >= 0;
+    if (q_top) {
+        bigint_mpn_sub(u + nn - n, u + nn - n, n, dp, n);
+    }
 
-    // Perform karatsuba's trick
-    tmp_res = bigint_karatsuba(x0, y0); // z0 = x0 * y0
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    z0 = tmp_res.value.number;
+    const bigint_limb_t v_top = dp[n - 1];
+    const bigint_limb_t v_next = dp[n - 2];
+    const bigint_limb_t reciprocal = bigint_limb_reciprocal(v_top);
 
-    tmp_res = bigint_karatsuba(x1, y1); // z2 = x1 * y1
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    z2 = tmp_res.value.number;
+    // D2-D6: the main loop. One iteration produces one quotient limb
+    for (size_t j = nn - n; j-- > 0;) {
+        // D3: 2-by-1 trial quotient, u[j + n] <= v_top holds at each step
+        bigint_limb_t q_hat, r_hat;
+        bool r_overflow = false;
+
+        if (u[j + n] == v_top) {
+            q_hat = ~(bigint_limb_t)0;
+            r_hat = u[j + n - 1] + v_top;
+            r_overflow = r_hat < v_top;
+        } else {
+            q_hat = bigint_div_2by1(&r_hat, u[j + n], u[j + n - 1], v_top, reciprocal);
+        }
 
-    // z1 = (x0 + x1) * (y0 + y1) - z0 - z2
-    tmp_res = bigint_add(x0, x1); // x_sum = x0 + x1
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    x_sum = tmp_res.value.number;
-
-    tmp_res = bigint_add(y0, y1); // y_sum = y0 + y1
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    y_sum = tmp_res.value.number;
-
-    tmp_res = bigint_karatsuba(x_sum, y_sum); // z1_temp = (x0 + x1) * (y0 + y1)
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    z1_temp = tmp_res.value.number;
-
-    tmp_res = bigint_sub(z1_temp, z0); // z1_sub1 = z1_temp - z0
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    z1_sub1 = tmp_res.value.number;
-
-    tmp_res = bigint_sub(z1_sub1, z2); // z1 = z1_sub1 - z2
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    z1 = tmp_res.value.number;
-
-    tmp_res = bigint_shift_left(z2, 2 * pivot); // z2_shifted = z2 << (2 * pivot)
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    z2_shifted = tmp_res.value.number;
-
-    tmp_res = bigint_shift_left(z1, pivot); // z1_shifted = z1 << pivot
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    z1_shifted = tmp_res.value.number;
-
-    tmp_res = bigint_add(z2_shifted, z1_shifted);
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    temp = tmp_res.value.number;
-
-    tmp_res = bigint_add(temp, z0);
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    product = tmp_res.value.number;
-
-    // Destroy intermediate allocations except for the product
-    bigint_destroy(x1); bigint_destroy(x0);
-    bigint_destroy(y1); bigint_destroy(y0);
-    bigint_destroy(z0); bigint_destroy(z2);
-    bigint_destroy(x_sum); bigint_destroy(y_sum);
-    bigint_destroy(z1_temp); bigint_destroy(z1_sub1);
-    bigint_destroy(z1); bigint_destroy(z2_shifted);
-    bigint_destroy(z1_shifted); bigint_destroy(temp);
+        while (!r_overflow &&
+               (bigint_dlimb_t)q_hat * v_next > (((bigint_dlimb_t)r_hat << BIGINT_LIMB_BITS) | u[j + n - 2])) {
+            q_hat--;
+            r_hat += v_top;
+            r_overflow = r_hat < v_top;
+        }
 
-    result.value.number = product;
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Product between big integers was successful");
+        // D4: multiply-subtract u[j ... j + n] -= q_hat * v[0 ... n - 1]
+        const bigint_limb_t borrow = bigint_mpn_submul_1(u + j, dp, n, q_hat);
+        const bigint_limb_t top = u[j + n];
+        u[j + n] = top - borrow;
 
-    return result;
+        // D6: if 'u' went negative, add 'v' back once and decrement q_hat
+        if (top < borrow) {
+            q_hat--;
+            u[j + n] += bigint_mpn_add(u + j, u + j, n, dp, n);
+        }
 
-cleanup: // Destroy intermediate allocations on error
-    if (x1) { bigint_destroy(x1); }
-    if (x0) { bigint_destroy(x0); }
-    if (y1) { bigint_destroy(y1); }
-    if (y0) { bigint_destroy(y0); }
-    if (z0) { bigint_destroy(z0); }
-    if (z2) { bigint_destroy(z2); }
-    if (x_sum) { bigint_destroy(x_sum); }
-    if (y_sum) { bigint_destroy(y_sum); }
-    if (z1_temp) { bigint_destroy(z1_temp); }
-    if (z1_sub1) { bigint_destroy(z1_sub1); }
-    if (z1) { bigint_destroy(z1); }
-    if (z2_shifted) { bigint_destroy(z2_shifted); }
-    if (z1_shifted) { bigint_destroy(z1_shifted); }
-    if (temp) { bigint_destroy(temp); }
-    if (product) { bigint_destroy(product); }
+        // D5: store quotient digit
+        qp[j] = q_hat;
+    }
 
-    return result;
+    return q_top;
 }
 
 /**
- * bigint_div
- *  @x: a non-null big integer acting as a dividend
- *  @y: a non-null big integer acting as a divisor
+ * bigint_mpn_dc_divrem_n
+ *  @qp: output span of @n limbs for the quotient
+ *  @np: a span of 2 * @n limbs acting as a dividend, it receives the remainder in its low @n limbs
+ *  @dp: a span of @n limbs acting as a divisor, with the most significant bit set
+ *  @n: number of limbs of @dp, at least BIGINT_DC_DIV_THRESHOLD
+ *  @tp: scratch span of @n limbs
+ *  @q_top: receives the most significant limb of the quotient (0 or 1)
  *
- *  Computers the quotient floor (i.e., |X| / |Y|) using Knuth's Algorithm D
- *  Adaoted from p. 273 of Don Knuth's TAoCP Vol. 2
- *  The complexity is O(n * m) where 'n' and 'm' are the number of base-10^9
- *  "parts" (the limbs in the code below) in the divisor and the quotient, respectively.
+ *  Computes the quotient floor(@np / @dp) with the recursive division of
+ *  Burnikel and Ziegler: the high half of the quotient comes from dividing
+ *  the top limbs by the high half of the divisor, then it is corrected by the
+ *  product with the low half of the divisor. The same steps yield the low
+ *  half of the quotient, so the cost is a constant multiple of multiplication.
  *
- *  Returns a bigint_result_t containing the quotient.
- *  The called of this function will be responsible for applying the sign.
+ *  Returns false if a product cannot be computed
  */
-static bigint_result_t bigint_div(const bigint_t *x, const bigint_t *y) {
-    bigint_result_t result = {0};
-    bigint_result_t tmp_res = {0};
-
-    bigint_t *quotient = NULL;
-    long long *u = NULL, *v = NULL, *q = NULL;
-
-    if (x == NULL || y == NULL) {
-        result.status = BIGINT_ERR_INVALID;
-        SET_MSG(result, "Invalid big integers");
-
-        return result;
+static bool bigint_mpn_dc_divrem_n(bigint_limb_t *qp, bigint_limb_t *np, const bigint_limb_t *dp, size_t n,
+                                   bigint_limb_t *tp, bigint_limb_t *q_top) {
+    const bigint_limb_t one = 1;
+    const size_t lo = n / 2;
+    const size_t hi = n - lo;
+    bigint_limb_t q_high, q_low, borrow;
+
+    // High half: np[2lo ... 2n) / dp[lo ... n), corrected by q_high * dp[0 ... lo)
+    if (hi < BIGINT_DC_DIV_THRESHOLD) {
+        q_high = bigint_mpn_sb_divrem(qp + lo, np + (2 * lo), 2 * hi, dp + lo, hi);
+    } else if (!bigint_mpn_dc_divrem_n(qp + lo, np + (2 * lo), dp + lo, hi, tp, &q_high)) {
+        return false;
     }
 
-    const size_t y_size = vector_size(y->digits);
-    if (y_size == 0) {
-        result.status = BIGINT_ERR_DIV_BY_ZERO;
-        SET_MSG(result, "Cannot divide by zero");
-
-        return result;
+    if (!bigint_mpn_mul(tp, qp + lo, hi, dp, lo)) {
+        return false;
     }
 
-    if (y_size == 1) {
-        vector_result_t y0_res = vector_get(y->digits, 0);
-        if (y0_res.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, y0_res.message);
+    borrow = bigint_mpn_sub(np + lo, np + lo, n, tp, n);
+    if (q_high != 0) {
+        borrow += bigint_mpn_sub(np + n, np + n, lo, dp, lo);
+    }
 
-            return result;
-        }
+    while (borrow != 0) {
+        q_high -= bigint_mpn_sub(qp + lo, qp + lo, hi, &one, 1);
+        borrow -= bigint_mpn_add(np + lo, np + lo, n, dp, n);
+    }
 
-        int *y0 = (int *)y0_res.value.element;
-        if (*y0 == 0) {
-            result.status = BIGINT_ERR_DIV_BY_ZERO;
-            SET_MSG(result, "Cannot divide by zero");
+    // Low half: np[hi ... hi + 2lo) / dp[hi ... n), corrected by q_low * dp[0 ... hi)
+    if (lo < BIGINT_DC_DIV_THRESHOLD) {
+        q_low = bigint_mpn_sb_divrem(qp, np + hi, 2 * lo, dp + hi, lo);
+    } else if (!bigint_mpn_dc_divrem_n(qp, np + hi, dp + hi, lo, tp, &q_low)) {
+        return false;
+    }
 
-            return result;
-        }
+    if (!bigint_mpn_mul(tp, dp, hi, qp, lo)) {
+        return false;
     }
 
-    tmp_res = bigint_compare_abs(x, y);
-    if (tmp_res.status != BIGINT_OK) {
-        return tmp_res;
+    borrow = bigint_mpn_sub(np, np, n, tp, n);
+    if (q_low != 0) {
+        borrow += bigint_mpn_sub(np + lo, np + lo, hi, dp, hi);
     }
 
-    if (tmp_res.value.compare_status < 0) {
-        return bigint_from_int(0);
+    while (borrow != 0) {
+        bigint_mpn_sub(qp, qp, lo, &one, 1);
+        borrow -= bigint_mpn_add(np, np, n, dp, n);
     }
 
-    const size_t x_size = vector_size(x->digits);
-    const size_t n = y_size;
-    const long long BASE = (long long)BIGINT_BASE;
+    *q_top = q_high;
 
-    quotient = malloc(sizeof(bigint_t));
-    if (quotient == NULL) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Cannot allocate memory for big integer");
+    return true;
+}
 
-        goto cleanup;
+/**
+ * bigint_mpn_dc_divrem
+ *  @qp: output span of @nn - @dn limbs for the quotient
+ *  @np: a span of @nn limbs acting as a dividend, it receives the remainder in its low @dn limbs
+ *  @nn: number of limbs of @np, its top @dn limbs must be less than @dp
+ *  @dp: a span of limbs acting as a divisor, with the most significant bit set
+ *  @dn: number of limbs of @dp, at least BIGINT_DC_DIV_THRESHOLD
+ *
+ *  Computes the quotient floor(@np / @dp) by blocks of @dn quotient limbs,
+ *  from the most significant one, see bigint_mpn_dc_divrem_n. The first block
+ *  takes the remaining limbs, dividing by the top limbs of @dp and correcting
+ *  the result with the product by the others.
+ *
+ *  Returns false if the scratch buffer cannot be allocated
+ */
+static bool bigint_mpn_dc_divrem(bigint_limb_t *qp, bigint_limb_t *np, size_t nn,
+                                 const bigint_limb_t *dp, size_t dn) {
+    const bigint_limb_t one = 1;
+    const size_t qn = nn - dn;
+    size_t offset = qn - (((qn - 1) % dn) + 1); // Start of the first (partial) block
+    const size_t first = qn - offset;
+    bigint_limb_t q_top = 0;
+
+    bigint_limb_t *tp = malloc(dn * sizeof(bigint_limb_t));
+    if (tp == NULL) {
+        return false;
     }
 
-    quotient->digits = NULL;
-    quotient->is_negative = false;
-
-    // Single-limb divisor case. Here, we scan using 64-bit arithmetic in O(n)
-    if (y_size == 1) {
-        vector_result_t y0_res = vector_get(y->digits, 0);
-        if (y0_res.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, y0_res.message);
+    bool ok = true;
+    if (first == dn) {
+        ok = bigint_mpn_dc_divrem_n(qp + offset, np + offset, dp, dn, tp, &q_top);
+    } else if (first < BIGINT_DC_DIV_THRESHOLD) {
+        bigint_mpn_sb_divrem(qp + offset, np + offset, dn + first, dp, dn);
+    } else {
+        // Divide the top 2 * first limbs by the top first limbs of the divisor, then correct
+        bigint_limb_t *wp = np + offset;
+        ok = bigint_mpn_dc_divrem_n(qp + offset, wp + (dn - first), dp + (dn - first), first, tp, &q_top) &&
+             bigint_mpn_mul(tp, qp + offset, first, dp, dn - first);
+
+        if (ok) {
+            bigint_limb_t borrow = bigint_mpn_sub(wp, wp, dn, tp, dn);
+            if (q_top != 0) {
+                borrow += bigint_mpn_sub(wp + first, wp + first, dn - first, dp, dn - first);
+            }
 
-            goto cleanup;
+            while (borrow != 0) {
+                q_top -= bigint_mpn_sub(qp + offset, qp + offset, first, &one, 1);
+                borrow -= bigint_mpn_add(wp, wp, dn, dp, dn);
+            }
         }
+    }
 
-        long long divisor = *(int *)y0_res.value.element;
-
-        vector_result_t vec_res = vector_new(x_size, sizeof(int));
-        if (vec_res.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_ALLOCATE;
-            COPY_MSG(result, vec_res.message);
+    // The remainder of each block is less than the divisor, so the following blocks fit
+    while (ok && offset > 0) {
+        offset -= dn;
+        ok = bigint_mpn_dc_divrem_n(qp + offset, np + offset, dp, dn, tp, &q_top);
+    }
 
-            goto cleanup;
-        }
+    free(tp);
 
-        quotient->digits = vec_res.value.vector;
+    return ok;
+}
 
-        long long remainder = 0;
-        for (int idx = (int)x_size - 1; idx >= 0; idx--) {
-            vector_result_t xidx_res = vector_get(x->digits, idx);
-            if (xidx_res.status != VECTOR_OK) {
-                result.status = BIGINT_ERR_INVALID;
-                COPY_MSG(result, xidx_res.message);
+/**
+ * bigint_mpn_invert
+ *  @ip: output span of @n limbs for the reciprocal
+ *  @dp: a span of @n limbs, with the most significant bit set
+ *  @n: number of limbs of @dp, at least 2
+ *
+ *  Computes the reciprocal B^n + @ip ~ floor((B^(2n) - 1) / @dp), where B = 2^64,
+ *  up to a few units. The reciprocal of the top half of @dp is computed recursively,
+ *  then a single Newton step X = X' + X' * (B^(2n) - D * X') / B^(2n), in fixed
+ *  point, doubles its precision. Short divisors are inverted exactly by division.
+ *  The cost is a constant multiple of multiplication.
+ *
+ *  Returns false if the scratch buffers cannot be allocated
+ */
+static bool bigint_mpn_invert(bigint_limb_t *ip, const bigint_limb_t *dp, size_t n) {
+    if (n < BIGINT_INVERT_THRESHOLD) {
+        // Short divisors: divide B^(2n) - 1 directly, the quotient is B^n + ip
+        bigint_limb_t *np = malloc(2 * n * sizeof(bigint_limb_t));
+        if (np == NULL) {
+            return false;
+        }
+        memset(np, 0xFF, 2 * n * sizeof(bigint_limb_t));
 
-                goto cleanup;
-            }
+        bool ok = true;
+        if (n < BIGINT_DC_DIV_THRESHOLD) {
+            bigint_mpn_sb_divrem(ip, np, 2 * n, dp, n);
+        } else {
+            bigint_limb_t *tp = malloc(n * sizeof(bigint_limb_t));
+            bigint_limb_t q_top;
 
-            long long current = remainder * BASE + *(int *)xidx_res.value.element;
-            int q_idx = (int)(current / divisor);
-            remainder = current % divisor;
+            ok = tp != NULL && bigint_mpn_dc_divrem_n(ip, np, dp, n, tp, &q_top);
+            free(tp);
+        }
+        free(np);
 
-            vector_result_t push_res = vector_push(quotient->digits, &q_idx);
-            if (push_res.status != VECTOR_OK) {
-                result.status = BIGINT_ERR_INVALID;
-                COPY_MSG(result, push_res.message);
+        return ok;
+    }
 
-                goto cleanup;
+    /* xp[0 ... n] -> the reciprocal being refined, n + 1 limbs
+     * hp[0 ... h] -> reciprocal of the top h limbs of the divisor
+     * pp[0 ... n + h] -> the error term
+     * ep[0 ... 2n + 1] -> the correction
+     */
+    const size_t h = (n / 2) + 1;
+    bigint_limb_t *xp = malloc(((n + 1) + (h + 1) + (n + h + 1) + (2 * n + 2)) * sizeof(bigint_limb_t));
+    if (xp == NULL) {
+        return false;
+    }
+    bigint_limb_t *hp = xp + n + 1;
+    bigint_limb_t *pp = hp + h + 1;
+    bigint_limb_t *ep = pp + n + h + 1;
+
+    bool ok = bigint_mpn_invert(hp, dp + n - h, h);
+    hp[h] = 1;
+
+    // e = B^(n + h) - D * X', a small signed value
+    ok = ok && bigint_mpn_mul(pp, dp, n, hp, h + 1);
+    if (ok) {
+        const bool negative = pp[n + h] != 0;
+        if (negative) {
+            pp[n + h]--;
+        } else {
+            for (size_t idx = 0; idx < n + h; idx++) {
+                pp[idx] = ~pp[idx];
             }
+            bigint_mpn_add_1(pp, pp, n + h, 1);
         }
 
-        // Restore the LSB-first order
-        const size_t q_size = vector_size(quotient->digits);
-        for (size_t lo = 0, hi = q_size - 1; lo < hi; hi--) {
-            vector_result_t lr = vector_get(quotient->digits, lo);
-            vector_result_t hr = vector_get(quotient->digits, hi);
+        // X = X' * B^(n - h) +/- floor(X' * e / B^(2h))
+        const size_t en = bigint_mpn_normalize(pp, n + h + 1);
+        memset(xp, 0, (n - h) * sizeof(bigint_limb_t));
+        memcpy(xp + n - h, hp, (h + 1) * sizeof(bigint_limb_t));
 
-            if (lr.status != VECTOR_OK || hr.status != VECTOR_OK) {
-                result.status = BIGINT_ERR_INVALID;
-                SET_MSG(result, "Failed to reverse quotient digits");
+        if (en > 0) {
+            ok = bigint_mpn_mul(ep, pp, en, hp, h + 1);
+        }
 
-                goto cleanup;
+        const size_t cn = en + h + 1;
+        if (ok && en > 0 && cn > 2 * h) {
+            const size_t dn = bigint_mpn_normalize(ep + (2 * h), cn - (2 * h) < n + 1 ? cn - (2 * h) : n + 1);
+            if (negative) {
+                bigint_mpn_sub(xp, xp, n + 1, ep + (2 * h), dn);
+            } else {
+                bigint_mpn_add(xp, xp, n + 1, ep + (2 * h), dn);
             }
-
-            int lower_val = *(int *)lr.value.element;
-            int higher_val = *(int *)hr.value.element;
-            vector_set(quotient->digits, lo, &higher_val);
-            vector_set(quotient->digits, hi, &lower_val);
         }
+    }
 
-        bigint_result_t trim_res = bigint_trim_zeros(quotient);
-        if (trim_res.status != BIGINT_OK) { result = trim_res; goto cleanup; }
-
-        result.value.number = quotient;
-        result.status = BIGINT_OK;
-        SET_MSG(result, "Division between big integers was successful");
-
-        return result;
+    // The reciprocal lies within B^n and 2 * B^n - 1, keep the approximation there too
+    if (ok && xp[n] == 0) {
+        memset(xp, 0, n * sizeof(bigint_limb_t));
+    } else if (ok && xp[n] > 1) {
+        memset(xp, 0xFF, n * sizeof(bigint_limb_t));
     }
 
-    /* General case using Knuth's Algorithm
-     * First, some definitions:
-     * index 0 -> least significant limb;
-     * n -> limb count of divisor y
-     * m -> limb count of quotient (x_size - n)
-     * u[0 ... m + n] -> working copy of the (scaled) dividend +1 sentinel limb
-     * v[0 ... n - 1] -> working copy of the (scaled) divisor
-     * q[0 ... m] -> output quotient limbs
-     */
-    const size_t m = x_size - n;
+    if (ok) {
+        memcpy(ip, xp, n * sizeof(bigint_limb_t));
+    }
+    free(xp);
 
-    u = calloc(m + n + 1, sizeof(long long));
-    v = calloc(n, sizeof(long long));
-    q = calloc(m + 1, sizeof(long long));
+    return ok;
+}
 
-    if (u == NULL || v == NULL || q == NULL) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Cannot allocate scratch arrays for division");
+/**
+ * bigint_mpn_mu_divrem_n
+ *  @qp: output span of @n limbs for the quotient
+ *  @np: a span of 2 * @n limbs acting as a dividend, its top @n limbs must be less than @dp.
+ *       It receives the remainder in its low @n limbs
+ *  @dp: a span of @n limbs acting as a divisor, with the most significant bit set
+ *  @n: number of limbs of @dp
+ *  @ip: the reciprocal of @dp, see bigint_mpn_invert
+ *  @tp: scratch span of 2 * @n limbs
+ *
+ *  Computes the quotient floor(@np / @dp) with Barrett's method: the product of the
+ *  top limbs of the dividend with the reciprocal estimates the quotient within a
+ *  few units, which are fixed by adding or subtracting the divisor to the remainder.
+ *
+ *  Returns false if a product cannot be computed
+ */
+static bool bigint_mpn_mu_divrem_n(bigint_limb_t *qp, bigint_limb_t *np, const bigint_limb_t *dp, size_t n,
+                                   const bigint_limb_t *ip, bigint_limb_t *tp) {
+    const bigint_limb_t one = 1;
 
-        goto cleanup;
+    // q = N_high + floor(N_high * ip / B^n), the quotient is less than B^n
+    if (!bigint_mpn_mul(tp, np + n, n, ip, n)) {
+        return false;
+    }
+    if (bigint_mpn_add(qp, tp + n, n, np + n, n) != 0) {
+        memset(qp, 0xFF, n * sizeof(bigint_limb_t));
     }
 
-    for (size_t idx = 0; idx < x_size; idx++) {
-        vector_result_t get_res = vector_get(x->digits, idx);
-        if (get_res.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, get_res.message);
-
-            goto cleanup;
-        }
+    // r = N - q * D, then bring it within 0 and D - 1
+    if (!bigint_mpn_mul(tp, qp, n, dp, n)) {
+        return false;
+    }
 
-        u[idx] = *(int *)get_res.value.element;
+    bigint_limb_t borrow = bigint_mpn_sub(np, np, 2 * n, tp, 2 * n);
+    while (borrow != 0) {
+        bigint_mpn_sub(qp, qp, n, &one, 1);
+        borrow -= bigint_mpn_add(np, np, 2 * n, dp, n);
     }
 
-    for (size_t idx = 0; idx < n; idx++) {
-        vector_result_t get_res = vector_get(y->digits, idx);
-        if (get_res.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, get_res.message);
+    while (bigint_mpn_cmp(np, bigint_mpn_normalize(np, 2 * n), dp, n) >= 0) {
+        bigint_mpn_add(qp, qp, n, &one, 1);
+        bigint_mpn_sub(np, np, 2 * n, dp, n);
+    }
 
-            goto cleanup;
-        }
+    return true;
+}
 
-        v[idx] = *(int *)get_res.value.element;
+/**
+ * bigint_mpn_mu_divrem
+ *  @qp: output span of @nn - @dn limbs for the quotient
+ *  @np: a span of @nn limbs acting as a dividend, it receives the remainder in its low @dn limbs
+ *  @nn: number of limbs of @np, its top @dn limbs must be less than @dp
+ *  @dp: a span of limbs acting as a divisor, with the most significant bit set
+ *  @dn: number of limbs of @dp, at least BIGINT_DC_DIV_THRESHOLD
+ *  @ip: the reciprocal of @dp, see bigint_mpn_invert
+ *
+ *  Computes the quotient floor(@np / @dp) by blocks of @dn quotient limbs,
+ *  from the most significant one, see bigint_mpn_mu_divrem_n. The first
+ *  (partial) block is padded with zeros to a full one when it takes at least
+ *  half of it, otherwise it uses the schoolbook or the recursive division.
+ *
+ *  Returns false if the scratch buffer cannot be allocated
+ */
+static bool bigint_mpn_mu_divrem(bigint_limb_t *qp, bigint_limb_t *np, size_t nn,
+                                 const bigint_limb_t *dp, size_t dn, const bigint_limb_t *ip) {
+    const size_t qn = nn - dn;
+    size_t offset = qn - (((qn - 1) % dn) + 1); // Start of the first (partial) block
+    const size_t first = qn - offset;
+    const bool pad = first < dn && 2 * first >= dn;
+
+    // The padded block and its quotient follow the scratch span of bigint_mpn_mu_divrem_n
+    bigint_limb_t *tp = malloc((pad ? 5 : 2) * dn * sizeof(bigint_limb_t));
+    if (tp == NULL) {
+        return false;
     }
 
-    // D1 (normalize): choose 'd' so that v[n - 1] >= BASE / 2 (after scaling)
-    const long long d = BASE / (v[n - 1] + 1);
-
-    long long carry = 0;
-    for (size_t idx = 0; idx < x_size; idx++) {
-        long long current = u[idx] * d + carry;
-        u[idx] = current % BASE;
-        carry = current / BASE;
+    bool ok = true;
+    if (first == dn) {
+        ok = bigint_mpn_mu_divrem_n(qp + offset, np + offset, dp, dn, ip, tp);
+    } else if (pad) {
+        bigint_limb_t *bp = tp + (2 * dn);
+        bigint_limb_t *bq = bp + (2 * dn);
+
+        // The block is less than dp * B^first, so the top dn - first limbs of its quotient are zero
+        memcpy(bp, np + offset, (dn + first) * sizeof(bigint_limb_t));
+        memset(bp + dn + first, 0, (dn - first) * sizeof(bigint_limb_t));
+        ok = bigint_mpn_mu_divrem_n(bq, bp, dp, dn, ip, tp);
+        memcpy(qp + offset, bq, first * sizeof(bigint_limb_t));
+        memcpy(np + offset, bp, dn * sizeof(bigint_limb_t));
+    } else if (first < BIGINT_DC_DIV_THRESHOLD) {
+        bigint_mpn_sb_divrem(qp + offset, np + offset, dn + first, dp, dn);
+    } else {
+        ok = bigint_mpn_dc_divrem(qp + offset, np + offset, dn + first, dp, dn);
     }
-    u[x_size] = carry;
 
-    carry = 0;
-    for (size_t idx = 0; idx < n; idx++) {
-        long long current = v[idx] * d + carry;
-        v[idx] = current % BASE;
-        carry = current / BASE;
+    // The remainder of each block is less than the divisor, so the following blocks fit
+    while (ok && offset > 0) {
+        offset -= dn;
+        ok = bigint_mpn_mu_divrem_n(qp + offset, np + offset, dp, dn, ip, tp);
     }
 
-    // D2-D6: the main loop. One iteration produces one quotient limb
-    for (long long j = (long long)m; j >= 0; j--) {
-        size_t jj = (size_t)j;
+    free(tp);
 
-        // D3: 2-by-1 trial quotient
-        long long two_limb = u[jj + n] * BASE + u[jj + n - 1];
-        long long q_hat = two_limb / v[n - 1];
-        long long r_hat = two_limb % v[n - 1];
+    return ok;
+}
 
-        while (q_hat >= BASE || ((n >= 2) && (q_hat * v[n - 2]) > (BASE * r_hat + u[jj + n - 2]))) {
-            q_hat--;
-            r_hat += v[n - 1];
-            if (r_hat >= BASE) { break; }
+/**
+ * bigint_mpn_divrem
+ *  @qp: output span of @xn - @yn + 1 limbs for the quotient, it can be @xp
+ *  @rp: output span of @yn limbs for the remainder, it can be NULL
+ *  @xp: a span of limbs acting as a dividend
+ *  @xn: number of limbs of @xp
+ *  @yp: a span of limbs acting as a divisor
+ *  @yn: number of limbs of @yp, at least 2 and at most @xn
+ *  @ip: the reciprocal of @yp shifted as below (see bigint_mpn_invert), or NULL
+ *
+ *  Computes the quotient floor(@xp / @yp) and the remainder @xp mod @yp.
+ *  Both operands are shifted so that the top bit of the divisor is set,
+ *  then divided with Knuth's Algorithm D or, when both the divisor and the
+ *  quotient reach BIGINT_DC_DIV_THRESHOLD limbs, with the recursive division.
+ *  Divisors of BIGINT_MU_DIV_THRESHOLD limbs or more, with a quotient at least
+ *  as long, are divided through their reciprocal, which is computed unless @ip
+ *  provides it. The most significant limb of @yp must be non-zero.
+ *
+ *  Returns false if the working copies cannot be allocated
+ */
+static bool bigint_mpn_divrem(bigint_limb_t *qp, bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                              const bigint_limb_t *yp, size_t yn, const bigint_limb_t *ip) {
+    /* u[0 ... xn] -> working copy of the (scaled) dividend +1 sentinel limb
+     * v[0 ... yn - 1] -> working copy of the (scaled) divisor
+     */
+    bigint_limb_t *u = malloc((xn + 1 + yn) * sizeof(bigint_limb_t));
+    if (u == NULL) {
+        return false;
+    }
+    bigint_limb_t *v = u + xn + 1;
+
+    // D1 (normalize): shift both operands so that the top bit of v[yn - 1] is set.
+    // The top yn limbs of u are then less than v, so the quotient fits xn - yn + 1 limbs
+    const unsigned shift = (unsigned)__builtin_clzll(yp[yn - 1]);
+    bigint_mpn_lshift(v, yp, yn, shift);
+    u[xn] = bigint_mpn_lshift(u, xp, xn, shift);
+
+    bool ok = true;
+    if (ip != NULL || (yn >= BIGINT_MU_DIV_THRESHOLD && xn + 1 - yn >= yn)) {
+        bigint_limb_t *reciprocal = NULL;
+        if (ip == NULL) {
+            reciprocal = malloc(yn * sizeof(bigint_limb_t));
+            ok = reciprocal != NULL && bigint_mpn_invert(reciprocal, v, yn);
+            ip = reciprocal;
         }
 
-        // D4: multiply-subtract u[j ... j + n] -= q_hat * v[0 ... n - 1]
-        long long borrow = 0;
-        for (size_t idx = 0; idx < n; idx++) {
-            long long product = q_hat * v[idx] + borrow;
-            borrow = product / BASE;
-            long long diff = u[jj + idx] - (product % BASE);
-            if (diff < 0) {
-                diff += BASE;
-                borrow++;
-            }
-            u[jj + idx] = diff;
-        }
-        u[jj + n] -= borrow;
+        ok = ok && bigint_mpn_mu_divrem(qp, u, xn + 1, v, yn, ip);
+        free(reciprocal);
+    } else if (yn < BIGINT_DC_DIV_THRESHOLD || xn - yn + 1 < BIGINT_DC_DIV_THRESHOLD) {
+        bigint_mpn_sb_divrem(qp, u, xn + 1, v, yn);
+    } else {
+        ok = bigint_mpn_dc_divrem(qp, u, xn + 1, v, yn);
+    }
 
-        // D5: store quotient digit
-        q[jj] = q_hat;
-
-        // D6: if 'u' went negative, add 'v' back once and decrement q[j]
-        if (u[jj + n] < 0) {
-            q[jj]--;
-            carry = 0;
-            for (size_t idx = 0; idx < n; idx++) {
-                long long sum = u[jj + idx] + v[idx] + carry;
-                u[jj + idx] = sum % BASE;
-                carry = sum / BASE;
+    // The remainder is left in u[0 ... yn - 1], scaled by 2^shift
+    if (ok && rp != NULL) {
+        bigint_mpn_rshift(rp, u, yn, shift);
+    }
+
+    free(u);
+
+    return ok;
+}
+
+/**
+ * bigint_mpn_mod
+ *  @rp: output span of @mn limbs for the remainder, disjoint from @xp
+ *  @xp: a span of limbs
+ *  @xn: number of limbs of @xp
+ *  @mp: a span of limbs acting as a modulus, its most significant limb is non-zero
+ *  @mn: number of limbs of @mp
+ *  @ip: the reciprocal of @mp as in bigint_mpn_divrem, or NULL
+ *
+ *  Computes @rp = @xp mod @mp, discarding the quotient
+ *
+ *  Returns false if the quotient cannot be allocated
+ */
+static bool bigint_mpn_mod(bigint_limb_t *rp, const bigint_limb_t *xp, size_t xn,
+                           const bigint_limb_t *mp, size_t mn, const bigint_limb_t *ip) {
+    if (xn < mn) {
+        memcpy(rp, xp, xn * sizeof(bigint_limb_t));
+        memset(rp + xn, 0, (mn - xn) * sizeof(bigint_limb_t));
+
+        return true;
+    }
+
+    bigint_limb_t *qp = malloc((xn - mn + 1) * sizeof(bigint_limb_t));
+    if (qp == NULL) {
+        return false;
+    }
+
+    bool ok = true;
+    if (mn == 1) {
+        rp[0] = bigint_mpn_divrem_1(qp, xp, xn, mp[0]);
+    } else {
+        ok = bigint_mpn_divrem(qp, rp, xp, xn, mp, mn, ip);
+    }
+    free(qp);
+
+    return ok;
+}
+
+/**
+ * bigint_mont_inverse
+ *  @m0: an odd limb
+ *
+ *  Computes the inverse of @m0 modulo B with Newton's iteration X = X * (2 - @m0 * X),
+ *  which doubles the number of correct low bits at each step. Since @m0 * @m0 = 1 mod 8,
+ *  @m0 itself is correct to 3 bits, so five steps reach 64 bits.
+ *
+ *  Returns -@m0^(-1) mod B
+ */
+static bigint_limb_t bigint_mont_inverse(bigint_limb_t m0) {
+    bigint_limb_t inverse = m0;
+
+    for (size_t idx = 0; idx < 5; idx++) {
+        inverse *= 2 - (m0 * inverse);
+    }
+
+    return -inverse;
+}
+
+/**
+ * bigint_mont_redc
+ *  @rp: output span of @n limbs, disjoint from @tp
+ *  @tp: a span of 2 * @n limbs less than @mp * B^n, it is overwritten
+ *  @mp: a span of @n limbs acting as an odd modulus
+ *  @n: number of limbs of @mp
+ *  @inverse: -@mp^(-1) mod B, see bigint_mont_inverse
+ *
+ *  Computes @rp = @tp / B^n mod @mp with Montgomery's reduction: adding
+ *  a multiple of @mp clears the low limbs of @tp one at a time. Neither
+ *  the running time nor the memory accesses depend on the values of the limbs.
+ */
+static void bigint_mont_redc(bigint_limb_t *rp, bigint_limb_t *tp, const bigint_limb_t *mp, size_t n,
+                             bigint_limb_t inverse) {
+    // Once cleared, limb idx holds the carry that belongs to limb idx + n
+    for (size_t idx = 0; idx < n; idx++) {
+        tp[idx] = bigint_mpn_addmul_1(tp + idx, mp, n, tp[idx] * inverse);
+    }
+    const bigint_limb_t carry = bigint_mpn_add(rp, tp + n, n, tp, n);
+
+    // The result is less than 2 * @mp: keep the difference with @mp unless it borrows past the carry
+    const bigint_limb_t borrow = bigint_mpn_sub(tp, rp, n, mp, n);
+    const bigint_limb_t mask = (carry ^ borrow) - 1;
+    for (size_t idx = 0; idx < n; idx++) {
+        rp[idx] = (tp[idx] & mask) | (rp[idx] & ~mask);
+    }
+}
+
+/**
+ * bigint_barrett_reduce
+ *  @ctx: a Barrett context
+ *  @rp: output span of ctx->size limbs, disjoint from @tp
+ *  @tp: a span of 2 * ctx->size limbs less than the square of the modulus, it is overwritten
+ *  @sp: scratch span of 3 * ctx->size limbs
+ *
+ *  Computes @rp = @tp mod ctx->modulus. The product of the top limbs of @tp, scaled like
+ *  the normalized modulus, with the reciprocal estimates the quotient within a few units.
+ *  Short moduli are divided with Knuth's Algorithm D, which costs less than the two
+ *  products of the estimate below BIGINT_DC_DIV_THRESHOLD limbs.
+ *
+ *  Returns false if a product cannot be computed
+ */
+static bool bigint_barrett_reduce(const bigint_barrett_ctx_t *ctx, bigint_limb_t *rp, bigint_limb_t *tp,
+                                  bigint_limb_t *sp) {
+    const size_t n = ctx->size;
+
+    if (n == 1) {
+        rp[0] = bigint_mpn_divrem_1(sp, tp, 2, ctx->modulus[0]);
+
+        return true;
+    }
+
+    // tp < m^2 and m < B^n / 2^shift, so no bit is shifted out and the top n limbs stay below the divisor
+    bigint_mpn_lshift(tp, tp, 2 * n, ctx->shift);
+    if (n < BIGINT_DC_DIV_THRESHOLD) {
+        bigint_mpn_sb_divrem(sp, tp, 2 * n, ctx->normalized, n);
+    } else if (!bigint_mpn_mu_divrem_n(sp, tp, ctx->normalized, n, ctx->reciprocal, sp + n)) {
+        return false;
+    }
+    bigint_mpn_rshift(rp, tp, n, ctx->shift);
+
+    return true;
+}
+
+/*
+ * Modular multiplication of the exponentiation: either in Montgomery form or
+ * with Barrett's reduction, with the scratch space of its products
+ */
+typedef struct {
+    const bigint_mont_ctx_t *mont; // NULL when reducing with @barrett
+    const bigint_barrett_ctx_t *barrett;
+    size_t n; // Limbs of the modulus
+    bool constant_time; // Schoolbook products only, their running time does not depend on the operands
+    bigint_limb_t *tp; // 2 * n limbs for the product
+    bigint_limb_t *sp; // Scratch of the product and of the reduction, see bigint_modmul_scratch
+} bigint_modmul_t;
+
+/**
+ * bigint_modmul_scratch
+ *  @n: number of limbs of the modulus
+ *
+ *  Returns the number of limbs of bigint_modmul_t.sp
+ */
+static size_t bigint_modmul_scratch(size_t n) {
+    const size_t mul = n < bigint_thresholds.ntt ? bigint_mpn_mul_scratch(n, n) : 0;
+
+    return mul > 3 * n ? mul : 3 * n;
+}
+
+/**
+ * bigint_modmul
+ *  @mm: a modular multiplication
+ *  @rp: output span of mm->n limbs, it may alias the operands
+ *  @xp: a span of mm->n limbs, less than the modulus
+ *  @yp: a span of mm->n limbs, less than the modulus
+ *
+ *  Computes @rp = @xp * @yp / B^n mod m in Montgomery form or @rp = @xp * @yp mod m
+ *
+ *  Returns false if a product cannot be computed
+ */
+static bool bigint_modmul(bigint_modmul_t *mm, bigint_limb_t *rp, const bigint_limb_t *xp, const bigint_limb_t *yp) {
+    const size_t n = mm->n;
+
+    if (xp == yp && (mm->constant_time || n < BIGINT_SQR_THRESHOLD)) {
+        bigint_mpn_sqr_basecase(mm->tp, xp, n);
+    } else if (mm->constant_time || n < bigint_thresholds.karatsuba) {
+        bigint_mpn_mul_basecase(mm->tp, xp, n, yp, n);
+    } else if (n < bigint_thresholds.ntt) {
+        bigint_mpn_mul_rec(mm->tp, xp, n, yp, n, mm->sp);
+    } else if (!bigint_mpn_mul(mm->tp, xp, n, yp, n)) {
+        return false;
+    }
+
+    if (mm->mont != NULL) {
+        bigint_mont_redc(rp, mm->tp, mm->mont->modulus, n, mm->mont->inverse);
+
+        return true;
+    }
+
+    return bigint_barrett_reduce(mm->barrett, rp, mm->tp, mm->sp);
+}
+
+/**
+ * bigint_powm_window
+ *  @bits: number of bits of the exponent
+ *
+ *  Returns the width of the windows of the exponentiation, which trades the
+ *  2^(width - 1) precomputed powers against the multiplications they save
+ */
+static unsigned bigint_powm_window(size_t bits) {
+    static const size_t limits[] = { 7, 25, 81, 241, 673 };
+    unsigned width = 1;
+
+    while (width < 6 && bits > limits[width - 1]) {
+        width++;
+    }
+
+    return width;
+}
+
+/**
+ * bigint_exp_bits
+ *  @ep: a span of limbs acting as an exponent
+ *  @en: number of limbs of @ep
+ *  @bit: position of the lowest bit
+ *  @count: number of bits, less than BIGINT_LIMB_BITS
+ *
+ *  Returns the @count bits of @ep starting at @bit, those past @en limbs being zero
+ */
+static inline unsigned bigint_exp_bits(const bigint_limb_t *ep, size_t en, size_t bit, unsigned count) {
+    const size_t limb = bit / BIGINT_LIMB_BITS;
+    const unsigned offset = (unsigned)(bit % BIGINT_LIMB_BITS);
+
+    bigint_limb_t bits = ep[limb] >> offset;
+    if (offset + count > BIGINT_LIMB_BITS && limb + 1 < en) {
+        bits |= ep[limb + 1] << (BIGINT_LIMB_BITS - offset);
+    }
+
+    return (unsigned)(bits & ((1U << count) - 1));
+}
+
+/**
+ * bigint_mpn_powm
+ *  @rp: output span of mm->n limbs, disjoint from @bp
+ *  @bp: a span of mm->n limbs acting as a base, less than the modulus
+ *  @ep: a span of limbs acting as an exponent, without leading zeros
+ *  @en: number of limbs of @ep, at least 1
+ *  @mm: the modular multiplication
+ *
+ *  Computes @rp = @bp^@ep with the sliding window method: the exponent is read
+ *  from its most significant bit by windows of at most bigint_powm_window bits
+ *  that end with a set bit, each window costing its squarings and a single
+ *  multiplication by a precomputed odd power of @bp. Runs of zeros only cost
+ *  their squarings.
+ *
+ *  Returns false if the table of powers or a product cannot be allocated
+ */
+static bool bigint_mpn_powm(bigint_limb_t *rp, const bigint_limb_t *bp, const bigint_limb_t *ep, size_t en,
+                            bigint_modmul_t *mm) {
+    const size_t n = mm->n;
+    size_t bit = (en * BIGINT_LIMB_BITS) - (size_t)__builtin_clzll(ep[en - 1]);
+    const unsigned width = bigint_powm_window(bit);
+    const size_t count = (size_t)1 << (width - 1);
+
+    // Odd powers b, b^3, ..., b^(2^width - 1), followed by b^2
+    bigint_limb_t *table = malloc((count + 1) * n * sizeof(bigint_limb_t));
+    if (table == NULL) {
+        return false;
+    }
+    bigint_limb_t *square = table + (count * n);
+
+    memcpy(table, bp, n * sizeof(bigint_limb_t));
+    bool ok = bigint_modmul(mm, square, bp, bp);
+    for (size_t idx = 1; ok && idx < count; idx++) {
+        ok = bigint_modmul(mm, table + (idx * n), table + ((idx - 1) * n), square);
+    }
+
+    // The most significant bit is set, so the first window initializes the result
+    bool first = true;
+    while (ok && bit > 0) {
+        if (bigint_exp_bits(ep, en, bit - 1, 1) == 0) {
+            ok = bigint_modmul(mm, rp, rp, rp);
+            bit--;
+
+            continue;
+        }
+
+        unsigned length = bit < width ? (unsigned)bit : width;
+        unsigned window = bigint_exp_bits(ep, en, bit - length, length);
+        while ((window & 1) == 0) {
+            window >>= 1;
+            length--;
+        }
+
+        if (first) {
+            memcpy(rp, table + ((window >> 1) * n), n * sizeof(bigint_limb_t));
+            first = false;
+        } else {
+            for (unsigned idx = 0; ok && idx < length; idx++) {
+                ok = bigint_modmul(mm, rp, rp, rp);
             }
-            u[jj + n] += carry;
+            ok = ok && bigint_modmul(mm, rp, rp, table + ((window >> 1) * n));
+        }
+        bit -= length;
+    }
+
+    free(table);
+
+    return ok;
+}
+
+/**
+ * bigint_mpn_select
+ *  @rp: output span of @n limbs
+ *  @table: a span of @count entries of @n limbs
+ *  @count: number of entries of @table
+ *  @n: number of limbs of an entry
+ *  @index: the entry to copy, less than @count
+ *
+ *  Copies the entry @index of @table to @rp, reading every entry and
+ *  masking the others out, so that the memory accesses do not depend on @index
+ */
+static void bigint_mpn_select(bigint_limb_t *rp, const bigint_limb_t *table, size_t count, size_t n, size_t index) {
+    memset(rp, 0, n * sizeof(bigint_limb_t));
+
+    for (size_t entry = 0; entry < count; entry++) {
+        const bigint_limb_t diff = (bigint_limb_t)(entry ^ index);
+        const bigint_limb_t mask = ((diff | -diff) >> (BIGINT_LIMB_BITS - 1)) - 1;
+
+        for (size_t idx = 0; idx < n; idx++) {
+            rp[idx] |= table[(entry * n) + idx] & mask;
         }
     }
+}
+
+/**
+ * bigint_mpn_powm_sec
+ *  @rp: output span of mm->n limbs, disjoint from @bp
+ *  @bp: a span of mm->n limbs acting as a base in Montgomery form
+ *  @onep: a span of mm->n limbs, that is B^n mod m (one in Montgomery form)
+ *  @ep: a span of limbs acting as an exponent
+ *  @en: number of limbs of @ep, at least 1
+ *  @mm: a constant time Montgomery multiplication
+ *
+ *  Computes @rp = @bp^@ep with the fixed window method: every window of every
+ *  limb of the exponent, zeros included, costs the same squarings and one
+ *  multiplication by a power of @bp read with bigint_mpn_select. The running
+ *  time and the memory accesses only depend on @en and on the modulus.
+ *
+ *  Returns false if the table of powers cannot be allocated
+ */
+static bool bigint_mpn_powm_sec(bigint_limb_t *rp, const bigint_limb_t *bp, const bigint_limb_t *onep,
+                                const bigint_limb_t *ep, size_t en, bigint_modmul_t *mm) {
+    const size_t n = mm->n;
+    const size_t bits = en * BIGINT_LIMB_BITS;
+    const unsigned width = bigint_powm_window(bits);
+    const size_t count = (size_t)1 << width;
+
+    // Powers 1, b, b^2, ..., b^(2^width - 1), followed by the selected one
+    bigint_limb_t *table = malloc((count + 1) * n * sizeof(bigint_limb_t));
+    if (table == NULL) {
+        return false;
+    }
+    bigint_limb_t *power = table + (count * n);
+
+    memcpy(table, onep, n * sizeof(bigint_limb_t));
+    memcpy(table + n, bp, n * sizeof(bigint_limb_t));
+    for (size_t idx = 2; idx < count; idx++) {
+        bigint_modmul(mm, table + (idx * n), table + ((idx - 1) * n), bp);
+    }
+
+    // The top window is partial unless the width divides the number of bits
+    size_t bit = bits - (((bits - 1) % width) + 1);
+    bigint_mpn_select(rp, table, count, n, bigint_exp_bits(ep, en, bit, (unsigned)(bits - bit)));
+    while (bit > 0) {
+        bit -= width;
+        for (unsigned idx = 0; idx < width; idx++) {
+            bigint_modmul(mm, rp, rp, rp);
+        }
+        bigint_mpn_select(power, table, count, n, bigint_exp_bits(ep, en, bit, width));
+        bigint_modmul(mm, rp, rp, power);
+    }
+
+    free(table);
+
+    return true;
+}
+
+/**
+ * bigint_limbs
+ *  @number: a non-null big integer
+ *
+ *  Returns the span of limbs of @number, that is its inline limb
+ *  when @number has no vector
+ */
+static inline bigint_limb_t *bigint_limbs(const bigint_t *number) {
+    return number->digits != NULL ? (bigint_limb_t *)number->digits->elements
+                                  : (bigint_limb_t *)&number->inline_limb;
+}
+
+/**
+ * bigint_size
+ *  @number: a non-null big integer
+ *
+ *  Returns the number of limbs of @number
+ */
+static inline size_t bigint_size(const bigint_t *number) {
+    return number->digits != NULL ? vector_size(number->digits) : 1;
+}
+
+/**
+ * bigint_set_size
+ *  @number: a non-null big integer
+ *  @size: number of limbs, at least one and within the capacity of @number
+ *
+ *  Sets the number of limbs of @number, an inline number always having one
+ */
+static inline void bigint_set_size(bigint_t *number, size_t size) {
+    if (number->digits != NULL) {
+        number->digits->size = size;
+    }
+}
+
+/**
+ * bigint_alloc
+ *  @limbs: number of limbs
+ *
+ *  Allocates a non-negative big integer made of @limbs zero limbs.
+ *  A single limb is stored inline, without allocating a vector
+ *
+ *  Returns a bigint_result_t data type containing a new big integer
+ */
+static bigint_result_t bigint_alloc(size_t limbs) {
+    bigint_result_t result = {0};
+
+    bigint_t *number = malloc(sizeof(bigint_t));
+    if (number == NULL) {
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for big integer");
+
+        return result;
+    }
+
+    number->inline_limb = 0;
+    number->is_negative = false;
+    if (limbs <= 1) {
+        number->digits = NULL;
+
+        result.value.number = number;
+        result.status = BIGINT_OK;
+        SET_MSG(result, "Big integer successfully created");
 
-    // Delete working copy from memory
-    REMOVE(u); REMOVE(v);
+        return result;
+    }
 
-    // Build the bigint quotient from q[0 ... m] (index 0 = LSB)
-    vector_result_t vec_res = vector_new(m + 1, sizeof(int));
+    // Vector elements are zeroed on creation
+    vector_result_t vec_res = vector_new(limbs, sizeof(bigint_limb_t));
     if (vec_res.status != VECTOR_OK) {
+        free(number);
         result.status = BIGINT_ERR_ALLOCATE;
         COPY_MSG(result, vec_res.message);
 
-        goto cleanup;
+        return result;
+    }
+
+    number->digits = vec_res.value.vector;
+    number->digits->size = limbs;
+
+    result.value.number = number;
+    result.status = BIGINT_OK;
+    SET_MSG(result, "Big integer successfully created");
+
+    return result;
+}
+
+/**
+ * bigint_reserve
+ *  @number: a non-null big integer
+ *  @limbs: number of limbs to hold
+ *
+ *  Grows the limbs of @number, at least doubling them, so that they can
+ *  hold @limbs limbs. An inline number moves to a vector when it needs
+ *  more than one limb. Neither the size nor the value of @number change.
+ *
+ *  Returns false if the limbs cannot be reallocated
+ */
+static bool bigint_reserve(bigint_t *number, size_t limbs) {
+    if (number->digits == NULL) {
+        if (limbs <= 1) {
+            return true;
+        }
+
+        vector_result_t vec_res = vector_new(limbs, sizeof(bigint_limb_t));
+        if (vec_res.status != VECTOR_OK) {
+            return false;
+        }
+        number->digits = vec_res.value.vector;
+        number->digits->size = 1;
+        bigint_limbs(number)[0] = number->inline_limb;
+
+        return true;
+    }
+
+    vector_t *digits = number->digits;
+    if (limbs <= digits->capacity) {
+        return true;
     }
 
-    quotient->digits = vec_res.value.vector;
-    for (size_t idx = 0; idx <= m; idx++) {
-        int q_idx = (int)q[idx];
+    size_t capacity = 2 * digits->capacity;
+    if (capacity < limbs) {
+        capacity = limbs;
+    }
+    if (capacity > SIZE_MAX / sizeof(bigint_limb_t)) {
+        return false;
+    }
+
+    void *elements = realloc(digits->elements, capacity * sizeof(bigint_limb_t));
+    if (elements == NULL) {
+        return false;
+    }
+    digits->elements = elements;
+    digits->capacity = capacity;
+
+    return true;
+}
+
+/**
+ * bigint_trim_zeros
+ *  @number: a non-null big integer
+ * 
+ *  Helper function to remove leading zeros. At least one limb
+ *  is always kept and zero is never negative
+ */
+static void bigint_trim_zeros(bigint_t *number) {
+    const size_t size = bigint_mpn_normalize(bigint_limbs(number), bigint_size(number));
+
+    bigint_set_size(number, size ? size : 1);
+    if (size == 0) {
+        number->is_negative = false;
+    }
+}
+
+/**
+ * bigint_is_zero
+ *  @number: a non-null big integer
+ *
+ *  Returns true if @number is equal to zero
+ */
+static inline bool bigint_is_zero(const bigint_t *number) {
+    return bigint_mpn_normalize(bigint_limbs(number), bigint_size(number)) == 0;
+}
+
+/**
+ * bigint_signed_limb
+ *  @limb: an absolute value
+ *  @negative: the sign given to @limb
+ *
+ *  Returns @limb, negated when @negative is true, as a signed double limb
+ */
+static inline bigint_sdlimb_t bigint_signed_limb(bigint_limb_t limb, bool negative) {
+    return negative ? -(bigint_sdlimb_t)limb : (bigint_sdlimb_t)limb;
+}
+
+/**
+ * bigint_small_fits
+ *  @value: a signed double limb
+ *
+ *  Returns true if the absolute value of @value fits a single limb
+ */
+static inline bool bigint_small_fits(bigint_sdlimb_t value) {
+    return value >= -(bigint_sdlimb_t)UINT64_MAX && value <= (bigint_sdlimb_t)UINT64_MAX;
+}
+
+/**
+ * bigint_set_small
+ *  @number: a non-null big integer
+ *  @value: a signed value whose absolute value fits a limb
+ *
+ *  Stores @value in the first limb of @number, keeping its capacity
+ */
+static inline void bigint_set_small(bigint_t *number, bigint_sdlimb_t value) {
+    bigint_limbs(number)[0] = (bigint_limb_t)(value < 0 ? -value : value);
+    bigint_set_size(number, 1);
+    number->is_negative = value < 0;
+}
+
+/**
+ * bigint_from_small
+ *  @value: a signed value whose absolute value fits a limb
+ *
+ *  Allocates an inline big integer equal to @value
+ *
+ *  Returns a bigint_result_t data type containing a new big integer
+ */
+static bigint_result_t bigint_from_small(bigint_sdlimb_t value) {
+    bigint_result_t result = bigint_alloc(1);
+    if (result.status == BIGINT_OK) {
+        bigint_set_small(result.value.number, value);
+    }
+
+    return result;
+}
+
+/**
+ * bigint_compare_abs
+ *  @x: a non-null big integer
+ *  @y: a non-null big integer
+ *
+ *  Compares absolute value of two big integers
+ *  if |x| <  |y| => -1
+ *  if |x| == |y| => 0
+ *  if |x| >  |y| => 1
+ */
+static int8_t bigint_compare_abs(const bigint_t *x, const bigint_t *y) {
+    return (int8_t)bigint_mpn_cmp(bigint_limbs(x), bigint_size(x), bigint_limbs(y), bigint_size(y));
+}
+
+/**
+ * bigint_add_abs
+ *  @x: a non-null big integer
+ *  @y: a non-null big integer
+ * 
+ *  Adds two absolute values together
+ * 
+ *  Returns a bigint_result_t data type
+ */
+static bigint_result_t bigint_add_abs(const bigint_t *x, const bigint_t *y) {
+    // Let x be the longest operand
+    if (bigint_size(x) < bigint_size(y)) {
+        const bigint_t *tmp = x; x = y; y = tmp;
+    }
+
+    const size_t x_size = bigint_size(x);
+    bigint_result_t result = bigint_alloc(x_size + 1);
+    if (result.status != BIGINT_OK) {
+        return result;
+    }
+
+    bigint_t *sum = result.value.number;
+    bigint_limb_t *sum_limbs = bigint_limbs(sum);
+    sum_limbs[x_size] = bigint_mpn_add(sum_limbs, bigint_limbs(x), x_size, bigint_limbs(y), bigint_size(y));
+    bigint_trim_zeros(sum);
+
+    SET_MSG(result, "Big integers successfully added");
+
+    return result;
+}
+
+/**
+ * bigint_sub_abs
+ *  @x: a non-null big integer
+ *  @y: a non-null big integer
+ * 
+ *  Subtracts two absolute values assuming that |x| >= |y|
+ * 
+ *  Returns a bigint_result_t data type
+ */
+static bigint_result_t bigint_sub_abs(const bigint_t *x, const bigint_t *y) {
+    const size_t x_size = bigint_size(x);
+    const size_t y_size = bigint_mpn_normalize(bigint_limbs(y), bigint_size(y));
+
+    bigint_result_t result = bigint_alloc(x_size);
+    if (result.status != BIGINT_OK) {
+        return result;
+    }
+
+    bigint_t *difference = result.value.number;
+    bigint_mpn_sub(bigint_limbs(difference), bigint_limbs(x), x_size, bigint_limbs(y), y_size);
+    bigint_trim_zeros(difference);
+
+    SET_MSG(result, "Big integers successfully subtracted");
+
+    return result;
+}
+
+/**
+ * bigint_mul_abs
+ *  @x: a non-null big integer
+ *  @y: a non-null big integer
+ *
+ *  Multiplies two absolute values together
+ *
+ *  Returns a bigint_result_t data type
+ */
+static bigint_result_t bigint_mul_abs(const bigint_t *x, const bigint_t *y) {
+    const size_t x_size = bigint_size(x);
+    const size_t y_size = bigint_size(y);
+
+    bigint_result_t result = bigint_alloc(x_size + y_size);
+    if (result.status != BIGINT_OK) {
+        return result;
+    }
+
+    bigint_t *product = result.value.number;
+    if (!bigint_mpn_mul(bigint_limbs(product), bigint_limbs(x), x_size, bigint_limbs(y), y_size)) {
+        bigint_destroy(product);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate scratch space for multiplication");
+
+        return result;
+    }
+    bigint_trim_zeros(product);
+
+    SET_MSG(result, "Product between big integers was successful");
+
+    return result;
+}
+
+/**
+ * bigint_add_signed
+ *  @dst: a non-null big integer, updated in place
+ *  @src: a non-null big integer, it may be @dst
+ *  @negative: the sign given to @src
+ *
+ *  Adds |@src| (or subtracts it when @negative differs from the sign of @dst)
+ *  to @dst, growing its limbs only when they are too short for the result
+ *
+ *  Returns false if the limbs of @dst cannot be grown
+ */
+static bool bigint_add_signed(bigint_t *dst, const bigint_t *src, bool negative) {
+    // Single limb operands: |dst + src| < 2^65 cannot overflow the signed double limb
+    if (bigint_size(dst) == 1 && bigint_size(src) == 1) {
+        const bigint_sdlimb_t sum = bigint_signed_limb(bigint_limbs(dst)[0], dst->is_negative) +
+                                    bigint_signed_limb(bigint_limbs(src)[0], negative);
+        if (bigint_small_fits(sum)) {
+            bigint_set_small(dst, sum);
+
+            return true;
+        }
+    }
+
+    const size_t dn = bigint_mpn_normalize(bigint_limbs(dst), bigint_size(dst));
+    const size_t sn = bigint_mpn_normalize(bigint_limbs(src), bigint_size(src));
+    const size_t n = dn > sn ? dn : sn;
+
+    // Growing @dst moves the limbs of @src as well when they are the same number
+    if (!bigint_reserve(dst, n + 1)) {
+        return false;
+    }
+    bigint_limb_t *dp = bigint_limbs(dst);
+    const bigint_limb_t *sp = bigint_limbs(src);
+
+    if (dst->is_negative == negative || dn == 0) {
+        dp[n] = dn >= sn ? bigint_mpn_add(dp, dp, dn, sp, sn) : bigint_mpn_add(dp, sp, sn, dp, dn);
+        bigint_set_size(dst, n + 1);
+        dst->is_negative = negative;
+    } else if (bigint_mpn_cmp(dp, dn, sp, sn) >= 0) {
+        bigint_mpn_sub(dp, dp, dn, sp, sn);
+        bigint_set_size(dst, dn);
+    } else {
+        bigint_mpn_sub(dp, sp, sn, dp, dn);
+        bigint_set_size(dst, sn);
+        dst->is_negative = negative;
+    }
+    bigint_trim_zeros(dst);
+
+    return true;
+}
+
+/**
+ * bigint_powm_base
+ *  @bp: output span of @mn limbs
+ *  @base: a non-null big integer
+ *  @mp: a span of limbs acting as a modulus, its most significant limb is non-zero
+ *  @mn: number of limbs of @mp
+ *  @ip: the reciprocal of @mp as in bigint_mpn_divrem, or NULL
+ *
+ *  Computes @bp = @base mod @mp, between 0 and @mp - 1 for negative bases as well
+ *
+ *  Returns false if the quotient cannot be allocated
+ */
+static bool bigint_powm_base(bigint_limb_t *bp, const bigint_t *base, const bigint_limb_t *mp, size_t mn,
+                             const bigint_limb_t *ip) {
+    const size_t base_size = bigint_mpn_normalize(bigint_limbs(base), bigint_size(base));
+    if (!bigint_mpn_mod(bp, bigint_limbs(base), base_size, mp, mn, ip)) {
+        return false;
+    }
+
+    // -b mod m = m - (b mod m), unless m divides b
+    if (base->is_negative && bigint_mpn_normalize(bp, mn) != 0) {
+        bigint_mpn_sub(bp, mp, mn, bp, mn);
+    }
+
+    return true;
+}
+
+/**
+ * bigint_powm
+ *  @mm: a modular multiplication, without scratch space
+ *  @base: a non-null big integer
+ *  @exponent: a non-null, non-negative big integer
+ *  @mp: the limbs of the modulus of @mm
+ *  @ip: the reciprocal of @mp as in bigint_mpn_divrem, or NULL
+ *
+ *  Computes @base^@exponent mod @mp between 0 and @mp - 1. Montgomery's
+ *  multiplication works on residues in Montgomery form, x * B^n mod m:
+ *  the base is converted by a product with B^(2n) mod m and the result
+ *  converted back by a reduction.
+ *
+ *  Returns a bigint_result_t data type containing a new big integer
+ */
+static bigint_result_t bigint_powm(bigint_modmul_t *mm, const bigint_t *base, const bigint_t *exponent,
+                                   const bigint_limb_t *mp, const bigint_limb_t *ip) {
+    const size_t n = mm->n;
+    const size_t exponent_size = bigint_mpn_normalize(bigint_limbs(exponent), bigint_size(exponent));
+
+    bigint_result_t result = bigint_alloc(n);
+    if (result.status != BIGINT_OK) {
+        return result;
+    }
+    bigint_t *power = result.value.number;
+    bigint_limb_t *rp = bigint_limbs(power);
+
+    // x^0 = 1, which is 0 modulo 1
+    if (exponent_size == 0) {
+        rp[0] = (n > 1 || mp[0] != 1);
+        bigint_trim_zeros(power);
+        SET_MSG(result, "Modular exponentiation was successful");
+
+        return result;
+    }
+
+    /* bp[0 ... n - 1] -> base
+     * xp[0 ... n - 1] -> power in Montgomery form, then one in Montgomery form
+     * tp[0 ... 2n - 1] -> product
+     * sp[...] -> scratch of the products and of the reduction
+     */
+    bigint_limb_t *bp = malloc(((4 * n) + bigint_modmul_scratch(n)) * sizeof(bigint_limb_t));
+    if (bp == NULL) {
+        bigint_destroy(power);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate scratch space for exponentiation");
+
+        return result;
+    }
+    bigint_limb_t *xp = bp + n;
+    mm->tp = xp + n;
+    mm->sp = mm->tp + (2 * n);
+
+    bool ok = bigint_powm_base(bp, base, mp, n, ip);
+    if (ok && mm->mont != NULL) {
+        ok = bigint_modmul(mm, bp, bp, mm->mont->r2);
+        if (ok && mm->constant_time) {
+            // B^n mod m = B^(2n) / B^n mod m
+            bigint_limb_t *onep = mm->sp;
+            memcpy(mm->tp, mm->mont->r2, n * sizeof(bigint_limb_t));
+            memset(mm->tp + n, 0, n * sizeof(bigint_limb_t));
+            bigint_mont_redc(xp, mm->tp, mp, n, mm->mont->inverse);
+            memcpy(onep, xp, n * sizeof(bigint_limb_t));
+            mm->sp = onep + n;
+
+            ok = bigint_mpn_powm_sec(xp, bp, onep, bigint_limbs(exponent), exponent_size, mm);
+        } else if (ok) {
+            ok = bigint_mpn_powm(xp, bp, bigint_limbs(exponent), exponent_size, mm);
+        }
+
+        if (ok) {
+            memcpy(mm->tp, xp, n * sizeof(bigint_limb_t));
+            memset(mm->tp + n, 0, n * sizeof(bigint_limb_t));
+            bigint_mont_redc(rp, mm->tp, mp, n, mm->mont->inverse);
+        }
+    } else if (ok) {
+        ok = bigint_mpn_powm(rp, bp, bigint_limbs(exponent), exponent_size, mm);
+    }
+    free(bp);
+
+    if (!ok) {
+        bigint_destroy(power);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate memory for exponentiation");
+
+        return result;
+    }
+    bigint_trim_zeros(power);
+
+    SET_MSG(result, "Modular exponentiation was successful");
+
+    return result;
+}
+
+/**
+ * bigint_div
+ *  @x: a non-null big integer acting as a dividend
+ *  @y: a non-null, non-zero big integer acting as a divisor, |@y| <= |@x|
+ *
+ *  Computes the quotient floor(|X| / |Y|) and the remainder |X| mod |Y|,
+ *  see bigint_mpn_divrem
+ *
+ *  Returns a bigint_result_t containing the quotient and the remainder.
+ *  The caller of this function will be responsible for applying the signs.
+ */
+static bigint_result_t bigint_div(const bigint_t *x, const bigint_t *y) {
+    const size_t x_size = bigint_size(x);
+    const size_t y_size = bigint_mpn_normalize(bigint_limbs(y), bigint_size(y));
+
+    bigint_result_t result = bigint_alloc(x_size - y_size + 1);
+    if (result.status != BIGINT_OK) {
+        return result;
+    }
+    bigint_t *quotient = result.value.number;
+
+    result = bigint_alloc(y_size);
+    if (result.status != BIGINT_OK) {
+        bigint_destroy(quotient);
+
+        return result;
+    }
+    bigint_t *remainder = result.value.number;
+
+    if (y_size == 1) {
+        // Single-limb divisor case. Here, we scan using 64-bit arithmetic in O(n)
+        bigint_limbs(remainder)[0] = bigint_mpn_divrem_1(bigint_limbs(quotient), bigint_limbs(x), x_size,
+                                                         bigint_limbs(y)[0]);
+    } else if (!bigint_mpn_divrem(bigint_limbs(quotient), bigint_limbs(remainder), bigint_limbs(x), x_size,
+                                  bigint_limbs(y), y_size, NULL)) {
+        bigint_destroy(quotient);
+        bigint_destroy(remainder);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate scratch arrays for division");
+
+        return result;
+    }
+    bigint_trim_zeros(quotient);
+    bigint_trim_zeros(remainder);
+
+    result.value.division.quotient = quotient;
+    result.value.division.remainder = remainder;
+    SET_MSG(result, "Division between big integers was successful");
+
+    return result;
+}
+
+/*
+ * Radix conversion. A chunk is the largest power of the base that fits a limb,
+ * the quadratic algorithms convert one chunk at a time while the recursive ones
+ * split the number at the powers chunk^(2^k), computed once per conversion.
+ */
+typedef struct {
+    unsigned base;
+    size_t chunk_digits; // Digits of a chunk
+    bigint_limb_t chunk; // base^chunk_digits
+    bigint_limb_t reciprocal; // bigint_limb_reciprocal(chunk) if its top bit is set, 0 otherwise
+} bigint_radix_t;
+
+typedef struct {
+    size_t levels;
+    bigint_limb_t *limbs[BIGINT_RADIX_LEVELS]; // limbs[k] = chunk^(2^k)
+    size_t sizes[BIGINT_RADIX_LEVELS];
+    bigint_limb_t *inverses[BIGINT_RADIX_LEVELS]; // Reciprocals of the powers, or NULL
+} bigint_powers_t;
+
+static const char bigint_digit_chars[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+static const char bigint_digit_pairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/**
+ * bigint_radix
+ *  @base: the base, from 2 to 36
+ *
+ *  Returns the chunk of @base
+ */
+static bigint_radix_t bigint_radix(unsigned base) {
+    bigint_radix_t radix = { base, 0, 1, 0 };
+
+    while (radix.chunk <= ~(bigint_limb_t)0 / base) {
+        radix.chunk *= base;
+        radix.chunk_digits++;
+    }
+
+    if ((radix.chunk >> (BIGINT_LIMB_BITS - 1)) != 0) {
+        radix.reciprocal = bigint_limb_reciprocal(radix.chunk);
+    }
+
+    return radix;
+}
+
+static void bigint_powers_free(bigint_powers_t *powers) {
+    for (size_t idx = 0; idx < powers->levels; idx++) {
+        free(powers->limbs[idx]);
+        free(powers->inverses[idx]);
+    }
+    powers->levels = 0;
+}
+
+/**
+ * bigint_powers_init
+ *  @powers: the table to fill
+ *  @radix: the radix of the conversion
+ *  @max_limbs: number of limbs of the converted number
+ *
+ *  Computes the powers chunk^(2^k) by repeated squaring, up to the last
+ *  one that has at most half the limbs of the number
+ *
+ *  Returns false if a power cannot be allocated
+ */
+static bool bigint_powers_init(bigint_powers_t *powers, const bigint_radix_t *radix, size_t max_limbs) {
+    powers->levels = 0;
+    powers->limbs[0] = malloc(sizeof(bigint_limb_t));
+    if (powers->limbs[0] == NULL) {
+        return false;
+    }
+    powers->limbs[0][0] = radix->chunk;
+    powers->sizes[0] = 1;
+    powers->inverses[0] = NULL;
+    powers->levels = 1;
+
+    while (powers->levels < BIGINT_RADIX_LEVELS && 4 * powers->sizes[powers->levels - 1] <= max_limbs) {
+        const bigint_limb_t *prev = powers->limbs[powers->levels - 1];
+        const size_t prev_n = powers->sizes[powers->levels - 1];
+
+        bigint_limb_t *next = malloc(2 * prev_n * sizeof(bigint_limb_t));
+        if (next == NULL || !bigint_mpn_mul(next, prev, prev_n, prev, prev_n)) {
+            free(next);
+            bigint_powers_free(powers);
+
+            return false;
+        }
+
+        powers->limbs[powers->levels] = next;
+        powers->sizes[powers->levels] = bigint_mpn_normalize(next, 2 * prev_n);
+        powers->inverses[powers->levels] = NULL;
+        powers->levels++;
+    }
+
+    return true;
+}
+
+/**
+ * bigint_powers_invert
+ *  @powers: the table of powers
+ *
+ *  Computes the reciprocals of the powers of at least BIGINT_RADIX_MU_THRESHOLD
+ *  limbs, shifted as by bigint_mpn_divrem, so that the divisions by the same
+ *  power reuse them
+ *
+ *  Returns false if a reciprocal cannot be allocated
+ */
+static bool bigint_powers_invert(bigint_powers_t *powers) {
+    for (size_t level = 0; level < powers->levels; level++) {
+        const size_t pn = powers->sizes[level];
+        if (pn < BIGINT_RADIX_MU_THRESHOLD) {
+            continue;
+        }
+
+        bigint_limb_t *ip = malloc(2 * pn * sizeof(bigint_limb_t));
+        if (ip == NULL) {
+            return false;
+        }
+        bigint_limb_t *vp = ip + pn;
+
+        bigint_mpn_lshift(vp, powers->limbs[level], pn, (unsigned)__builtin_clzll(powers->limbs[level][pn - 1]));
+        if (!bigint_mpn_invert(ip, vp, pn)) {
+            free(ip);
+
+            return false;
+        }
+        powers->inverses[level] = ip;
+    }
+
+    return true;
+}
+
+/**
+ * bigint_format_chunk
+ *  @end: end of the output, digits are written right before it
+ *  @chunk: the value to format
+ *  @digits: number of digits to write, leading zeros included
+ *  @base: the base
+ *
+ *  Writes the @digits lowest digits of @chunk. Decimal digits are
+ *  written in pairs from a lookup table.
+ */
+static void bigint_format_chunk(char *end, bigint_limb_t chunk, size_t digits, unsigned base) {
+    if (base == 10) {
+        for (; digits >= 2; digits -= 2) {
+            const size_t pair = (size_t)(chunk % 100) * 2;
+            chunk /= 100;
+            end -= 2;
+            end[0] = bigint_digit_pairs[pair];
+            end[1] = bigint_digit_pairs[pair + 1];
+        }
+    }
+
+    for (; digits > 0; digits--) {
+        *--end = bigint_digit_chars[chunk % base];
+        chunk /= base;
+    }
+}
+
+/**
+ * bigint_radix_format
+ *  @out: output span of @width characters
+ *  @width: number of digits to write, the value must be less than base^@width
+ *  @xp: a span of limbs, overwritten by the conversion
+ *  @xn: number of limbs of @xp
+ *  @level: the power of the chunk that splits @xp
+ *  @tp: scratch span of sizes[k] limbs for each level k up to @level
+ *  @powers: the powers of the chunk
+ *  @radix: the radix of the conversion
+ *
+ *  Writes the digits of @xp padded with leading zeros. Short numbers are
+ *  split in chunks by repeated divisions by the chunk, in O(n^2), longer ones
+ *  are divided by the power of @level, usually once, and the remainder and the
+ *  quotient are formatted recursively with the power below, in O(D(n) * log(n))
+ *  where D(n) is the cost of a division. Each level keeps its remainder in its
+ *  own span of @tp while the level below formats it.
+ *
+ *  Returns false if the scratch buffers of a division cannot be allocated
+ */
+static bool bigint_radix_format(char *out, size_t width, bigint_limb_t *xp, size_t xn, size_t level,
+                                bigint_limb_t *tp, const bigint_powers_t *powers, const bigint_radix_t *radix) {
+    xn = bigint_mpn_normalize(xp, xn);
+
+    if (xn < BIGINT_RADIX_THRESHOLD || level == 0) {
+        char *end = out + width;
+
+        /* A normalized chunk is divided out twice per pass, the second division
+         * taking each quotient limb as soon as the first one produces it, so that
+         * their dependency chains overlap
+         */
+        while (radix->reciprocal != 0 && xn > 1) {
+            bigint_limb_t low = 0, high = 0;
+            for (size_t idx = xn; idx-- > 0;) {
+                const bigint_limb_t limb = bigint_div_2by1(&low, low, xp[idx], radix->chunk, radix->reciprocal);
+                xp[idx] = bigint_div_2by1(&high, high, limb, radix->chunk, radix->reciprocal);
+            }
+
+            const size_t left = (size_t)(end - out);
+            const size_t low_digits = left < radix->chunk_digits ? left : radix->chunk_digits;
+            bigint_format_chunk(end, low, low_digits, radix->base);
+            end -= low_digits;
+
+            const size_t high_digits = left - low_digits < radix->chunk_digits ? left - low_digits : radix->chunk_digits;
+            bigint_format_chunk(end, high, high_digits, radix->base);
+            end -= high_digits;
+            xn = bigint_mpn_normalize(xp, xn);
+        }
+
+        while (xn > 0) {
+            const bigint_limb_t chunk = bigint_mpn_divrem_1(xp, xp, xn, radix->chunk);
+            const size_t left = (size_t)(end - out);
+            const size_t digits = left < radix->chunk_digits ? left : radix->chunk_digits;
+
+            bigint_format_chunk(end, chunk, digits, radix->base);
+            end -= digits;
+            xn = bigint_mpn_normalize(xp, xn);
+        }
+        memset(out, '0', (size_t)(end - out));
+
+        return true;
+    }
+
+    const bigint_limb_t *pp = powers->limbs[level];
+    const size_t pn = powers->sizes[level];
+    const size_t low_width = radix->chunk_digits << level;
+    bigint_limb_t *next = tp + pn;
+
+    /* x = q * chunk^(2^level) + r, the remainder takes exactly chunk_digits * 2^level digits
+     * and, being less than the square of the power below, is formatted by the level below.
+     * The quotient replaces x until it is less than the power, which only takes more than
+     * one division for the top level of a number
+     */
+    while (xn > pn || (xn == pn && bigint_mpn_cmp(xp, xn, pp, pn) >= 0)) {
+        if (!bigint_mpn_divrem(xp, tp, xp, xn, pp, pn, powers->inverses[level]) ||
+            !bigint_radix_format(out + width - low_width, low_width, tp, pn, level - 1, next, powers, radix)) {
+            return false;
+        }
+
+        width -= low_width;
+        xn = bigint_mpn_normalize(xp, xn - pn + 1);
+    }
+
+    return bigint_radix_format(out, width, xp, xn, level - 1, tp, powers, radix);
+}
+
+/**
+ * bigint_parse_8
+ *  @str: eight decimal digits
+ *
+ *  Converts eight digits at once, combining adjacent digits, then
+ *  pairs and then quadruples within a single 64-bit word
+ *
+ *  Returns the value of the digits
+ */
+static inline bigint_limb_t bigint_parse_8(const char *str) {
+    uint64_t word = 0;
+    for (size_t idx = 8; idx-- > 0;) {
+        word = (word << 8) | (unsigned char)str[idx];
+    }
+
+    word -= 0x3030303030303030ULL;
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+            (((word >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+
+    return word;
+}
+
+/**
+ * bigint_parse_chunk
+ *  @str: a string of decimal digits
+ *  @len: number of digits, at most BIGINT_DECIMAL_DIGITS
+ *
+ *  Returns the value of the digits
+ */
+static bigint_limb_t bigint_parse_chunk(const char *str, size_t len) {
+    bigint_limb_t chunk = 0;
+
+    for (; len >= 8; str += 8, len -= 8) {
+        chunk = (chunk * 100000000) + bigint_parse_8(str);
+    }
+    for (; len > 0; str++, len--) {
+        chunk = (chunk * 10) + (bigint_limb_t)(*str - '0');
+    }
+
+    return chunk;
+}
+
+/**
+ * bigint_radix_parse
+ *  @rp: output span of @len / BIGINT_DECIMAL_DIGITS + 3 limbs
+ *  @rn: receives the number of limbs of the result, without leading zeros
+ *  @str: a string of decimal digits
+ *  @len: number of digits
+ *  @powers: the powers of 10^BIGINT_DECIMAL_DIGITS
+ *
+ *  Converts the digits of @str. Short strings are processed from left to right
+ *  by chunks of BIGINT_DECIMAL_DIGITS in O(n^2), longer ones are split at a power
+ *  of the chunk and rebuilt as high * chunk^(2^k) + low in O(M(n) * log(n)).
+ *
+ *  Returns false if the scratch buffers cannot be allocated
+ */
+static bool bigint_radix_parse(bigint_limb_t *rp, size_t *rn, const char *str, size_t len,
+                               const bigint_powers_t *powers) {
+    size_t level = powers->levels - 1;
+    while (level > 0 && ((size_t)BIGINT_DECIMAL_DIGITS << level) >= len) {
+        level--;
+    }
+
+    if (len < BIGINT_RADIX_THRESHOLD * BIGINT_DECIMAL_DIGITS || level == 0) {
+        /* The first chunk takes the remainder, each chunk computes
+         * number = number * 10^chunk_len + chunk
+         */
+        size_t size = 1;
+        size_t chunk_len = len % BIGINT_DECIMAL_DIGITS;
+        if (chunk_len == 0) {
+            chunk_len = BIGINT_DECIMAL_DIGITS;
+        }
+
+        rp[0] = bigint_parse_chunk(str, chunk_len);
+        for (size_t pos = chunk_len; pos < len; pos += BIGINT_DECIMAL_DIGITS) {
+            const bigint_limb_t chunk = bigint_parse_chunk(str + pos, BIGINT_DECIMAL_DIGITS);
+
+            bigint_limb_t carry = bigint_mpn_mul_1(rp, rp, size, BIGINT_DECIMAL_BASE);
+            carry += bigint_mpn_add_1(rp, rp, size, chunk);
+            if (carry != 0) {
+                rp[size++] = carry;
+            }
+        }
+        *rn = bigint_mpn_normalize(rp, size);
+
+        return true;
+    }
+
+    // x = high * chunk^(2^level) + low, where low takes the last chunk_digits * 2^level digits
+    const size_t low_len = (size_t)BIGINT_DECIMAL_DIGITS << level;
+    const size_t high_len = len - low_len;
+    const size_t high_cap = (high_len / BIGINT_DECIMAL_DIGITS) + 3;
+    const size_t low_cap = (low_len / BIGINT_DECIMAL_DIGITS) + 3;
+
+    bigint_limb_t *hp = malloc((high_cap + low_cap) * sizeof(bigint_limb_t));
+    if (hp == NULL) {
+        return false;
+    }
+    bigint_limb_t *lp = hp + high_cap;
+    size_t hn, ln;
+
+    bool ok = bigint_radix_parse(hp, &hn, str, high_len, powers) &&
+              bigint_radix_parse(lp, &ln, str + high_len, low_len, powers);
+
+    if (ok && hn == 0) {
+        memcpy(rp, lp, ln * sizeof(bigint_limb_t));
+        *rn = ln;
+    } else if (ok) {
+        // low < chunk^(2^level), so the sum fits the product span
+        const size_t size = hn + powers->sizes[level];
+        ok = bigint_mpn_mul(rp, hp, hn, powers->limbs[level], powers->sizes[level]);
+        if (ok) {
+            bigint_mpn_add(rp, rp, size, lp, ln);
+            *rn = bigint_mpn_normalize(rp, size);
+        }
+    }
+    free(hp);
+
+    return ok;
+}
+
+/**
+ * bigint_from_int
+ *  @value: an integer value
+ * 
+ *  Takes an integer and convert it to a big integer
+ * 
+ *  Returns a bigint_result_t data type containing a new big integer
+ */
+bigint_result_t bigint_from_int(long long value) {
+    // Any long long fits the inline limb
+    return bigint_from_small(value);
+}
+
+/**
+ * bigint_from_string
+ *  @string_num: an array of chars representing a number
+ * 
+ *  Takes a string containing a number and convert it to big integer
+ * 
+ *  Returns a bigint_result_t data type containing a new big integer
+ */
+bigint_result_t bigint_from_string(const char *string_num) {
+    bigint_result_t result = {0};
+
+    if (string_num == NULL || *string_num == 0) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid string");
+
+        return result;
+    }
+
+    bool is_negative = false;
+    if (*string_num == '-') {
+        is_negative = true;
+        string_num++;
+    } else if (*string_num == '+') {
+        string_num++;
+    }
+
+    // Check whether the integer is valid or not
+    if (*string_num == '\0') {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid integer");
+
+        return result;
+    }
+
+    // Check whether characters are digits
+    for (const char *p = string_num; *p; ++p) {
+        if (!IS_DIGIT((unsigned char)*p)) {
+            result.status = BIGINT_ERR_INVALID;
+            SET_MSG(result, "Invalid integer");
+
+            return result;
+        }
+    }
+
+    // Skip leading zeros
+    while (*string_num == '0' && *(string_num + 1) != '\0') {
+        string_num++;
+    }
+
+    const size_t number_len = strlen(string_num);
+
+    // Values up to 2^64 - 1, which has 20 digits, fit an inline number
+    if (number_len <= BIGINT_DECIMAL_DIGITS + 1) {
+        const size_t head = number_len < BIGINT_DECIMAL_DIGITS ? number_len : BIGINT_DECIMAL_DIGITS;
+        bigint_dlimb_t value = bigint_parse_chunk(string_num, head);
+        if (number_len > head) {
+            value = (value * 10) + (bigint_limb_t)(string_num[head] - '0');
+        }
+        if ((value >> BIGINT_LIMB_BITS) == 0) {
+            return bigint_from_small(bigint_signed_limb((bigint_limb_t)value, is_negative));
+        }
+    }
+
+    result = bigint_alloc((number_len / BIGINT_DECIMAL_DIGITS) + 3);
+    if (result.status != BIGINT_OK) {
+        return result;
+    }
+
+    bigint_t *number = result.value.number;
+    number->is_negative = is_negative;
+
+    const bigint_radix_t radix = bigint_radix(10);
+    bigint_powers_t powers;
+    size_t size = 0;
+
+    bool ok = bigint_powers_init(&powers, &radix, (number_len / BIGINT_DECIMAL_DIGITS) + 1);
+    if (ok) {
+        ok = bigint_radix_parse(bigint_limbs(number), &size, string_num, number_len, &powers);
+        bigint_powers_free(&powers);
+    }
+
+    if (!ok) {
+        bigint_destroy(number);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate scratch arrays for conversion");
+
+        return result;
+    }
+    bigint_trim_zeros(number);
+
+    SET_MSG(result, "Big integer successfully created");
+
+    return result;
+}
+
+/**
+ * bigint_to_string
+ *  @number: a valid non-null big number
+ * 
+ *  Converts a big integer to a C string
+ *
+ *  Returns a bigint_result_t data type
+ */
+bigint_result_t bigint_to_string(const bigint_t *number) {
+    return bigint_to_string_base(number, 10);
+}
+
+/**
+ * bigint_to_string_base
+ *  @number: a valid non-null big number
+ *  @base: the base of the digits, from 2 to 36
+ * 
+ *  Converts a big integer to a C string, digits beyond 9 are lowercase letters.
+ *  Power of two bases read the digits straight from the bits of the limbs,
+ *  the others use the recursive radix conversion
+ *
+ *  Returns a bigint_result_t data type
+ */
+bigint_result_t bigint_to_string_base(const bigint_t *number, unsigned base) {
+    bigint_result_t result = {0};
+
+    if (number == NULL || base < 2 || base > 36) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big integer or base");
+
+        return result;
+    }
+
+    const size_t size = bigint_mpn_normalize(bigint_limbs(number), bigint_size(number));
+    const bigint_limb_t *limbs = bigint_limbs(number);
+    const bigint_radix_t radix = bigint_radix(base);
+    const bool power_of_two = (base & (base - 1)) == 0;
+
+    // Upper bound of the digits, a limb holds less than chunk_digits + 1 of them
+    const size_t width = size == 0 ? 1 : size * (radix.chunk_digits + 1);
+    char *str = malloc(width + 2); // +2 for sign and terminator
+    if (str == NULL) {
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for string");
+
+        return result;
+    }
+
+    char *digits = str + 1;
+    if (size == 0) {
+        digits[0] = '0';
+    } else if (power_of_two) {
+        const unsigned bits = (unsigned)__builtin_ctz(base);
+
+        for (size_t idx = 0, pos = 0; idx < width; idx++, pos += bits) {
+            const size_t limb = pos / BIGINT_LIMB_BITS;
+            const unsigned offset = (unsigned)(pos % BIGINT_LIMB_BITS);
+            bigint_limb_t digit = 0;
+
+            if (limb < size) {
+                digit = limbs[limb] >> offset;
+                if (offset + bits > BIGINT_LIMB_BITS && limb + 1 < size) {
+                    digit |= limbs[limb + 1] << (BIGINT_LIMB_BITS - offset);
+                }
+            }
+            digits[width - 1 - idx] = bigint_digit_chars[digit & (base - 1)];
+        }
+    } else {
+        bigint_powers_t powers;
+        bool ok = bigint_powers_init(&powers, &radix, size);
+
+        if (ok) {
+            // The top level is the longest power with at most half the limbs of the number
+            size_t level = powers.levels - 1;
+            while (level > 0 && 2 * powers.sizes[level] > size + 1) {
+                level--;
+            }
+
+            // The copy of the number is followed by the remainder span of each level
+            size_t scratch = size;
+            for (size_t idx = 0; idx <= level; idx++) {
+                scratch += powers.sizes[idx];
+            }
+
+            bigint_limb_t *copy = malloc(scratch * sizeof(bigint_limb_t));
+            if (copy != NULL) {
+                memcpy(copy, limbs, size * sizeof(bigint_limb_t));
+            }
+            ok = copy != NULL && bigint_powers_invert(&powers) &&
+                 bigint_radix_format(digits, width, copy, size, level, copy + size, &powers, &radix);
+            free(copy);
+            bigint_powers_free(&powers);
+        }
+
+        if (!ok) {
+            free(str);
+            result.status = BIGINT_ERR_ALLOCATE;
+            SET_MSG(result, "Cannot allocate scratch arrays for conversion");
+
+            return result;
+        }
+    }
+
+    // Drop the leading zeros of the padded digits, then prepend the sign
+    size_t skip = 0;
+    while (skip + 1 < width && digits[skip] == '0') {
+        skip++;
+    }
+
+    char *ptr = str;
+    if (number->is_negative && size > 0) {
+        *ptr++ = '-';
+    }
+    memmove(ptr, digits + skip, width - skip);
+    ptr[width - skip] = '\0';
+
+    result.value.string_num = str;
+    result.status = BIGINT_OK;
+    SET_MSG(result, "Big integer successfully converted");
+
+    return result;
+}
+
+/**
+ * bigint_clone
+ *  @number: a valid non-null big integer
+ *  
+ *  Clones a big integer
+ * 
+ *  Returns a bigint_result_t data type containing the new big integer
+ */
+bigint_result_t bigint_clone(const bigint_t *number) {
+    bigint_result_t result = {0};
+
+    if (number == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big integer");
+
+        return result;
+    }
+
+    const size_t size = bigint_size(number);
+
+    result = bigint_alloc(size);
+    if (result.status != BIGINT_OK) {
+        return result;
+    }
+
+    bigint_t *cloned = result.value.number;
+    memcpy(bigint_limbs(cloned), bigint_limbs(number), size * sizeof(bigint_limb_t));
+    cloned->is_negative = number->is_negative;
+
+    SET_MSG(result, "Big integer successfully cloned");
+
+    return result;
+}
+
+/**
+ * bigint_compare
+ *  @x: a valid non-null big integer
+ *  @y: a valid non-null big integer
+ * 
+ *  Compares two big integers
+ *  if x < y => -1
+ *  if x == y => 0
+ *  if x > y => 1
+ * 
+ *  Returns a bigint_result_t data type
+ */
+bigint_result_t bigint_compare(const bigint_t *x, const bigint_t *y) {
+    bigint_result_t result = {0};
+
+    if (x->is_negative != y->is_negative) {
+        result.value.compare_status = x->is_negative ? -1 : 1;
+        result.status = BIGINT_OK;
+        SET_MSG(result, "Big integer comparison was successful");
+
+        return result;
+    }
+    
+    const int8_t abs_cmp = bigint_compare_abs(x, y);
+
+    result.value.compare_status = x->is_negative ? -abs_cmp : abs_cmp;
+    result.status = BIGINT_OK;
+    SET_MSG(result, "Big integer comparison was successful");
+
+    return result;
+}
+
+/**
+ * bigint_add
+ *  @x: a non-null big integer
+ *  @y: a non-null big integer
+ * 
+ *  Adds two big integers together
+ * 
+ *  Returns a bigint_result_t data type 
+ */
+bigint_result_t bigint_add(const bigint_t *x, const bigint_t *y) {
+    bigint_result_t result = {0};
+
+    if (x == NULL || y == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big integers");
+
+        return result;
+    }
+
+    // Single limb operands: |x + y| < 2^65 cannot overflow the signed double limb
+    if (bigint_size(x) == 1 && bigint_size(y) == 1) {
+        const bigint_sdlimb_t sum = bigint_signed_limb(bigint_limbs(x)[0], x->is_negative) +
+                                    bigint_signed_limb(bigint_limbs(y)[0], y->is_negative);
+        if (bigint_small_fits(sum)) {
+            result = bigint_from_small(sum);
+            if (result.status == BIGINT_OK) {
+                SET_MSG(result, "Big integers successfully added");
+            }
+
+            return result;
+        }
+    }
+
+    // Same sign: add absolute values
+    if (x->is_negative == y->is_negative) {
+        bigint_result_t sum_res = bigint_add_abs(x, y);
+        if (sum_res.status != BIGINT_OK) {
+            return sum_res;
+        }
+
+        bigint_t *sum = sum_res.value.number;
+        if (sum) {
+            sum->is_negative = x->is_negative;
+        }
+
+        result.value.number = sum;
+        result.status = BIGINT_OK;
+        SET_MSG(result, "Big integers successfully added");
+
+        return result;
+    }
+
+    // Different signs: subtract smaller from larger
+    const int8_t cmp = bigint_compare_abs(x, y);
+    if (cmp == 0) {
+        return bigint_from_int(0);
+    } else if (cmp > 0) {
+        bigint_result_t sub_res = bigint_sub_abs(x, y);
+        if (sub_res.status != BIGINT_OK) {
+            return sub_res;
+        }
+
+        bigint_t *sub = sub_res.value.number;
+        if (sub) {
+            sub->is_negative = x->is_negative;
+        }
+
+        result.value.number = sub;
+        result.status = BIGINT_OK;
+        SET_MSG(result, "Big integers successfully added");
+    } else {
+        bigint_result_t sub_res = bigint_sub_abs(y, x);
+        if (sub_res.status != BIGINT_OK) {
+            return sub_res;
+        }
+        
+        bigint_t *sub = sub_res.value.number;
+        if (sub) {
+            sub->is_negative = y->is_negative;
+        }
+
+        result.value.number = sub;
+        result.status = BIGINT_OK;
+        SET_MSG(result, "Big integers successfully added");
+    }
+
+    return result;
+}
+
+/**
+ * bigint_sub
+ *  @x: a non-null big integer
+ *  @y: a non-null big integer
+ * 
+ *  Subtracts two big integers together
+ * 
+ *  Returns a bigint_result_t data type 
+ */
+bigint_result_t bigint_sub(const bigint_t *x, const bigint_t *y) {
+    bigint_result_t result = {0};
+
+    if (x == NULL || y == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big integers");
+
+        return result;
+    }
+
+    /* To subtract two big integers we can consider
+     * the following equivalence:
+     * x - y = x + (-y) 
+     * where -y is a shallow copy of y sharing its limbs
+     */
+    bigint_t neg_y = *y;
+    neg_y.is_negative = !neg_y.is_negative;
+
+    result = bigint_add(x, &neg_y);
+    if (result.status == BIGINT_OK) {
+        SET_MSG(result, "Big integers successfully subtracted");
+    }
+
+    return result;
+}
+
+/**
+ * bigint_prod
+ *  @x: a non-null big integer
+ *  @y: a non-null big integer
+ * 
+ *  Perform a multiplication between @a and @b
+ *  using Karatsuba's algorithm
+ * 
+ *  Returns a bigint_result_t data type
+ */
+bigint_result_t bigint_prod(const bigint_t *x, const bigint_t *y) {
+    bigint_result_t result = {0};
+
+    if (x == NULL || y == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big integers");
+
+        return result;
+    }
+
+    // Single limb operands whose product fits a limb are multiplied natively
+    if (bigint_size(x) == 1 && bigint_size(y) == 1) {
+        const bigint_dlimb_t product = (bigint_dlimb_t)bigint_limbs(x)[0] * bigint_limbs(y)[0];
+        if ((product >> BIGINT_LIMB_BITS) == 0) {
+            result = bigint_from_small(bigint_signed_limb((bigint_limb_t)product, x->is_negative != y->is_negative));
+            if (result.status == BIGINT_OK) {
+                SET_MSG(result, "Product between big integers was successful");
+            }
+
+            return result;
+        }
+    }
+
+    bigint_result_t product_res = bigint_mul_abs(x, y);
+    if (product_res.status != BIGINT_OK) {
+        return product_res;
+    }
+
+    bigint_t *product = product_res.value.number;
+    product->is_negative = (x->is_negative != y->is_negative);
+    bigint_trim_zeros(product);
+
+    result.value.number = product;
+    result.status = BIGINT_OK;
+    SET_MSG(result, "Product between big integers was successful");
+
+    return result;
+}
+
+/**
+ * bigint_divmod
+ *  @x: a valid non-null big integer
+ *  @y: a valid non-null big integer
+ * 
+ *  Computes truncated division with remainder. That is:
+ *   quotient = trunc(x / y)       sign = sign(x) XOR sign(y)
+ *   remainder = x - y * quotient  sign = sign(x)
+ *  
+ *  Returns a bigint_result_t data type
+ */
+bigint_result_t bigint_divmod(const bigint_t *x, const bigint_t *y) {
+    bigint_result_t result = {0};
+    bigint_result_t tmp_res = {0};
+
+    bigint_t *quotient = NULL;
+    bigint_t *remainder = NULL;
+
+    if (x == NULL || y == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big numbers");
+
+        return result;
+    }
+
+    if (bigint_is_zero(y)) {
+        result.status = BIGINT_ERR_DIV_BY_ZERO;
+        SET_MSG(result, "Cannot divide by zero");
+
+        return result;
+    }
+
+    // Single limb operands are divided natively
+    if (bigint_size(x) == 1 && bigint_size(y) == 1) {
+        const bigint_limb_t x_limb = bigint_limbs(x)[0];
+        const bigint_limb_t y_limb = bigint_limbs(y)[0];
+
+        tmp_res = bigint_from_small(bigint_signed_limb(x_limb / y_limb, x->is_negative != y->is_negative));
+        if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
+        quotient = tmp_res.value.number;
+
+        tmp_res = bigint_from_small(bigint_signed_limb(x_limb % y_limb, x->is_negative));
+        if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
+        remainder = tmp_res.value.number;
+
+        result.value.division.quotient = quotient;
+        result.value.division.remainder = remainder;
+
+        result.status = BIGINT_OK;
+        SET_MSG(result, "Division between big integers was successful");
+
+        return result;
+    }
+
+    // |x| < |y|: quotient is 0, remainder is x
+    if (bigint_compare_abs(x, y) < 0) {
+        tmp_res = bigint_from_int(0);
+        if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
+        quotient = tmp_res.value.number;
+
+        tmp_res = bigint_clone(x);
+        if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
+        remainder = tmp_res.value.number;
+
+        result.value.division.quotient = quotient;
+        result.value.division.remainder = remainder;
 
-        vector_result_t push_res = vector_push(quotient->digits, &q_idx);
-        if (push_res.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
+        result.status = BIGINT_OK;
+        SET_MSG(result, "Division between big integers was successful");
 
-            goto cleanup;
-        }
+        return result;
     }
 
-    REMOVE(q);
-
-    bigint_result_t trim_res = bigint_trim_zeros(quotient);
-    if (trim_res.status != BIGINT_OK) { result = trim_res; goto cleanup; }
+    result = bigint_div(x, y);
+    if (result.status != BIGINT_OK) {
+        return result;
+    }
+    quotient = result.value.division.quotient;
+    remainder = result.value.division.remainder;
 
-    result.value.number = quotient;
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Division between big integers was successful");
+    // Set quotient and remainder signs accordingly
+    quotient->is_negative = !bigint_is_zero(quotient) && (x->is_negative != y->is_negative);
+    remainder->is_negative = !bigint_is_zero(remainder) && x->is_negative;
 
     return result;
 
 cleanup:
-    free(u); free(v); free(q);
     if (quotient) { bigint_destroy(quotient); }
+    if (remainder) { bigint_destroy(remainder); }
 
     return result;
 }
 
-
 /**
- * bigint_from_int
- *  @value: an integer value
+ * bigint_mod
+ *  @x: a valid non-null big integer
+ *  @y: a valid non-null big integer
  * 
- *  Takes an integer and convert it to a big integer
+ *  Computes @x mod @y
  * 
- *  Returns a bigint_result_t data type containing a new big integer
+ *  Returns a bigint_result_t data type
  */
-bigint_result_t bigint_from_int(long long value) {
+bigint_result_t bigint_mod(const bigint_t *x, const bigint_t *y) {
     bigint_result_t result = {0};
 
-    bigint_t *number = malloc(sizeof(bigint_t));
-    if (number == NULL) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for big integer");
-
-        return result;
-    }
-
-    vector_result_t vec_res = vector_new(4, sizeof(int));
-    if (vec_res.status != VECTOR_OK) {
-        free(number);
-        result.status = BIGINT_ERR_ALLOCATE;
-        COPY_MSG(result, vec_res.message);
+    if (x == NULL || y == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big numbers");
 
         return result;
     }
 
-    number->digits = vec_res.value.vector;
-    number->is_negative = (value < 0);
-
-    // Discard the sign since we don't need it anymore
-    unsigned long long abs_val = value < 0 ? -(unsigned long long)value : (unsigned long long)value;
-
-    if(abs_val == 0) {
-        int zero = 0;
-        vector_result_t push_res = vector_push(number->digits, &zero);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy(number->digits);
-            free(number);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
+    bigint_result_t div_res = bigint_divmod(x, y);
+    if (div_res.status != BIGINT_OK) { return div_res; }
 
-            return result;
-        }
-    } else {
-        while (abs_val != 0) {
-            int digit = abs_val % BIGINT_BASE;
-            vector_result_t push_res = vector_push(number->digits, &digit);
-            if (push_res.status != VECTOR_OK) {
-                vector_destroy(number->digits);
-                free(number);
-                result.status = BIGINT_ERR_INVALID;
-                COPY_MSG(result, push_res.message);
-
-                return result;
-            }
+    bigint_t* const quotient = div_res.value.division.quotient;
+    bigint_t* const remainder = div_res.value.division.remainder;
 
-            abs_val /= BIGINT_BASE;
-        }
-    }
+    // Discard quotient
+    bigint_destroy(quotient);
 
+    result.value.number = remainder;
     result.status = BIGINT_OK;
-    SET_MSG(result, "Big integer successfully created");
-    result.value.number = number;
+    SET_MSG(result, "Division between big integers was successful");
 
     return result;
 }
 
 /**
- * bigint_from_string
- *  @string_num: an array of chars representing a number
- * 
- *  Takes a string containing a number and convert it to big integer
- * 
- *  Returns a bigint_result_t data type containing a new big integer
+ * bigint_add_inplace
+ *  @dst: a valid non-null big integer, receives the sum
+ *  @src: a valid non-null big integer, it may be @dst
+ *
+ *  Adds @src to @dst in place, reusing the limbs of @dst
+ *  unless the sum needs more of them
+ *
+ *  Returns a bigint_result_t data type containing @dst
  */
-bigint_result_t bigint_from_string(const char *string_num) {
+bigint_result_t bigint_add_inplace(bigint_t *dst, const bigint_t *src) {
     bigint_result_t result = {0};
 
-    if (string_num == NULL || *string_num == 0) {
+    if (dst == NULL || src == NULL) {
         result.status = BIGINT_ERR_INVALID;
-        SET_MSG(result, "Invalid string");
+        SET_MSG(result, "Invalid big integers");
 
         return result;
     }
 
-    bigint_t *number = malloc(sizeof(bigint_t));
-    if (number == NULL) {
+    if (!bigint_add_signed(dst, src, src->is_negative)) {
         result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for big integer");
+        SET_MSG(result, "Failed to grow the big integer");
 
         return result;
     }
 
-    vector_result_t vec_res = vector_new(4, sizeof(int));
-    if (vec_res.status != VECTOR_OK) {
-        free(number);        
-        result.status = BIGINT_ERR_ALLOCATE;
-        COPY_MSG(result, vec_res.message);
+    result.value.number = dst;
+    result.status = BIGINT_OK;
+    SET_MSG(result, "Big integers successfully added");
 
-        return result;
-    }
+    return result;
+}
 
-    number->digits = vec_res.value.vector;
+/**
+ * bigint_sub_from
+ *  @dst: a valid non-null big integer, receives the difference
+ *  @src: a valid non-null big integer, it may be @dst
+ *
+ *  Subtracts @src from @dst in place, reusing the limbs of @dst
+ *  unless the difference needs more of them
+ *
+ *  Returns a bigint_result_t data type containing @dst
+ */
+bigint_result_t bigint_sub_from(bigint_t *dst, const bigint_t *src) {
+    bigint_result_t result = {0};
 
-    number->is_negative = false;
-    if (*string_num == '-') {
-        number->is_negative = true;
-        string_num++;
-    } else if (*string_num == '+') {
-        string_num++;
+    if (dst == NULL || src == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big integers");
+
+        return result;
     }
 
-    // Check whether the integer is valid or not
-    if (*string_num == '\0') {
-        vector_destroy(number->digits);
-        free(number);
+    if (!bigint_add_signed(dst, src, !src->is_negative)) {
         result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Invalid integer");
+        SET_MSG(result, "Failed to grow the big integer");
 
         return result;
     }
 
-    // Check whether characters are digits
-    for (const char *p = string_num; *p; ++p) {
-        if (!IS_DIGIT((unsigned char)*p)) {
-            vector_destroy(number->digits);
-            free(number);
-            result.status = BIGINT_ERR_INVALID;
-            SET_MSG(result, "Invalid integer");
+    result.value.number = dst;
+    result.status = BIGINT_OK;
+    SET_MSG(result, "Big integers successfully subtracted");
 
-            return result;
-        }
-    }
+    return result;
+}
 
-    // Skip leading zeros
-    while (*string_num == '0' && *(string_num + 1) != '\0') {
-        string_num++;
+/**
+ * bigint_mul_into
+ *  @dst: a valid non-null big integer, receives the product
+ *  @x: a valid non-null big integer
+ *  @y: a valid non-null big integer
+ *
+ *  Multiplies @x by @y and stores the product in @dst, reusing its limbs
+ *  unless the product needs more of them. When @dst is one of the operands
+ *  the product is computed aside and then replaces the limbs of @dst
+ *
+ *  Returns a bigint_result_t data type containing @dst
+ */
+bigint_result_t bigint_mul_into(bigint_t *dst, const bigint_t *x, const bigint_t *y) {
+    bigint_result_t result = {0};
+
+    if (dst == NULL || x == NULL || y == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big integers");
+
+        return result;
     }
 
-    const size_t number_len = strlen(string_num);
+    const bool negative = (x->is_negative != y->is_negative);
+    bool ok;
+
+    // Single limb operands whose product fits a limb are multiplied natively
+    if (bigint_size(x) == 1 && bigint_size(y) == 1) {
+        const bigint_dlimb_t product = (bigint_dlimb_t)bigint_limbs(x)[0] * bigint_limbs(y)[0];
+        if ((product >> BIGINT_LIMB_BITS) == 0) {
+            bigint_set_small(dst, bigint_signed_limb((bigint_limb_t)product, negative));
 
-    // Process digits from right to left by chunks of the representation base
-    for (int i = number_len; i > 0; i -= BIGINT_BASE_DIGITS) {
-        const int start = (i - BIGINT_BASE_DIGITS > 0) ? i - BIGINT_BASE_DIGITS : 0;
-        const int chunk_len = (i - start);
+            result.value.number = dst;
+            result.status = BIGINT_OK;
+            SET_MSG(result, "Product between big integers was successful");
 
-        int digit = 0;
-        for (int j = 0; j < chunk_len; j++) {
-            digit = digit * 10 + (string_num[start + j] - '0');
+            return result;
         }
+    }
 
-        vector_result_t push_res = vector_push(number->digits, &digit);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy(number->digits);
-            free(number);
-            result.status = BIGINT_ERR_ALLOCATE;
-            COPY_MSG(result, push_res.message);
+    if (dst == x || dst == y) {
+        bigint_result_t product_res = bigint_mul_abs(x, y);
+        ok = product_res.status == BIGINT_OK;
+        if (ok) {
+            bigint_swap(dst, product_res.value.number);
+            bigint_destroy(product_res.value.number);
+        }
+    } else {
+        const size_t x_size = bigint_size(x);
+        const size_t y_size = bigint_size(y);
 
-            return result;
+        ok = bigint_reserve(dst, x_size + y_size) &&
+             bigint_mpn_mul(bigint_limbs(dst), bigint_limbs(x), x_size, bigint_limbs(y), y_size);
+        if (ok) {
+            bigint_set_size(dst, x_size + y_size);
         }
     }
 
-    bigint_result_t trim_res = bigint_trim_zeros(number);
-    if (trim_res.status != BIGINT_OK) {
-        vector_destroy(number->digits);
-        free(number);
+    if (!ok) {
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate memory for multiplication");
 
-        return trim_res;
+        return result;
     }
 
-    result.value.number = number;
+    dst->is_negative = negative;
+    bigint_trim_zeros(dst);
+
+    result.value.number = dst;
     result.status = BIGINT_OK;
-    SET_MSG(result, "Big integer successfully created");
+    SET_MSG(result, "Product between big integers was successful");
 
     return result;
 }
 
 /**
- * bigint_to_string
- *  @number: a valid non-null big number
- * 
- *  Converts a big integer to a C string
+ * bigint_addmul_small
+ *  @dst: a valid non-null big integer, receives the result
+ *  @x: a valid non-null big integer, it may be @dst
+ *  @factor: a small non-negative factor
  *
- *  Returns a bigint_result_t data type
+ *  Adds @x * @factor to @dst in place in a single pass over the limbs of @x,
+ *  without computing the product aside
+ *
+ *  Returns a bigint_result_t data type containing @dst
  */
-bigint_result_t bigint_to_string(const bigint_t *number) {
+bigint_result_t bigint_addmul_small(bigint_t *dst, const bigint_t *x, uint32_t factor) {
     bigint_result_t result = {0};
 
-    if (number == NULL) {
+    if (dst == NULL || x == NULL) {
         result.status = BIGINT_ERR_INVALID;
-        SET_MSG(result, "Invalid big integer");
+        SET_MSG(result, "Invalid big integers");
 
         return result;
     }
 
-    const size_t size = vector_size(number->digits);
-    const size_t max_len = (size * BIGINT_BASE_DIGITS) + 2; // +2 for sign and terminator
-    
-    char *str = malloc(max_len);
-    if (str == NULL) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for string");
+    // Single limb operands: |dst + x * factor| < 2^97 cannot overflow the signed double limb
+    if (bigint_size(dst) == 1 && bigint_size(x) == 1) {
+        const bigint_sdlimb_t value = bigint_signed_limb(bigint_limbs(dst)[0], dst->is_negative) +
+                                      bigint_signed_limb(bigint_limbs(x)[0], x->is_negative) * factor;
+        if (bigint_small_fits(value)) {
+            bigint_set_small(dst, value);
 
-        return result;
-    }
+            result.value.number = dst;
+            result.status = BIGINT_OK;
+            SET_MSG(result, "Big integers successfully multiplied and added");
 
-    char *ptr = str;
-    if (number->is_negative) {
-        *ptr++ = '-';
+            return result;
+        }
     }
 
-    // Print MSB without leading zeros
-    vector_result_t msb_res = vector_get(number->digits, size - 1);
-    if (msb_res.status != VECTOR_OK) {
-        result.status = BIGINT_ERR_INVALID;
-        COPY_MSG(result, msb_res.message);
+    const size_t dn = bigint_mpn_normalize(bigint_limbs(dst), bigint_size(dst));
+    const size_t xn = bigint_mpn_normalize(bigint_limbs(x), bigint_size(x));
+    const size_t n = dn > xn ? dn : xn;
+
+    // |x| * factor < 2^32 * B^n, so n + 1 limbs hold both the sum and the difference
+    if (!bigint_reserve(dst, n + 1)) {
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to grow the big integer");
 
         return result;
     }
+    bigint_limb_t *dp = bigint_limbs(dst);
+    const bigint_limb_t *xp = bigint_limbs(x);
+    memset(dp + dn, 0, (n + 1 - dn) * sizeof(bigint_limb_t));
+
+    if (dst->is_negative == x->is_negative || dn == 0) {
+        const bigint_limb_t carry = bigint_mpn_addmul_1(dp, xp, xn, factor);
+        bigint_mpn_add_1(dp + xn, dp + xn, n + 1 - xn, carry);
+        dst->is_negative = x->is_negative;
+    } else {
+        const bigint_limb_t borrow = bigint_mpn_submul_1(dp, xp, xn, factor);
+
+        // A borrow out of the top limb means |x| * factor > |dst|: negate the two's complement
+        if (bigint_mpn_sub(dp + xn, dp + xn, n + 1 - xn, &borrow, 1) != 0) {
+            for (size_t idx = 0; idx <= n; idx++) {
+                dp[idx] = ~dp[idx];
+            }
+            bigint_mpn_add_1(dp, dp, n + 1, 1);
+            dst->is_negative = !dst->is_negative;
+        }
+    }
+    bigint_set_size(dst, n + 1);
+    bigint_trim_zeros(dst);
 
-    int *msb = (int*)msb_res.value.element;
-    ptr += sprintf(ptr, "%d", *msb);
+    result.value.number = dst;
+    result.status = BIGINT_OK;
+    SET_MSG(result, "Big integers successfully multiplied and added");
 
-    // Print remaining digits with leading zeros
-    for (int idx = size - 2; idx >= 0; idx--) {
-        vector_result_t digit_res = vector_get(number->digits, idx);
-        if (digit_res.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, digit_res.message);
+    return result;
+}
 
-            return result;
-        }
+/**
+ * bigint_swap
+ *  @x: a valid non-null big integer
+ *  @y: a valid non-null big integer
+ *
+ *  Exchanges the values of @x and @y in constant time, without copying their limbs
+ *
+ *  Returns a bigint_result_t data type
+ */
+bigint_result_t bigint_swap(bigint_t *x, bigint_t *y) {
+    bigint_result_t result = {0};
+
+    if (x == NULL || y == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid big integers");
 
-        int *digit = (int*)digit_res.value.element;
-        ptr += sprintf(ptr, "%09d", *digit);
+        return result;
     }
 
-    result.value.string_num = str;
+    const bigint_t tmp = *x;
+    *x = *y;
+    *y = tmp;
+
     result.status = BIGINT_OK;
-    SET_MSG(result, "Big integer successfully converted");
+    SET_MSG(result, "Big integers successfully swapped");
 
     return result;
 }
 
 /**
- * bigint_clone
- *  @number: a valid non-null big integer
- *  
- *  Clones a big integer
- * 
+ * bigint_pow
+ *  @base: a valid non-null big integer
+ *  @exponent: a non-negative integer
+ *
+ *  Raises @base to the power of @exponent by squaring and multiplying from
+ *  the most significant bit of @exponent. The intermediate powers are computed
+ *  in two numbers that swap roles, so their limbs are reused across the steps
+ *
  *  Returns a bigint_result_t data type containing the new big integer
  */
-bigint_result_t bigint_clone(const bigint_t *number) {
+bigint_result_t bigint_pow(const bigint_t *base, uint64_t exponent) {
     bigint_result_t result = {0};
 
-    if (number == NULL) {
+    if (base == NULL) {
         result.status = BIGINT_ERR_INVALID;
         SET_MSG(result, "Invalid big integer");
 
         return result;
     }
 
-    bigint_t *cloned = malloc(sizeof(bigint_t));
-    if (cloned == NULL) {
-        result.status = BIGINT_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for big integer");
-
-        return result;
+    // x^0 = 1, 0^0 included
+    if (exponent == 0) {
+        return bigint_from_int(1);
     }
 
-    vector_result_t vec_res = vector_new(vector_size(number->digits), sizeof(int));
-    if (vec_res.status != VECTOR_OK) {
-        free(cloned);
-        result.status = BIGINT_ERR_ALLOCATE;
-        COPY_MSG(result, vec_res.message);
-
+    result = bigint_clone(base);
+    if (result.status != BIGINT_OK) {
         return result;
     }
+    bigint_t *power = result.value.number;
 
-    cloned->digits = vec_res.value.vector;
-    cloned->is_negative = number->is_negative;
-
-    // Copy digits
-    const size_t sz = vector_size(number->digits);
-    for (size_t idx = 0; idx < sz; idx++) {
-        vector_result_t get_res = vector_get(number->digits, idx);
-        if (get_res.status != VECTOR_OK) {
-            vector_destroy(cloned->digits);
-            free(cloned);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, get_res.message);
-
-            return result;
-        }
-
-        int *digit = (int*)get_res.value.element;
-        
-        vector_result_t push_res = vector_push(cloned->digits, digit);
-        if (push_res.status != VECTOR_OK) {
-            vector_destroy(cloned->digits);
-            free(cloned);
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, push_res.message);
+    bigint_result_t tmp_res = bigint_from_int(0);
+    if (tmp_res.status != BIGINT_OK) {
+        bigint_destroy(power);
 
-            return result;
-        }
+        return tmp_res;
     }
+    bigint_t *tmp = tmp_res.value.number;
 
-    result.value.number = cloned;
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Big integer successfully cloned");
-
-    return result;
-}
-
-/**
- * bigint_compare
- *  @x: a valid non-null big integer
- *  @y: a valid non-null big integer
- * 
- *  Compares two big integers
- *  if x < y => -1
- *  if x == y => 0
- *  if x > y => 1
- * 
- *  Returns a bigint_result_t data type
- */
-bigint_result_t bigint_compare(const bigint_t *x, const bigint_t *y) {
-    bigint_result_t result = {0};
+    bool ok = true;
+    for (int bit = 62 - __builtin_clzll(exponent); ok && bit >= 0; bit--) {
+        ok = bigint_mul_into(tmp, power, power).status == BIGINT_OK;
+        bigint_swap(tmp, power);
 
-    if (x->is_negative != y->is_negative) {
-        result.value.compare_status = x->is_negative ? -1 : 1;
-        result.status = BIGINT_OK;
-        SET_MSG(result, "Big integer comparison was successful");
+        if (ok && ((exponent >> bit) & 1)) {
+            ok = bigint_mul_into(tmp, power, base).status == BIGINT_OK;
+            bigint_swap(tmp, power);
+        }
+    }
+    bigint_destroy(tmp);
+
+    if (!ok) {
+        bigint_destroy(power);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate memory for exponentiation");
 
         return result;
     }
-    
-    bigint_result_t cmp_res = bigint_compare_abs(x, y);
-    if (cmp_res.status != BIGINT_OK) {
-        return cmp_res;
-    }
-    
-    const int8_t abs_cmp = cmp_res.value.compare_status;
 
-    result.value.compare_status = x->is_negative ? -abs_cmp : abs_cmp;
+    result.value.number = power;
     result.status = BIGINT_OK;
-    SET_MSG(result, "Big integer comparison was successful");
+    SET_MSG(result, "Exponentiation was successful");
 
     return result;
 }
 
 /**
- * bigint_add
- *  @x: a non-null big integer
- *  @y: a non-null big integer
- * 
- *  Adds two big integers together
- * 
- *  Returns a bigint_result_t data type 
+ * bigint_modpow
+ *  @base: a valid non-null big integer
+ *  @exponent: a valid non-null, non-negative big integer
+ *  @modulus: a valid non-null, positive big integer
+ *
+ *  Computes @base^@exponent mod @modulus, between 0 and @modulus - 1, with the
+ *  sliding window method. Odd moduli are reduced with Montgomery's method, even
+ *  ones with Barrett's. The reduction constants are computed at each call, use
+ *  a context to compute them once for many exponentiations with the same modulus
+ *
+ *  Returns a bigint_result_t data type containing the new big integer
  */
-bigint_result_t bigint_add(const bigint_t *x, const bigint_t *y) {
+bigint_result_t bigint_modpow(const bigint_t *base, const bigint_t *exponent, const bigint_t *modulus) {
     bigint_result_t result = {0};
 
-    if (x == NULL || y == NULL) {
+    if (base == NULL || exponent == NULL || modulus == NULL) {
         result.status = BIGINT_ERR_INVALID;
         SET_MSG(result, "Invalid big integers");
 
         return result;
     }
 
-    // Same sign: add absolute values
-    if (x->is_negative == y->is_negative) {
-        bigint_result_t sum_res = bigint_add_abs(x, y);
-        if (sum_res.status != BIGINT_OK) {
-            return sum_res;
-        }
-
-        bigint_t *sum = sum_res.value.number;
-        if (sum) {
-            sum->is_negative = x->is_negative;
-        }
-
-        result.value.number = sum;
-        result.status = BIGINT_OK;
-        SET_MSG(result, "Big integers successfully added");
+    if (bigint_is_zero(modulus)) {
+        result.status = BIGINT_ERR_DIV_BY_ZERO;
+        SET_MSG(result, "Cannot reduce modulo zero");
 
         return result;
     }
 
-    // Different signs: subtract smaller from larger
-    bigint_result_t cmp_res = bigint_compare_abs(x, y);
-    if (cmp_res.status != BIGINT_OK) {
-        return cmp_res;
+    if (modulus->is_negative || exponent->is_negative) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Modulus and exponent must be non-negative");
+
+        return result;
     }
-    
-    const int8_t cmp = cmp_res.value.compare_status;
-    if (cmp == 0) {
-        return bigint_from_int(0);
-    } else if (cmp > 0) {
-        bigint_result_t sub_res = bigint_sub_abs(x, y);
-        if (sub_res.status != BIGINT_OK) {
-            return sub_res;
-        }
 
-        bigint_t *sub = sub_res.value.number;
-        if (sub) {
-            sub->is_negative = x->is_negative;
+    if (bigint_limbs(modulus)[0] & 1) {
+        bigint_result_t ctx_res = bigint_mont_ctx_new(modulus);
+        if (ctx_res.status != BIGINT_OK) {
+            return ctx_res;
         }
 
-        result.value.number = sub;
-        result.status = BIGINT_OK;
-        SET_MSG(result, "Big integers successfully added");
+        result = bigint_mont_modpow(ctx_res.value.mont_ctx, base, exponent, false);
+        bigint_mont_ctx_destroy(ctx_res.value.mont_ctx);
     } else {
-        bigint_result_t sub_res = bigint_sub_abs(y, x);
-        if (sub_res.status != BIGINT_OK) {
-            return sub_res;
-        }
-        
-        bigint_t *sub = sub_res.value.number;
-        if (sub) {
-            sub->is_negative = y->is_negative;
+        bigint_result_t ctx_res = bigint_barrett_ctx_new(modulus);
+        if (ctx_res.status != BIGINT_OK) {
+            return ctx_res;
         }
 
-        result.value.number = sub;
-        result.status = BIGINT_OK;
-        SET_MSG(result, "Big integers successfully added");
+        result = bigint_barrett_modpow(ctx_res.value.barrett_ctx, base, exponent);
+        bigint_barrett_ctx_destroy(ctx_res.value.barrett_ctx);
     }
 
     return result;
 }
 
 /**
- * bigint_sub
- *  @x: a non-null big integer
- *  @y: a non-null big integer
- * 
- *  Subtracts two big integers together
- * 
- *  Returns a bigint_result_t data type 
+ * bigint_mont_ctx_new
+ *  @modulus: a valid non-null, positive and odd big integer
+ *
+ *  Precomputes the constants of Montgomery's reduction modulo @modulus,
+ *  that is -@modulus^(-1) mod 2^64 and B^(2n) mod @modulus, where n is the
+ *  number of limbs of @modulus, so that several exponentiations can share them
+ *
+ *  Returns a bigint_result_t data type containing the new context
  */
-bigint_result_t bigint_sub(const bigint_t *x, const bigint_t *y) {
+bigint_result_t bigint_mont_ctx_new(const bigint_t *modulus) {
     bigint_result_t result = {0};
 
-    if (x == NULL || y == NULL) {
+    if (modulus == NULL || modulus->is_negative || (bigint_limbs(modulus)[0] & 1) == 0) {
         result.status = BIGINT_ERR_INVALID;
-        SET_MSG(result, "Invalid big integers");
+        SET_MSG(result, "Montgomery modulus must be positive and odd");
 
         return result;
     }
 
-    /* To subtract two big integers we can consider
-     * the following equivalence:
-     * x - y = x + (-y) 
-     */
-    bigint_result_t neg_y_res = bigint_clone(y);
-    if (neg_y_res.status != BIGINT_OK) {
-        return neg_y_res;
+    const size_t n = bigint_mpn_normalize(bigint_limbs(modulus), bigint_size(modulus));
+
+    bigint_mont_ctx_t *ctx = malloc(sizeof(bigint_mont_ctx_t));
+    bigint_limb_t *limbs = malloc(((2 * n) + (2 * n) + 1) * sizeof(bigint_limb_t));
+    if (ctx == NULL || limbs == NULL) {
+        free(ctx);
+        free(limbs);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for Montgomery context");
+
+        return result;
     }
-    
-    bigint_t *neg_y = neg_y_res.value.number;
-    neg_y->is_negative = !neg_y->is_negative;
 
-    bigint_result_t difference_res = bigint_add(x, neg_y);
-    if (difference_res.status != BIGINT_OK) {
-        bigint_destroy(neg_y);
+    ctx->modulus = limbs;
+    ctx->r2 = limbs + n;
+    ctx->size = n;
+    memcpy(ctx->modulus, bigint_limbs(modulus), n * sizeof(bigint_limb_t));
+    ctx->inverse = bigint_mont_inverse(ctx->modulus[0]);
+
+    // B^(2n), in the space following r2
+    bigint_limb_t *xp = limbs + (2 * n);
+    memset(xp, 0, 2 * n * sizeof(bigint_limb_t));
+    xp[2 * n] = 1;
 
-        return difference_res;
+    if (!bigint_mpn_mod(ctx->r2, xp, (2 * n) + 1, ctx->modulus, n, NULL)) {
+        bigint_mont_ctx_destroy(ctx);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate memory for Montgomery context");
+
+        return result;
     }
-    
-    bigint_destroy(neg_y);
-    bigint_t *difference = difference_res.value.number;
 
-    result.value.number = difference;
+    result.value.mont_ctx = ctx;
     result.status = BIGINT_OK;
-    SET_MSG(result, "Big integers successfully subtracted");
+    SET_MSG(result, "Montgomery context successfully created");
 
     return result;
 }
 
 /**
- * bigint_prod
- *  @x: a non-null big integer
- *  @y: a non-null big integer
- * 
- *  Perform a multiplication between @a and @b
- *  using Karatsuba's algorithm
- * 
- *  Returns a bigint_result_t data type
+ * bigint_mont_modpow
+ *  @ctx: a valid non-null Montgomery context
+ *  @base: a valid non-null big integer
+ *  @exponent: a valid non-null, non-negative big integer
+ *  @constant_time: whether the running time must not depend on the exponent
+ *
+ *  Computes @base^@exponent mod @ctx->modulus, between 0 and the modulus - 1,
+ *  with Montgomery's reduction. The sliding window method is used unless
+ *  @constant_time is set, in which case a fixed window method reads every
+ *  power of its table and the products use the quadratic algorithm only,
+ *  so that the running time and the memory accesses only depend on the
+ *  length of @exponent and of the modulus. The reduction of @base is not
+ *  protected
+ *
+ *  Returns a bigint_result_t data type containing the new big integer
  */
-bigint_result_t bigint_prod(const bigint_t *x, const bigint_t *y) {
+bigint_result_t bigint_mont_modpow(const bigint_mont_ctx_t *ctx, const bigint_t *base,
+                                   const bigint_t *exponent, bool constant_time) {
     bigint_result_t result = {0};
 
-    if (x == NULL || y == NULL) {
+    if (ctx == NULL || base == NULL || exponent == NULL || exponent->is_negative) {
         result.status = BIGINT_ERR_INVALID;
-        SET_MSG(result, "Invalid big integers");
+        SET_MSG(result, "Invalid modular exponentiation");
 
         return result;
     }
 
-    bigint_result_t product_res = bigint_karatsuba(x, y);
-    if (product_res.status != BIGINT_OK) {
-        return product_res;
-    }
+    bigint_modmul_t mm = { ctx, NULL, ctx->size, constant_time, NULL, NULL };
 
-    bigint_t *product = product_res.value.number;
-    product->is_negative = (x->is_negative != y->is_negative);
+    return bigint_powm(&mm, base, exponent, ctx->modulus, NULL);
+}
 
-    bigint_result_t trim_res = bigint_trim_zeros(product);
-    if (trim_res.status != BIGINT_OK) {
-        bigint_destroy(product);
+/**
+ * bigint_mont_ctx_destroy
+ *  @ctx: a valid non-null Montgomery context
+ *
+ *  Deletes the Montgomery context from the memory
+ *
+ *  Returns a bigint_result_t data type
+ */
+bigint_result_t bigint_mont_ctx_destroy(bigint_mont_ctx_t *ctx) {
+    bigint_result_t result = {0};
 
-        return trim_res;
+    if (ctx == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid Montgomery context");
+
+        return result;
     }
 
-    result.value.number = product;
+    free(ctx->modulus);
+    free(ctx);
+
     result.status = BIGINT_OK;
-    SET_MSG(result, "Product between big integers was successful");
+    SET_MSG(result, "Montgomery context successfully deleted");
 
     return result;
 }
 
 /**
- * bigint_divmod
- *  @x: a valid non-null big integer
- *  @y: a valid non-null big integer
- * 
- *  Computes truncated division with remainder. That is:
- *   quotient = trunc(x / y)       sign = sign(x) XOR sign(y)
- *   remainder = x - y * quotient  sign = sign(x)
- *  
- *  Returns a bigint_result_t data type
+ * bigint_barrett_ctx_new
+ *  @modulus: a valid non-null, positive big integer
+ *
+ *  Precomputes the constants of Barrett's reduction modulo @modulus, that is
+ *  @modulus shifted so that its top bit is set and the reciprocal of the
+ *  latter, so that several reductions can share them
+ *
+ *  Returns a bigint_result_t data type containing the new context
  */
-bigint_result_t bigint_divmod(const bigint_t *x, const bigint_t *y) {
+bigint_result_t bigint_barrett_ctx_new(const bigint_t *modulus) {
     bigint_result_t result = {0};
-    bigint_result_t tmp_res = {0};
-
-    bigint_t *quotient = NULL;
-    bigint_t *y_times_q = NULL;
-    bigint_t *remainder = NULL;
 
-    if (x == NULL || y == NULL) {
+    if (modulus == NULL || modulus->is_negative || bigint_is_zero(modulus)) {
         result.status = BIGINT_ERR_INVALID;
-        SET_MSG(result, "Invalid big numbers");
+        SET_MSG(result, "Barrett modulus must be positive");
 
         return result;
     }
 
-    const size_t y_size = vector_size(y->digits);
-    if (y_size == 0) {
-        result.status = BIGINT_ERR_DIV_BY_ZERO;
-        SET_MSG(result, "Cannot divide by zero");
+    const size_t n = bigint_mpn_normalize(bigint_limbs(modulus), bigint_size(modulus));
+
+    bigint_barrett_ctx_t *ctx = malloc(sizeof(bigint_barrett_ctx_t));
+    bigint_limb_t *limbs = malloc(3 * n * sizeof(bigint_limb_t));
+    if (ctx == NULL || limbs == NULL) {
+        free(ctx);
+        free(limbs);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for Barrett context");
 
         return result;
     }
 
-    if (y_size == 1) {
-        vector_result_t y_val_res = vector_get(y->digits, 0);
-        if (y_val_res.status != VECTOR_OK) {
-            result.status = BIGINT_ERR_INVALID;
-            COPY_MSG(result, y_val_res.message);
-
-            return result;
-        }
+    ctx->modulus = limbs;
+    ctx->normalized = limbs + n;
+    ctx->reciprocal = limbs + (2 * n);
+    ctx->size = n;
+    ctx->shift = (unsigned)__builtin_clzll(bigint_limbs(modulus)[n - 1]);
+    memcpy(ctx->modulus, bigint_limbs(modulus), n * sizeof(bigint_limb_t));
+    bigint_mpn_lshift(ctx->normalized, ctx->modulus, n, ctx->shift);
 
-        int *y_val = (int *)y_val_res.value.element;
-        if (*y_val == 0) {
-            result.status = BIGINT_ERR_DIV_BY_ZERO;
-            SET_MSG(result, "Cannot divide by zero");
+    if (n > 1 && !bigint_mpn_invert(ctx->reciprocal, ctx->normalized, n)) {
+        bigint_barrett_ctx_destroy(ctx);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate memory for Barrett context");
 
-            return result;
-        }
+        return result;
     }
 
-    // |x| < |y|: quotient is 0, remainder is x
-    tmp_res = bigint_compare_abs(x, y);
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-
-    if (tmp_res.value.compare_status < 0) {
-        tmp_res = bigint_from_int(0);
-        if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-        quotient = tmp_res.value.number;
+    result.value.barrett_ctx = ctx;
+    result.status = BIGINT_OK;
+    SET_MSG(result, "Barrett context successfully created");
 
-        tmp_res = bigint_clone(x);
-        if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-        remainder = tmp_res.value.number;
+    return result;
+}
 
-        result.value.division.quotient = quotient;
-        result.value.division.remainder = remainder;
+/**
+ * bigint_barrett_mod
+ *  @ctx: a valid non-null Barrett context
+ *  @x: a valid non-null big integer
+ *
+ *  Computes @x mod @ctx->modulus like bigint_mod (the remainder takes the sign
+ *  of @x) through the precomputed reciprocal, without computing the reciprocal
+ *  again nor returning the quotient
+ *
+ *  Returns a bigint_result_t data type containing the new big integer
+ */
+bigint_result_t bigint_barrett_mod(const bigint_barrett_ctx_t *ctx, const bigint_t *x) {
+    bigint_result_t result = {0};
 
-        result.status = BIGINT_OK;
-        SET_MSG(result, "Division between big integers was successful");
+    if (ctx == NULL || x == NULL) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid Barrett reduction");
 
         return result;
     }
 
-    tmp_res = bigint_div(x, y);
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    quotient = tmp_res.value.number;
+    const size_t n = ctx->size;
+    const size_t x_size = bigint_mpn_normalize(bigint_limbs(x), bigint_size(x));
 
-    // Set quotient sign accordingly
-    quotient->is_negative = (x->is_negative != y->is_negative);
-
-    // Compute remainder using r = x - y * q
-    tmp_res = bigint_prod(y, quotient);
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    y_times_q = tmp_res.value.number;
-
-    tmp_res = bigint_sub(x, y_times_q);
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
-    remainder = tmp_res.value.number;
-
-    tmp_res = bigint_trim_zeros(remainder);
-    if (tmp_res.status != BIGINT_OK) { result = tmp_res; goto cleanup; }
+    result = bigint_alloc(n);
+    if (result.status != BIGINT_OK) {
+        return result;
+    }
 
-    // Set remainder sign accordingly
-    vector_result_t r0 = vector_get(remainder->digits, 0);
-    if (r0.status != VECTOR_OK) {
-        result.status = BIGINT_ERR_INVALID;
-        COPY_MSG(result, r0.message);
+    bigint_t *remainder = result.value.number;
+    if (!bigint_mpn_mod(bigint_limbs(remainder), bigint_limbs(x), x_size, ctx->modulus, n,
+                        n > 1 ? ctx->reciprocal : NULL)) {
+        bigint_destroy(remainder);
+        result.status = BIGINT_ERR_ALLOCATE;
+        SET_MSG(result, "Cannot allocate memory for reduction");
 
-        goto cleanup;
+        return result;
     }
+    remainder->is_negative = x->is_negative;
+    bigint_trim_zeros(remainder);
 
-    bool rem_is_zero = (vector_size(remainder->digits) == 1 && *(int *)r0.value.element == 0);
+    SET_MSG(result, "Barrett reduction was successful");
 
-    if (!rem_is_zero) {
-        remainder->is_negative = x->is_negative;
-    }
+    return result;
+}
 
-    result.value.division.quotient = quotient;
-    result.value.division.remainder = remainder;
-    result.status = BIGINT_OK;
-    SET_MSG(result, "Division between big integers was successful");
+/**
+ * bigint_barrett_modpow
+ *  @ctx: a valid non-null Barrett context
+ *  @base: a valid non-null big integer
+ *  @exponent: a valid non-null, non-negative big integer
+ *
+ *  Computes @base^@exponent mod @ctx->modulus, between 0 and the modulus - 1,
+ *  with the sliding window method and Barrett's reduction
+ *
+ *  Returns a bigint_result_t data type containing the new big integer
+ */
+bigint_result_t bigint_barrett_modpow(const bigint_barrett_ctx_t *ctx, const bigint_t *base, const bigint_t *exponent) {
+    bigint_result_t result = {0};
 
-    bigint_destroy(y_times_q);
+    if (ctx == NULL || base == NULL || exponent == NULL || exponent->is_negative) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid modular exponentiation");
 
-    return result;
+        return result;
+    }
 
-cleanup:
-    if (quotient) { bigint_destroy(quotient); }
-    if (y_times_q) { bigint_destroy(y_times_q); }
-    if (remainder) { bigint_destroy(remainder); }
+    bigint_modmul_t mm = { NULL, ctx, ctx->size, false, NULL, NULL };
 
-    return result;
+    return bigint_powm(&mm, base, exponent, ctx->modulus, ctx->size > 1 ? ctx->reciprocal : NULL);
 }
 
 /**
- * bigint_mod
- *  @x: a valid non-null big integer
- *  @y: a valid non-null big integer
- * 
- *  Computes @x mod @y
- * 
+ * bigint_barrett_ctx_destroy
+ *  @ctx: a valid non-null Barrett context
+ *
+ *  Deletes the Barrett context from the memory
+ *
  *  Returns a bigint_result_t data type
  */
-bigint_result_t bigint_mod(const bigint_t *x, const bigint_t *y) {
+bigint_result_t bigint_barrett_ctx_destroy(bigint_barrett_ctx_t *ctx) {
     bigint_result_t result = {0};
 
-    if (x == NULL || y == NULL) {
+    if (ctx == NULL) {
         result.status = BIGINT_ERR_INVALID;
-        SET_MSG(result, "Invalid big numbers");
+        SET_MSG(result, "Invalid Barrett context");
 
         return result;
     }
 
-    bigint_result_t div_res = bigint_divmod(x, y);
-    if (div_res.status != BIGINT_OK) { return div_res; }
-
-    bigint_t* const quotient = div_res.value.division.quotient;
-    bigint_t* const remainder = div_res.value.division.remainder;
-
-    // Discard quotient
-    bigint_destroy(quotient);
+    free(ctx->modulus);
+    free(ctx);
 
-    result.value.number = remainder;
     result.status = BIGINT_OK;
-    SET_MSG(result, "Division between big integers was successful");
+    SET_MSG(result, "Barrett context successfully deleted");
 
     return result;
 }
@@ -1850,7 +4143,9 @@ bigint_result_t bigint_destroy(bigint_t *number) {
         return result;
     }
 
-    vector_destroy(number->digits);
+    if (number->digits != NULL) {
+        vector_destroy(number->digits);
+    }
     free(number);
 
     result.status = BIGINT_OK;
@@ -1859,6 +4154,48 @@ bigint_result_t bigint_destroy(bigint_t *number) {
     return result;
 }
 
+/**
+ * bigint_set_thresholds
+ *  @thresholds: the multiplication thresholds, NULL to restore the defaults
+ * 
+ *  Sets the operand lengths (in limbs) at which the multiplication switches
+ *  to Karatsuba, Toom-3 and the number theoretic transform. The thresholds
+ *  are global and must not be changed while other threads multiply
+ *  
+ *  Returns a bigint_result_t data type
+ */
+bigint_result_t bigint_set_thresholds(const bigint_thresholds_t *thresholds) {
+    bigint_result_t result = {0};
+
+    if (thresholds == NULL) {
+        const bigint_thresholds_t defaults = {
+            BIGINT_KARATSUBA_THRESHOLD, BIGINT_TOOM3_THRESHOLD, BIGINT_NTT_THRESHOLD
+        };
+        bigint_thresholds = defaults;
+
+        result.status = BIGINT_OK;
+        SET_MSG(result, "Thresholds successfully restored");
+
+        return result;
+    }
+
+    // Karatsuba and Toom-3 need a few limbs per part
+    if (thresholds->karatsuba < 4 || thresholds->toom3 < thresholds->karatsuba ||
+        thresholds->ntt == 0) {
+        result.status = BIGINT_ERR_INVALID;
+        SET_MSG(result, "Invalid multiplication thresholds");
+
+        return result;
+    }
+
+    bigint_thresholds = *thresholds;
+
+    result.status = BIGINT_OK;
+    SET_MSG(result, "Thresholds successfully set");
+
+    return result;
+}
+
 /**
  * bigint_printf
  *  @format: format string
@@ -3,10 +3,31 @@
 
 #define RESULT_MSG_SIZE 64
 
-// Numerical base (10^9)
-#define BIGINT_BASE 1000000000
-// Each digit stores values from 0 to 999,999,999
-#define BIGINT_BASE_DIGITS 9
+// Numerical base (2^64), each limb stores values from 0 to 2^64 - 1
+#define BIGINT_LIMB_BITS 64
+// Multiplication thresholds (in limbs of the shortest operand), override them
+// with the values suggested by `./benchmark_datum bigint-tune`.
+// Operands shorter than this are multiplied with the quadratic algorithm
+#ifndef BIGINT_KARATSUBA_THRESHOLD
+#define BIGINT_KARATSUBA_THRESHOLD 32
+#endif
+// Operands at least this long use Toom-3 instead of Karatsuba
+#ifndef BIGINT_TOOM3_THRESHOLD
+#define BIGINT_TOOM3_THRESHOLD 192
+#endif
+// Operands at least this long use the number theoretic transform
+#ifndef BIGINT_NTT_THRESHOLD
+#define BIGINT_NTT_THRESHOLD 2048
+#endif
+// Divisors and quotients at least this long use the recursive division (at least 4)
+#ifndef BIGINT_DC_DIV_THRESHOLD
+#define BIGINT_DC_DIV_THRESHOLD 32
+#endif
+// Divisors at least this long, with a quotient at least as long, are divided
+// through their reciprocal computed with Newton's iteration (at least 8)
+#ifndef BIGINT_MU_DIV_THRESHOLD
+#define BIGINT_MU_DIV_THRESHOLD 32768
+#endif
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -19,11 +40,40 @@ typedef enum {
     BIGINT_ERR_INVALID
 } bigint_status_t;
 
+// A single base 2^64 digit
+typedef uint64_t bigint_limb_t;
+
+// Numbers whose absolute value fits a limb keep it in inline_limb, with a NULL
+// digits vector, and are promoted to a vector when they outgrow it
 typedef struct {
-    vector_t *digits;
+    vector_t *digits; // Elements are bigint_limb_t, NULL for an inline number
+    bigint_limb_t inline_limb; // Absolute value of an inline number
     bool is_negative;
 } bigint_t;
 
+typedef struct {
+    size_t karatsuba;
+    size_t toom3;
+    size_t ntt;
+} bigint_thresholds_t;
+
+// Montgomery reduction modulo an odd number, see bigint_mont_ctx_new
+typedef struct {
+    bigint_limb_t *modulus; // size limbs
+    bigint_limb_t *r2; // B^(2 * size) mod modulus, with B = 2^64, size limbs
+    bigint_limb_t inverse; // -modulus^(-1) mod B
+    size_t size;
+} bigint_mont_ctx_t;
+
+// Barrett reduction modulo a positive number, see bigint_barrett_ctx_new
+typedef struct {
+    bigint_limb_t *modulus; // size limbs
+    bigint_limb_t *normalized; // modulus << shift, whose top bit is set
+    bigint_limb_t *reciprocal; // Reciprocal of normalized, when size > 1
+    size_t size;
+    unsigned shift;
+} bigint_barrett_ctx_t;
+
 typedef struct {
     bigint_t *quotient;
     bigint_t *remainder;
@@ -37,6 +87,8 @@ typedef struct {
         div_result_t division;
         int8_t compare_status;
         char *string_num;
+        bigint_mont_ctx_t *mont_ctx;
+        bigint_barrett_ctx_t *barrett_ctx;
     } value;
 } bigint_result_t;
 
@@ -47,6 +99,7 @@ extern "C" {
 bigint_result_t bigint_from_int(long long value);
 bigint_result_t bigint_from_string(const char *string_num);
 bigint_result_t bigint_to_string(const bigint_t *number);
+bigint_result_t bigint_to_string_base(const bigint_t *number, unsigned base);
 bigint_result_t bigint_clone(const bigint_t *number);
 bigint_result_t bigint_compare(const bigint_t *x, const bigint_t *y);
 bigint_result_t bigint_add(const bigint_t *x, const bigint_t *y);
@@ -54,7 +107,23 @@ bigint_result_t bigint_sub(const bigint_t *x, const bigint_t *y);
 bigint_result_t bigint_prod(const bigint_t *x, const bigint_t *y);
 bigint_result_t bigint_divmod(const bigint_t *x, const bigint_t *y);
 bigint_result_t bigint_mod(const bigint_t *x, const bigint_t *y);
+bigint_result_t bigint_add_inplace(bigint_t *dst, const bigint_t *src);
+bigint_result_t bigint_sub_from(bigint_t *dst, const bigint_t *src);
+bigint_result_t bigint_mul_into(bigint_t *dst, const bigint_t *x, const bigint_t *y);
+bigint_result_t bigint_addmul_small(bigint_t *dst, const bigint_t *x, uint32_t factor);
+bigint_result_t bigint_swap(bigint_t *x, bigint_t *y);
+bigint_result_t bigint_pow(const bigint_t *base, uint64_t exponent);
+bigint_result_t bigint_modpow(const bigint_t *base, const bigint_t *exponent, const bigint_t *modulus);
+bigint_result_t bigint_mont_ctx_new(const bigint_t *modulus);
+bigint_result_t bigint_mont_modpow(const bigint_mont_ctx_t *ctx, const bigint_t *base,
+                                   const bigint_t *exponent, bool constant_time);
+bigint_result_t bigint_mont_ctx_destroy(bigint_mont_ctx_t *ctx);
+bigint_result_t bigint_barrett_ctx_new(const bigint_t *modulus);
+bigint_result_t bigint_barrett_mod(const bigint_barrett_ctx_t *ctx, const bigint_t *x);
+bigint_result_t bigint_barrett_modpow(const bigint_barrett_ctx_t *ctx, const bigint_t *base, const bigint_t *exponent);
+bigint_result_t bigint_barrett_ctx_destroy(bigint_barrett_ctx_t *ctx);
 bigint_result_t bigint_destroy(bigint_t *number);
+bigint_result_t bigint_set_thresholds(const bigint_thresholds_t *thresholds);
 bigint_result_t bigint_printf(const char *format, ...);
 
 #ifdef __cplusplus
@@ -0,0 +1,768 @@
+#define SET_MSG(result, msg) \
+    do { \
+        snprintf((char *)(result).message, RESULT_MSG_SIZE, "%s", (const char *)msg); \
+    } while (0)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cache.h"
+
+/**
+ * cache_over_budget
+ *  @cache: a non-null cache
+ *  @size: number of entries
+ *  @bytes: sum of the charges of the entries
+ *
+ *  Returns true if @size entries charging @bytes do not fit in @cache
+ */
+static inline bool cache_over_budget(const cache_t *cache, size_t size, size_t bytes) {
+    return (cache->capacity > 0 && size > cache->capacity) ||
+           (cache->byte_budget > 0 && bytes > cache->byte_budget);
+}
+
+/**
+ * cache_small_full
+ *  @cache: a non-null S3-FIFO cache
+ *
+ *  Returns true if the small queue holds its share of the budget
+ */
+static inline bool cache_small_full(const cache_t *cache) {
+    return (cache->capacity > 0 && cache->small_count * 100 >= cache->capacity * CACHE_SMALL_RATIO) ||
+           (cache->byte_budget > 0 && cache->small_bytes * 100 >= cache->byte_budget * CACHE_SMALL_RATIO);
+}
+
+/**
+ * cache_ghost_tag
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  Returns the non-zero digest of @key stored in the ghost table
+ */
+static inline uint64_t cache_ghost_tag(const void *key, size_t key_len) {
+    return map_hash_int(map_hash(key, key_len)) | 1;
+}
+
+/**
+ * cache_ghost_slot
+ *  @cache: a non-null S3-FIFO cache
+ *  @tag: a ghost tag
+ *
+ *  Returns the slot of the ghost table for @tag
+ */
+static inline uint64_t *cache_ghost_slot(const cache_t *cache, uint64_t tag) {
+    return cache->ghost + ((tag >> 1) & (cache->ghost_size - 1));
+}
+
+/**
+ * cache_drop
+ *  @cache: a non-null cache
+ *  @key: the key of @entry
+ *  @key_len: length of @key in bytes
+ *  @entry: an entry of @cache
+ *
+ *  Hands the value of @entry to the eviction callback and removes @key
+ */
+static void cache_drop(cache_t *cache, const char *key, size_t key_len, const cache_entry_t *entry) {
+    const cache_entry_t dropped = *entry;
+
+    if (cache->policy == CACHE_S3FIFO) {
+        if (dropped.queue == CACHE_QUEUE_SMALL) {
+            cache->small_count--;
+            cache->small_bytes -= dropped.charge;
+        } else {
+            cache->main_count--;
+        }
+    }
+
+    cache->bytes -= dropped.charge;
+    if (cache->on_evict != NULL) {
+        cache->on_evict(key, key_len, dropped.value, cache->env);
+    }
+
+    map_remove_bytes(cache->map, key, key_len);
+}
+
+/**
+ * cache_evict_sampled
+ *  @cache: a non-null, non-empty cache
+ *
+ *  Evicts the least recently used out of the next CACHE_LRU_SAMPLES entries
+ *  after the hand. Slot positions follow the key digests, so consecutive
+ *  entries are as good a sample as random ones, and the sweep reads the
+ *  table sequentially. Cache maps never resize incrementally, so every
+ *  entry lives in the main table
+ */
+static void cache_evict_sampled(cache_t *cache) {
+    const map_t *map = cache->map;
+    const size_t mask = map_capacity(map) - 1;
+    const size_t samples = map_size(map) < CACHE_LRU_SAMPLES ? map_size(map) : CACHE_LRU_SAMPLES;
+    size_t victim_idx = 0;
+    uint32_t victim_age = 0;
+
+    // Whole groups of control bytes are read at once and only their occupied slots are visited.
+    // Control bytes are padded to MAP_GROUP_SIZE, so a group never reads past the table
+    size_t sampled = 0;
+    size_t group_idx = cache->hand & mask & ~(size_t)(MAP_GROUP_SIZE - 1);
+    for (; sampled < samples; group_idx = (group_idx + MAP_GROUP_SIZE) & mask & ~(size_t)(MAP_GROUP_SIZE - 1)) {
+        uint64_t occupied;
+        memcpy(&occupied, map->ctrl + group_idx, sizeof(occupied));
+        occupied &= 0x8080808080808080ULL;
+
+        for (; occupied != 0 && sampled < samples; occupied &= occupied - 1, sampled++) {
+            const size_t idx = group_idx + ((size_t)__builtin_ctzll(occupied) / 8);
+
+            // Ages wrap around with the tick, unlike the stamps
+            const cache_entry_t *entry = (const cache_entry_t *)(const void *)(map->values + (idx * map->value_size));
+            const uint32_t age = cache->tick - entry->stamp;
+            const bool older = sampled == 0 || age > victim_age;
+            victim_idx = older ? idx : victim_idx;
+            victim_age = older ? age : victim_age;
+        }
+    }
+
+    cache->hand = group_idx;
+
+    // The iterator resolves the key of the victim, inline or in the key arena
+    map_iter_t iter = map_iter_begin(map);
+    iter.index = victim_idx;
+    map_iter_next(&iter);
+    cache_drop(cache, iter.key, iter.key_len, iter.value);
+}
+
+/**
+ * cache_evict_clock
+ *  @cache: a non-null cache with at least one entry in the main queue
+ *
+ *  Sweeps the slots from the hand, giving a second chance to the entries
+ *  accessed since the last sweep, and evicts the first one that was not
+ */
+static void cache_evict_clock(cache_t *cache) {
+    map_iter_t iter = map_iter_begin(cache->map);
+    iter.index = cache->hand;
+
+    while (true) {
+        if (!map_iter_next(&iter)) {
+            iter.index = 0;
+            continue;
+        }
+
+        cache_entry_t *entry = iter.value;
+        if (entry->queue == CACHE_QUEUE_SMALL) {
+            continue;
+        }
+
+        if (entry->freq > 0) {
+            entry->freq--;
+            continue;
+        }
+
+        cache->hand = iter.index;
+        cache_drop(cache, iter.key, iter.key_len, entry);
+
+        return;
+    }
+}
+
+/**
+ * cache_pop_small
+ *  @cache: a non-null S3-FIFO cache with a non-empty small queue
+ *
+ *  Pops the oldest record of the small queue. The entry is promoted to the
+ *  main queue if it was accessed since its insertion, otherwise it is evicted
+ *  and remembered by the ghost table. Records of removed or reinserted keys
+ *  are discarded
+ *
+ *  Returns true if an entry was evicted
+ */
+static bool cache_pop_small(cache_t *cache) {
+    const cache_record_t record = cache->small[cache->small_head];
+    bool evicted = false;
+
+    cache->small_head = (cache->small_head + 1) % cache->small_capacity;
+    cache->small_records--;
+
+    map_result_t res = map_get_bytes(cache->map, record.key, record.key_len);
+    if (res.status == MAP_OK) {
+        cache_entry_t *entry = res.value.element;
+
+        if (entry->queue == CACHE_QUEUE_SMALL && entry->stamp == record.seq) {
+            if (entry->freq > 0) {
+                entry->queue = CACHE_QUEUE_MAIN;
+                entry->freq = 0;
+                cache->small_count--;
+                cache->small_bytes -= entry->charge;
+                cache->main_count++;
+            } else {
+                const uint64_t tag = cache_ghost_tag(record.key, record.key_len);
+                *cache_ghost_slot(cache, tag) = tag;
+                cache_drop(cache, record.key, record.key_len, entry);
+                evicted = true;
+            }
+        }
+    }
+
+    free(record.key);
+
+    return evicted;
+}
+
+/**
+ * cache_evict
+ *  @cache: a non-null, non-empty cache
+ *
+ *  Evicts one entry according to the policy of @cache
+ */
+static void cache_evict(cache_t *cache) {
+    if (cache->policy == CACHE_LRU) {
+        cache_evict_sampled(cache);
+
+        return;
+    }
+
+    // S3-FIFO evicts from the small queue while it exceeds its share
+    while (cache->policy == CACHE_S3FIFO && cache->small_count > 0 &&
+           (cache->main_count == 0 || cache_small_full(cache))) {
+        if (cache_pop_small(cache)) {
+            return;
+        }
+    }
+
+    cache_evict_clock(cache);
+}
+
+/**
+ * cache_compact_small
+ *  @cache: a non-null S3-FIFO cache
+ *
+ *  Drops the stale records of the small queue, preserving the order of the others
+ */
+static void cache_compact_small(cache_t *cache) {
+    size_t kept = 0;
+
+    for (size_t idx = 0; idx < cache->small_records; idx++) {
+        const cache_record_t record = cache->small[(cache->small_head + idx) % cache->small_capacity];
+        map_result_t res = map_get_bytes(cache->map, record.key, record.key_len);
+        const cache_entry_t *entry = res.value.element;
+
+        if (res.status == MAP_OK && entry->queue == CACHE_QUEUE_SMALL && entry->stamp == record.seq) {
+            cache->small[(cache->small_head + kept) % cache->small_capacity] = record;
+            kept++;
+        } else {
+            free(record.key);
+        }
+    }
+
+    cache->small_records = kept;
+}
+
+/**
+ * cache_push_small
+ *  @cache: a non-null S3-FIFO cache
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *  @seq: sequence number of the entry
+ *
+ *  Returns MAP_OK if a copy of @key is appended to the small queue
+ */
+static map_status_t cache_push_small(cache_t *cache, const void *key, size_t key_len, uint32_t seq) {
+    // Removed keys leave their records behind, drop them before the ring grows
+    if (cache->small_records >= 2 * cache->small_count + 16) {
+        cache_compact_small(cache);
+    }
+
+    if (cache->small_records == cache->small_capacity) {
+        const size_t new_capacity = cache->small_capacity ? cache->small_capacity * 2 : 16;
+        cache_record_t *ring = malloc(new_capacity * sizeof(cache_record_t));
+        if (ring == NULL) {
+            return MAP_ERR_ALLOCATE;
+        }
+
+        for (size_t idx = 0; idx < cache->small_records; idx++) {
+            ring[idx] = cache->small[(cache->small_head + idx) % cache->small_capacity];
+        }
+
+        free(cache->small);
+        cache->small = ring;
+        cache->small_head = 0;
+        cache->small_capacity = new_capacity;
+    }
+
+    char *copy = malloc(key_len ? key_len : 1);
+    if (copy == NULL) {
+        return MAP_ERR_ALLOCATE;
+    }
+    memcpy(copy, key, key_len);
+
+    cache_record_t *record = &cache->small[(cache->small_head + cache->small_records) % cache->small_capacity];
+    record->key = copy;
+    record->key_len = key_len;
+    record->seq = seq;
+    cache->small_records++;
+
+    return MAP_OK;
+}
+
+/**
+ * cache_grow_ghost
+ *  @cache: a non-null S3-FIFO cache
+ *
+ *  The ghost table remembers about as many keys as the cache holds. Caches
+ *  bounded only by bytes double it, forgetting its content, as they grow
+ *
+ *  Returns MAP_OK on success, MAP_ERR_ALLOCATE otherwise
+ */
+static map_status_t cache_grow_ghost(cache_t *cache) {
+    uint64_t *ghost = calloc(cache->ghost_size * 2, sizeof(uint64_t));
+    if (ghost == NULL) {
+        return MAP_ERR_ALLOCATE;
+    }
+
+    free(cache->ghost);
+    cache->ghost = ghost;
+    cache->ghost_size *= 2;
+
+    return MAP_OK;
+}
+
+/**
+ * cache_new
+ *  @policy: the eviction policy
+ *  @capacity: maximum number of entries, 0 if unbounded
+ *  @byte_budget: maximum sum of the charges of the entries, 0 if unbounded
+ *
+ *  At least one of @capacity and @byte_budget must be bounded
+ *
+ *  Returns a cache_result_t data type containing a new empty cache
+ */
+cache_result_t cache_new(cache_policy_t policy, size_t capacity, size_t byte_budget) {
+    cache_result_t result = {0};
+
+    if ((policy != CACHE_LRU && policy != CACHE_CLOCK && policy != CACHE_S3FIFO) ||
+        (capacity == 0 && byte_budget == 0)) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid policy or unbounded cache");
+
+        return result;
+    }
+
+    cache_t *cache = calloc(1, sizeof(cache_t));
+    if (cache == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for cache");
+
+        return result;
+    }
+
+    map_result_t map_res = map_new_sized(sizeof(cache_entry_t));
+    if (map_res.status != MAP_OK) {
+        free(cache);
+        result.status = map_res.status;
+        SET_MSG(result, "Failed to allocate memory for cache");
+
+        return result;
+    }
+
+    cache->map = map_res.value.map;
+    cache->policy = policy;
+    cache->capacity = capacity;
+    cache->byte_budget = byte_budget;
+
+    if (policy == CACHE_S3FIFO) {
+        cache->ghost_size = CACHE_INITIAL_GHOST;
+        while (cache->ghost_size < capacity && cache->ghost_size <= SIZE_MAX / 4) {
+            cache->ghost_size *= 2;
+        }
+
+        cache->ghost = calloc(cache->ghost_size, sizeof(uint64_t));
+        if (cache->ghost == NULL) {
+            map_destroy(cache->map);
+            free(cache);
+            result.status = MAP_ERR_ALLOCATE;
+            SET_MSG(result, "Failed to allocate memory for cache");
+
+            return result;
+        }
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Cache successfully created");
+    result.value.cache = cache;
+
+    return result;
+}
+
+/**
+ * cache_set_evict
+ *  @cache: a non-null cache
+ *  @callback: the function called on each value leaving the cache, or NULL
+ *  @env: an optional environment passed to @callback
+ *
+ *  @callback receives the values evicted, replaced, removed, cleared and
+ *  destroyed. It must not use @cache
+ *
+ *  Returns a cache_result_t data type containing the status
+ */
+cache_result_t cache_set_evict(cache_t *cache, cache_evict_fn callback, void *env) {
+    cache_result_t result = {0};
+
+    if (cache == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid cache");
+
+        return result;
+    }
+
+    cache->on_evict = callback;
+    cache->env = env;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Eviction callback successfully set");
+
+    return result;
+}
+
+/**
+ * cache_touch
+ *  @cache: a non-null cache
+ *  @entry: an entry of @cache
+ *
+ *  Records an access to @entry, without moving it
+ */
+static inline void cache_touch(cache_t *cache, cache_entry_t *entry) {
+    switch (cache->policy) {
+        case CACHE_LRU: entry->stamp = ++cache->tick; break;
+        case CACHE_CLOCK: entry->freq = 1; break;
+        default: entry->freq += entry->freq < CACHE_MAX_FREQ; break;
+    }
+}
+
+/**
+ * cache_put_bytes
+ *  @cache: a non-null cache
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *  @value: the value to store, referenced by the cache
+ *  @charge: bytes charged to the budget of @cache for this entry
+ *
+ *  Adds or replaces @key, evicting other entries until it fits.
+ *  The replaced value is handed to the eviction callback
+ *
+ *  Returns a cache_result_t data type containing the status
+ */
+cache_result_t cache_put_bytes(cache_t *cache, const void *key, size_t key_len, void *value, size_t charge) {
+    cache_result_t result = {0};
+
+    if (cache == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid cache or key");
+
+        return result;
+    }
+
+    if (cache->byte_budget > 0 && charge > cache->byte_budget) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Entry is larger than the cache budget");
+
+        return result;
+    }
+
+    map_result_t map_res = map_get_bytes(cache->map, key, key_len);
+    if (map_res.status == MAP_OK) {
+        cache_entry_t *entry = map_res.value.element;
+        void *old_value = entry->value;
+
+        if (cache->policy == CACHE_S3FIFO && entry->queue == CACHE_QUEUE_SMALL) {
+            cache->small_bytes = cache->small_bytes - entry->charge + charge;
+        }
+        cache->bytes = cache->bytes - entry->charge + charge;
+        entry->value = value;
+        entry->charge = charge;
+        cache_touch(cache, entry);
+
+        if (cache->on_evict != NULL && old_value != value) {
+            cache->on_evict((const char*)key, key_len, old_value, cache->env);
+        }
+
+        // A larger charge may push other entries out
+        while (cache_over_budget(cache, cache_size(cache), cache->bytes)) {
+            cache_evict(cache);
+        }
+
+        result.status = MAP_OK;
+        SET_MSG(result, "Entry successfully updated");
+
+        return result;
+    }
+
+    while (cache_size(cache) > 0 && cache_over_budget(cache, cache_size(cache) + 1, cache->bytes + charge)) {
+        cache_evict(cache);
+    }
+
+    cache_entry_t entry = { value, charge, 0, 0, CACHE_QUEUE_MAIN };
+    if (cache->policy == CACHE_LRU) {
+        entry.stamp = ++cache->tick;
+    } else if (cache->policy == CACHE_S3FIFO) {
+        if (cache_size(cache) >= cache->ghost_size && cache_grow_ghost(cache) != MAP_OK) {
+            result.status = MAP_ERR_ALLOCATE;
+            SET_MSG(result, "Failed to allocate memory for cache");
+
+            return result;
+        }
+
+        // Keys evicted recently from the small queue go straight to the main one
+        const uint64_t tag = cache_ghost_tag(key, key_len);
+        uint64_t *ghost = cache_ghost_slot(cache, tag);
+        if (*ghost == tag) {
+            *ghost = 0;
+        } else {
+            entry.queue = CACHE_QUEUE_SMALL;
+            entry.stamp = ++cache->tick;
+
+            if (cache_push_small(cache, key, key_len, entry.stamp) != MAP_OK) {
+                result.status = MAP_ERR_ALLOCATE;
+                SET_MSG(result, "Failed to allocate memory for cache");
+
+                return result;
+            }
+        }
+    }
+
+    // A failed insertion leaves a stale record behind, which is dropped later
+    map_res = map_add_bytes(cache->map, key, key_len, &entry);
+    if (map_res.status != MAP_OK) {
+        result.status = map_res.status;
+        SET_MSG(result, "Failed to add entry to cache");
+
+        return result;
+    }
+
+    cache->bytes += charge;
+    if (cache->policy == CACHE_S3FIFO) {
+        if (entry.queue == CACHE_QUEUE_SMALL) {
+            cache->small_count++;
+            cache->small_bytes += charge;
+        } else {
+            cache->main_count++;
+        }
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Entry successfully added");
+
+    return result;
+}
+
+/**
+ * cache_put
+ *  @cache: a non-null cache
+ *  @key: a string
+ *  @value: the value to store, referenced by the cache
+ *  @charge: bytes charged to the budget of @cache for this entry
+ *
+ *  Returns a cache_result_t data type containing the status
+ */
+cache_result_t cache_put(cache_t *cache, const char *key, void *value, size_t charge) {
+    if (key == NULL) {
+        return cache_put_bytes(cache, NULL, 0, value, charge);
+    }
+
+    return cache_put_bytes(cache, key, strlen(key), value, charge);
+}
+
+/**
+ * cache_get_bytes
+ *  @cache: a non-null cache
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  A hit only updates the metadata stored in the slot of @key
+ *
+ *  Returns a cache_result_t data type containing the value of @key
+ */
+cache_result_t cache_get_bytes(cache_t *cache, const void *key, size_t key_len) {
+    cache_result_t result = {0};
+
+    if (cache == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid cache or key");
+
+        return result;
+    }
+
+    map_result_t map_res = map_get_bytes(cache->map, key, key_len);
+    if (map_res.status != MAP_OK) {
+        cache->misses++;
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    cache_entry_t *entry = map_res.value.element;
+    cache_touch(cache, entry);
+    cache->hits++;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Element found");
+    result.value.element = entry->value;
+
+    return result;
+}
+
+/**
+ * cache_get
+ *  @cache: a non-null cache
+ *  @key: a string
+ *
+ *  Returns a cache_result_t data type containing the value of @key
+ */
+cache_result_t cache_get(cache_t *cache, const char *key) {
+    if (key == NULL) {
+        return cache_get_bytes(cache, NULL, 0);
+    }
+
+    return cache_get_bytes(cache, key, strlen(key));
+}
+
+/**
+ * cache_remove_bytes
+ *  @cache: a non-null cache
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  The value of @key is handed to the eviction callback
+ *
+ *  Returns a cache_result_t data type containing the status
+ */
+cache_result_t cache_remove_bytes(cache_t *cache, const void *key, size_t key_len) {
+    cache_result_t result = {0};
+
+    if (cache == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid cache or key");
+
+        return result;
+    }
+
+    map_result_t map_res = map_get_bytes(cache->map, key, key_len);
+    if (map_res.status != MAP_OK) {
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    cache_drop(cache, (const char*)key, key_len, map_res.value.element);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Entry successfully deleted");
+
+    return result;
+}
+
+/**
+ * cache_remove
+ *  @cache: a non-null cache
+ *  @key: a string
+ *
+ *  Returns a cache_result_t data type containing the status
+ */
+cache_result_t cache_remove(cache_t *cache, const char *key) {
+    if (key == NULL) {
+        return cache_remove_bytes(cache, NULL, 0);
+    }
+
+    return cache_remove_bytes(cache, key, strlen(key));
+}
+
+/**
+ * cache_release
+ *  @cache: a non-null cache
+ *
+ *  Hands every value to the eviction callback and frees the small queue
+ */
+static void cache_release(cache_t *cache) {
+    if (cache->on_evict != NULL) {
+        map_iter_t iter = map_iter_begin(cache->map);
+        while (map_iter_next(&iter)) {
+            const cache_entry_t *entry = iter.value;
+            cache->on_evict(iter.key, iter.key_len, entry->value, cache->env);
+        }
+    }
+
+    for (size_t idx = 0; idx < cache->small_records; idx++) {
+        free(cache->small[(cache->small_head + idx) % cache->small_capacity].key);
+    }
+
+    cache->small_head = 0;
+    cache->small_records = 0;
+}
+
+/**
+ * cache_clear
+ *  @cache: a non-null cache
+ *
+ *  Removes every entry, handing its value to the eviction callback.
+ *  Hit and miss counters are preserved
+ *
+ *  Returns a cache_result_t data type containing the status
+ */
+cache_result_t cache_clear(cache_t *cache) {
+    cache_result_t result = {0};
+
+    if (cache == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid cache");
+
+        return result;
+    }
+
+    cache_release(cache);
+    map_clear(cache->map);
+
+    cache->bytes = 0;
+    cache->hand = 0;
+    cache->small_count = 0;
+    cache->small_bytes = 0;
+    cache->main_count = 0;
+    if (cache->ghost != NULL) {
+        memset(cache->ghost, 0, cache->ghost_size * sizeof(uint64_t));
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Cache successfully cleared");
+
+    return result;
+}
+
+/**
+ * cache_destroy
+ *  @cache: a cache
+ *
+ *  The remaining values are handed to the eviction callback
+ *
+ *  Returns a cache_result_t data type containing the status
+ */
+cache_result_t cache_destroy(cache_t *cache) {
+    cache_result_t result = {0};
+
+    if (cache == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid cache");
+
+        return result;
+    }
+
+    cache_release(cache);
+    map_destroy(cache->map);
+    free(cache->small);
+    free(cache->ghost);
+    free(cache);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Cache successfully deleted");
+
+    return result;
+}
@@ -0,0 +1,117 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#define RESULT_MSG_SIZE 64
+
+// Number of entries compared by the sampled LRU eviction
+#define CACHE_LRU_SAMPLES 8
+// S3-FIFO: share (in percent) of the budget given to the small queue
+// and frequency saturation of each entry
+#define CACHE_SMALL_RATIO 10
+#define CACHE_MAX_FREQ 3
+#define CACHE_INITIAL_GHOST 64
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "map.h"
+
+typedef enum {
+    CACHE_LRU = 0x0, // Evicts the least recently used entry out of CACHE_LRU_SAMPLES, slower than CLOCK
+    CACHE_CLOCK, // Second chance, a hand sweeps the slots clearing the reference bits
+    CACHE_S3FIFO // Small probationary FIFO, main CLOCK queue and ghost of the recent evictions
+} cache_policy_t;
+
+typedef enum {
+    CACHE_QUEUE_MAIN = 0x0,
+    CACHE_QUEUE_SMALL
+} cache_queue_t;
+
+// Value stored by the map slot of each key, along with its recency metadata
+typedef struct {
+    void *value;
+    size_t charge; // Bytes charged to the budget
+    uint32_t stamp; // LRU: tick of the last access, S3-FIFO: sequence number in the small queue
+    uint8_t freq; // CLOCK: reference bit, S3-FIFO: accesses since insertion (up to CACHE_MAX_FREQ)
+    uint8_t queue; // S3-FIFO: cache_queue_t of the entry
+} cache_entry_t;
+
+// Key copy of an entry of the S3-FIFO small queue
+typedef struct {
+    char *key;
+    size_t key_len;
+    uint32_t seq;
+} cache_record_t;
+
+// Callback functions
+typedef void (*cache_evict_fn)(const char *key, size_t key_len, void *value, void *env);
+
+typedef struct {
+    map_t *map; // Values are cache_entry_t
+    cache_policy_t policy;
+    size_t capacity; // Maximum number of entries, 0 if unbounded
+    size_t byte_budget; // Maximum sum of the charges, 0 if unbounded
+    size_t bytes;
+    uint32_t tick;
+    size_t hand; // Next slot inspected by the CLOCK sweep or sampled by LRU
+    cache_evict_fn on_evict;
+    void *env;
+    size_t hits;
+    size_t misses;
+    cache_record_t *small; // Ring buffer of the small queue, may hold stale records
+    size_t small_head;
+    size_t small_records;
+    size_t small_capacity;
+    size_t small_count; // Live entries of the small queue
+    size_t small_bytes;
+    size_t main_count;
+    uint64_t *ghost; // Direct-mapped digests of the keys evicted from the small queue
+    size_t ghost_size;
+} cache_t;
+
+typedef struct {
+    map_status_t status;
+    uint8_t message[RESULT_MSG_SIZE];
+    union {
+        cache_t *cache;
+        void *element;
+    } value;
+} cache_result_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+cache_result_t cache_new(cache_policy_t policy, size_t capacity, size_t byte_budget);
+cache_result_t cache_set_evict(cache_t *cache, cache_evict_fn callback, void *env);
+cache_result_t cache_put(cache_t *cache, const char *key, void *value, size_t charge);
+cache_result_t cache_put_bytes(cache_t *cache, const void *key, size_t key_len, void *value, size_t charge);
+cache_result_t cache_get(cache_t *cache, const char *key);
+cache_result_t cache_get_bytes(cache_t *cache, const void *key, size_t key_len);
+cache_result_t cache_remove(cache_t *cache, const char *key);
+cache_result_t cache_remove_bytes(cache_t *cache, const void *key, size_t key_len);
+cache_result_t cache_clear(cache_t *cache);
+cache_result_t cache_destroy(cache_t *cache);
+
+// Inline methods
+static inline size_t cache_size(const cache_t *cache) {
+    return cache ? map_size(cache->map) : 0;
+}
+
+static inline size_t cache_bytes(const cache_t *cache) {
+    return cache ? cache->bytes : 0;
+}
+
+static inline size_t cache_hits(const cache_t *cache) {
+    return cache ? cache->hits : 0;
+}
+
+static inline size_t cache_misses(const cache_t *cache) {
+    return cache ? cache->misses : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
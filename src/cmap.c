@@ -0,0 +1,768 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define SET_MSG(result, msg) \
+    do { \
+        snprintf((char *)(result).message, RESULT_MSG_SIZE, "%s", (const char *)msg); \
+    } while (0)
+
+#define COPY_MSG(result, msg) \
+    do { \
+        strncpy((char *)(result).message, (const char *)(msg), RESULT_MSG_SIZE - 1); \
+        (result).message[RESULT_MSG_SIZE - 1] = '\0'; \
+    } while (0)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "cmap.h"
+
+typedef struct {
+    pthread_rwlock_t lock;
+    map_t *map;
+} shard_data_t;
+
+struct cmap_shard {
+    shard_data_t data;
+    // Keep each shard on its own cache lines
+    uint8_t padding[CMAP_SHARD_SIZE - (sizeof(shard_data_t) % CMAP_SHARD_SIZE)];
+};
+
+typedef struct {
+    uint64_t epoch; // Epoch observed by the reader, 0 outside of read sections
+    uint32_t in_use;
+} reader_data_t;
+
+typedef struct {
+    reader_data_t data;
+    // Each reader only writes to its own cache lines
+    uint8_t padding[CMAP_SHARD_SIZE - (sizeof(reader_data_t) % CMAP_SHARD_SIZE)];
+} rmap_reader_t;
+
+typedef struct rmap_retired {
+    map_t *map;
+    uint64_t epoch; // Last epoch in which the table was published
+    struct rmap_retired *next;
+} rmap_retired_t;
+
+struct rmap_state {
+    rmap_reader_t readers[RMAP_MAX_READERS];
+    pthread_mutex_t lock;
+    rmap_retired_t *retired;
+};
+
+/**
+ * cmap_shard_of
+ *  @map: a non-null concurrent map
+ *  @key_digest: the map_hash of a key
+ *
+ *  Selects the shard of a key using the high bits of its digest. The 7 most
+ *  significant bits are skipped because the shard maps use them as slot tags.
+ *  The digest is then passed on to the shard map, so every key is hashed once
+ *
+ *  Returns the shard owning the key
+ */
+static inline shard_data_t *cmap_shard_of(const cmap_t *map, uint64_t key_digest) {
+    const size_t idx = (size_t)(key_digest >> (57 - map->shard_bits)) & (map->shard_count - 1);
+
+    return &map->shards[idx].data;
+}
+
+/**
+ * cmap_new
+ *  @shard_count: number of independent tables, rounded up to a power of two.
+ *                Zero selects CMAP_DEFAULT_SHARDS
+ *
+ *  Returns a cmap_result_t data type containing a new concurrent map
+ */
+cmap_result_t cmap_new(size_t shard_count) {
+    cmap_result_t result = {0};
+
+    if (shard_count == 0) {
+        shard_count = CMAP_DEFAULT_SHARDS;
+    }
+
+    if (shard_count > (1 << 16)) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Too many shards");
+
+        return result;
+    }
+
+    unsigned shard_bits = 0;
+    while (((size_t)1 << shard_bits) < shard_count) {
+        shard_bits++;
+    }
+    shard_count = (size_t)1 << shard_bits;
+
+    cmap_t *map = malloc(sizeof(cmap_t));
+    if (map == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map");
+
+        return result;
+    }
+
+    void *shards = NULL;
+    if (posix_memalign(&shards, CMAP_SHARD_SIZE, shard_count * sizeof(cmap_shard_t)) != 0) {
+        free(map);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map shards");
+
+        return result;
+    }
+
+    map->shards = shards;
+    map->shard_count = shard_count;
+    map->shard_bits = shard_bits;
+
+    for (size_t idx = 0; idx < shard_count; idx++) {
+        shard_data_t *shard = &map->shards[idx].data;
+        map_result_t map_res = map_new();
+
+        if (map_res.status != MAP_OK || pthread_rwlock_init(&shard->lock, NULL) != 0) {
+            if (map_res.status == MAP_OK) { map_destroy(map_res.value.map); }
+
+            // Roll back the shards initialized so far
+            for (size_t prev = 0; prev < idx; prev++) {
+                pthread_rwlock_destroy(&map->shards[prev].data.lock);
+                map_destroy(map->shards[prev].data.map);
+            }
+
+            free(map->shards);
+            free(map);
+            result.status = MAP_ERR_ALLOCATE;
+            SET_MSG(result, "Failed to initialize map shards");
+
+            return result;
+        }
+
+        shard->map = map_res.value.map;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully created");
+    result.value.map = map;
+
+    return result;
+}
+
+/**
+ * cmap_add
+ *  @map: a non-null concurrent map
+ *  @key: a string representing the index key
+ *  @value: a generic value to add to the map
+ *
+ *  Adds (@key, @value) to @map. Only the shard owning @key is locked
+ *
+ *  Returns a cmap_result_t data type containing the status
+ */
+cmap_result_t cmap_add(cmap_t *map, const char *key, void *value) {
+    cmap_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    const size_t key_len = strlen(key);
+    const uint64_t key_digest = map_hash(key, key_len);
+    shard_data_t *shard = cmap_shard_of(map, key_digest);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    map_result_t add_res = map_add_digest(shard->map, key, key_len, key_digest, value);
+    pthread_rwlock_unlock(&shard->lock);
+
+    result.status = add_res.status;
+    COPY_MSG(result, add_res.message);
+
+    return result;
+}
+
+/**
+ * cmap_get
+ *  @map: a non-null concurrent map
+ *  @key: a string representing the index key
+ *
+ *  Looks up @key while holding the read lock of its shard,
+ *  so concurrent readers never block each other
+ *
+ *  Returns a cmap_result_t data type containing the element indexed by @key if available
+ */
+cmap_result_t cmap_get(cmap_t *map, const char *key) {
+    cmap_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    const size_t key_len = strlen(key);
+    const uint64_t key_digest = map_hash(key, key_len);
+    shard_data_t *shard = cmap_shard_of(map, key_digest);
+
+    pthread_rwlock_rdlock(&shard->lock);
+    map_result_t get_res = map_get_digest(shard->map, key, key_len, key_digest);
+    pthread_rwlock_unlock(&shard->lock);
+
+    result.status = get_res.status;
+    result.value.element = get_res.value.element;
+    COPY_MSG(result, get_res.message);
+
+    return result;
+}
+
+/**
+ * cmap_remove
+ *  @map: a non-null concurrent map
+ *  @key: a string representing the index key
+ *
+ *  Removes an element indexed by @key from @map
+ *
+ *  Returns a cmap_result_t data type
+ */
+cmap_result_t cmap_remove(cmap_t *map, const char *key) {
+    cmap_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    const size_t key_len = strlen(key);
+    const uint64_t key_digest = map_hash(key, key_len);
+    shard_data_t *shard = cmap_shard_of(map, key_digest);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    map_result_t rm_res = map_remove_digest(shard->map, key, key_len, key_digest);
+    pthread_rwlock_unlock(&shard->lock);
+
+    result.status = rm_res.status;
+    COPY_MSG(result, rm_res.message);
+
+    return result;
+}
+
+/**
+ * cmap_size
+ *  @map: a concurrent map
+ *
+ *  Returns the number of elements of @map. Shards are visited one
+ *  at a time, so the result is only a snapshot under concurrent updates
+ */
+size_t cmap_size(cmap_t *map) {
+    if (map == NULL) {
+        return 0;
+    }
+
+    size_t size = 0;
+    for (size_t idx = 0; idx < map->shard_count; idx++) {
+        shard_data_t *shard = &map->shards[idx].data;
+
+        pthread_rwlock_rdlock(&shard->lock);
+        size += map_size(shard->map);
+        pthread_rwlock_unlock(&shard->lock);
+    }
+
+    return size;
+}
+
+/**
+ * cmap_clear
+ *  @map: a non-null concurrent map
+ *
+ *  Resets every shard of the map to an empty state
+ *
+ *  Returns a cmap_result_t data type
+ */
+cmap_result_t cmap_clear(cmap_t *map) {
+    cmap_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    for (size_t idx = 0; idx < map->shard_count; idx++) {
+        shard_data_t *shard = &map->shards[idx].data;
+
+        pthread_rwlock_wrlock(&shard->lock);
+        map_clear(shard->map);
+        pthread_rwlock_unlock(&shard->lock);
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully cleared");
+
+    return result;
+}
+
+/**
+ * cmap_destroy
+ *  @map: a non-null concurrent map
+ *
+ *  Deletes the map and all its shards from the memory.
+ *  No other thread may be using @map
+ *
+ *  Returns a cmap_result_t data type
+ */
+cmap_result_t cmap_destroy(cmap_t *map) {
+    cmap_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    for (size_t idx = 0; idx < map->shard_count; idx++) {
+        pthread_rwlock_destroy(&map->shards[idx].data.lock);
+        map_destroy(map->shards[idx].data.map);
+    }
+
+    free(map->shards);
+    free(map);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully deleted");
+
+    return result;
+}
+
+/**
+ * rmap_new
+ *
+ *  Returns a cmap_result_t data type containing a new read-mostly map
+ *  that stores values by reference
+ */
+cmap_result_t rmap_new(void) {
+    cmap_result_t result = {0};
+
+    rmap_t *map = malloc(sizeof(rmap_t));
+    if (map == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map");
+
+        return result;
+    }
+
+    void *state = NULL;
+    if (posix_memalign(&state, CMAP_SHARD_SIZE, sizeof(rmap_state_t)) != 0) {
+        free(map);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map state");
+
+        return result;
+    }
+
+    map_result_t map_res = map_new();
+    if (map_res.status != MAP_OK) {
+        free(state);
+        free(map);
+        result.status = map_res.status;
+        COPY_MSG(result, map_res.message);
+
+        return result;
+    }
+
+    map->state = state;
+    memset(map->state->readers, 0, sizeof(map->state->readers));
+    map->state->retired = NULL;
+    if (pthread_mutex_init(&map->state->lock, NULL) != 0) {
+        map_destroy(map_res.value.map);
+        free(state);
+        free(map);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to initialize map lock");
+
+        return result;
+    }
+
+    // Epoch 0 marks idle readers
+    map->current = map_res.value.map;
+    map->epoch = 1;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully created");
+    result.value.rmap = map;
+
+    return result;
+}
+
+/**
+ * rmap_register
+ *  @map: a non-null read-mostly map
+ *
+ *  Reserves a reader slot for the calling thread
+ *
+ *  Returns a cmap_result_t data type containing the reader handle
+ */
+cmap_result_t rmap_register(rmap_t *map) {
+    cmap_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    for (size_t idx = 0; idx < RMAP_MAX_READERS; idx++) {
+        uint32_t expected = 0;
+
+        if (__atomic_compare_exchange_n(&map->state->readers[idx].data.in_use, &expected, 1,
+                                        false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            result.status = MAP_OK;
+            SET_MSG(result, "Reader successfully registered");
+            result.value.reader = idx;
+
+            return result;
+        }
+    }
+
+    result.status = MAP_ERR_OVERFLOW;
+    SET_MSG(result, "Too many readers");
+
+    return result;
+}
+
+/**
+ * rmap_unregister
+ *  @map: a non-null read-mostly map
+ *  @reader: a reader handle returned by rmap_register
+ *
+ *  Releases the reader slot. The reader must not be inside a read section
+ *
+ *  Returns a cmap_result_t data type
+ */
+cmap_result_t rmap_unregister(rmap_t *map, size_t reader) {
+    cmap_result_t result = {0};
+
+    if (map == NULL || reader >= RMAP_MAX_READERS) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or reader");
+
+        return result;
+    }
+
+    __atomic_store_n(&map->state->readers[reader].data.epoch, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&map->state->readers[reader].data.in_use, 0, __ATOMIC_RELEASE);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Reader successfully unregistered");
+
+    return result;
+}
+
+/**
+ * rmap_read_begin
+ *  @map: a non-null read-mostly map
+ *  @reader: a reader handle returned by rmap_register
+ *
+ *  Enters a read section. The reader announces the current epoch in its
+ *  own slot and then loads the published table, which will not be freed
+ *  until the matching rmap_read_end. No lock is taken and no shared
+ *  cache line is written
+ *
+ *  Returns the published table, to be queried with the read-only map methods
+ */
+const map_t *rmap_read_begin(rmap_t *map, size_t reader) {
+    reader_data_t *slot = &map->state->readers[reader].data;
+
+    __atomic_store_n(&slot->epoch, __atomic_load_n(&map->epoch, __ATOMIC_SEQ_CST), __ATOMIC_SEQ_CST);
+
+    return __atomic_load_n(&map->current, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * rmap_read_end
+ *  @map: a non-null read-mostly map
+ *  @reader: a reader handle returned by rmap_register
+ *
+ *  Leaves a read section. Tables obtained from rmap_read_begin
+ *  must not be used afterwards
+ */
+void rmap_read_end(rmap_t *map, size_t reader) {
+    __atomic_store_n(&map->state->readers[reader].data.epoch, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * rmap_get
+ *  @map: a non-null read-mostly map
+ *  @reader: a reader handle returned by rmap_register
+ *  @key: a string representing the index key
+ *
+ *  Looks up @key inside a read section
+ *
+ *  Returns a cmap_result_t data type containing the element indexed by @key if available
+ */
+cmap_result_t rmap_get(rmap_t *map, size_t reader, const char *key) {
+    cmap_result_t result = {0};
+
+    if (map == NULL || key == NULL || reader >= RMAP_MAX_READERS) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map, reader or key");
+
+        return result;
+    }
+
+    const map_t *table = rmap_read_begin(map, reader);
+    map_result_t get_res = map_get(table, key);
+    rmap_read_end(map, reader);
+
+    result.status = get_res.status;
+    result.value.element = get_res.value.element;
+    COPY_MSG(result, get_res.message);
+
+    return result;
+}
+
+/**
+ * rmap_reclaim
+ *  @map: a non-null read-mostly map
+ *
+ *  Frees the retired tables that no reader can still observe, that is
+ *  the ones retired before the oldest epoch announced by an active reader.
+ *  Must be called with the writer lock held
+ */
+static void rmap_reclaim(rmap_t *map) {
+    uint64_t oldest = UINT64_MAX;
+
+    for (size_t idx = 0; idx < RMAP_MAX_READERS; idx++) {
+        const uint64_t epoch = __atomic_load_n(&map->state->readers[idx].data.epoch, __ATOMIC_SEQ_CST);
+
+        if (epoch != 0 && epoch < oldest) {
+            oldest = epoch;
+        }
+    }
+
+    rmap_retired_t **link = &map->state->retired;
+    while (*link != NULL) {
+        rmap_retired_t *node = *link;
+
+        if (node->epoch < oldest) {
+            *link = node->next;
+            map_destroy(node->map);
+            free(node);
+        } else {
+            link = &node->next;
+        }
+    }
+}
+
+/**
+ * rmap_publish
+ *  @map: a non-null read-mostly map
+ *  @table: the new table
+ *
+ *  Swaps the published table with @table, then retires the previous
+ *  one and starts a new epoch. Must be called with the writer lock held
+ *
+ *  Returns MAP_OK on success
+ */
+static map_status_t rmap_publish(rmap_t *map, map_t *table) {
+    rmap_retired_t *node = malloc(sizeof(rmap_retired_t));
+    if (node == NULL) {
+        return MAP_ERR_ALLOCATE;
+    }
+
+    const uint64_t epoch = __atomic_load_n(&map->epoch, __ATOMIC_RELAXED);
+
+    node->map = __atomic_exchange_n(&map->current, table, __ATOMIC_SEQ_CST);
+    node->epoch = epoch;
+    node->next = map->state->retired;
+    map->state->retired = node;
+
+    // Readers announcing the new epoch are guaranteed to load the new table
+    __atomic_store_n(&map->epoch, epoch + 1, __ATOMIC_SEQ_CST);
+
+    rmap_reclaim(map);
+
+    return MAP_OK;
+}
+
+/**
+ * rmap_add_batch
+ *  @map: a non-null read-mostly map
+ *  @keys: an array of @count strings
+ *  @values: an array of @count generic values
+ *  @count: number of pairs to add
+ *
+ *  Adds every (key, value) pair to a private copy of the published table
+ *  and then publishes the copy. Resizing happens on the copy as well, so
+ *  readers are never stopped. Writers are serialized by a mutex
+ *
+ *  Returns a cmap_result_t data type containing the status
+ */
+cmap_result_t rmap_add_batch(rmap_t *map, const char *const *keys, void *const *values, size_t count) {
+    cmap_result_t result = {0};
+
+    if (map == NULL || (count > 0 && (keys == NULL || values == NULL))) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map, keys or values");
+
+        return result;
+    }
+
+    pthread_mutex_lock(&map->state->lock);
+
+    map_result_t clone_res = map_clone(map->current);
+    if (clone_res.status != MAP_OK) {
+        pthread_mutex_unlock(&map->state->lock);
+        result.status = clone_res.status;
+        COPY_MSG(result, clone_res.message);
+
+        return result;
+    }
+
+    map_t *table = clone_res.value.map;
+    map_result_t add_res = map_add_batch(table, keys, values, count, NULL);
+    if (add_res.status != MAP_OK) {
+        map_destroy(table);
+        pthread_mutex_unlock(&map->state->lock);
+        result.status = add_res.status;
+        COPY_MSG(result, add_res.message);
+
+        return result;
+    }
+
+    result.status = rmap_publish(map, table);
+    pthread_mutex_unlock(&map->state->lock);
+
+    if (result.status != MAP_OK) {
+        map_destroy(table);
+        SET_MSG(result, "Failed to retire map table");
+    } else {
+        SET_MSG(result, "Elements successfully added");
+    }
+
+    return result;
+}
+
+/**
+ * rmap_add
+ *  @map: a non-null read-mostly map
+ *  @key: a string representing the index key
+ *  @value: a generic value to add to the map
+ *
+ *  Adds (@key, @value) to @map. Each call copies the whole table,
+ *  use rmap_add_batch to apply several updates at once
+ *
+ *  Returns a cmap_result_t data type containing the status
+ */
+cmap_result_t rmap_add(rmap_t *map, const char *key, void *value) {
+    cmap_result_t result = {0};
+
+    if (key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    return rmap_add_batch(map, &key, &value, 1);
+}
+
+/**
+ * rmap_remove
+ *  @map: a non-null read-mostly map
+ *  @key: a string representing the index key
+ *
+ *  Removes an element indexed by @key from a private copy
+ *  of the published table and then publishes the copy
+ *
+ *  Returns a cmap_result_t data type
+ */
+cmap_result_t rmap_remove(rmap_t *map, const char *key) {
+    cmap_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    pthread_mutex_lock(&map->state->lock);
+
+    // Writers are serialized, so the published table is stable here
+    if (map_get(map->current, key).status != MAP_OK) {
+        pthread_mutex_unlock(&map->state->lock);
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    map_result_t clone_res = map_clone(map->current);
+    if (clone_res.status != MAP_OK) {
+        pthread_mutex_unlock(&map->state->lock);
+        result.status = clone_res.status;
+        COPY_MSG(result, clone_res.message);
+
+        return result;
+    }
+
+    map_t *table = clone_res.value.map;
+    map_remove(table, key);
+
+    result.status = rmap_publish(map, table);
+    pthread_mutex_unlock(&map->state->lock);
+
+    if (result.status != MAP_OK) {
+        map_destroy(table);
+        SET_MSG(result, "Failed to retire map table");
+    } else {
+        SET_MSG(result, "Key successfully deleted");
+    }
+
+    return result;
+}
+
+/**
+ * rmap_destroy
+ *  @map: a non-null read-mostly map
+ *
+ *  Deletes the map, its retired tables and its state from the memory.
+ *  No other thread may be using @map
+ *
+ *  Returns a cmap_result_t data type
+ */
+cmap_result_t rmap_destroy(rmap_t *map) {
+    cmap_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    rmap_retired_t *node = map->state->retired;
+    while (node != NULL) {
+        rmap_retired_t *next = node->next;
+        map_destroy(node->map);
+        free(node);
+        node = next;
+    }
+
+    pthread_mutex_destroy(&map->state->lock);
+    map_destroy(map->current);
+    free(map->state);
+    free(map);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully deleted");
+
+    return result;
+}
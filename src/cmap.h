@@ -0,0 +1,73 @@
+#ifndef CMAP_H
+#define CMAP_H
+
+#define RESULT_MSG_SIZE 64
+
+// Default number of shards, must be a power of two
+#define CMAP_DEFAULT_SHARDS 64
+// Each shard is padded to this size to avoid false sharing
+#define CMAP_SHARD_SIZE 128
+// Maximum number of threads registered on a read-mostly map
+#define RMAP_MAX_READERS 64
+
+#include <stdint.h>
+#include <stddef.h>
+#include "map.h"
+
+// Shards embed a POSIX lock, their layout is private to cmap.c
+typedef struct cmap_shard cmap_shard_t;
+
+typedef struct {
+    cmap_shard_t *shards;
+    size_t shard_count;
+    unsigned shard_bits;
+} cmap_t;
+
+// Writer lock, reader slots and retired tables, private to cmap.c
+typedef struct rmap_state rmap_state_t;
+
+typedef struct {
+    map_t *current; // Published table, replaced atomically by writers
+    uint64_t epoch;
+    rmap_state_t *state;
+} rmap_t;
+
+typedef struct {
+    map_status_t status;
+    uint8_t message[RESULT_MSG_SIZE];
+    union {
+        cmap_t *map;
+        rmap_t *rmap;
+        size_t reader;
+        void *element;
+    } value;
+} cmap_result_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+cmap_result_t cmap_new(size_t shard_count);
+cmap_result_t cmap_add(cmap_t *map, const char *key, void *value);
+cmap_result_t cmap_get(cmap_t *map, const char *key);
+cmap_result_t cmap_remove(cmap_t *map, const char *key);
+cmap_result_t cmap_clear(cmap_t *map);
+cmap_result_t cmap_destroy(cmap_t *map);
+size_t cmap_size(cmap_t *map);
+
+cmap_result_t rmap_new(void);
+cmap_result_t rmap_register(rmap_t *map);
+cmap_result_t rmap_unregister(rmap_t *map, size_t reader);
+const map_t *rmap_read_begin(rmap_t *map, size_t reader);
+void rmap_read_end(rmap_t *map, size_t reader);
+cmap_result_t rmap_get(rmap_t *map, size_t reader, const char *key);
+cmap_result_t rmap_add(rmap_t *map, const char *key, void *value);
+cmap_result_t rmap_add_batch(rmap_t *map, const char *const *keys, void *const *values, size_t count);
+cmap_result_t rmap_remove(rmap_t *map, const char *key);
+cmap_result_t rmap_destroy(rmap_t *map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
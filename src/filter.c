@@ -0,0 +1,868 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define SET_MSG(result, msg) \
+    do { \
+        snprintf((char *)(result).message, RESULT_MSG_SIZE, "%s", (const char *)msg); \
+    } while (0)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "filter.h"
+
+#define FILTER_LN2 0.69314718055994530942
+// bloom_bits_for_fpr aims below the target, since the rate measured on a given set of keys varies around its expectation
+#define FILTER_FPR_MARGIN 0.9
+
+/**
+ * filter_log
+ *  @x: a positive number
+ *
+ *  Returns the natural logarithm of @x, without depending on libm
+ */
+static double filter_log(double x) {
+    double exponent = 0.0;
+
+    while (x >= 2.0) { x /= 2.0; exponent += 1.0; }
+    while (x < 1.0) { x *= 2.0; exponent -= 1.0; }
+
+    // ln(x) = 2 * atanh((x - 1) / (x + 1)), which converges quickly for x in [1, 2)
+    const double y = (x - 1.0) / (x + 1.0);
+    double term = y, sum = 0.0;
+    for (int idx = 1; idx < 40; idx += 2) {
+        sum += term / idx;
+        term *= y * y;
+    }
+
+    return 2.0 * sum + exponent * FILTER_LN2;
+}
+
+/**
+ * filter_exp
+ *  @x: a number lower than 700
+ *
+ *  Returns e^@x, without depending on libm
+ */
+static double filter_exp(double x) {
+    // e^x = 2^n * e^r with r in [0, ln(2))
+    double n = 0.0;
+    while (x >= FILTER_LN2) { x -= FILTER_LN2; n += 1.0; }
+    while (x < 0.0) { x += FILTER_LN2; n -= 1.0; }
+
+    double term = 1.0, sum = 1.0;
+    for (int idx = 1; idx < 20; idx++) {
+        term *= x / idx;
+        sum += term;
+    }
+
+    for (; n > 0.0; n -= 1.0) { sum *= 2.0; }
+    for (; n < 0.0; n += 1.0) { sum /= 2.0; }
+
+    return sum;
+}
+
+/**
+ * bloom_hash_count
+ *  @bits_per_key: number of bits reserved for each key
+ *
+ *  Returns the number of bits set for each key, k = ln(2) * @bits_per_key
+ *  rounded and clamped to [1, FILTER_MAX_HASHES], which minimizes the false positive rate
+ */
+static uint32_t bloom_hash_count(double bits_per_key) {
+    const double hashes = bits_per_key * FILTER_LN2 + 0.5;
+
+    return hashes < 1.0 ? 1 : (hashes > FILTER_MAX_HASHES ? FILTER_MAX_HASHES : (uint32_t)hashes);
+}
+
+/**
+ * bloom_blocked_fpr
+ *  @bits_per_key: number of bits reserved for each key
+ *
+ *  The keys of a blocked filter are spread unevenly over the blocks: the
+ *  number of keys of a block follows a Poisson distribution of mean
+ *  FILTER_BLOCK_BITS / @bits_per_key, and the crowded blocks answer most
+ *  of the false positives. The FPR of each block occupancy is weighted
+ *  by its probability
+ *
+ *  Returns the expected false positive rate of a full filter
+ */
+static double bloom_blocked_fpr(double bits_per_key) {
+    const uint32_t hashes = bloom_hash_count(bits_per_key);
+    const double mean = FILTER_BLOCK_BITS / bits_per_key;
+
+    // Probability that a bit stays clear after one more key is added to its block
+    const double clear_step = filter_exp(hashes * filter_log(1.0 - 1.0 / FILTER_BLOCK_BITS));
+
+    double weight = filter_exp(-mean); // Probability of an empty block
+    double clear = 1.0;
+    double fpr = 0.0;
+    for (size_t keys = 0; keys < 2 * (size_t)mean + 100; keys++) {
+        if (keys > 0) {
+            weight *= mean / keys;
+            clear *= clear_step;
+        }
+
+        double block_fpr = 1.0;
+        for (uint32_t idx = 0; idx < hashes; idx++) {
+            block_fpr *= 1.0 - clear;
+        }
+        fpr += weight * block_fpr;
+    }
+
+    return fpr;
+}
+
+/**
+ * bloom_bits_for_fpr
+ *  @fpr: the target false positive rate, between 0 and 1
+ *
+ *  The optimal Bloom filter needs log2(1 / @fpr) / ln(2) bits per key, but
+ *  blocking all the bits of a key in one cache line loses some accuracy, and
+ *  more so for low rates. Starting from the optimal size, the bits per key are
+ *  increased by 1/16 until the expected FPR of the blocked filter drops to
+ *  FILTER_FPR_MARGIN times @fpr
+ *
+ *  Returns the number of bits per key to pass to bloom_new, 0 if @fpr is invalid
+ *  or 64 if @fpr cannot be reached by a blocked filter
+ */
+double bloom_bits_for_fpr(double fpr) {
+    if (!(fpr > 0.0 && fpr < 1.0)) {
+        return 0.0;
+    }
+
+    double bits_per_key = -filter_log(fpr) / (FILTER_LN2 * FILTER_LN2);
+    if (bits_per_key < 1.0) {
+        bits_per_key = 1.0;
+    }
+
+    while (bits_per_key < 64.0 && bloom_blocked_fpr(bits_per_key) > fpr * FILTER_FPR_MARGIN) {
+        bits_per_key += 1.0 / 16.0;
+    }
+
+    return bits_per_key < 64.0 ? bits_per_key : 64.0;
+}
+
+/**
+ * bloom_new
+ *  @capacity: the expected number of keys
+ *  @bits_per_key: number of bits reserved for each key (see bloom_bits_for_fpr)
+ *
+ *  Returns a filter_result_t data type containing a new empty Bloom filter
+ */
+filter_result_t bloom_new(size_t capacity, double bits_per_key) {
+    filter_result_t result = {0};
+
+    if (!(bits_per_key > 0.0 && bits_per_key <= 64.0)) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid number of bits per key");
+
+        return result;
+    }
+
+    const double bits = (double)(capacity ? capacity : 1) * bits_per_key;
+    const double blocks = bits / FILTER_BLOCK_BITS + 1.0;
+    if (blocks > (double)UINT32_MAX) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Filter capacity is too big");
+
+        return result;
+    }
+
+    bloom_t *bloom = malloc(sizeof(bloom_t));
+    if (bloom == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for filter");
+
+        return result;
+    }
+
+    bloom->block_count = (size_t)blocks;
+    bloom->size = 0;
+
+    bloom->hash_count = bloom_hash_count(bits_per_key);
+
+    void *blocks_memory = NULL;
+    if (posix_memalign(&blocks_memory, FILTER_CACHE_LINE, bloom->block_count * (FILTER_BLOCK_BITS / 8)) != 0) {
+        free(bloom);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for filter blocks");
+
+        return result;
+    }
+
+    bloom->blocks = blocks_memory;
+    memset(bloom->blocks, 0, bloom->block_count * (FILTER_BLOCK_BITS / 8));
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Filter successfully created");
+    result.value.bloom = bloom;
+
+    return result;
+}
+
+/**
+ * bloom_block
+ *  @bloom: a non-null Bloom filter
+ *  @digest: the mixed digest of a key
+ *
+ *  Returns the block of the key with @digest
+ */
+static inline uint64_t *bloom_block(const bloom_t *bloom, uint64_t digest) {
+    const size_t idx = (size_t)(((digest >> 32) * bloom->block_count) >> 32);
+
+    return bloom->blocks + (idx * FILTER_BLOCK_WORDS);
+}
+
+/**
+ * bloom_add_bytes
+ *  @bloom: a non-null Bloom filter
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  Returns a filter_result_t data type containing the status
+ */
+filter_result_t bloom_add_bytes(bloom_t *bloom, const void *key, size_t key_len) {
+    filter_result_t result = {0};
+
+    if (bloom == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid filter or key");
+
+        return result;
+    }
+
+    // The digest is mixed again since FNV-1a barely changes its high bits on short keys
+    const uint64_t digest = map_hash_int(map_hash(key, key_len));
+    uint64_t *block = bloom_block(bloom, digest);
+
+    // Each position takes 9 bits of a hash word, which is rehashed once they run out.
+    // Unlike double hashing, distinct keys almost never share all of their positions
+    uint64_t word = map_hash_int(digest);
+    uint64_t bits = word;
+    for (uint32_t idx = 0; idx < bloom->hash_count; idx++) {
+        if (idx > 0 && idx % FILTER_POSITIONS_PER_WORD == 0) {
+            word = map_hash_int(word);
+            bits = word;
+        }
+
+        const uint32_t pos = (uint32_t)bits & (FILTER_BLOCK_BITS - 1);
+        block[pos >> 6] |= (uint64_t)1 << (pos & 63);
+        bits >>= FILTER_POSITION_BITS;
+    }
+
+    bloom->size++;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Key successfully added");
+
+    return result;
+}
+
+/**
+ * bloom_add
+ *  @bloom: a non-null Bloom filter
+ *  @key: a string
+ *
+ *  Returns a filter_result_t data type containing the status
+ */
+filter_result_t bloom_add(bloom_t *bloom, const char *key) {
+    if (key == NULL) {
+        return bloom_add_bytes(bloom, NULL, 0);
+    }
+
+    return bloom_add_bytes(bloom, key, strlen(key));
+}
+
+/**
+ * bloom_contains_bytes
+ *  @bloom: a Bloom filter
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  Reads a single cache line of the filter
+ *
+ *  Returns false if @key was never added to @bloom, true if it may have been
+ */
+bool bloom_contains_bytes(const bloom_t *bloom, const void *key, size_t key_len) {
+    if (bloom == NULL || key == NULL) {
+        return false;
+    }
+
+    const uint64_t digest = map_hash_int(map_hash(key, key_len));
+    const uint64_t *block = bloom_block(bloom, digest);
+
+    // No early exit: the block is already in cache and the bit tests are cheaper than mispredicted branches
+    uint64_t word = map_hash_int(digest);
+    uint64_t bits = word;
+    uint64_t found = 1;
+    for (uint32_t idx = 0; idx < bloom->hash_count; idx++) {
+        if (idx > 0 && idx % FILTER_POSITIONS_PER_WORD == 0) {
+            word = map_hash_int(word);
+            bits = word;
+        }
+
+        const uint32_t pos = (uint32_t)bits & (FILTER_BLOCK_BITS - 1);
+        found &= block[pos >> 6] >> (pos & 63);
+        bits >>= FILTER_POSITION_BITS;
+    }
+
+    return found != 0;
+}
+
+/**
+ * bloom_contains
+ *  @bloom: a Bloom filter
+ *  @key: a string
+ *
+ *  Returns false if @key was never added to @bloom, true if it may have been
+ */
+bool bloom_contains(const bloom_t *bloom, const char *key) {
+    if (key == NULL) {
+        return false;
+    }
+
+    return bloom_contains_bytes(bloom, key, strlen(key));
+}
+
+/**
+ * bloom_clear
+ *  @bloom: a non-null Bloom filter
+ *
+ *  Returns a filter_result_t data type containing the status
+ */
+filter_result_t bloom_clear(bloom_t *bloom) {
+    filter_result_t result = {0};
+
+    if (bloom == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid filter");
+
+        return result;
+    }
+
+    memset(bloom->blocks, 0, bloom->block_count * (FILTER_BLOCK_BITS / 8));
+    bloom->size = 0;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Filter successfully cleared");
+
+    return result;
+}
+
+/**
+ * bloom_destroy
+ *  @bloom: a Bloom filter
+ *
+ *  Returns a filter_result_t data type containing the status
+ */
+filter_result_t bloom_destroy(bloom_t *bloom) {
+    filter_result_t result = {0};
+
+    if (bloom == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid filter");
+
+        return result;
+    }
+
+    free(bloom->blocks);
+    free(bloom);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Filter successfully deleted");
+
+    return result;
+}
+
+/**
+ * fuse_mulhi
+ *  @x: a 64-bit integer
+ *  @y: a 64-bit integer
+ *
+ *  Returns the high 64 bits of the 128-bit product of @x and @y
+ */
+static inline uint64_t fuse_mulhi(uint64_t x, uint64_t y) {
+    const uint64_t x_lo = (uint32_t)x, x_hi = x >> 32;
+    const uint64_t y_lo = (uint32_t)y, y_hi = y >> 32;
+    const uint64_t lo_lo = x_lo * y_lo, hi_lo = x_hi * y_lo;
+    const uint64_t lo_hi = x_lo * y_hi, hi_hi = x_hi * y_hi;
+    const uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+
+    return (hi_lo >> 32) + (cross >> 32) + hi_hi;
+}
+
+/**
+ * fuse_key_hash
+ *  @seed: the seed of the filter
+ *  @digest: the digest of a key
+ *
+ *  Returns the hash of the key for the filter with @seed
+ */
+static inline uint64_t fuse_key_hash(uint64_t seed, uint64_t digest) {
+    return map_hash_int(digest + seed);
+}
+
+/**
+ * fuse_positions
+ *  @fuse: a non-null binary fuse filter
+ *  @hash: the hash of a key
+ *  @positions: receives the three slots of the key
+ *
+ *  The slots belong to three consecutive segments, the first of which is
+ *  chosen by the high bits of @hash
+ */
+static inline void fuse_positions(const fuse_t *fuse, uint64_t hash, uint32_t *positions) {
+    const uint32_t mask = fuse->segment_length - 1;
+
+    positions[0] = (uint32_t)fuse_mulhi(hash, fuse->segment_count_length);
+    positions[1] = (positions[0] + fuse->segment_length) ^ ((uint32_t)(hash >> 18) & mask);
+    positions[2] = (positions[0] + 2 * fuse->segment_length) ^ ((uint32_t)hash & mask);
+}
+
+/**
+ * fuse_fingerprint
+ *  @hash: the hash of a key
+ *
+ *  Returns the fingerprint of the key, truncated by the caller
+ */
+static inline uint32_t fuse_fingerprint(uint64_t hash) {
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+/**
+ * fuse_get
+ *  @fuse: a non-null binary fuse filter
+ *  @slot: a slot of the filter
+ *
+ *  Returns the fingerprint stored at @slot
+ */
+static inline uint32_t fuse_get(const fuse_t *fuse, uint32_t slot) {
+    return fuse->fingerprint_bits == 8 ? ((const uint8_t*)fuse->fingerprints)[slot]
+                                       : ((const uint16_t*)fuse->fingerprints)[slot];
+}
+
+static int compare_digests(const void *x, const void *y) {
+    const uint64_t a = *(const uint64_t*)x, b = *(const uint64_t*)y;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * fuse_layout
+ *  @fuse: a non-null binary fuse filter
+ *  @size: number of distinct keys
+ *
+ *  Computes the segment length and the number of slots of @fuse,
+ *  following the parameters of 3-wise binary fuse filters
+ */
+static void fuse_layout(fuse_t *fuse, size_t size) {
+    // Segment length: 2^floor(log_3.33(size) + 2.25)
+    const double exponent = size > 1 ? filter_log((double)size) / filter_log(3.33) + 2.25 : 2.25;
+    fuse->segment_length = (uint32_t)1 << (exponent > 18.0 ? 18 : (uint32_t)exponent);
+    if (fuse->segment_length > FUSE_MAX_SEGMENT_LENGTH) {
+        fuse->segment_length = FUSE_MAX_SEGMENT_LENGTH;
+    }
+
+    // Small filters need proportionally more slots to be peeled successfully
+    double size_factor = 0.0;
+    if (size > 1) {
+        size_factor = 0.875 + 0.25 * filter_log(1000000.0) / filter_log((double)size);
+        size_factor = size_factor < 1.125 ? 1.125 : size_factor;
+    }
+
+    const size_t capacity = (size_t)((double)size * size_factor + 0.5);
+    const size_t total_segments = (capacity + fuse->segment_length - 1) / fuse->segment_length;
+    const uint32_t segment_count = total_segments > 2 ? (uint32_t)(total_segments - 2) : 1;
+
+    fuse->segment_count_length = segment_count * fuse->segment_length;
+    fuse->array_length = (segment_count + 2) * fuse->segment_length;
+}
+
+/**
+ * fuse_build
+ *  @fuse: a binary fuse filter with its layout and fingerprints array
+ *  @digests: @size distinct key digests
+ *  @size: number of keys
+ *
+ *  Assigns each key to one of its three slots by peeling the hypergraph
+ *  of the keys, then stores the fingerprints in reverse peeling order so
+ *  that the three slots of each key xor to its fingerprint. A new seed is
+ *  tried whenever the graph cannot be fully peeled
+ *
+ *  Returns MAP_OK on success, MAP_ERR_ALLOCATE or MAP_ERR_OVERFLOW otherwise
+ */
+static map_status_t fuse_build(fuse_t *fuse, const uint64_t *digests, size_t size) {
+    const uint32_t length = fuse->array_length;
+    const uint32_t segment_count = fuse->segment_count_length / fuse->segment_length;
+
+    uint32_t block_bits = 1;
+    while (((uint32_t)1 << block_bits) < segment_count) {
+        block_bits++;
+    }
+    const size_t block = (size_t)1 << block_bits;
+
+    uint64_t *reverse_order = calloc(size + 1, sizeof(uint64_t));
+    uint8_t *reverse_h = malloc(size);
+    uint8_t *t2count = calloc(length, sizeof(uint8_t));
+    uint64_t *t2hash = calloc(length, sizeof(uint64_t));
+    uint32_t *alone = malloc(length * sizeof(uint32_t));
+    size_t *start_pos = malloc(block * sizeof(size_t));
+    map_status_t status = MAP_ERR_OVERFLOW;
+
+    if (reverse_order == NULL || reverse_h == NULL || t2count == NULL ||
+        t2hash == NULL || alone == NULL || start_pos == NULL) {
+        status = MAP_ERR_ALLOCATE;
+        goto cleanup;
+    }
+
+    uint64_t rng = FNV_OFFSET_BASIS_64;
+    reverse_order[size] = 1; // Sentinel that stops the bucketing below
+
+    for (size_t attempt = 0; attempt < FUSE_MAX_ATTEMPTS; attempt++) {
+        rng += 0x9E3779B97F4A7C15ULL;
+        fuse->seed = map_hash_int(rng);
+
+        // Sort the hashes by segment, so that the counts below are updated
+        // with a cache friendly access pattern
+        for (size_t idx = 0; idx < block; idx++) {
+            start_pos[idx] = (size_t)(((uint64_t)idx * size) >> block_bits);
+        }
+
+        for (size_t idx = 0; idx < size; idx++) {
+            const uint64_t hash = fuse_key_hash(fuse->seed, digests[idx]);
+            size_t segment = (size_t)(hash >> (64 - block_bits));
+            while (reverse_order[start_pos[segment]] != 0) {
+                segment = (segment + 1) & (block - 1);
+            }
+            reverse_order[start_pos[segment]] = hash;
+            start_pos[segment]++;
+        }
+
+        // Each slot counts its keys (times 4) and xors their hashes and their position (0, 1 or 2)
+        bool overflow = false;
+        uint32_t positions[3];
+        for (size_t idx = 0; idx < size; idx++) {
+            const uint64_t hash = reverse_order[idx];
+            fuse_positions(fuse, hash, positions);
+
+            for (uint32_t which = 0; which < 3; which++) {
+                t2count[positions[which]] += 4;
+                t2count[positions[which]] ^= (uint8_t)which;
+                t2hash[positions[which]] ^= hash;
+                overflow = overflow || t2count[positions[which]] < 4;
+            }
+        }
+
+        size_t stack_size = 0;
+        if (!overflow) {
+            // Peel the slots holding a single key
+            size_t queue_size = 0;
+            for (uint32_t idx = 0; idx < length; idx++) {
+                alone[queue_size] = idx;
+                queue_size += (t2count[idx] >> 2) == 1;
+            }
+
+            while (queue_size > 0) {
+                const uint32_t slot = alone[--queue_size];
+                if ((t2count[slot] >> 2) != 1) {
+                    continue;
+                }
+
+                const uint64_t hash = t2hash[slot];
+                const uint8_t found = t2count[slot] & 3;
+                reverse_h[stack_size] = found;
+                reverse_order[stack_size] = hash;
+                stack_size++;
+
+                fuse_positions(fuse, hash, positions);
+                for (uint32_t other = 1; other < 3; other++) {
+                    const uint32_t which = (found + other) % 3;
+                    const uint32_t index = positions[which];
+
+                    alone[queue_size] = index;
+                    queue_size += (t2count[index] >> 2) == 2;
+                    t2count[index] -= 4;
+                    t2count[index] ^= (uint8_t)which;
+                    t2hash[index] ^= hash;
+                }
+            }
+        }
+
+        if (stack_size == size) {
+            status = MAP_OK;
+            break;
+        }
+
+        memset(reverse_order, 0, size * sizeof(uint64_t));
+        memset(t2count, 0, length);
+        memset(t2hash, 0, length * sizeof(uint64_t));
+    }
+
+    if (status != MAP_OK) {
+        goto cleanup;
+    }
+
+    // The slot a key was peeled from is the last one of the key to be assigned
+    uint32_t positions[3];
+    for (size_t idx = size; idx-- > 0;) {
+        const uint64_t hash = reverse_order[idx];
+        const uint32_t found = reverse_h[idx];
+        fuse_positions(fuse, hash, positions);
+
+        const uint32_t value = fuse_fingerprint(hash) ^
+                               fuse_get(fuse, positions[(found + 1) % 3]) ^
+                               fuse_get(fuse, positions[(found + 2) % 3]);
+        if (fuse->fingerprint_bits == 8) {
+            ((uint8_t*)fuse->fingerprints)[positions[found]] = (uint8_t)value;
+        } else {
+            ((uint16_t*)fuse->fingerprints)[positions[found]] = (uint16_t)value;
+        }
+    }
+
+cleanup:
+    free(reverse_order);
+    free(reverse_h);
+    free(t2count);
+    free(t2hash);
+    free(alone);
+    free(start_pos);
+
+    return status;
+}
+
+/**
+ * fuse_from_hashes
+ *  @hashes: an array of key digests, as returned by map_hash
+ *  @count: number of digests
+ *  @fingerprint_bits: size of the fingerprints, 8 or 16 bits
+ *
+ *  Builds a static binary fuse filter with a false positive rate of
+ *  2^-@fingerprint_bits, using about 1.13 * @fingerprint_bits bits per key.
+ *  Duplicated digests are dropped
+ *
+ *  Returns a filter_result_t data type containing the new filter
+ */
+filter_result_t fuse_from_hashes(const uint64_t *hashes, size_t count, uint32_t fingerprint_bits) {
+    filter_result_t result = {0};
+
+    if ((hashes == NULL && count > 0) || (fingerprint_bits != 8 && fingerprint_bits != 16)) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid keys or fingerprint size");
+
+        return result;
+    }
+
+    if (count > UINT32_MAX / 2) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Too many keys for filter");
+
+        return result;
+    }
+
+    fuse_t *fuse = malloc(sizeof(fuse_t));
+    uint64_t *digests = malloc((count ? count : 1) * sizeof(uint64_t));
+    if (fuse == NULL || digests == NULL) {
+        free(fuse);
+        free(digests);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for filter");
+
+        return result;
+    }
+
+    // Duplicated keys would never be peeled
+    size_t size = 0;
+    if (count > 0) {
+        memcpy(digests, hashes, count * sizeof(uint64_t));
+        qsort(digests, count, sizeof(uint64_t), compare_digests);
+        for (size_t idx = 0; idx < count; idx++) {
+            if (size == 0 || digests[size - 1] != digests[idx]) {
+                digests[size++] = digests[idx];
+            }
+        }
+    }
+
+    fuse->seed = 0;
+    fuse->size = size;
+    fuse->fingerprint_bits = fingerprint_bits;
+    fuse_layout(fuse, size);
+    fuse->fingerprints = calloc(fuse->array_length, fingerprint_bits / 8);
+
+    map_status_t status = fuse->fingerprints == NULL ? MAP_ERR_ALLOCATE : MAP_OK;
+    if (status == MAP_OK && size > 0) {
+        status = fuse_build(fuse, digests, size);
+    }
+
+    free(digests);
+
+    if (status != MAP_OK) {
+        free(fuse->fingerprints);
+        free(fuse);
+        result.status = status;
+        SET_MSG(result, (status == MAP_ERR_ALLOCATE ?
+                "Failed to allocate memory for filter" : "Failed to build the filter"));
+
+        return result;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Filter successfully created");
+    result.value.fuse = fuse;
+
+    return result;
+}
+
+/**
+ * fuse_from_map
+ *  @map: a non-null map
+ *  @fingerprint_bits: size of the fingerprints, 8 or 16 bits
+ *
+ *  Returns a filter_result_t data type containing a new filter with the keys of @map
+ */
+filter_result_t fuse_from_map(const map_t *map, uint32_t fingerprint_bits) {
+    filter_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    uint64_t *digests = malloc((map_size(map) ? map_size(map) : 1) * sizeof(uint64_t));
+    if (digests == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for filter");
+
+        return result;
+    }
+
+    size_t count = 0;
+    map_iter_t iter = map_iter_begin(map);
+    while (map_iter_next(&iter)) {
+        digests[count++] = map_hash(iter.key, iter.key_len);
+    }
+
+    result = fuse_from_hashes(digests, count, fingerprint_bits);
+    free(digests);
+
+    return result;
+}
+
+/**
+ * fuse_from_vector
+ *  @vector: a non-null vector
+ *  @fingerprint_bits: size of the fingerprints, 8 or 16 bits
+ *
+ *  Each element is hashed as a key of data_size bytes, so it
+ *  can be queried with fuse_contains_bytes
+ *
+ *  Returns a filter_result_t data type containing a new filter with the elements of @vector
+ */
+filter_result_t fuse_from_vector(const vector_t *vector, uint32_t fingerprint_bits) {
+    filter_result_t result = {0};
+
+    if (vector == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid vector");
+
+        return result;
+    }
+
+    uint64_t *digests = malloc((vector->size ? vector->size : 1) * sizeof(uint64_t));
+    if (digests == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for filter");
+
+        return result;
+    }
+
+    const uint8_t *elements = vector->elements;
+    for (size_t idx = 0; idx < vector->size; idx++) {
+        digests[idx] = map_hash(elements + (idx * vector->data_size), vector->data_size);
+    }
+
+    result = fuse_from_hashes(digests, vector->size, fingerprint_bits);
+    free(digests);
+
+    return result;
+}
+
+/**
+ * fuse_contains_hash
+ *  @fuse: a binary fuse filter
+ *  @hash: the digest of a key, as returned by map_hash
+ *
+ *  Returns false if the key was not in the filter keys, true if it may have been
+ */
+bool fuse_contains_hash(const fuse_t *fuse, uint64_t hash) {
+    if (fuse == NULL || fuse->size == 0) {
+        return false;
+    }
+
+    const uint64_t key_hash = fuse_key_hash(fuse->seed, hash);
+    uint32_t positions[3];
+    fuse_positions(fuse, key_hash, positions);
+
+    const uint32_t value = fuse_fingerprint(key_hash) ^ fuse_get(fuse, positions[0]) ^
+                           fuse_get(fuse, positions[1]) ^ fuse_get(fuse, positions[2]);
+
+    return (value & (((uint32_t)1 << fuse->fingerprint_bits) - 1)) == 0;
+}
+
+/**
+ * fuse_contains_bytes
+ *  @fuse: a binary fuse filter
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  Returns false if @key was not in the filter keys, true if it may have been
+ */
+bool fuse_contains_bytes(const fuse_t *fuse, const void *key, size_t key_len) {
+    if (key == NULL) {
+        return false;
+    }
+
+    return fuse_contains_hash(fuse, map_hash(key, key_len));
+}
+
+/**
+ * fuse_contains
+ *  @fuse: a binary fuse filter
+ *  @key: a string
+ *
+ *  Returns false if @key was not in the filter keys, true if it may have been
+ */
+bool fuse_contains(const fuse_t *fuse, const char *key) {
+    if (key == NULL) {
+        return false;
+    }
+
+    return fuse_contains_bytes(fuse, key, strlen(key));
+}
+
+/**
+ * fuse_destroy
+ *  @fuse: a binary fuse filter
+ *
+ *  Returns a filter_result_t data type containing the status
+ */
+filter_result_t fuse_destroy(fuse_t *fuse) {
+    filter_result_t result = {0};
+
+    if (fuse == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid filter");
+
+        return result;
+    }
+
+    free(fuse->fingerprints);
+    free(fuse);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Filter successfully deleted");
+
+    return result;
+}
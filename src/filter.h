@@ -0,0 +1,93 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#define RESULT_MSG_SIZE 64
+
+// Blocked Bloom filters set all the bits of a key in a single
+// FILTER_BLOCK_BITS block, that is one cache line
+#define FILTER_CACHE_LINE 64
+#define FILTER_BLOCK_BITS 512
+#define FILTER_BLOCK_WORDS (FILTER_BLOCK_BITS / 64)
+// Bits of a position inside a block and positions drawn from each 64-bit hash word
+#define FILTER_POSITION_BITS 9
+#define FILTER_POSITIONS_PER_WORD (64 / FILTER_POSITION_BITS)
+#define FILTER_MAX_HASHES 16
+// Binary fuse filters: maximum segment length and construction attempts
+#define FUSE_MAX_SEGMENT_LENGTH 262144
+#define FUSE_MAX_ATTEMPTS 100
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "map.h"
+#include "vector.h"
+
+typedef struct {
+    uint64_t *blocks; // block_count blocks of FILTER_BLOCK_WORDS words
+    size_t block_count;
+    uint32_t hash_count; // Bits set by each key
+    size_t size;
+} bloom_t;
+
+typedef struct {
+    uint64_t seed;
+    size_t size;
+    uint32_t fingerprint_bits; // 8 or 16
+    uint32_t segment_length;
+    uint32_t segment_count_length;
+    uint32_t array_length;
+    void *fingerprints; // array_length fingerprints of fingerprint_bits bits
+} fuse_t;
+
+typedef struct {
+    map_status_t status;
+    uint8_t message[RESULT_MSG_SIZE];
+    union {
+        bloom_t *bloom;
+        fuse_t *fuse;
+    } value;
+} filter_result_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+filter_result_t bloom_new(size_t capacity, double bits_per_key);
+filter_result_t bloom_add(bloom_t *bloom, const char *key);
+filter_result_t bloom_add_bytes(bloom_t *bloom, const void *key, size_t key_len);
+bool bloom_contains(const bloom_t *bloom, const char *key);
+bool bloom_contains_bytes(const bloom_t *bloom, const void *key, size_t key_len);
+filter_result_t bloom_clear(bloom_t *bloom);
+filter_result_t bloom_destroy(bloom_t *bloom);
+double bloom_bits_for_fpr(double fpr);
+
+filter_result_t fuse_from_map(const map_t *map, uint32_t fingerprint_bits);
+filter_result_t fuse_from_vector(const vector_t *vector, uint32_t fingerprint_bits);
+filter_result_t fuse_from_hashes(const uint64_t *hashes, size_t count, uint32_t fingerprint_bits);
+bool fuse_contains(const fuse_t *fuse, const char *key);
+bool fuse_contains_bytes(const fuse_t *fuse, const void *key, size_t key_len);
+bool fuse_contains_hash(const fuse_t *fuse, uint64_t hash);
+filter_result_t fuse_destroy(fuse_t *fuse);
+
+// Inline methods
+static inline size_t bloom_size(const bloom_t *bloom) {
+    return bloom ? bloom->size : 0;
+}
+
+static inline size_t bloom_memory(const bloom_t *bloom) {
+    return bloom ? bloom->block_count * (FILTER_BLOCK_BITS / 8) : 0;
+}
+
+static inline size_t fuse_size(const fuse_t *fuse) {
+    return fuse ? fuse->size : 0;
+}
+
+static inline size_t fuse_memory(const fuse_t *fuse) {
+    return fuse ? (size_t)fuse->array_length * (fuse->fingerprint_bits / 8) : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
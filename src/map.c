@@ -1,380 +1,2622 @@
+#define _POSIX_C_SOURCE 200809L
+
 #define SET_MSG(result, msg) \
     do { \
         snprintf((char *)(result).message, RESULT_MSG_SIZE, "%s", (const char *)msg); \
     } while (0)
 
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define PREFETCH(addr) ((void)(addr))
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "map.h"
 
 /**
  * hash_key
- *  @key: The input string for the hash function
+ *  @key: The input bytes for the hash function
+ *  @key_len: length of @key in bytes
  *
  *  Returns the digest of @key using the Fowler-Noll-Vo hashing algorithm
  */
-static uint64_t hash_key(const char *key) {
+static uint64_t hash_key(const char *key, size_t key_len) {
     uint64_t hash = FNV_OFFSET_BASIS_64;
 
-    while (*key) {
-        hash ^= (uint64_t)*(key++);
+    for (size_t idx = 0; idx < key_len; idx++) {
+        hash ^= (uint64_t)(unsigned char)key[idx];
         hash *= FNV_PRIME_64;
     }
 
     return hash;
 }
 
+/**
+ * map_ctrl_tag
+ *  @key_digest: the digest of a key
+ *
+ *  Returns the control byte of an occupied slot holding a key with @key_digest
+ */
+static inline uint8_t map_ctrl_tag(uint64_t key_digest) {
+    return (uint8_t)(MAP_CTRL_OCCUPIED | (key_digest >> 57));
+}
+
+/**
+ * map_ctrl_size
+ *  @capacity: number of slots
+ *
+ *  Returns the number of control bytes allocated for @capacity slots
+ */
+static inline size_t map_ctrl_size(size_t capacity) {
+    return (capacity + MAP_GROUP_SIZE - 1) & ~(size_t)(MAP_GROUP_SIZE - 1);
+}
+
+/**
+ * map_element_key
+ *  @map: a non-null map
+ *  @element: an occupied slot of @map
+ *
+ *  Returns a pointer to the key of @element, either stored
+ *  inline in the slot or in the key arena
+ */
+static inline const char *map_element_key(const map_t *map, const map_element_t *element) {
+    return (element->key_len <= MAP_INLINE_KEY_MAX) ?
+            element->key.inline_key : map->key_arena + element->key.offset;
+}
+
+/**
+ * map_key_equals
+ *  @map: a non-null map
+ *  @element: an occupied slot of @map
+ *  @key: the key to compare
+ *  @key_len: length of @key in bytes
+ *
+ *  Returns 1 if @element is indexed by @key, 0 otherwise
+ */
+static inline int map_key_equals(const map_t *map, const map_element_t *element,
+                                 const char *key, size_t key_len) {
+    return element->key_len == key_len &&
+           !memcmp(map_element_key(map, element), key, key_len);
+}
+
+/**
+ * map_value_at
+ *  @map: a non-null map
+ *  @idx: a slot index
+ *
+ *  Returns a pointer to the value storage of slot @idx
+ */
+static inline uint8_t *map_value_at(const map_t *map, size_t idx) {
+    return map->values + (idx * map->value_size);
+}
+
+/**
+ * map_values_size
+ *  @capacity: number of slots
+ *  @value_size: number of bytes reserved for each value
+ *
+ *  Returns the number of bytes to allocate for the values of @capacity slots.
+ *  Maps that only store keys still get a one byte array, so that
+ *  the zero-length copies of their values never use a null pointer
+ */
+static inline size_t map_values_size(size_t capacity, size_t value_size) {
+    return value_size > 0 ? capacity * value_size : 1;
+}
+
+/**
+ * map_store_value
+ *  @map: a non-null map
+ *  @idx: a slot index
+ *  @value: the value to store
+ *
+ *  Copies the pointed value into slot @idx if @map owns its values,
+ *  otherwise stores the @value pointer itself
+ */
+static inline void map_store_value(map_t *map, size_t idx, void *value) {
+    if (map->owns_values) {
+        if (map->value_size > 0) {
+            memcpy(map_value_at(map, idx), value, map->value_size);
+        }
+    } else {
+        memcpy(map_value_at(map, idx), &value, sizeof(void*));
+    }
+}
+
+/**
+ * map_value_from
+ *  @map: a non-null map
+ *  @storage: the value storage of an occupied slot
+ *
+ *  Returns @storage if @map owns its values,
+ *  otherwise the pointer stored by the caller
+ */
+static inline void *map_value_from(const map_t *map, uint8_t *storage) {
+    if (map->owns_values) {
+        return storage;
+    }
+
+    void *value;
+    memcpy(&value, storage, sizeof(void*));
+
+    return value;
+}
+
+/**
+ * map_load_value
+ *  @map: a non-null map
+ *  @idx: index of an occupied slot
+ *
+ *  Returns a pointer into the value array if @map owns its values,
+ *  otherwise the pointer stored by the caller
+ */
+static inline void *map_load_value(const map_t *map, size_t idx) {
+    return map_value_from(map, map_value_at(map, idx));
+}
+
 /**
  * map_insert_index
  *  @map: a non-null map
- *  @key: a string representing the key to find 
+ *  @key: the key to find
+ *  @key_len: length of @key in bytes
+ *  @key_digest: the digest of @key
  *  
  *  Finds next available slot for insertion (empty or deleted)
  *  or the slot containing an existing key
  *
  *  Returns the index of available slot or SIZE_MAX otherwise
  */
-static size_t map_insert_index(const map_t *map, const char *key) {
-    const uint64_t key_digest = hash_key(key);
-    size_t idx = key_digest % map->capacity;
+static size_t map_insert_index(const map_t *map, const char *key, size_t key_len, uint64_t key_digest) {
+    const uint8_t tag = map_ctrl_tag(key_digest);
+    const size_t mask = map->capacity - 1; // Capacity is a power of two
+    size_t idx = key_digest & mask;
     size_t delete_tracker = map->capacity; // Fallback index
 
     for (size_t probes = 0; probes < map->capacity; probes++) {
-        if (map->elements[idx].state == ENTRY_EMPTY) {
+        const uint8_t ctrl = map->ctrl[idx];
+
+        if (ctrl == MAP_CTRL_EMPTY) {
             return (delete_tracker != map->capacity) ? delete_tracker : idx;
         }
 
-        if (map->elements[idx].state == ENTRY_OCCUPIED) {
-            if (!strcmp(map->elements[idx].key, key)) {
+        if (ctrl == tag) {
+            if (map_key_equals(map, &map->elements[idx], key, key_len)) {
                 return idx;
             }
-        } else if (map->elements[idx].state == ENTRY_DELETED) {
+        } else if (ctrl == MAP_CTRL_DELETED) {
             if (delete_tracker == map->capacity) {
                 delete_tracker = idx;
             }
         }
 
-        idx = (idx + 1) % map->capacity;
+        idx = (idx + 1) & mask;
     }
 
-    return SIZE_MAX;
+    return (delete_tracker != map->capacity) ? delete_tracker : SIZE_MAX;
 }
 
 /**
- * @map: a non-null map
+ * map_compact_arena
+ *  @map: a non-null map
+ *  @reserve: number of free bytes to reserve at the end of the arena
  *
- * Increases the size of @map
+ *  Moves the long keys of @map into a new arena, dropping the bytes
+ *  held by removed keys and updating the offsets of the slots
  *
- * Returns a a map_result_t data type containing the status
+ *  Returns a map_result_t data type containing the status
  */
-static map_result_t map_resize(map_t *map) {
+static map_result_t map_compact_arena(map_t *map, size_t reserve) {
     map_result_t result = {0};
 
-    const size_t old_capacity = map->capacity;
-    const size_t old_size = map->size;
-    const size_t old_tombstone = map->tombstone_count;
-    map_element_t *old_elements = map->elements;
-
-    if (map->capacity > SIZE_MAX / 2) {
+    const size_t live_size = map->arena_size - map->arena_garbage;
+    if (live_size > SIZE_MAX - reserve) {
         result.status = MAP_ERR_OVERFLOW;
-        SET_MSG(result, "Capacity overflow on map resize");
+        SET_MSG(result, "Key arena overflow");
 
         return result;
     }
 
-    map->capacity *= 2;
-    map->elements = calloc(map->capacity, sizeof(map_element_t));
-    if (map->elements == NULL) {
-        // Restore old parameters if resize failed
-        map->capacity = old_capacity;
-        map->elements = old_elements;
+    size_t new_capacity = MAP_INITIAL_ARENA_CAP;
+    while (new_capacity < live_size + reserve) {
+        if (new_capacity > SIZE_MAX / 2) {
+            result.status = MAP_ERR_OVERFLOW;
+            SET_MSG(result, "Key arena overflow");
+
+            return result;
+        }
+
+        new_capacity *= 2;
+    }
 
+    char *new_arena = malloc(new_capacity);
+    if (new_arena == NULL) {
         result.status = MAP_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to reallocate memory for map");
+        SET_MSG(result, "Failed to allocate memory for key arena");
 
         return result;
     }
 
-    map->size = 0;
-    map->tombstone_count = 0;
+    size_t arena_size = 0;
+    for (size_t idx = 0; idx < map->capacity; idx++) {
+        map_element_t *element = &map->elements[idx];
 
-    // Rehash all existing elements
-    for (size_t idx = 0; idx < old_capacity; idx++) {
-        if (old_elements[idx].state == ENTRY_OCCUPIED) {
-            size_t new_idx = map_insert_index(map, old_elements[idx].key);
-            if (new_idx == SIZE_MAX) {
-                // if we can't find a free slot, restore previous state and fail
-                free(map->elements);
-                map->elements = old_elements;
-                map->capacity = old_capacity;
-                map->size = old_size;
-                map->tombstone_count = old_tombstone;
-                result.status = MAP_ERR_OVERFLOW;
-                SET_MSG(result, "Failed to rehash elements during resize");
-
-                return result;
-            }
+        if ((map->ctrl[idx] & MAP_CTRL_OCCUPIED) && element->key_len > MAP_INLINE_KEY_MAX) {
+            memcpy(new_arena + arena_size, map->key_arena + element->key.offset, element->key_len + 1);
+            element->key.offset = arena_size;
+            arena_size += element->key_len + 1;
+        }
+    }
 
-            map->elements[new_idx] = old_elements[idx];
-            map->size++;
+    // Keys that still live in the table being migrated share the same arena
+    for (size_t idx = 0; map->old_ctrl != NULL && idx < map->old_capacity; idx++) {
+        map_element_t *element = &map->old_elements[idx];
+
+        if ((map->old_ctrl[idx] & MAP_CTRL_OCCUPIED) && element->key_len > MAP_INLINE_KEY_MAX) {
+            memcpy(new_arena + arena_size, map->key_arena + element->key.offset, element->key_len + 1);
+            element->key.offset = arena_size;
+            arena_size += element->key_len + 1;
         }
     }
 
-    free(old_elements);
+    free(map->key_arena);
+    map->key_arena = new_arena;
+    map->arena_size = arena_size;
+    map->arena_capacity = new_capacity;
+    map->arena_garbage = 0;
 
     result.status = MAP_OK;
-    SET_MSG(result, "Map successfully resized");
+    SET_MSG(result, "Key arena successfully compacted");
 
     return result;
 }
 
 /**
- * map_new
+ * map_store_key
+ *  @map: a non-null map
+ *  @element: the slot that will hold the key
+ *  @key: the key to copy
+ *  @key_len: length of @key in bytes
  *
- * Returns a map_result_t data type containing a new hash map
+ *  Copies @key inside @element if it is short enough,
+ *  otherwise appends it (NUL-terminated) to the key arena
+ *
+ *  Returns MAP_OK on success or the error status otherwise
  */
-map_result_t map_new(void) {
-    map_result_t result = {0};
-
-    map_t *map = malloc(sizeof(map_t));
-    if (map == NULL) {
-        result.status = MAP_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for map");
+static map_status_t map_store_key(map_t *map, map_element_t *element, const char *key, size_t key_len) {
+    if (key_len <= MAP_INLINE_KEY_MAX) {
+        memcpy(element->key.inline_key, key, key_len);
+        element->key.inline_key[key_len] = '\0';
+        element->key_len = (uint32_t)key_len;
 
-        return result;
+        return MAP_OK;
     }
 
-    map->elements = calloc(INITIAL_CAP, sizeof(map_element_t));
-    if (map->elements == NULL) {
-        free(map);
-        result.status = MAP_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for map elements");
+    const size_t needed = key_len + 1;
+    if (map->arena_capacity - map->arena_size < needed) {
+        if (map->arena_garbage > map->arena_size / 2) {
+            // Reclaim the space of removed keys instead of growing
+            map_result_t compact_res = map_compact_arena(map, needed);
+            if (compact_res.status != MAP_OK) {
+                return compact_res.status;
+            }
+        }
 
-        return result;
-    }
+        if (map->arena_capacity - map->arena_size < needed) {
+            size_t new_capacity = map->arena_capacity ? map->arena_capacity : MAP_INITIAL_ARENA_CAP;
+            while (new_capacity - map->arena_size < needed) {
+                if (new_capacity > SIZE_MAX / 2) {
+                    return MAP_ERR_OVERFLOW;
+                }
 
-    // Initialize map
-    map->capacity = INITIAL_CAP;
-    map->size = 0;
-    map->tombstone_count = 0;
+                new_capacity *= 2;
+            }
 
-    result.status = MAP_OK;
-    SET_MSG(result, "Map successfully created");
-    result.value.map = map;
+            char *new_arena = realloc(map->key_arena, new_capacity);
+            if (new_arena == NULL) {
+                return MAP_ERR_ALLOCATE;
+            }
 
-    return result;
+            map->key_arena = new_arena;
+            map->arena_capacity = new_capacity;
+        }
+    }
+
+    memcpy(map->key_arena + map->arena_size, key, key_len);
+    map->key_arena[map->arena_size + key_len] = '\0';
+    element->key.offset = map->arena_size;
+    element->key_len = (uint32_t)key_len;
+    map->arena_size += needed;
+
+    return MAP_OK;
 }
 
 /**
- * map_add
+ * map_rehash
  *  @map: a non-null map
- *  @key: a string representing the index key
- *  @value: a generic value to add to the map
+ *  @new_capacity: the capacity of the new table, a power of two holding every key
  *
- *  Adds (@key, @value) to @map
+ *  Moves the keys of @map into a new table without tombstones
  *
- *  Returns a map_result_t data type containing the status 
+ *  Returns a map_result_t data type containing the status
  */
-map_result_t map_add(map_t *map, const char *key, void *value) {
+static map_result_t map_rehash(map_t *map, size_t new_capacity) {
     map_result_t result = {0};
 
-    if (map == NULL || key == NULL) {
-        result.status = MAP_ERR_INVALID;
-        SET_MSG(result, "Invalid map or key");
-
-        return result;
-    }
+    const size_t old_capacity = map->capacity;
+    uint8_t *old_ctrl = map->ctrl;
+    map_element_t *old_elements = map->elements;
+    uint8_t *old_values = map->values;
 
-    // Check whether there's enough space available
-    const double load_factor = (double)(map->size + map->tombstone_count) / map->capacity;
-    if (load_factor > LOAD_FACTOR_THRESHOLD) {
-        result = map_resize(map);
-        if (result.status != MAP_OK) {
-            return result;
-        }
-    }
+    uint8_t *new_ctrl = calloc(map_ctrl_size(new_capacity), sizeof(uint8_t));
+    map_element_t *new_elements = malloc(new_capacity * sizeof(map_element_t));
+    uint8_t *new_values = malloc(map_values_size(new_capacity, map->value_size));
+    if (new_ctrl == NULL || new_elements == NULL || new_values == NULL) {
+        free(new_ctrl);
+        free(new_elements);
+        free(new_values);
 
-    // Find next available slot for insertion
-    size_t idx = map_insert_index(map, key);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to reallocate memory for map");
 
-    // if index is SIZE_MAX then the map is full
-    if (idx == SIZE_MAX) {
-        map_result_t resize_res = map_resize(map);
-        if (resize_res.status != MAP_OK) {
-            result.status = MAP_ERR_OVERFLOW;
-            SET_MSG(result, "The map is full and resize has failed");
+        return result;
+    }
 
-            return result;
-        }
+    map->ctrl = new_ctrl;
+    map->elements = new_elements;
+    map->values = new_values;
+    map->capacity = new_capacity;
+    map->tombstone_count = 0;
 
-        idx = map_insert_index(map, key);
+    // Rehash all existing elements. The new table has no tombstones and
+    // enough room for every key, so the first empty slot is the right one
+    for (size_t idx = 0; idx < old_capacity; idx++) {
+        if (old_ctrl[idx] & MAP_CTRL_OCCUPIED) {
+            const char *key = map_element_key(map, &old_elements[idx]);
+            const uint64_t key_digest = hash_key(key, old_elements[idx].key_len);
 
-        // This is very uncommon but still...
-        if (idx == SIZE_MAX) {
-            result.status = MAP_ERR_OVERFLOW;
-            SET_MSG(result, "The map is full after resize(!)");
+            size_t new_idx = key_digest & (new_capacity - 1);
+            while (map->ctrl[new_idx] != MAP_CTRL_EMPTY) {
+                new_idx = (new_idx + 1) & (new_capacity - 1);
+            }
 
-            return result;
+            map->ctrl[new_idx] = old_ctrl[idx];
+            map->elements[new_idx] = old_elements[idx];
+            memcpy(map_value_at(map, new_idx), old_values + (idx * map->value_size), map->value_size);
         }
     }
 
-    // If slot is occupied, it means that the key already exists.
-    // Therefore we can update it
-    if (map->elements[idx].state == ENTRY_OCCUPIED) {
-        map->elements[idx].value = value;
-
-        result.status = MAP_OK;
-        SET_MSG(result, "Element successfully updated");
+    free(old_ctrl);
+    free(old_elements);
+    free(old_values);
 
-        return result;
+    // Drop the bytes of removed keys from the arena. If this fails,
+    // the old arena is still valid and we simply keep using it
+    if (map->arena_garbage > 0) {
+        map_compact_arena(map, 0);
     }
 
-    // Allocate a new key
-    char *new_key = malloc(strlen(key) + 1);
-    if (new_key == NULL) {
-        result.status = MAP_ERR_ALLOCATE;
-        SET_MSG(result, "Failed to allocate memory for map key");
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully resized");
 
-        return result;
-    }
+    return result;
+}
 
-    strcpy(new_key, key);
+/**
+ * map_can_double
+ *  @map: a non-null map
+ *
+ *  Returns true if the capacity of @map can be doubled without overflowing
+ */
+static inline bool map_can_double(const map_t *map) {
+    return map->capacity <= SIZE_MAX / 2 &&
+           (map->value_size == 0 || map->capacity * 2 <= SIZE_MAX / map->value_size);
+}
 
-    // If we're reusing a deleted slot, decrement the tombstone count
-    if (map->elements[idx].state == ENTRY_DELETED) {
-        if (map->tombstone_count > 0) { map->tombstone_count--; }
-    }
+/**
+ * map_resize
+ *  @map: a non-null map
+ *
+ *  Doubles the capacity of @map at once
+ *
+ *  Returns a map_result_t data type containing the status
+ */
+static map_result_t map_resize(map_t *map) {
+    map_result_t result = {0};
 
-    map->elements[idx].key = new_key;
-    map->elements[idx].value = value;
-    map->elements[idx].state = ENTRY_OCCUPIED;
-    map->size++;
+    if (!map_can_double(map)) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Capacity overflow on map resize");
 
-    result.status = MAP_OK;
-    SET_MSG(result, "Element successfully added");
+        return result;
+    }
 
-    return result;
+    return map_rehash(map, map->capacity * 2);
 }
 
 /**
- * map_find_index
- *  @map: a non-null map
- *  @key: a string representing the index key to find
+ * map_find_old
+ *  @map: a non-null map with a resize in progress
+ *  @key: the index key to find
+ *  @key_len: length of @key in bytes
+ *  @key_digest: the digest of @key
  *
- *  Finds the index where a key is located using linear probing to handle collisions
+ *  Finds a key that has not been migrated yet
  *
- *  Returns the index of the key if it is found or SIZE_MAX otherwise
+ *  Returns the index of the key in the old table if it is found or SIZE_MAX otherwise
  */
-size_t map_find_index(const map_t *map, const char *key) {
-    const uint64_t key_digest = hash_key(key);
-    const size_t start_idx = key_digest % map->capacity;
+static size_t map_find_old(const map_t *map, const char *key, size_t key_len, uint64_t key_digest) {
+    const uint8_t tag = map_ctrl_tag(key_digest);
+    const size_t mask = map->old_capacity - 1;
+    const size_t start_idx = key_digest & mask;
 
-    for (size_t probes = 0; probes < map->capacity; probes++) {
-        size_t idx = (start_idx + probes) % map->capacity;
+    for (size_t probes = 0; probes < map->old_capacity; probes++) {
+        size_t idx = (start_idx + probes) & mask;
 
-        if (map->elements[idx].state == ENTRY_EMPTY) {
-            // The key is not on the map
+        if (map->old_ctrl[idx] == MAP_CTRL_EMPTY) {
             return SIZE_MAX;
         }
 
-        if ((map->elements[idx].state == ENTRY_OCCUPIED) &&
-            (!strcmp(map->elements[idx].key, key))) {
-            // The key has been found
+        if ((map->old_ctrl[idx] == tag) &&
+            map_key_equals(map, &map->old_elements[idx], key, key_len)) {
             return idx;
         }
     }
 
-    // If we fail to find an ENTRY_EMPTY slot after probing the entire table,
-    // fall back by returning SIZE_MAX. This should never
-    // happen because the map is resized whenever an element is inserted or removed.
     return SIZE_MAX;
 }
 
 /**
- * map_get
- *  @map: a non-null map
- *  @key: a string representing the index key
+ * map_migrate
+ *  @map: a non-null map with a resize in progress
+ *  @steps: maximum number of old slots to visit
  *
- *  Returns a map_result_t data type containing the element indexed by @key if available
+ *  Moves the elements of the next @steps slots of the old table into the
+ *  new one. Migrated slots are marked as deleted, so the probe sequences of
+ *  the remaining keys stay intact. The old table is released once empty
  */
-map_result_t map_get(const map_t *map, const char *key) {
-    map_result_t result = {0};
+static void map_migrate(map_t *map, size_t steps) {
+    const size_t mask = map->capacity - 1;
 
-    if (map == NULL || key == NULL) {
-        result.status = MAP_ERR_INVALID;
-        SET_MSG(result, "Invalid map or key");
+    while (steps-- > 0 && map->migrate_index < map->old_capacity && map->old_size > 0) {
+        const size_t old_idx = map->migrate_index++;
 
-        return result;
-    }
+        if (!(map->old_ctrl[old_idx] & MAP_CTRL_OCCUPIED)) {
+            continue;
+        }
 
-    // Retrieve key index
-    const size_t idx = map_find_index(map, key);
+        // The key is not in the new table, so the first free slot is the right one
+        const map_element_t *element = &map->old_elements[old_idx];
+        const uint64_t key_digest = hash_key(map_element_key(map, element), element->key_len);
+        size_t idx = key_digest & mask;
+        while (map->ctrl[idx] & MAP_CTRL_OCCUPIED) {
+            idx = (idx + 1) & mask;
+        }
 
-    // If slot status is 'occupied' then the key exists
-    // otherwise the idx is set to SIZE_MAX
-    if (idx == SIZE_MAX) {
-        result.status = MAP_ERR_NOT_FOUND;
-        SET_MSG(result, "Element not found");
-    } else if (map->elements[idx].state == ENTRY_OCCUPIED) {
-        result.status = MAP_OK;
-        SET_MSG(result, "Value successfully retrieved");
-        result.value.element = map->elements[idx].value;
-    } else {
-        // Fallback case. Shouldn't happen but better safe than sorry
-        result.status = MAP_ERR_NOT_FOUND;
-        SET_MSG(result, "Element not found");
+        if (map->ctrl[idx] == MAP_CTRL_DELETED) {
+            map->tombstone_count--;
+        }
+
+        map->ctrl[idx] = map->old_ctrl[old_idx];
+        map->elements[idx] = *element;
+        memcpy(map_value_at(map, idx), map->old_values + (old_idx * map->value_size), map->value_size);
+
+        map->old_ctrl[old_idx] = MAP_CTRL_DELETED;
+        map->old_size--;
     }
 
-    return result;
+    if (map->migrate_index >= map->old_capacity || map->old_size == 0) {
+        free(map->old_ctrl);
+        free(map->old_elements);
+        free(map->old_values);
+        map->old_ctrl = NULL;
+        map->old_elements = NULL;
+        map->old_values = NULL;
+        map->old_capacity = 0;
+        map->old_size = 0;
+        map->migrate_index = 0;
+    }
 }
 
 /**
- * map_remove
- *  @map: a non-null map
- *  @key: a string representing the index key
+ * map_start_migration
+ *  @map: a non-null map without a resize in progress
+ *  @new_capacity: the capacity of the new table, a power of two holding every key
  *
- *  Removes an element indexed by @key from @map
+ *  Replaces the table of @map with an empty one of @new_capacity slots
+ *  and keeps the current table aside, to be migrated by map_migrate
  *
- *  Returns a map_result_t data type
+ *  Returns a map_result_t data type containing the status
  */
-map_result_t map_remove(map_t *map, const char *key) {
+static map_result_t map_start_migration(map_t *map, size_t new_capacity) {
     map_result_t result = {0};
 
-    if (map == NULL || key == NULL) {
-        result.status = MAP_ERR_INVALID;
-        SET_MSG(result, "Invalid map or key");
-
-        return result;
-    }
+    uint8_t *new_ctrl = calloc(map_ctrl_size(new_capacity), sizeof(uint8_t));
+    map_element_t *new_elements = malloc(new_capacity * sizeof(map_element_t));
+    uint8_t *new_values = malloc(map_values_size(new_capacity, map->value_size));
+    if (new_ctrl == NULL || new_elements == NULL || new_values == NULL) {
+        free(new_ctrl);
+        free(new_elements);
+        free(new_values);
 
-    const size_t idx = map_find_index(map, key);
-
-    if (idx == SIZE_MAX || map->elements[idx].state != ENTRY_OCCUPIED) {
-        result.status = MAP_ERR_NOT_FOUND;
-        SET_MSG(result, "Element not found");
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to reallocate memory for map");
 
         return result;
     }
 
-    // Remove element key
-    free(map->elements[idx].key);
+    map->old_ctrl = map->ctrl;
+    map->old_elements = map->elements;
+    map->old_values = map->values;
+    map->old_capacity = map->capacity;
+    map->old_size = map->size;
+    map->migrate_index = 0;
+
+    map->ctrl = new_ctrl;
+    map->elements = new_elements;
+    map->values = new_values;
+    map->capacity = new_capacity;
+    map->tombstone_count = 0;
 
-    // Remove element properties
-    map->elements[idx].key = NULL;
-    map->elements[idx].value = NULL;
-    map->elements[idx].state = ENTRY_DELETED;
+    result.status = MAP_OK;
+    SET_MSG(result, "Map resize started");
 
-    // Decrease map size and increase its tombstone count
-    map->size--;
+    return result;
+}
+
+/**
+ * map_grow
+ *  @map: a non-null map
+ *
+ *  Increases the size of @map, either at once or, in incremental mode,
+ *  by starting a migration. A migration still in progress is completed first.
+ *  Tables mostly filled by tombstones are rebuilt at the same capacity
+ *
+ *  Returns a map_result_t data type containing the status
+ */
+static map_result_t map_grow(map_t *map) {
+    map_result_t result = {0};
+
+    if (map->old_ctrl != NULL) {
+        map_migrate(map, SIZE_MAX);
+    }
+
+    // Under a steady flow of insertions and removals the table fills up
+    // with tombstones, which are purged without doubling the capacity
+    const bool purge = (double)map->size < map->capacity * LOAD_FACTOR_THRESHOLD / 2;
+    if (!purge && !map_can_double(map)) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Capacity overflow on map resize");
+
+        return result;
+    }
+
+    const size_t new_capacity = purge ? map->capacity : map->capacity * 2;
+
+    return map->incremental ? map_start_migration(map, new_capacity) : map_rehash(map, new_capacity);
+}
+
+/**
+ * map_create
+ *  @value_size: number of bytes reserved for each value
+ *  @owns_values: whether values are copied into the map
+ *
+ * Returns a map_result_t data type containing a new hash map
+ */
+static map_result_t map_create(size_t value_size, bool owns_values) {
+    map_result_t result = {0};
+
+    map_t *map = malloc(sizeof(map_t));
+    if (map == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map");
+
+        return result;
+    }
+
+    if (value_size > SIZE_MAX / INITIAL_CAP) {
+        free(map);
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Value size is too big");
+
+        return result;
+    }
+
+    map->ctrl = calloc(map_ctrl_size(INITIAL_CAP), sizeof(uint8_t));
+    map->elements = malloc(INITIAL_CAP * sizeof(map_element_t));
+    map->values = malloc(map_values_size(INITIAL_CAP, value_size));
+    if (map->ctrl == NULL || map->elements == NULL || map->values == NULL) {
+        free(map->ctrl);
+        free(map->elements);
+        free(map->values);
+        free(map);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map elements");
+
+        return result;
+    }
+
+    // Initialize map
+    map->value_size = value_size;
+    map->owns_values = owns_values;
+    map->capacity = INITIAL_CAP;
+    map->size = 0;
+    map->tombstone_count = 0;
+    map->key_arena = NULL;
+    map->arena_size = 0;
+    map->arena_capacity = 0;
+    map->arena_garbage = 0;
+    map->incremental = false;
+    map->old_ctrl = NULL;
+    map->old_elements = NULL;
+    map->old_values = NULL;
+    map->old_capacity = 0;
+    map->old_size = 0;
+    map->migrate_index = 0;
+    map->mapping = NULL;
+    map->mapping_size = 0;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully created");
+    result.value.map = map;
+
+    return result;
+}
+
+/**
+ * map_new
+ *
+ * Returns a map_result_t data type containing a new hash map
+ * that stores values by reference
+ */
+map_result_t map_new(void) {
+    return map_create(sizeof(void*), false);
+}
+
+/**
+ * map_new_sized
+ *  @value_size: size of each value in bytes
+ *
+ * Returns a map_result_t data type containing a new hash map
+ * that stores a copy of each value
+ */
+map_result_t map_new_sized(size_t value_size) {
+    map_result_t result = {0};
+
+    if (value_size == 0) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid value size");
+
+        return result;
+    }
+
+    return map_create(value_size, true);
+}
+
+/**
+ * map_new_keys
+ *
+ * Returns a map_result_t data type containing a new hash map
+ * that stores keys only. Values passed to map_add are ignored
+ * and may be NULL
+ */
+map_result_t map_new_keys(void) {
+    return map_create(0, true);
+}
+
+/**
+ * map_clone
+ *  @map: a non-null map
+ *
+ *  Copies the table of @map as it is, without rehashing any key.
+ *  Values stored by reference are shared between the two maps
+ *
+ * Returns a map_result_t data type containing the new hash map
+ */
+map_result_t map_clone(const map_t *map) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    map_t *clone = malloc(sizeof(map_t));
+    if (clone == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map");
+
+        return result;
+    }
+
+    *clone = *map;
+    clone->mapping = NULL;
+    clone->mapping_size = 0;
+    clone->old_ctrl = NULL;
+    clone->old_elements = NULL;
+    clone->old_values = NULL;
+    clone->ctrl = malloc(map_ctrl_size(map->capacity));
+    clone->elements = malloc(map->capacity * sizeof(map_element_t));
+    clone->values = malloc(map_values_size(map->capacity, map->value_size));
+    clone->key_arena = map->arena_capacity > 0 ? malloc(map->arena_capacity) : NULL;
+    if (clone->ctrl == NULL || clone->elements == NULL || clone->values == NULL ||
+        (map->arena_capacity > 0 && clone->key_arena == NULL)) {
+        free(clone->ctrl);
+        free(clone->elements);
+        free(clone->values);
+        free(clone->key_arena);
+        free(clone);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map elements");
+
+        return result;
+    }
+
+    memcpy(clone->ctrl, map->ctrl, map_ctrl_size(map->capacity));
+    memcpy(clone->elements, map->elements, map->capacity * sizeof(map_element_t));
+    memcpy(clone->values, map->values, map->capacity * map->value_size);
+    if (map->arena_size > 0) {
+        memcpy(clone->key_arena, map->key_arena, map->arena_size);
+    }
+
+    // Copy the table of an ongoing resize as well
+    if (map->old_ctrl != NULL) {
+        clone->old_ctrl = malloc(map_ctrl_size(map->old_capacity));
+        clone->old_elements = malloc(map->old_capacity * sizeof(map_element_t));
+        clone->old_values = malloc(map_values_size(map->old_capacity, map->value_size));
+        if (clone->old_ctrl == NULL || clone->old_elements == NULL || clone->old_values == NULL) {
+            map_destroy(clone);
+            result.status = MAP_ERR_ALLOCATE;
+            SET_MSG(result, "Failed to allocate memory for map elements");
+
+            return result;
+        }
+
+        memcpy(clone->old_ctrl, map->old_ctrl, map_ctrl_size(map->old_capacity));
+        memcpy(clone->old_elements, map->old_elements, map->old_capacity * sizeof(map_element_t));
+        memcpy(clone->old_values, map->old_values, map->old_capacity * map->value_size);
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully cloned");
+    result.value.map = clone;
+
+    return result;
+}
+
+/**
+ * map_set_incremental
+ *  @map: a non-null map
+ *  @enabled: whether the map should be resized incrementally
+ *
+ *  In incremental mode, growing the map only allocates the new table: the
+ *  elements are then moved MAP_MIGRATE_STEP slots at a time by each
+ *  insertion or removal, while lookups check both tables. This bounds
+ *  the latency of every update at the cost of slower lookups of keys
+ *  not yet migrated. Disabling the mode completes any ongoing migration
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t map_set_incremental(map_t *map, bool enabled) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    if (!enabled && map->old_ctrl != NULL) {
+        map_migrate(map, SIZE_MAX);
+    }
+
+    map->incremental = enabled;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Resize mode successfully updated");
+
+    return result;
+}
+
+/**
+ * map_add
+ *  @map: a non-null map
+ *  @key: a string representing the index key
+ *  @value: a generic value to add to the map
+ *
+ *  Adds (@key, @value) to @map. If @map owns its values,
+ *  the value_size bytes pointed by @value are copied
+ *
+ *  Returns a map_result_t data type containing the status 
+ */
+map_result_t map_add(map_t *map, const char *key, void *value) {
+    map_result_t result = {0};
+
+    if (key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    return map_add_bytes(map, key, strlen(key), value);
+}
+
+/**
+ * map_update_old
+ *  @map: a non-null map
+ *  @key: the index key
+ *  @key_len: length of @key in bytes
+ *  @key_digest: the digest of @key
+ *  @value: the new value
+ *
+ *  Updates @key in place if it still lives in the table being migrated
+ *
+ *  Returns true if @key was found in the old table, false otherwise
+ */
+static bool map_update_old(map_t *map, const char *key, size_t key_len, uint64_t key_digest, void *value) {
+    if (map->old_ctrl == NULL) {
+        return false;
+    }
+
+    const size_t old_idx = map_find_old(map, key, key_len, key_digest);
+    if (old_idx == SIZE_MAX) {
+        return false;
+    }
+
+    uint8_t *storage = map->old_values + (old_idx * map->value_size);
+    if (map->owns_values) {
+        if (map->value_size > 0) {
+            memcpy(storage, value, map->value_size);
+        }
+    } else {
+        memcpy(storage, &value, sizeof(void*));
+    }
+
+    return true;
+}
+
+/**
+ * map_put
+ *  @map: a non-null map
+ *  @key: the index key
+ *  @key_len: length of @key in bytes
+ *  @key_digest: the digest of @key
+ *  @value: a generic value to add to the map
+ *  @message: set to a static description of the outcome
+ *
+ *  Adds (@key, @value) to @map, growing it if needed
+ *
+ *  Returns MAP_OK on success or the error status otherwise
+ */
+static map_status_t map_put(map_t *map, const char *key, size_t key_len,
+                            uint64_t key_digest, void *value, const char **message) {
+    // Move a bounded number of slots of an ongoing resize
+    if (map->old_ctrl != NULL) {
+        map_migrate(map, MAP_MIGRATE_STEP);
+    }
+
+    // Check whether there's enough space available
+    const double load_factor = (double)(map->size + map->tombstone_count) / map->capacity;
+    if (load_factor > LOAD_FACTOR_THRESHOLD) {
+        map_result_t resize_res = map_grow(map);
+        if (resize_res.status != MAP_OK) {
+            *message = "Failed to resize the map";
+
+            return resize_res.status;
+        }
+    }
+
+    // Keys that have not been migrated yet are updated in place
+    if (map_update_old(map, key, key_len, key_digest, value)) {
+        *message = "Element successfully updated";
+
+        return MAP_OK;
+    }
+
+    // Find next available slot for insertion
+    size_t idx = map_insert_index(map, key, key_len, key_digest);
+
+    // if index is SIZE_MAX then the map is full
+    if (idx == SIZE_MAX) {
+        map_result_t resize_res = map_grow(map);
+        if (resize_res.status != MAP_OK) {
+            *message = "The map is full and resize has failed";
+
+            return MAP_ERR_OVERFLOW;
+        }
+
+        if (map_update_old(map, key, key_len, key_digest, value)) {
+            *message = "Element successfully updated";
+
+            return MAP_OK;
+        }
+
+        idx = map_insert_index(map, key, key_len, key_digest);
+
+        // This is very uncommon but still...
+        if (idx == SIZE_MAX) {
+            *message = "The map is full after resize(!)";
+
+            return MAP_ERR_OVERFLOW;
+        }
+    }
+
+    // If slot is occupied, it means that the key already exists.
+    // Therefore we can update it
+    if (map->ctrl[idx] & MAP_CTRL_OCCUPIED) {
+        map_store_value(map, idx, value);
+        *message = "Element successfully updated";
+
+        return MAP_OK;
+    }
+
+    // Copy the key inline or into the key arena
+    const map_status_t key_status = map_store_key(map, &map->elements[idx], key, key_len);
+    if (key_status != MAP_OK) {
+        *message = "Failed to store map key";
+
+        return key_status;
+    }
+
+    // If we're reusing a deleted slot, decrement the tombstone count
+    if (map->ctrl[idx] == MAP_CTRL_DELETED) {
+        if (map->tombstone_count > 0) { map->tombstone_count--; }
+    }
+
+    map_store_value(map, idx, value);
+    map->ctrl[idx] = map_ctrl_tag(key_digest);
+    map->size++;
+    *message = "Element successfully added";
+
+    return MAP_OK;
+}
+
+/**
+ * map_add_bytes
+ *  @map: a non-null map
+ *  @key: an arbitrary sequence of bytes representing the index key
+ *  @key_len: length of @key in bytes
+ *  @value: a generic value to add to the map
+ *
+ *  Adds (@key, @value) to @map. The key does not need to be NUL-terminated
+ *  and may contain NUL bytes
+ *
+ *  Returns a map_result_t data type containing the status 
+ */
+map_result_t map_add_bytes(map_t *map, const void *key, size_t key_len, void *value) {
+    return map_add_digest(map, key, key_len, key ? hash_key((const char*)key, key_len) : 0, value);
+}
+
+/**
+ * map_add_digest
+ *  @map: a non-null map
+ *  @key: an arbitrary sequence of bytes representing the index key
+ *  @key_len: length of @key in bytes
+ *  @key_digest: map_hash(@key, @key_len)
+ *  @value: a generic value to add to the map
+ *
+ *  Same as map_add_bytes, for callers that already hashed @key
+ *
+ *  Returns a map_result_t data type containing the status
+ */
+map_result_t map_add_digest(map_t *map, const void *key, size_t key_len, uint64_t key_digest, void *value) {
+    map_result_t result = {0};
+
+    if (map == NULL || key == NULL || (map->owns_values && map->value_size > 0 && value == NULL)) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map, key or value");
+
+        return result;
+    }
+
+    if (map->mapping != NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Memory-mapped maps are read-only");
+
+        return result;
+    }
+
+    if (key_len > UINT32_MAX) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Map key is too long");
+
+        return result;
+    }
+
+    const char *message = NULL;
+    result.status = map_put(map, (const char*)key, key_len, key_digest, value, &message);
+    SET_MSG(result, message);
+
+    return result;
+}
+
+/**
+ * map_find_digest
+ *  @map: a non-null map
+ *  @key: the index key to find
+ *  @key_len: length of @key in bytes
+ *  @key_digest: the digest of @key
+ *
+ *  Finds the index where a key is located using linear probing to handle collisions
+ *
+ *  Returns the index of the key if it is found or SIZE_MAX otherwise
+ */
+static size_t map_find_digest(const map_t *map, const char *key, size_t key_len, uint64_t key_digest) {
+    const uint8_t tag = map_ctrl_tag(key_digest);
+    const size_t mask = map->capacity - 1;
+    const size_t start_idx = key_digest & mask;
+
+    for (size_t probes = 0; probes < map->capacity; probes++) {
+        size_t idx = (start_idx + probes) & mask;
+
+        if (map->ctrl[idx] == MAP_CTRL_EMPTY) {
+            // The key is not on the map
+            return SIZE_MAX;
+        }
+
+        // Compare the keys only if the 7-bit tags match
+        if ((map->ctrl[idx] == tag) &&
+            map_key_equals(map, &map->elements[idx], key, key_len)) {
+            // The key has been found
+            return idx;
+        }
+    }
+
+    // If we fail to find an empty slot after probing the entire table,
+    // fall back by returning SIZE_MAX. This should never
+    // happen because the map is resized whenever an element is inserted or removed.
+    return SIZE_MAX;
+}
+
+/**
+ * map_find_index
+ *  @map: a non-null map
+ *  @key: the index key to find
+ *  @key_len: length of @key in bytes
+ *
+ *  Returns the index of the key if it is found or SIZE_MAX otherwise
+ */
+size_t map_find_index(const map_t *map, const char *key, size_t key_len) {
+    return map_find_digest(map, key, key_len, hash_key(key, key_len));
+}
+
+/**
+ * map_get
+ *  @map: a non-null map
+ *  @key: a string representing the index key
+ *
+ *  Returns a map_result_t data type containing the element indexed by @key if available.
+ *  If @map owns its values, the element points inside the map and remains valid
+ *  until the next insertion, removal or clear
+ */
+map_result_t map_get(const map_t *map, const char *key) {
+    map_result_t result = {0};
+
+    if (key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    return map_get_bytes(map, key, strlen(key));
+}
+
+/**
+ * map_get_bytes
+ *  @map: a non-null map
+ *  @key: an arbitrary sequence of bytes representing the index key
+ *  @key_len: length of @key in bytes
+ *
+ *  Returns a map_result_t data type containing the element indexed by @key if available
+ */
+map_result_t map_get_bytes(const map_t *map, const void *key, size_t key_len) {
+    return map_get_digest(map, key, key_len, key ? hash_key((const char*)key, key_len) : 0);
+}
+
+/**
+ * map_get_digest
+ *  @map: a non-null map
+ *  @key: an arbitrary sequence of bytes representing the index key
+ *  @key_len: length of @key in bytes
+ *  @key_digest: map_hash(@key, @key_len)
+ *
+ *  Same as map_get_bytes, for callers that already hashed @key
+ *
+ *  Returns a map_result_t data type containing the element indexed by @key if available
+ */
+map_result_t map_get_digest(const map_t *map, const void *key, size_t key_len, uint64_t key_digest) {
+    map_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    // Retrieve key index
+    const size_t idx = map_find_digest(map, (const char*)key, key_len, key_digest);
+
+    // If slot status is 'occupied' then the key exists
+    // otherwise the idx is set to SIZE_MAX
+    if (idx == SIZE_MAX) {
+        // During a resize, the key may not have been migrated yet
+        const size_t old_idx = map->old_ctrl ? map_find_old(map, (const char*)key, key_len, key_digest) : SIZE_MAX;
+
+        if (old_idx == SIZE_MAX) {
+            result.status = MAP_ERR_NOT_FOUND;
+            SET_MSG(result, "Element not found");
+        } else {
+            result.status = MAP_OK;
+            SET_MSG(result, "Value successfully retrieved");
+            result.value.element = map_value_from(map, map->old_values + (old_idx * map->value_size));
+        }
+    } else if (map->ctrl[idx] & MAP_CTRL_OCCUPIED) {
+        result.status = MAP_OK;
+        SET_MSG(result, "Value successfully retrieved");
+        result.value.element = map_load_value(map, idx);
+    } else {
+        // Fallback case. Shouldn't happen but better safe than sorry
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+    }
+
+    return result;
+}
+
+/**
+ * map_prefetch_slot
+ *  @map: a non-null map
+ *  @key_digest: the digest of a key
+ *
+ *  Hints the CPU to load the home slot of a key (control byte,
+ *  element and value) into the cache
+ */
+static inline void map_prefetch_slot(const map_t *map, uint64_t key_digest) {
+    const size_t idx = key_digest & (map->capacity - 1);
+
+    PREFETCH(&map->ctrl[idx]);
+    PREFETCH(&map->elements[idx]);
+    PREFETCH(map_value_at(map, idx));
+}
+
+/**
+ * map_add_batch
+ *  @map: a non-null map
+ *  @keys: an array of @count strings representing the index keys
+ *  @values: an array of @count generic values
+ *  @count: number of pairs to add
+ *  @out_status: an optional array of @count statuses, one for each pair
+ *
+ *  Adds the (@keys[i], @values[i]) pairs to @map. The map is grown once
+ *  up front, then keys are hashed and their home slots prefetched
+ *  MAP_BATCH_SIZE at a time, so that the cache misses of the
+ *  insertions overlap instead of being serialized
+ *
+ *  Returns a map_result_t data type. The status is MAP_OK if every pair
+ *  was added, otherwise the status of the first failed insertion
+ */
+map_result_t map_add_batch(map_t *map, const char *const *keys, void *const *values,
+                           size_t count, map_status_t *out_status) {
+    map_result_t result = {0};
+
+    if (map == NULL || (count > 0 && (keys == NULL || values == NULL))) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map, keys or values");
+
+        return result;
+    }
+
+    if (map->mapping != NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Memory-mapped maps are read-only");
+
+        return result;
+    }
+
+    // Make room for the whole batch, assuming that every key is new.
+    // Incremental maps keep growing one step at a time instead
+    while (!map->incremental && count <= SIZE_MAX - map->size - map->tombstone_count &&
+           (double)(map->size + map->tombstone_count + count) / map->capacity > LOAD_FACTOR_THRESHOLD) {
+        map_result_t resize_res = map_resize(map);
+        if (resize_res.status != MAP_OK) {
+            // Individual insertions will retry to grow the map
+            break;
+        }
+    }
+
+    size_t key_lens[MAP_BATCH_SIZE];
+    uint64_t digests[MAP_BATCH_SIZE];
+    result.status = MAP_OK;
+
+    for (size_t start = 0; start < count; start += MAP_BATCH_SIZE) {
+        const size_t chunk = (count - start) < MAP_BATCH_SIZE ? (count - start) : MAP_BATCH_SIZE;
+
+        // First pass: hash all keys and prefetch their home slots
+        for (size_t idx = 0; idx < chunk; idx++) {
+            const char *key = keys[start + idx];
+            if (key == NULL) {
+                continue;
+            }
+
+            key_lens[idx] = strlen(key);
+            digests[idx] = hash_key(key, key_lens[idx]);
+            map_prefetch_slot(map, digests[idx]);
+        }
+
+        // Second pass: probe and insert
+        for (size_t idx = 0; idx < chunk; idx++) {
+            const char *key = keys[start + idx];
+            void *value = values[start + idx];
+            const char *message = NULL;
+            map_status_t status;
+
+            if (key == NULL || (map->owns_values && map->value_size > 0 && value == NULL)) {
+                status = MAP_ERR_INVALID;
+            } else if (key_lens[idx] > UINT32_MAX) {
+                status = MAP_ERR_OVERFLOW;
+            } else {
+                status = map_put(map, key, key_lens[idx], digests[idx], value, &message);
+            }
+
+            if (out_status) { out_status[start + idx] = status; }
+            if (status != MAP_OK && result.status == MAP_OK) { result.status = status; }
+        }
+    }
+
+    if (result.status == MAP_OK) {
+        SET_MSG(result, "Elements successfully added");
+    } else {
+        SET_MSG(result, "Some elements could not be added");
+    }
+
+    return result;
+}
+
+/**
+ * map_get_batch
+ *  @map: a non-null map
+ *  @keys: an array of @count strings representing the index keys
+ *  @count: number of keys to look up
+ *  @out_values: an array of @count elements that receives the values
+ *  @out_status: an optional array of @count statuses, one for each key
+ *
+ *  Looks up @keys in @map. Keys are hashed and their home slots prefetched
+ *  MAP_BATCH_SIZE at a time before probing, so that the cache misses of
+ *  the lookups overlap instead of being serialized. Missing keys
+ *  yield a NULL value and MAP_ERR_NOT_FOUND
+ *
+ *  Returns a map_result_t data type. The status is MAP_OK if every key
+ *  was found, otherwise the status of the first failed lookup
+ */
+map_result_t map_get_batch(const map_t *map, const char *const *keys, size_t count,
+                           void **out_values, map_status_t *out_status) {
+    map_result_t result = {0};
+
+    if (map == NULL || (count > 0 && (keys == NULL || out_values == NULL))) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map, keys or output array");
+
+        return result;
+    }
+
+    size_t key_lens[MAP_BATCH_SIZE];
+    uint64_t digests[MAP_BATCH_SIZE];
+    result.status = MAP_OK;
+
+    for (size_t start = 0; start < count; start += MAP_BATCH_SIZE) {
+        const size_t chunk = (count - start) < MAP_BATCH_SIZE ? (count - start) : MAP_BATCH_SIZE;
+
+        // First pass: hash all keys and prefetch their home slots
+        for (size_t idx = 0; idx < chunk; idx++) {
+            const char *key = keys[start + idx];
+            if (key == NULL) {
+                continue;
+            }
+
+            key_lens[idx] = strlen(key);
+            digests[idx] = hash_key(key, key_lens[idx]);
+            map_prefetch_slot(map, digests[idx]);
+        }
+
+        // Second pass: probe
+        for (size_t idx = 0; idx < chunk; idx++) {
+            const char *key = keys[start + idx];
+            map_status_t status = MAP_ERR_INVALID;
+            void *value = NULL;
+
+            if (key != NULL) {
+                const size_t slot = map_find_digest(map, key, key_lens[idx], digests[idx]);
+                const size_t old_slot = (slot == SIZE_MAX && map->old_ctrl) ?
+                                        map_find_old(map, key, key_lens[idx], digests[idx]) : SIZE_MAX;
+                if (slot != SIZE_MAX) {
+                    status = MAP_OK;
+                    value = map_load_value(map, slot);
+                } else if (old_slot != SIZE_MAX) {
+                    status = MAP_OK;
+                    value = map_value_from(map, map->old_values + (old_slot * map->value_size));
+                } else {
+                    status = MAP_ERR_NOT_FOUND;
+                }
+            }
+
+            out_values[start + idx] = value;
+            if (out_status) { out_status[start + idx] = status; }
+            if (status != MAP_OK && result.status == MAP_OK) { result.status = status; }
+        }
+    }
+
+    if (result.status == MAP_OK) {
+        SET_MSG(result, "Values successfully retrieved");
+    } else {
+        SET_MSG(result, "Some elements were not found");
+    }
+
+    return result;
+}
+
+/**
+ * map_remove
+ *  @map: a non-null map
+ *  @key: a string representing the index key
+ *
+ *  Removes an element indexed by @key from @map
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t map_remove(map_t *map, const char *key) {
+    map_result_t result = {0};
+
+    if (key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    return map_remove_bytes(map, key, strlen(key));
+}
+
+/**
+ * map_remove_bytes
+ *  @map: a non-null map
+ *  @key: an arbitrary sequence of bytes representing the index key
+ *  @key_len: length of @key in bytes
+ *
+ *  Removes an element indexed by @key from @map
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t map_remove_bytes(map_t *map, const void *key, size_t key_len) {
+    return map_remove_digest(map, key, key_len, key ? hash_key((const char*)key, key_len) : 0);
+}
+
+/**
+ * map_remove_digest
+ *  @map: a non-null map
+ *  @key: an arbitrary sequence of bytes representing the index key
+ *  @key_len: length of @key in bytes
+ *  @key_digest: map_hash(@key, @key_len)
+ *
+ *  Same as map_remove_bytes, for callers that already hashed @key
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t map_remove_digest(map_t *map, const void *key, size_t key_len, uint64_t key_digest) {
+    map_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    if (map->mapping != NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Memory-mapped maps are read-only");
+
+        return result;
+    }
+
+    // Move a bounded number of slots of an ongoing resize
+    if (map->old_ctrl != NULL) {
+        map_migrate(map, MAP_MIGRATE_STEP);
+    }
+
+    const size_t idx = map_find_digest(map, (const char*)key, key_len, key_digest);
+
+    if (idx == SIZE_MAX || !(map->ctrl[idx] & MAP_CTRL_OCCUPIED)) {
+        const size_t old_idx = map->old_ctrl ? map_find_old(map, (const char*)key, key_len, key_digest) : SIZE_MAX;
+
+        if (old_idx == SIZE_MAX) {
+            result.status = MAP_ERR_NOT_FOUND;
+            SET_MSG(result, "Element not found");
+
+            return result;
+        }
+
+        // The key has not been migrated yet, drop it from the old table
+        if (map->old_elements[old_idx].key_len > MAP_INLINE_KEY_MAX) {
+            map->arena_garbage += map->old_elements[old_idx].key_len + 1;
+        }
+
+        map->old_elements[old_idx].key_len = 0;
+        map->old_ctrl[old_idx] = MAP_CTRL_DELETED;
+        map->old_size--;
+        map->size--;
+
+        result.status = MAP_OK;
+        SET_MSG(result, "Key successfully deleted");
+
+        return result;
+    }
+
+    // Long keys leave a hole in the arena that is reclaimed by the next compaction
+    if (map->elements[idx].key_len > MAP_INLINE_KEY_MAX) {
+        map->arena_garbage += map->elements[idx].key_len + 1;
+    }
+
+    // Remove element properties
+    map->elements[idx].key_len = 0;
+    map->ctrl[idx] = MAP_CTRL_DELETED;
+
+    // Decrease map size and increase its tombstone count
+    map->size--;
+    map->tombstone_count++;
+
+    // Check if there are too many tombstone entries
+    const double load_factor = (double)(map->size + map->tombstone_count) / map->capacity;
+    if (load_factor > LOAD_FACTOR_THRESHOLD) {
+        map_result_t resize_res = map_grow(map);
+        if (resize_res.status != MAP_OK) {
+            result.status = resize_res.status;
+            SET_MSG(result, "Key successfully deleted. Resize has failed");
+
+            return result;
+        }
+    }
+
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Key successfully deleted");
+
+    return result;
+}
+
+/**
+ * map_hash
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  Returns the digest used by the map to index @key
+ */
+uint64_t map_hash(const void *key, size_t key_len) {
+    return hash_key((const char*)key, key_len);
+}
+
+/**
+ * map_next_occupied
+ *  @map: a non-null map
+ *  @idx: the slot where the scan starts
+ *
+ *  Scans the control bytes of @map starting from @idx. Whole groups of
+ *  MAP_GROUP_SIZE slots without occupied entries are skipped at once
+ *
+ *  Returns the index of the next occupied slot or SIZE_MAX otherwise
+ */
+static size_t map_next_occupied(const map_t *map, size_t idx) {
+    const uint64_t occupied_mask = 0x8080808080808080ULL;
+
+    // Slots past the capacity belong to the table being migrated, if any
+    while (idx < map->capacity + map->old_capacity) {
+        const bool is_old = idx >= map->capacity;
+        const size_t slot = is_old ? idx - map->capacity : idx;
+        const size_t table_capacity = is_old ? map->old_capacity : map->capacity;
+        const uint8_t *ctrl = is_old ? map->old_ctrl + slot : map->ctrl + idx;
+
+        // Groups are aligned within each table, and a skip never crosses into
+        // the next table, whose slots may start in the middle of a group
+        if ((slot % MAP_GROUP_SIZE) == 0) {
+            uint64_t group;
+            memcpy(&group, ctrl, sizeof(group));
+
+            if ((group & occupied_mask) == 0) {
+                idx += (table_capacity - slot) < MAP_GROUP_SIZE ? (table_capacity - slot) : MAP_GROUP_SIZE;
+                continue;
+            }
+        }
+
+        if (*ctrl & MAP_CTRL_OCCUPIED) {
+            return idx;
+        }
+
+        idx++;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * map_slot_element
+ *  @map: a non-null map
+ *  @idx: a slot index returned by map_next_occupied
+ *
+ *  Returns the element stored in slot @idx
+ */
+static inline const map_element_t *map_slot_element(const map_t *map, size_t idx) {
+    return idx < map->capacity ? &map->elements[idx] : &map->old_elements[idx - map->capacity];
+}
+
+/**
+ * map_slot_value
+ *  @map: a non-null map
+ *  @idx: a slot index returned by map_next_occupied
+ *
+ *  Returns the value storage of slot @idx
+ */
+static inline uint8_t *map_slot_value(const map_t *map, size_t idx) {
+    return idx < map->capacity ? map_value_at(map, idx) :
+           map->old_values + ((idx - map->capacity) * map->value_size);
+}
+
+/**
+ * map_iter_begin
+ *  @map: a map
+ *
+ *  Creates a cursor over the elements of @map. The cursor is invalidated
+ *  by any insertion, removal or clear performed on @map
+ *
+ *  Returns a map_iter_t data type positioned before the first element
+ */
+map_iter_t map_iter_begin(const map_t *map) {
+    map_iter_t iter = {0};
+
+    iter.map = map;
+    iter.index = 0;
+
+    return iter;
+}
+
+/**
+ * map_iter_next
+ *  @iter: a cursor created by map_iter_begin
+ *
+ *  Advances @iter to the next element of the map, in no particular order,
+ *  and exposes its key, key length and value
+ *
+ *  Returns true if an element is available, false at the end of the map
+ */
+bool map_iter_next(map_iter_t *iter) {
+    if (iter == NULL || iter->map == NULL) {
+        return false;
+    }
+
+    const size_t idx = map_next_occupied(iter->map, iter->index);
+    if (idx == SIZE_MAX) {
+        iter->index = iter->map->capacity + iter->map->old_capacity;
+        iter->key = NULL;
+        iter->key_len = 0;
+        iter->value = NULL;
+
+        return false;
+    }
+
+    iter->index = idx + 1;
+    const map_element_t *element = map_slot_element(iter->map, idx);
+    iter->key = map_element_key(iter->map, element);
+    iter->key_len = element->key_len;
+    iter->value = map_value_from(iter->map, map_slot_value(iter->map, idx));
+
+    return true;
+}
+
+/**
+ * map_keys
+ *  @map: a non-null map
+ *
+ *  Exports the keys of @map into a new vector of `const char *`.
+ *  Keys are NUL-terminated and point inside the map, therefore they
+ *  remain valid until the next insertion, removal or clear
+ *
+ *  Returns a map_result_t data type containing the vector
+ */
+map_result_t map_keys(const map_t *map) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    vector_result_t vec_res = vector_new(map->size ? map->size : 1, sizeof(const char*));
+    if (vec_res.status != VECTOR_OK) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, vec_res.message);
+
+        return result;
+    }
+
+    vector_t *keys = vec_res.value.vector;
+    for (size_t idx = map_next_occupied(map, 0); idx != SIZE_MAX; idx = map_next_occupied(map, idx + 1)) {
+        const char *key = map_element_key(map, map_slot_element(map, idx));
+
+        vec_res = vector_push(keys, (void*)&key);
+        if (vec_res.status != VECTOR_OK) {
+            vector_destroy(keys);
+            result.status = MAP_ERR_ALLOCATE;
+            SET_MSG(result, vec_res.message);
+
+            return result;
+        }
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Keys successfully exported");
+    result.value.vector = keys;
+
+    return result;
+}
+
+/**
+ * map_values
+ *  @map: a non-null map
+ *
+ *  Exports the values of @map into a new vector. If @map owns its values,
+ *  each element is a copy of value_size bytes, otherwise each element
+ *  is the pointer stored by the caller
+ *
+ *  Returns a map_result_t data type containing the vector
+ */
+map_result_t map_values(const map_t *map) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    vector_result_t vec_res = vector_new(map->size ? map->size : 1, map->value_size);
+    if (vec_res.status != VECTOR_OK) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, vec_res.message);
+
+        return result;
+    }
+
+    vector_t *values = vec_res.value.vector;
+    for (size_t idx = map_next_occupied(map, 0); idx != SIZE_MAX; idx = map_next_occupied(map, idx + 1)) {
+        vec_res = vector_push(values, map_slot_value(map, idx));
+        if (vec_res.status != VECTOR_OK) {
+            vector_destroy(values);
+            result.status = MAP_ERR_ALLOCATE;
+            SET_MSG(result, vec_res.message);
+
+            return result;
+        }
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Values successfully exported");
+    result.value.vector = values;
+
+    return result;
+}
+
+/**
+ * map_foreach
+ *  @map: a non-null map
+ *  @callback: a function invoked on each (key, value) pair
+ *  @env: an optional environment passed to @callback
+ *
+ *  Calls @callback on each element of @map, in no particular order.
+ *  @callback must not insert or remove keys
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t map_foreach(const map_t *map, map_foreach_fn callback, void *env) {
+    map_result_t result = {0};
+
+    if (map == NULL || callback == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or callback");
+
+        return result;
+    }
+
+    for (size_t idx = map_next_occupied(map, 0); idx != SIZE_MAX; idx = map_next_occupied(map, idx + 1)) {
+        const map_element_t *element = map_slot_element(map, idx);
+
+        callback(map_element_key(map, element), element->key_len,
+                 map_value_from(map, map_slot_value(map, idx)), env);
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully traversed");
+
+    return result;
+}
+
+/**
+ * map_clear
+ *  @map: a non-null map
+ *
+ *  Resets the map to an empty state
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t map_clear(map_t *map) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    if (map->mapping != NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Memory-mapped maps are read-only");
+
+        return result;
+    }
+
+    memset(map->ctrl, MAP_CTRL_EMPTY, map_ctrl_size(map->capacity));
+
+    // Drop the table of an ongoing resize
+    free(map->old_ctrl);
+    free(map->old_elements);
+    free(map->old_values);
+    map->old_ctrl = NULL;
+    map->old_elements = NULL;
+    map->old_values = NULL;
+    map->old_capacity = 0;
+    map->old_size = 0;
+    map->migrate_index = 0;
+
+    // Resets map size, tombstone count and key arena (its memory is kept for reuse)
+    map->size = 0;
+    map->tombstone_count = 0;
+    map->arena_size = 0;
+    map->arena_garbage = 0;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully cleared");
+
+    return result;
+}
+
+/**
+ * map_destroy
+ *  @map: a non-null map
+ *
+ *  Deletes the map and all its elements from the memory
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t map_destroy(map_t *map) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    if (map->mapping != NULL) {
+        // Every array points inside the file mapping
+        munmap(map->mapping, map->mapping_size);
+    } else {
+        free(map->key_arena);
+        free(map->values);
+        free(map->elements);
+        free(map->ctrl);
+        free(map->old_values);
+        free(map->old_elements);
+        free(map->old_ctrl);
+    }
+    free(map);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully deleted");
+
+    return result;
+}
+
+// Header of a map snapshot, followed by the control bytes, the elements,
+// the values and the key arena at the given offsets
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t element_size; // sizeof(map_element_t), guards against foreign layouts
+    uint64_t capacity;
+    uint64_t size;
+    uint64_t tombstone_count;
+    uint64_t value_size;
+    uint64_t ctrl_offset;
+    uint64_t elements_offset;
+    uint64_t values_offset;
+    uint64_t arena_offset;
+    uint64_t arena_size;
+    uint64_t file_size;
+} map_file_header_t;
+
+/**
+ * map_file_align
+ *  @offset: a file offset
+ *
+ *  Returns @offset rounded up to a multiple of MAP_FILE_ALIGN
+ */
+static inline uint64_t map_file_align(uint64_t offset) {
+    return (offset + MAP_FILE_ALIGN - 1) & ~(uint64_t)(MAP_FILE_ALIGN - 1);
+}
+
+/**
+ * map_write_section
+ *  @file: an open file
+ *  @offset: current position in @file
+ *  @target: offset where the section starts
+ *  @data: the section content
+ *  @size: size of @data in bytes
+ *
+ *  Pads @file with zeros up to @target and then writes @data
+ *
+ *  Returns true on success, false otherwise
+ */
+static bool map_write_section(FILE *file, uint64_t offset, uint64_t target, const void *data, size_t size) {
+    for (; offset < target; offset++) {
+        if (fputc(0, file) == EOF) {
+            return false;
+        }
+    }
+
+    return size == 0 || fwrite(data, 1, size, file) == size;
+}
+
+/**
+ * map_write_slots
+ *  @file: an open file
+ *  @map: a non-null map
+ *  @base: an array with one entry of @stride bytes per slot of @map
+ *
+ *  Writes the entries of the occupied slots of @map, and zeros for the others,
+ *  so that no stale memory ends up in the snapshot
+ *
+ *  Returns true on success, false otherwise
+ */
+static bool map_write_slots(FILE *file, const map_t *map, const uint8_t *base, size_t stride) {
+    uint8_t buffer[4096];
+    const size_t per_chunk = stride <= sizeof(buffer) ? sizeof(buffer) / stride : 0;
+
+    for (size_t idx = 0; idx < map->capacity;) {
+        // Entries larger than the buffer are written one at a time
+        if (per_chunk == 0) {
+            const bool occupied = map->ctrl[idx] & MAP_CTRL_OCCUPIED;
+
+            for (size_t byte = 0; byte < stride; byte++) {
+                if (fputc(occupied ? base[idx * stride + byte] : 0, file) == EOF) {
+                    return false;
+                }
+            }
+            idx++;
+            continue;
+        }
+
+        const size_t count = (map->capacity - idx) < per_chunk ? (map->capacity - idx) : per_chunk;
+        for (size_t slot = 0; slot < count; slot++) {
+            if (map->ctrl[idx + slot] & MAP_CTRL_OCCUPIED) {
+                memcpy(buffer + slot * stride, base + (idx + slot) * stride, stride);
+            } else {
+                memset(buffer + slot * stride, 0, stride);
+            }
+        }
+
+        if (fwrite(buffer, stride, count, file) != count) {
+            return false;
+        }
+        idx += count;
+    }
+
+    return true;
+}
+
+/**
+ * map_save
+ *  @map: a non-null map that owns its values
+ *  @path: the destination file
+ *
+ *  Writes a snapshot of @map to @path. The snapshot mirrors the in-memory
+ *  table: control bytes, elements, values and key arena are stored as they
+ *  are, and long keys are already referenced by their offset in the arena,
+ *  so the file can be mapped back by map_open_mmap without rebuilding it.
+ *  Maps that store values by reference or keys only cannot be saved
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t map_save(const map_t *map, const char *path) {
+    map_result_t result = {0};
+
+    if (map == NULL || path == NULL || !map->owns_values || map->value_size == 0) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or path");
+
+        return result;
+    }
+
+    // Snapshots hold a single table, so complete any ongoing migration on a copy
+    if (map->old_ctrl != NULL) {
+        map_result_t clone_res = map_clone(map);
+        if (clone_res.status != MAP_OK) {
+            return clone_res;
+        }
+
+        map_set_incremental(clone_res.value.map, false);
+        result = map_save(clone_res.value.map, path);
+        map_destroy(clone_res.value.map);
+
+        return result;
+    }
+
+    map_file_header_t header = {0};
+    memcpy(header.magic, MAP_FILE_MAGIC, sizeof(header.magic));
+    header.version = MAP_FILE_VERSION;
+    header.element_size = sizeof(map_element_t);
+    header.capacity = map->capacity;
+    header.size = map->size;
+    header.tombstone_count = map->tombstone_count;
+    header.value_size = map->value_size;
+    header.ctrl_offset = map_file_align(sizeof(header));
+    header.elements_offset = map_file_align(header.ctrl_offset + map_ctrl_size(map->capacity));
+    header.values_offset = map_file_align(header.elements_offset + map->capacity * sizeof(map_element_t));
+    header.arena_offset = map_file_align(header.values_offset + map->capacity * map->value_size);
+    header.arena_size = map->arena_size;
+    header.file_size = header.arena_offset + map->arena_size;
+
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        result.status = MAP_ERR_IO;
+        SET_MSG(result, "Failed to open snapshot file");
+
+        return result;
+    }
+
+    const bool written =
+        map_write_section(file, 0, 0, &header, sizeof(header)) &&
+        map_write_section(file, sizeof(header), header.ctrl_offset,
+                          map->ctrl, map_ctrl_size(map->capacity)) &&
+        map_write_section(file, header.ctrl_offset + map_ctrl_size(map->capacity), header.elements_offset, NULL, 0) &&
+        map_write_slots(file, map, (const uint8_t *)map->elements, sizeof(map_element_t)) &&
+        map_write_section(file, header.elements_offset + map->capacity * sizeof(map_element_t), header.values_offset, NULL, 0) &&
+        map_write_slots(file, map, map->values, map->value_size) &&
+        map_write_section(file, header.values_offset + map->capacity * map->value_size, header.arena_offset,
+                          map->key_arena, map->arena_size);
+
+    if (fclose(file) != 0 || !written) {
+        result.status = MAP_ERR_IO;
+        SET_MSG(result, "Failed to write snapshot file");
+
+        return result;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully saved");
+
+    return result;
+}
+
+/**
+ * map_file_section_end
+ *  @offset: offset of a section
+ *  @count: number of entries of the section
+ *  @entry_size: size of each entry in bytes
+ *  @end: where to store the end offset of the section
+ *
+ *  Returns false if the end of the section does not fit in 64 bits
+ */
+static inline bool map_file_section_end(uint64_t offset, uint64_t count, uint64_t entry_size, uint64_t *end) {
+    if (entry_size != 0 && count > UINT64_MAX / entry_size) {
+        return false;
+    }
+
+    const uint64_t length = count * entry_size;
+    if (offset > UINT64_MAX - length) {
+        return false;
+    }
+    *end = offset + length;
+
+    return true;
+}
+
+/**
+ * map_file_valid
+ *  @header: the header of a snapshot
+ *  @mapping: the mapped snapshot
+ *  @mapping_size: size of @mapping in bytes
+ *
+ *  Checks that the sections described by @header lie within @mapping, that
+ *  the control bytes agree with the element counters and that every long
+ *  key references a NUL-terminated string inside the key arena, so that lookups on a
+ *  corrupted or forged snapshot never read outside the mapping
+ *
+ *  Returns true if the snapshot can be mapped, false otherwise
+ */
+static bool map_file_valid(const map_file_header_t *header, const uint8_t *mapping, size_t mapping_size) {
+    if (memcmp(header->magic, MAP_FILE_MAGIC, sizeof(header->magic)) ||
+        header->version != MAP_FILE_VERSION ||
+        header->element_size != sizeof(map_element_t) ||
+        header->capacity < INITIAL_CAP || (header->capacity & (header->capacity - 1)) != 0 ||
+        header->capacity > SIZE_MAX / sizeof(map_element_t) ||
+        header->value_size == 0 || header->capacity > SIZE_MAX / header->value_size ||
+        header->size > header->capacity || header->tombstone_count >= header->capacity - header->size ||
+        header->file_size != mapping_size) {
+        return false;
+    }
+
+    // Sections must follow each other in order without wrapping around
+    uint64_t ctrl_end, elements_end, values_end, arena_end;
+    if (!map_file_section_end(header->ctrl_offset, map_ctrl_size(header->capacity), 1, &ctrl_end) ||
+        !map_file_section_end(header->elements_offset, header->capacity, sizeof(map_element_t), &elements_end) ||
+        !map_file_section_end(header->values_offset, header->capacity, header->value_size, &values_end) ||
+        !map_file_section_end(header->arena_offset, header->arena_size, 1, &arena_end)) {
+        return false;
+    }
+
+    if (header->ctrl_offset < sizeof(*header) || ctrl_end > header->elements_offset ||
+        elements_end > header->values_offset || values_end > header->arena_offset ||
+        arena_end != header->file_size ||
+        header->ctrl_offset % MAP_FILE_ALIGN != 0 ||
+        header->elements_offset % MAP_FILE_ALIGN != 0 ||
+        header->values_offset % MAP_FILE_ALIGN != 0) {
+        return false;
+    }
+
+    const uint8_t *ctrl = mapping + header->ctrl_offset;
+    const map_element_t *elements = (const map_element_t *)(const void *)(mapping + header->elements_offset);
+    const uint8_t *arena = mapping + header->arena_offset;
+    uint64_t occupied = 0;
+    uint64_t deleted = 0;
+
+    for (uint64_t idx = 0; idx < map_ctrl_size(header->capacity); idx++) {
+        if (ctrl[idx] == MAP_CTRL_EMPTY) {
+            continue;
+        }
+
+        // The padding after the last slot is always empty
+        if (idx >= header->capacity) {
+            return false;
+        }
+
+        if (ctrl[idx] == MAP_CTRL_DELETED) {
+            deleted++;
+        } else if (ctrl[idx] & MAP_CTRL_OCCUPIED) {
+            const map_element_t *element = &elements[idx];
+            occupied++;
+
+            // Long keys are handed out as strings, so their terminator must be in the arena too
+            if (element->key_len > MAP_INLINE_KEY_MAX &&
+                (element->key.offset >= header->arena_size ||
+                 element->key_len >= header->arena_size - element->key.offset ||
+                 arena[element->key.offset + element->key_len] != '\0')) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+
+    return occupied == header->size && deleted == header->tombstone_count;
+}
+
+/**
+ * map_open_mmap
+ *  @path: a snapshot written by map_save
+ *
+ *  Maps @path in memory and returns a read-only map whose arrays point
+ *  directly into the mapping: lookups are served from the page cache
+ *  and no element is deserialized. Insertions, removals and clear fail
+ *  on the returned map; use map_clone to obtain a mutable copy
+ *
+ *  Returns a map_result_t data type containing the map
+ */
+map_result_t map_open_mmap(const char *path) {
+    map_result_t result = {0};
+
+    if (path == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid path");
+
+        return result;
+    }
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        result.status = MAP_ERR_IO;
+        SET_MSG(result, "Failed to open snapshot file");
+
+        return result;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(map_file_header_t)) {
+        close(fd);
+        result.status = MAP_ERR_IO;
+        SET_MSG(result, "Invalid snapshot file");
+
+        return result;
+    }
+
+    const size_t mapping_size = (size_t)info.st_size;
+    uint8_t *mapping = mmap(NULL, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        result.status = MAP_ERR_IO;
+        SET_MSG(result, "Failed to map snapshot file");
+
+        return result;
+    }
+
+    map_file_header_t header;
+    memcpy(&header, mapping, sizeof(header));
+
+    const bool valid = map_file_valid(&header, mapping, mapping_size);
+
+    if (!valid) {
+        munmap(mapping, mapping_size);
+        result.status = MAP_ERR_IO;
+        SET_MSG(result, "Invalid snapshot file");
+
+        return result;
+    }
+
+    map_t *map = malloc(sizeof(map_t));
+    if (map == NULL) {
+        munmap(mapping, mapping_size);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map");
+
+        return result;
+    }
+
+    // The arrays are only read, so dropping the const qualifier is safe
+    map->ctrl = mapping + header.ctrl_offset;
+    map->elements = (map_element_t *)(void *)(mapping + header.elements_offset);
+    map->values = mapping + header.values_offset;
+    map->value_size = header.value_size;
+    map->owns_values = true;
+    map->capacity = header.capacity;
+    map->size = header.size;
+    map->tombstone_count = header.tombstone_count;
+    map->key_arena = (char *)(mapping + header.arena_offset);
+    map->arena_size = header.arena_size;
+    map->arena_capacity = header.arena_size;
+    map->arena_garbage = 0;
+    map->incremental = false;
+    map->old_ctrl = NULL;
+    map->old_elements = NULL;
+    map->old_values = NULL;
+    map->old_capacity = 0;
+    map->old_size = 0;
+    map->migrate_index = 0;
+    map->mapping = mapping;
+    map->mapping_size = mapping_size;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully mapped");
+    result.value.map = map;
+
+    return result;
+}
+
+/**
+ * hash_int
+ *  @key: a 64-bit integer key
+ *
+ *  Returns the digest of @key using the MurmurHash3 finalizer
+ */
+static inline uint64_t hash_int(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDULL;
+    key ^= key >> 33;
+    key *= 0xC4CEB9FE1A85EC53ULL;
+    key ^= key >> 33;
+
+    return key;
+}
+
+/**
+ * map_hash_int
+ *  @key: a 64-bit integer
+ *
+ *  Returns the digest used by the integer map to index @key
+ */
+uint64_t map_hash_int(uint64_t key) {
+    return hash_int(key);
+}
+
+/**
+ * intmap_slot
+ *  @map: a non-null integer map
+ *  @idx: a slot index
+ *
+ *  Returns the header of slot @idx
+ */
+static inline intmap_element_t *intmap_slot(const intmap_t *map, size_t idx) {
+    return (intmap_element_t*)(void*)(map->slots + (idx * map->slot_size));
+}
+
+/**
+ * intmap_slot_value
+ *  @map: a non-null integer map
+ *  @idx: a slot index
+ *
+ *  Returns a pointer to the value storage of slot @idx,
+ *  which immediately follows the slot header
+ */
+static inline uint8_t *intmap_slot_value(const intmap_t *map, size_t idx) {
+    return map->slots + (idx * map->slot_size) + sizeof(intmap_element_t);
+}
+
+/**
+ * intmap_insert_index
+ *  @map: a non-null integer map
+ *  @key: the key to find
+ *
+ *  Finds next available slot for insertion (empty or deleted)
+ *  or the slot containing an existing key
+ *
+ *  Returns the index of available slot or SIZE_MAX otherwise
+ */
+static size_t intmap_insert_index(const intmap_t *map, uint64_t key) {
+    const size_t mask = map->capacity - 1;
+    size_t idx = hash_int(key) & mask;
+    size_t delete_tracker = map->capacity; // Fallback index
+
+    for (size_t probes = 0; probes < map->capacity; probes++) {
+        const intmap_element_t *slot = intmap_slot(map, idx);
+
+        if (slot->state == ENTRY_EMPTY) {
+            return (delete_tracker != map->capacity) ? delete_tracker : idx;
+        }
+
+        if (slot->state == ENTRY_OCCUPIED) {
+            if (slot->key == key) {
+                return idx;
+            }
+        } else if (delete_tracker == map->capacity) {
+            delete_tracker = idx;
+        }
+
+        idx = (idx + 1) & mask;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * intmap_find_index
+ *  @map: a non-null integer map
+ *  @key: the key to find
+ *
+ *  Returns the index of the key if it is found or SIZE_MAX otherwise
+ */
+static size_t intmap_find_index(const intmap_t *map, uint64_t key) {
+    const size_t mask = map->capacity - 1;
+    size_t idx = hash_int(key) & mask;
+
+    for (size_t probes = 0; probes < map->capacity; probes++) {
+        const intmap_element_t *slot = intmap_slot(map, idx);
+
+        if (slot->state == ENTRY_EMPTY) {
+            return SIZE_MAX;
+        }
+
+        if (slot->state == ENTRY_OCCUPIED && slot->key == key) {
+            return idx;
+        }
+
+        idx = (idx + 1) & mask;
+    }
+
+    return SIZE_MAX;
+}
+
+/**
+ * intmap_resize
+ *  @map: a non-null integer map
+ *
+ *  Doubles the capacity of @map and drops its tombstones
+ *
+ *  Returns a map_result_t data type containing the status
+ */
+static map_result_t intmap_resize(intmap_t *map) {
+    map_result_t result = {0};
+
+    if (map->capacity > SIZE_MAX / 2 || map->capacity * 2 > SIZE_MAX / map->slot_size) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Capacity overflow on map resize");
+
+        return result;
+    }
+
+    const size_t old_capacity = map->capacity;
+    uint8_t *old_slots = map->slots;
+
+    uint8_t *new_slots = calloc(old_capacity * 2, map->slot_size);
+    if (new_slots == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to reallocate memory for map");
+
+        return result;
+    }
+
+    map->slots = new_slots;
+    map->capacity = old_capacity * 2;
+    map->tombstone_count = 0;
+
+    // Rehash all existing elements. The new table has no tombstones and
+    // enough room for every key, so the first empty slot is the right one
+    const size_t mask = map->capacity - 1;
+    for (size_t idx = 0; idx < old_capacity; idx++) {
+        const uint8_t *old_slot = old_slots + (idx * map->slot_size);
+        const intmap_element_t *element = (const intmap_element_t*)(const void*)old_slot;
+
+        if (element->state == ENTRY_OCCUPIED) {
+            size_t new_idx = hash_int(element->key) & mask;
+            while (intmap_slot(map, new_idx)->state != ENTRY_EMPTY) {
+                new_idx = (new_idx + 1) & mask;
+            }
+
+            memcpy(map->slots + (new_idx * map->slot_size), old_slot, map->slot_size);
+        }
+    }
+
+    free(old_slots);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully resized");
+
+    return result;
+}
+
+/**
+ * intmap_create
+ *  @value_size: number of bytes reserved for each value
+ *  @owns_values: whether values are copied into the map
+ *
+ *  Returns a map_result_t data type containing a new integer map
+ */
+static map_result_t intmap_create(size_t value_size, bool owns_values) {
+    map_result_t result = {0};
+
+    // Keep each slot header 8-byte aligned
+    const size_t align = sizeof(uint64_t);
+    if (value_size > SIZE_MAX / INITIAL_CAP - sizeof(intmap_element_t) - align) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Value size is too big");
+
+        return result;
+    }
+
+    intmap_t *map = malloc(sizeof(intmap_t));
+    if (map == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map");
+
+        return result;
+    }
+
+    map->slot_size = (sizeof(intmap_element_t) + value_size + align - 1) & ~(align - 1);
+    map->slots = calloc(INITIAL_CAP, map->slot_size);
+    if (map->slots == NULL) {
+        free(map);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map elements");
+
+        return result;
+    }
+
+    map->value_size = value_size;
+    map->owns_values = owns_values;
+    map->capacity = INITIAL_CAP;
+    map->size = 0;
+    map->tombstone_count = 0;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully created");
+    result.value.intmap = map;
+
+    return result;
+}
+
+/**
+ * intmap_new
+ *
+ *  Returns a map_result_t data type containing a new integer map
+ *  that stores values by reference
+ */
+map_result_t intmap_new(void) {
+    return intmap_create(sizeof(void*), false);
+}
+
+/**
+ * intmap_new_sized
+ *  @value_size: size of each value in bytes
+ *
+ *  Returns a map_result_t data type containing a new integer map
+ *  that stores a copy of each value next to its key
+ */
+map_result_t intmap_new_sized(size_t value_size) {
+    map_result_t result = {0};
+
+    if (value_size == 0) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid value size");
+
+        return result;
+    }
+
+    return intmap_create(value_size, true);
+}
+
+/**
+ * intmap_add
+ *  @map: a non-null integer map
+ *  @key: a 64-bit integer key
+ *  @value: a generic value to add to the map
+ *
+ *  Adds (@key, @value) to @map. If @map owns its values,
+ *  the value_size bytes pointed by @value are copied
+ *
+ *  Returns a map_result_t data type containing the status
+ */
+map_result_t intmap_add(intmap_t *map, uint64_t key, void *value) {
+    map_result_t result = {0};
+
+    if (map == NULL || (map->owns_values && value == NULL)) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or value");
+
+        return result;
+    }
+
+    // Check whether there's enough space available
+    const double load_factor = (double)(map->size + map->tombstone_count) / map->capacity;
+    if (load_factor > LOAD_FACTOR_THRESHOLD) {
+        result = intmap_resize(map);
+        if (result.status != MAP_OK) {
+            return result;
+        }
+    }
+
+    const size_t idx = intmap_insert_index(map, key);
+    if (idx == SIZE_MAX) {
+        // Cannot happen while the load factor is bounded
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "The map is full");
+
+        return result;
+    }
+
+    intmap_element_t *slot = intmap_slot(map, idx);
+    if (map->owns_values) {
+        memcpy(intmap_slot_value(map, idx), value, map->value_size);
+    } else {
+        memcpy(intmap_slot_value(map, idx), &value, sizeof(void*));
+    }
+
+    if (slot->state == ENTRY_OCCUPIED) {
+        result.status = MAP_OK;
+        SET_MSG(result, "Element successfully updated");
+
+        return result;
+    }
+
+    if (slot->state == ENTRY_DELETED && map->tombstone_count > 0) {
+        map->tombstone_count--;
+    }
+
+    slot->key = key;
+    slot->state = ENTRY_OCCUPIED;
+    map->size++;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Element successfully added");
+
+    return result;
+}
+
+/**
+ * intmap_get
+ *  @map: a non-null integer map
+ *  @key: a 64-bit integer key
+ *
+ *  Returns a map_result_t data type containing the element indexed by @key if available.
+ *  If @map owns its values, the element points inside the map and remains valid
+ *  until the next insertion, removal or clear
+ */
+map_result_t intmap_get(const intmap_t *map, uint64_t key) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    const size_t idx = intmap_find_index(map, key);
+    if (idx == SIZE_MAX) {
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    if (map->owns_values) {
+        result.value.element = intmap_slot_value(map, idx);
+    } else {
+        memcpy(&result.value.element, intmap_slot_value(map, idx), sizeof(void*));
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Value successfully retrieved");
+
+    return result;
+}
+
+/**
+ * intmap_remove
+ *  @map: a non-null integer map
+ *  @key: a 64-bit integer key
+ *
+ *  Removes an element indexed by @key from @map
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t intmap_remove(intmap_t *map, uint64_t key) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    const size_t idx = intmap_find_index(map, key);
+    if (idx == SIZE_MAX) {
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    intmap_slot(map, idx)->state = ENTRY_DELETED;
+    map->size--;
     map->tombstone_count++;
 
     // Check if there are too many tombstone entries
     const double load_factor = (double)(map->size + map->tombstone_count) / map->capacity;
     if (load_factor > LOAD_FACTOR_THRESHOLD) {
-        map_result_t resize_res = map_resize(map);
+        map_result_t resize_res = intmap_resize(map);
         if (resize_res.status != MAP_OK) {
             result.status = resize_res.status;
             SET_MSG(result, "Key successfully deleted. Resize has failed");
@@ -383,7 +2625,6 @@ map_result_t map_remove(map_t *map, const char *key) {
         }
     }
 
-
     result.status = MAP_OK;
     SET_MSG(result, "Key successfully deleted");
 
@@ -391,14 +2632,14 @@ map_result_t map_remove(map_t *map, const char *key) {
 }
 
 /**
- * map_clear
- *  @map: a non-null map
+ * intmap_clear
+ *  @map: a non-null integer map
  *
  *  Resets the map to an empty state
  *
  *  Returns a map_result_t data type
  */
-map_result_t map_clear(map_t *map) {
+map_result_t intmap_clear(intmap_t *map) {
     map_result_t result = {0};
 
     if (map == NULL) {
@@ -408,17 +2649,7 @@ map_result_t map_clear(map_t *map) {
         return result;
     }
 
-    for (size_t idx = 0; idx < map->capacity; idx++) {
-        if (map->elements[idx].state == ENTRY_OCCUPIED) {
-            free(map->elements[idx].key);
-            map->elements[idx].key = NULL;
-            map->elements[idx].value = NULL;
-        }
-
-        map->elements[idx].state = ENTRY_EMPTY;
-    }
-
-    // Resets map size and tombstone count
+    memset(map->slots, 0, map->capacity * map->slot_size);
     map->size = 0;
     map->tombstone_count = 0;
 
@@ -429,14 +2660,14 @@ map_result_t map_clear(map_t *map) {
 }
 
 /**
- * map_destroy
- *  @map: a non-null map
+ * intmap_destroy
+ *  @map: a non-null integer map
  *
  *  Deletes the map and all its elements from the memory
  *
  *  Returns a map_result_t data type
  */
-map_result_t map_destroy(map_t *map) {
+map_result_t intmap_destroy(intmap_t *map) {
     map_result_t result = {0};
 
     if (map == NULL) {
@@ -446,13 +2677,471 @@ map_result_t map_destroy(map_t *map) {
         return result;
     }
 
-    for (size_t idx = 0; idx < map->capacity; idx++) {
-        if (map->elements[idx].state == ENTRY_OCCUPIED) {
-            free(map->elements[idx].key);
+    free(map->slots);
+    free(map);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully deleted");
+
+    return result;
+}
+
+/**
+ * frozen_slot
+ *  @map: a non-null frozen map
+ *  @idx: a slot index
+ *
+ *  Returns the key header of slot @idx
+ */
+static inline map_element_t *frozen_slot(const frozen_map_t *map, size_t idx) {
+    return (map_element_t*)(void*)(map->slots + (idx * map->slot_size));
+}
+
+/**
+ * frozen_slot_value
+ *  @map: a non-null frozen map
+ *  @idx: a slot index
+ *
+ *  Returns a pointer to the value storage of slot @idx
+ */
+static inline uint8_t *frozen_slot_value(const frozen_map_t *map, size_t idx) {
+    return map->slots + (idx * map->slot_size) + sizeof(map_element_t);
+}
+
+/**
+ * frozen_range
+ *  @hash: a 64-bit hash
+ *  @range: an upper bound lower than 2^32
+ *
+ *  Returns a value in [0, @range) using the high 32 bits of @hash
+ */
+static inline size_t frozen_range(uint64_t hash, size_t range) {
+    return (size_t)(((hash >> 32) * (uint64_t)range) >> 32);
+}
+
+/**
+ * frozen_position
+ *  @key_hash: the seeded hash of a key
+ *  @pilot: the displacement of the bucket of the key
+ *  @table_size: number of slots of a frozen map
+ *
+ *  Returns the slot of a key
+ */
+static inline size_t frozen_position(uint64_t key_hash, uint16_t pilot, size_t table_size) {
+    return frozen_range(hash_int(key_hash ^ hash_int((uint64_t)pilot + 1)), table_size);
+}
+
+/**
+ * frozen_bucket
+ *  @hash: the seeded hash of a key
+ *  @buckets: number of buckets of a frozen map
+ *
+ *  Returns the bucket of a key. As in PTHash, FROZEN_DENSE_KEYS percent of the
+ *  keys go to the first FROZEN_DENSE_BUCKETS percent of the buckets, so that
+ *  the large buckets are placed while the table is still mostly empty and the
+ *  last buckets to be placed are small
+ */
+static inline size_t frozen_bucket(uint64_t hash, size_t buckets) {
+    const size_t dense = (buckets * FROZEN_DENSE_BUCKETS + 99) / 100;
+    const uint64_t selector = (hash & 0xFFFFFFFFULL) * 100;
+
+    if (selector < (uint64_t)FROZEN_DENSE_KEYS << 32 || dense == buckets) {
+        return frozen_range(hash, dense);
+    }
+
+    return dense + frozen_range(hash, buckets - dense);
+}
+
+/**
+ * frozen_key_hash
+ *  @seed: the seed of a frozen map
+ *  @key: the key bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  Hashes @key eight bytes at a time, passing the state through hash_int
+ *  after each word. Each step is a bijection of the state, so two distinct
+ *  keys collide only for a few seeds: unlike a seeded FNV-1a digest, a
+ *  collision of the digests cannot defeat every seed tried by map_freeze
+ *
+ *  Returns the seeded hash that selects the bucket and the position of a key
+ */
+static uint64_t frozen_key_hash(uint64_t seed, const char *key, size_t key_len) {
+    uint64_t hash = hash_int(seed ^ ((uint64_t)key_len * FNV_PRIME_64));
+    size_t idx = 0;
+
+    for (; idx + sizeof(uint64_t) <= key_len; idx += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, key + idx, sizeof(word));
+        hash = hash_int(hash ^ word);
+    }
+
+    // The length is already part of the state, so zero padding is unambiguous
+    if (idx < key_len) {
+        uint64_t word = 0;
+        memcpy(&word, key + idx, key_len - idx);
+        hash = hash_int(hash ^ word);
+    }
+
+    return hash;
+}
+
+/**
+ * frozen_build_pilots
+ *  @map: a frozen map whose sizes and seed are set
+ *  @hashes: the seeded hash of each key
+ *  @positions: receives the slot of each key
+ *
+ *  Finds, for each bucket, a pilot that sends all of its keys to free
+ *  positions. Buckets are placed from the largest to the smallest, while
+ *  the table is still mostly empty
+ *
+ *  Returns MAP_OK on success, MAP_ERR_OVERFLOW if some bucket cannot be placed
+ *  with this seed or MAP_ERR_ALLOCATE otherwise
+ */
+static map_status_t frozen_build_pilots(frozen_map_t *map, const uint64_t *hashes, size_t *positions) {
+    const size_t n = map->size;
+    const size_t buckets = map->bucket_count;
+    map_status_t status = MAP_OK;
+
+    size_t *bucket_start = calloc(buckets + 1, sizeof(size_t));
+    size_t *bucket_keys = malloc(n * sizeof(size_t));
+    size_t *order = malloc(buckets * sizeof(size_t));
+    uint8_t *taken = calloc((map->table_size + 7) / 8, sizeof(uint8_t));
+    size_t *slots = NULL;
+    size_t max_bucket = 0;
+
+    if (bucket_start == NULL || bucket_keys == NULL || order == NULL || taken == NULL) {
+        status = MAP_ERR_ALLOCATE;
+        goto cleanup;
+    }
+
+    // Group the keys by bucket (counting sort)
+    for (size_t idx = 0; idx < n; idx++) {
+        bucket_start[frozen_bucket(hashes[idx], buckets) + 1]++;
+    }
+    for (size_t bucket = 0; bucket < buckets; bucket++) {
+        const size_t bucket_size = bucket_start[bucket + 1];
+        if (bucket_size > max_bucket) { max_bucket = bucket_size; }
+        bucket_start[bucket + 1] += bucket_start[bucket];
+    }
+
+    size_t *fill = calloc(buckets, sizeof(size_t));
+    size_t *by_size = calloc(max_bucket + 2, sizeof(size_t));
+    slots = malloc((max_bucket + 1) * sizeof(size_t));
+    if (fill == NULL || by_size == NULL || slots == NULL) {
+        free(fill);
+        free(by_size);
+        status = MAP_ERR_ALLOCATE;
+        goto cleanup;
+    }
+
+    for (size_t idx = 0; idx < n; idx++) {
+        const size_t bucket = frozen_bucket(hashes[idx], buckets);
+        bucket_keys[bucket_start[bucket] + fill[bucket]++] = idx;
+    }
+
+    // Sort the buckets by decreasing size (counting sort)
+    for (size_t bucket = 0; bucket < buckets; bucket++) {
+        by_size[max_bucket - (bucket_start[bucket + 1] - bucket_start[bucket]) + 1]++;
+    }
+    for (size_t size = 0; size <= max_bucket; size++) {
+        by_size[size + 1] += by_size[size];
+    }
+    for (size_t bucket = 0; bucket < buckets; bucket++) {
+        order[by_size[max_bucket - (bucket_start[bucket + 1] - bucket_start[bucket])]++] = bucket;
+    }
+
+    free(fill);
+    free(by_size);
+
+    for (size_t rank = 0; rank < buckets; rank++) {
+        const size_t bucket = order[rank];
+        const size_t first = bucket_start[bucket];
+        const size_t count = bucket_start[bucket + 1] - first;
+        bool placed = (count == 0);
+
+        map->pilots[bucket] = 0;
+
+        for (uint32_t pilot = 0; !placed && pilot <= UINT16_MAX; pilot++) {
+            size_t done = 0;
+
+            for (; done < count; done++) {
+                const size_t pos = frozen_position(hashes[bucket_keys[first + done]], (uint16_t)pilot, map->table_size);
+
+                if (taken[pos / 8] & (1u << (pos % 8))) {
+                    break;
+                }
+
+                // Keys of the same bucket must not collide with each other either
+                taken[pos / 8] |= (uint8_t)(1u << (pos % 8));
+                slots[done] = pos;
+            }
+
+            if (done == count) {
+                map->pilots[bucket] = (uint16_t)pilot;
+                for (size_t idx = 0; idx < count; idx++) {
+                    positions[bucket_keys[first + idx]] = slots[idx];
+                }
+                placed = true;
+            } else {
+                // Release the positions claimed by this attempt
+                for (size_t idx = 0; idx < done; idx++) {
+                    taken[slots[idx] / 8] &= (uint8_t)~(1u << (slots[idx] % 8));
+                }
+            }
+        }
+
+        if (!placed) {
+            status = MAP_ERR_OVERFLOW;
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    free(bucket_start);
+    free(bucket_keys);
+    free(order);
+    free(taken);
+    free(slots);
+
+    return status;
+}
+
+/**
+ * map_freeze
+ *  @map: a non-null map
+ *
+ *  Builds a read-only copy of @map indexed by a minimal perfect hash in the
+ *  style of PTHash. Keys are spread over buckets of FROZEN_BUCKET_SIZE keys on
+ *  average and every bucket stores a 16-bit pilot that displaces its keys
+ *  to distinct slots of a table of size / FROZEN_LOAD_FACTOR entries.
+ *  Each slot holds the key header next to the value, so that a lookup
+ *  touches one pilot and one slot. Values are copied if @map owns them,
+ *  otherwise their pointers are shared
+ *
+ *  Returns a map_result_t data type containing the frozen map
+ */
+map_result_t map_freeze(const map_t *map) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    const size_t n = map->size;
+    const size_t table_size = n ? (size_t)((double)n / FROZEN_LOAD_FACTOR) + 1 : 0;
+    if (table_size > UINT32_MAX) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Too many keys to freeze");
+
+        return result;
+    }
+
+    frozen_map_t *frozen = calloc(1, sizeof(frozen_map_t));
+    uint64_t *hashes = malloc((n ? n : 1) * sizeof(uint64_t));
+    size_t *positions = malloc((n ? n : 1) * sizeof(size_t));
+    size_t *sources = malloc((n ? n : 1) * sizeof(size_t));
+    if (frozen == NULL || hashes == NULL || positions == NULL || sources == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for frozen map");
+        goto failure;
+    }
+
+    frozen->size = n;
+    frozen->table_size = table_size;
+    frozen->bucket_count = n ? (n + FROZEN_BUCKET_SIZE - 1) / FROZEN_BUCKET_SIZE : 0;
+    frozen->value_size = map->value_size;
+    frozen->owns_values = map->owns_values;
+
+    // Collect the keys of both tables of an ongoing resize
+    size_t arena_size = 0, count = 0;
+    for (size_t idx = map_next_occupied(map, 0); idx != SIZE_MAX && count < n; idx = map_next_occupied(map, idx + 1)) {
+        const map_element_t *element = map_slot_element(map, idx);
+
+        sources[count++] = idx;
+        if (element->key_len > MAP_INLINE_KEY_MAX) {
+            arena_size += element->key_len;
+        }
+    }
+
+    if (count != n) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Map size does not match its slots");
+        goto failure;
+    }
+
+    // Keep each slot header 8-byte aligned
+    const size_t align = sizeof(uint64_t);
+    frozen->slot_size = (sizeof(map_element_t) + map->value_size + align - 1) & ~(align - 1);
+    if (table_size > SIZE_MAX / frozen->slot_size) {
+        result.status = MAP_ERR_OVERFLOW;
+        SET_MSG(result, "Too many keys to freeze");
+        goto failure;
+    }
+
+    frozen->pilots = malloc((frozen->bucket_count ? frozen->bucket_count : 1) * sizeof(uint16_t));
+    frozen->slots = malloc((table_size ? table_size : 1) * frozen->slot_size);
+    frozen->key_arena = malloc(arena_size ? arena_size : 1);
+    if (frozen->pilots == NULL || frozen->slots == NULL || frozen->key_arena == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for frozen map");
+        goto failure;
+    }
+
+    // Retry with a new seed when some bucket cannot be placed
+    map_status_t status = n ? MAP_ERR_OVERFLOW : MAP_OK;
+    for (uint64_t attempt = 0; attempt < FROZEN_MAX_ATTEMPTS && status == MAP_ERR_OVERFLOW; attempt++) {
+        frozen->seed = hash_int(FNV_OFFSET_BASIS_64 + attempt);
+        for (size_t idx = 0; idx < n; idx++) {
+            const map_element_t *element = map_slot_element(map, sources[idx]);
+            hashes[idx] = frozen_key_hash(frozen->seed, map_element_key(map, element), element->key_len);
+        }
+
+        status = frozen_build_pilots(frozen, hashes, positions);
+    }
+
+    if (status != MAP_OK) {
+        result.status = status;
+        SET_MSG(result, (status == MAP_ERR_ALLOCATE ?
+                "Failed to allocate memory for frozen map" : "Failed to build the perfect hash"));
+        goto failure;
+    }
+
+    for (size_t slot = 0; slot < table_size; slot++) {
+        frozen_slot(frozen, slot)->key_len = FROZEN_EMPTY_SLOT;
+    }
+
+    // Copy the key header and the value of each key into its slot
+    for (size_t idx = 0; idx < n; idx++) {
+        const map_element_t *element = map_slot_element(map, sources[idx]);
+        map_element_t *header = frozen_slot(frozen, positions[idx]);
+
+        *header = *element;
+        if (element->key_len > MAP_INLINE_KEY_MAX) {
+            memcpy(frozen->key_arena + frozen->arena_size, map_element_key(map, element), element->key_len);
+            header->key.offset = frozen->arena_size;
+            frozen->arena_size += element->key_len;
         }
+        memcpy(frozen_slot_value(frozen, positions[idx]), map_slot_value(map, sources[idx]), map->value_size);
+    }
+
+    free(hashes);
+    free(positions);
+    free(sources);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully frozen");
+    result.value.frozen = frozen;
+
+    return result;
+
+failure:
+    free(hashes);
+    free(positions);
+    free(sources);
+    frozen_map_destroy(frozen);
+
+    return result;
+}
+
+/**
+ * frozen_map_get_bytes
+ *  @map: a non-null frozen map
+ *  @key: an arbitrary sequence of bytes representing the index key
+ *  @key_len: length of @key in bytes
+ *
+ *  Computes the only slot that can hold @key and compares the stored key
+ *
+ *  Returns a map_result_t data type containing the element indexed by @key if available
+ */
+map_result_t frozen_map_get_bytes(const frozen_map_t *map, const void *key, size_t key_len) {
+    map_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    if (map->size == 0) {
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    const uint64_t key_hash = frozen_key_hash(map->seed, (const char*)key, key_len);
+    const uint16_t pilot = map->pilots[frozen_bucket(key_hash, map->bucket_count)];
+    const size_t slot = frozen_position(key_hash, pilot, map->table_size);
+    const map_element_t *element = frozen_slot(map, slot);
+
+    // Empty slots never match, since no key is FROZEN_EMPTY_SLOT bytes long
+    if (element->key_len != key_len || key_len >= FROZEN_EMPTY_SLOT ||
+        memcmp(key_len <= MAP_INLINE_KEY_MAX ? element->key.inline_key :
+               map->key_arena + element->key.offset, key, key_len)) {
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Value successfully retrieved");
+    uint8_t *storage = frozen_slot_value(map, slot);
+    if (map->owns_values) {
+        result.value.element = storage;
+    } else {
+        memcpy(&result.value.element, storage, sizeof(void*));
+    }
+
+    return result;
+}
+
+/**
+ * frozen_map_get
+ *  @map: a non-null frozen map
+ *  @key: a string representing the index key
+ *
+ *  Returns a map_result_t data type containing the element indexed by @key if available
+ */
+map_result_t frozen_map_get(const frozen_map_t *map, const char *key) {
+    map_result_t result = {0};
+
+    if (key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    return frozen_map_get_bytes(map, key, strlen(key));
+}
+
+/**
+ * frozen_map_destroy
+ *  @map: a non-null frozen map
+ *
+ *  Deletes the frozen map and all its elements from the memory
+ *
+ *  Returns a map_result_t data type
+ */
+map_result_t frozen_map_destroy(frozen_map_t *map) {
+    map_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
     }
 
-    free(map->elements);
+    free(map->pilots);
+    free(map->slots);
+    free(map->key_arena);
     free(map);
 
     result.status = MAP_OK;
@@ -7,19 +7,56 @@
 #define INITIAL_CAP 4
 #define LOAD_FACTOR_THRESHOLD 0.75
 
+// Keys up to MAP_INLINE_KEY_MAX bytes are stored inside the slot,
+// longer keys are appended to the map-owned key arena
+#define MAP_INLINE_KEY_SIZE 16
+#define MAP_INLINE_KEY_MAX (MAP_INLINE_KEY_SIZE - 1)
+#define MAP_INITIAL_ARENA_CAP 64
+
+// Metadata (control byte) of each map slot. Occupied slots store
+// MAP_CTRL_OCCUPIED ored with the 7 high bits of the key digest
+#define MAP_CTRL_EMPTY 0x00
+#define MAP_CTRL_DELETED 0x01
+#define MAP_CTRL_OCCUPIED 0x80
+// Number of control bytes scanned at once by the iterator
+#define MAP_GROUP_SIZE 8
+// Number of keys hashed and prefetched at once by the batch operations
+#define MAP_BATCH_SIZE 32
+// Number of old slots migrated by each update during an incremental resize
+#define MAP_MIGRATE_STEP 32
+
+// Perfect hash of frozen maps: average number of keys per bucket, share (in
+// percent) of the keys sent to the dense buckets and share of dense buckets,
+// fill ratio of the table and number of seeds to try
+#define FROZEN_BUCKET_SIZE 6
+#define FROZEN_DENSE_KEYS 60
+#define FROZEN_DENSE_BUCKETS 30
+#define FROZEN_LOAD_FACTOR 0.97
+#define FROZEN_MAX_ATTEMPTS 8
+// Key length of the slots of a frozen map that hold no key
+#define FROZEN_EMPTY_SLOT UINT32_MAX
+
+// Snapshot file format. Sections are aligned to MAP_FILE_ALIGN bytes
+#define MAP_FILE_MAGIC "DATUMMAP"
+#define MAP_FILE_VERSION 1
+#define MAP_FILE_ALIGN 64
+
 // FNV-1a constants
 #define FNV_OFFSET_BASIS_64 0xCBF29CE484222325
 #define FNV_PRIME_64 0x00000100000001B3
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdbool.h>
+#include "vector.h"
 
 typedef enum {
     MAP_OK = 0x0,
     MAP_ERR_ALLOCATE,
     MAP_ERR_OVERFLOW,
     MAP_ERR_INVALID,
-    MAP_ERR_NOT_FOUND
+    MAP_ERR_NOT_FOUND,
+    MAP_ERR_IO
 } map_status_t;
 
 typedef enum {
@@ -29,38 +66,140 @@ typedef enum {
 } element_state_t;
 
 typedef struct {
-    char *key;
-    void *value;
-    element_state_t state;
+    union {
+        char inline_key[MAP_INLINE_KEY_SIZE]; // key_len <= MAP_INLINE_KEY_MAX
+        size_t offset; // key_len > MAP_INLINE_KEY_MAX, offset into the key arena
+    } key;
+    uint32_t key_len;
 } map_element_t;
 
 typedef struct {
+    uint8_t *ctrl; // Control bytes, padded to a multiple of MAP_GROUP_SIZE
     map_element_t *elements;
+    uint8_t *values; // Parallel array of value_size bytes per slot
+    size_t value_size;
+    bool owns_values; // Values are copied into the map instead of referenced
     size_t capacity;
     size_t size;
     size_t tombstone_count;
+    char *key_arena; // Contiguous storage for long keys
+    size_t arena_size;
+    size_t arena_capacity;
+    size_t arena_garbage; // Bytes held by removed keys
+    bool incremental; // Resize by migrating a few slots on each update
+    uint8_t *old_ctrl; // Table being migrated, NULL when no resize is in progress
+    map_element_t *old_elements;
+    uint8_t *old_values;
+    size_t old_capacity;
+    size_t old_size; // Elements not yet migrated
+    size_t migrate_index; // Next slot of the old table to migrate
+    void *mapping; // Read-only file mapping backing the arrays, if any
+    size_t mapping_size;
 } map_t;
 
+// Slot header of an integer map, followed by value_size bytes
+typedef struct {
+    uint64_t key;
+    element_state_t state;
+} intmap_element_t;
+
+typedef struct {
+    uint8_t *slots; // Header and value of each slot are stored contiguously
+    size_t slot_size;
+    size_t value_size;
+    bool owns_values;
+    size_t capacity;
+    size_t size;
+    size_t tombstone_count;
+} intmap_t;
+
+// Read-only map indexed by a minimal perfect hash
+typedef struct {
+    uint64_t seed;
+    size_t size;
+    size_t table_size; // Number of slots, about size / FROZEN_LOAD_FACTOR
+    size_t bucket_count;
+    uint16_t *pilots; // Displacement of each bucket
+    uint8_t *slots; // Key header and value of each slot are stored contiguously
+    size_t slot_size;
+    char *key_arena; // Keys longer than MAP_INLINE_KEY_MAX
+    size_t arena_size;
+    size_t value_size;
+    bool owns_values;
+} frozen_map_t;
+
 typedef struct {
     map_status_t status;
     uint8_t message[RESULT_MSG_SIZE];
     union {
         map_t *map;
+        intmap_t *intmap;
+        frozen_map_t *frozen;
+        vector_t *vector;
         void *element;
     } value;
 } map_result_t;
 
+typedef struct {
+    const map_t *map;
+    size_t index; // Next slot to inspect
+    const char *key;
+    size_t key_len;
+    void *value;
+} map_iter_t;
+
+// Callback functions
+typedef void (*map_foreach_fn)(const char *key, size_t key_len, void *value, void *env);
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 map_result_t map_new(void);
+map_result_t map_new_sized(size_t value_size);
+map_result_t map_new_keys(void);
+map_result_t map_clone(const map_t *map);
+map_result_t map_set_incremental(map_t *map, bool enabled);
+map_result_t map_save(const map_t *map, const char *path);
+map_result_t map_open_mmap(const char *path);
 map_result_t map_add(map_t *map, const char *key, void *value);
+map_result_t map_add_bytes(map_t *map, const void *key, size_t key_len, void *value);
 map_result_t map_get(const map_t *map, const char *key);
+map_result_t map_get_bytes(const map_t *map, const void *key, size_t key_len);
+map_result_t map_add_batch(map_t *map, const char *const *keys, void *const *values,
+                           size_t count, map_status_t *out_status);
+map_result_t map_get_batch(const map_t *map, const char *const *keys, size_t count,
+                           void **out_values, map_status_t *out_status);
 map_result_t map_remove(map_t *map, const char *key);
+map_result_t map_remove_bytes(map_t *map, const void *key, size_t key_len);
+map_result_t map_keys(const map_t *map);
+map_result_t map_values(const map_t *map);
+map_result_t map_foreach(const map_t *map, map_foreach_fn callback, void *env);
 map_result_t map_clear(map_t *map);
 map_result_t map_destroy(map_t *map);
 
+uint64_t map_hash(const void *key, size_t key_len);
+uint64_t map_hash_int(uint64_t key);
+// Variants of the _bytes methods taking the map_hash of the key, for callers that already computed it
+map_result_t map_add_digest(map_t *map, const void *key, size_t key_len, uint64_t key_digest, void *value);
+map_result_t map_get_digest(const map_t *map, const void *key, size_t key_len, uint64_t key_digest);
+map_result_t map_remove_digest(map_t *map, const void *key, size_t key_len, uint64_t key_digest);
+map_iter_t map_iter_begin(const map_t *map);
+bool map_iter_next(map_iter_t *iter);
+
+map_result_t intmap_new(void);
+map_result_t intmap_new_sized(size_t value_size);
+map_result_t intmap_add(intmap_t *map, uint64_t key, void *value);
+map_result_t intmap_get(const intmap_t *map, uint64_t key);
+map_result_t intmap_remove(intmap_t *map, uint64_t key);
+map_result_t intmap_clear(intmap_t *map);
+map_result_t intmap_destroy(intmap_t *map);
+
+map_result_t map_freeze(const map_t *map);
+map_result_t frozen_map_get(const frozen_map_t *map, const char *key);
+map_result_t frozen_map_get_bytes(const frozen_map_t *map, const void *key, size_t key_len);
+map_result_t frozen_map_destroy(frozen_map_t *map);
+
 // Inline methods
 static inline size_t map_size(const map_t *map) {
     return map ? map->size : 0;
@@ -70,6 +209,22 @@ static inline size_t map_capacity(const map_t *map) {
     return map ? map->capacity : 0;
 }
 
+static inline size_t map_value_size(const map_t *map) {
+    return map ? map->value_size : 0;
+}
+
+static inline size_t intmap_size(const intmap_t *map) {
+    return map ? map->size : 0;
+}
+
+static inline size_t intmap_capacity(const intmap_t *map) {
+    return map ? map->capacity : 0;
+}
+
+static inline size_t frozen_map_size(const frozen_map_t *map) {
+    return map ? map->size : 0;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,1552 @@
+#define _POSIX_C_SOURCE 200809L
+
+#define SET_MSG(result, msg) \
+    do { \
+        snprintf((char *)(result).message, RESULT_MSG_SIZE, "%s", (const char *)msg); \
+    } while (0)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "omap.h"
+
+// Suffix length marking a long key: the node stores a pointer to it
+#define OMAP_LONG_KEY UINT16_MAX
+// Entries handled at once: two nodes and the separator between them
+#define OMAP_WORK_ENTRIES (2 * OMAP_FANOUT + 2)
+#define OMAP_CACHE_LINE 64
+
+// Keys longer than OMAP_INLINE_KEY_MAX bytes, NUL-terminated
+typedef struct {
+    size_t len;
+    char bytes[];
+} omap_long_key_t;
+
+typedef struct {
+    uint16_t count;
+    uint16_t prefix_len; // Bytes shared by every key, stored at the start of data
+    uint16_t data_used;
+    uint8_t leaf;
+    uint16_t offsets[OMAP_FANOUT]; // Position of each suffix in data
+    uint16_t lengths[OMAP_FANOUT]; // Length of each suffix, or OMAP_LONG_KEY
+    void *ptrs[OMAP_FANOUT + 1]; // Values of a leaf, children of an inner node
+    omap_node_t *next; // Next leaf in key order
+} omap_header_t;
+
+#define OMAP_DATA_SIZE (OMAP_NODE_SIZE - sizeof(omap_header_t))
+
+struct omap_node {
+    omap_header_t h;
+    uint8_t data[OMAP_DATA_SIZE];
+};
+
+// A node must span exactly OMAP_NODE_SIZE bytes
+typedef char omap_node_size_check[(sizeof(omap_node_t) == OMAP_NODE_SIZE) ? 1 : -1];
+
+// A key of a node, rebuilt in full while the node is rewritten
+typedef struct {
+    const uint8_t *key;
+    size_t len;
+    omap_long_key_t *long_key; // Owned copy of a long key, NULL otherwise
+    void *ptr; // Value, or child on the right of the key
+} omap_entry_t;
+
+typedef struct {
+    omap_entry_t entries[OMAP_WORK_ENTRIES];
+    uint8_t scratch[OMAP_WORK_ENTRIES][OMAP_INLINE_KEY_MAX];
+} omap_work_t;
+
+// Separator and new node produced by a split
+typedef struct {
+    bool happened;
+    omap_entry_t separator;
+    uint8_t buffer[OMAP_INLINE_KEY_MAX];
+} omap_split_t;
+
+/**
+ * omap_compare
+ *  @a: a sequence of bytes
+ *  @a_len: length of @a
+ *  @b: a sequence of bytes
+ *  @b_len: length of @b
+ *
+ *  Returns a negative, zero or positive value if @a sorts before, equal to or after @b
+ */
+static inline int omap_compare(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len) {
+    const int cmp = memcmp(a, b, a_len < b_len ? a_len : b_len);
+
+    if (cmp != 0) {
+        return cmp;
+    }
+
+    return (a_len > b_len) - (a_len < b_len);
+}
+
+/**
+ * omap_common_prefix
+ *  @a: a sequence of bytes
+ *  @a_len: length of @a
+ *  @b: a sequence of bytes
+ *  @b_len: length of @b
+ *
+ *  Returns the number of leading bytes shared by @a and @b
+ */
+static inline size_t omap_common_prefix(const uint8_t *a, size_t a_len, const uint8_t *b, size_t b_len) {
+    const size_t limit = a_len < b_len ? a_len : b_len;
+    size_t len = 0;
+
+    while (len < limit && a[len] == b[len]) {
+        len++;
+    }
+
+    return len;
+}
+
+/**
+ * omap_suffix
+ *  @node: a non-null node
+ *  @idx: the index of a key of @node
+ *  @len: receives the length of the suffix
+ *
+ *  Returns the bytes of the key at @idx that follow the prefix of @node
+ */
+static inline const uint8_t *omap_suffix(const omap_node_t *node, size_t idx, size_t *len) {
+    const uint8_t *slot = node->data + node->h.offsets[idx];
+
+    if (node->h.lengths[idx] == OMAP_LONG_KEY) {
+        omap_long_key_t *long_key;
+        memcpy(&long_key, slot, sizeof(long_key));
+        *len = long_key->len - node->h.prefix_len;
+
+        return (const uint8_t*)long_key->bytes + node->h.prefix_len;
+    }
+
+    *len = node->h.lengths[idx];
+
+    return slot;
+}
+
+/**
+ * omap_long_key_at
+ *  @node: a non-null node
+ *  @idx: the index of a key of @node
+ *
+ *  Returns the long key stored at @idx or NULL if the key is stored inline
+ */
+static inline omap_long_key_t *omap_long_key_at(const omap_node_t *node, size_t idx) {
+    omap_long_key_t *long_key = NULL;
+
+    if (node->h.lengths[idx] == OMAP_LONG_KEY) {
+        memcpy(&long_key, node->data + node->h.offsets[idx], sizeof(long_key));
+    }
+
+    return long_key;
+}
+
+/**
+ * omap_node_search
+ *  @node: a non-null node
+ *  @key: a sequence of bytes
+ *  @key_len: length of @key
+ *  @exact: set to true if @node contains @key
+ *
+ *  Compares @key with the prefix of @node once, then binary searches the suffixes
+ *
+ *  Returns the index of the first key of @node that is not lower than @key
+ */
+static size_t omap_node_search(const omap_node_t *node, const uint8_t *key, size_t key_len, bool *exact) {
+    const size_t prefix_len = node->h.prefix_len;
+    const int cmp = memcmp(key, node->data, key_len < prefix_len ? key_len : prefix_len);
+
+    *exact = false;
+
+    if (cmp < 0 || (cmp == 0 && key_len < prefix_len)) {
+        return 0;
+    }
+
+    if (cmp > 0) {
+        return node->h.count;
+    }
+
+    key += prefix_len;
+    key_len -= prefix_len;
+
+    size_t lo = 0, hi = node->h.count;
+    while (lo < hi) {
+        const size_t mid = lo + ((hi - lo) / 2);
+        size_t suffix_len;
+        const uint8_t *suffix = omap_suffix(node, mid, &suffix_len);
+        const int order = omap_compare(suffix, suffix_len, key, key_len);
+
+        if (order < 0) {
+            lo = mid + 1;
+        } else if (order > 0) {
+            hi = mid;
+        } else {
+            *exact = true;
+
+            return mid;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * omap_child_index
+ *  @node: a non-null inner node
+ *  @key: a sequence of bytes
+ *  @key_len: length of @key
+ *
+ *  Returns the index of the child of @node whose keys range includes @key
+ */
+static inline size_t omap_child_index(const omap_node_t *node, const uint8_t *key, size_t key_len) {
+    bool exact;
+    const size_t idx = omap_node_search(node, key, key_len, &exact);
+
+    return exact ? idx + 1 : idx;
+}
+
+/**
+ * omap_find_leaf
+ *  @map: a non-null ordered map
+ *  @key: a sequence of bytes
+ *  @key_len: length of @key
+ *
+ *  Returns the leaf where @key is or would be stored
+ */
+static const omap_node_t *omap_find_leaf(const omap_t *map, const uint8_t *key, size_t key_len) {
+    const omap_node_t *node = map->root;
+
+    while (!node->h.leaf) {
+        node = node->h.ptrs[omap_child_index(node, key, key_len)];
+    }
+
+    return node;
+}
+
+/**
+ * omap_load
+ *  @node: a non-null node
+ *  @work: a work area
+ *  @first: index of the first entry to fill
+ *
+ *  Rebuilds the full keys of @node into the entries of @work starting at @first.
+ *  The child on the left of the first key of an inner node is not loaded
+ *
+ *  Returns the number of loaded entries
+ */
+static size_t omap_load(const omap_node_t *node, omap_work_t *work, size_t first) {
+    for (size_t idx = 0; idx < node->h.count; idx++) {
+        omap_entry_t *entry = &work->entries[first + idx];
+
+        entry->long_key = omap_long_key_at(node, idx);
+        entry->ptr = node->h.ptrs[node->h.leaf ? idx : idx + 1];
+
+        if (entry->long_key != NULL) {
+            entry->key = (const uint8_t*)entry->long_key->bytes;
+            entry->len = entry->long_key->len;
+        } else {
+            uint8_t *buffer = work->scratch[first + idx];
+            memcpy(buffer, node->data, node->h.prefix_len);
+            memcpy(buffer + node->h.prefix_len, node->data + node->h.offsets[idx], node->h.lengths[idx]);
+            entry->key = buffer;
+            entry->len = node->h.prefix_len + node->h.lengths[idx];
+        }
+    }
+
+    return node->h.count;
+}
+
+/**
+ * omap_layout
+ *  @entries: sorted entries
+ *  @count: number of entries
+ *  @prefix_len: receives the length of the prefix shared by the entries
+ *
+ *  Returns the number of data bytes needed to store @entries in one node
+ */
+static size_t omap_layout(const omap_entry_t *entries, size_t count, size_t *prefix_len) {
+    if (count == 0) {
+        *prefix_len = 0;
+
+        return 0;
+    }
+
+    // Keys are sorted, so the first and the last one share the shortest prefix
+    size_t shared = omap_common_prefix(entries[0].key, entries[0].len,
+                                       entries[count - 1].key, entries[count - 1].len);
+    if (shared > OMAP_PREFIX_MAX) {
+        shared = OMAP_PREFIX_MAX;
+    }
+
+    size_t bytes = shared;
+    for (size_t idx = 0; idx < count; idx++) {
+        bytes += entries[idx].long_key != NULL ? sizeof(omap_long_key_t*) : entries[idx].len - shared;
+    }
+
+    *prefix_len = shared;
+
+    return bytes;
+}
+
+/**
+ * omap_fits
+ *  @entries: sorted entries
+ *  @count: number of entries
+ *
+ *  Returns true if @entries can be stored in a single node
+ */
+static inline bool omap_fits(const omap_entry_t *entries, size_t count) {
+    size_t prefix_len;
+
+    return count <= OMAP_FANOUT && omap_layout(entries, count, &prefix_len) <= OMAP_DATA_SIZE;
+}
+
+/**
+ * omap_store
+ *  @node: a non-null node
+ *  @entries: sorted entries that fit in a node
+ *  @count: number of entries
+ *
+ *  Rewrites the keys and the pointers of @node, factoring out their
+ *  common prefix. The first child of an inner node is left untouched
+ */
+static void omap_store(omap_node_t *node, const omap_entry_t *entries, size_t count) {
+    size_t prefix_len;
+    omap_layout(entries, count, &prefix_len);
+
+    node->h.count = (uint16_t)count;
+    node->h.prefix_len = (uint16_t)prefix_len;
+    if (count > 0) {
+        memcpy(node->data, entries[0].key, prefix_len);
+    }
+
+    size_t used = prefix_len;
+    for (size_t idx = 0; idx < count; idx++) {
+        const omap_entry_t *entry = &entries[idx];
+
+        node->h.offsets[idx] = (uint16_t)used;
+        if (entry->long_key != NULL) {
+            node->h.lengths[idx] = OMAP_LONG_KEY;
+            memcpy(node->data + used, &entry->long_key, sizeof(entry->long_key));
+            used += sizeof(entry->long_key);
+        } else {
+            node->h.lengths[idx] = (uint16_t)(entry->len - prefix_len);
+            memcpy(node->data + used, entry->key + prefix_len, entry->len - prefix_len);
+            used += entry->len - prefix_len;
+        }
+
+        node->h.ptrs[node->h.leaf ? idx : idx + 1] = entry->ptr;
+    }
+
+    node->h.data_used = (uint16_t)used;
+}
+
+/**
+ * omap_append
+ *  @node: a non-null node
+ *  @entry: an entry greater than every key of @node
+ *  @work: a work area
+ *
+ *  Appends @entry at the end of @node. The node is rewritten only if the
+ *  new key does not share the prefix of @node
+ *
+ *  Returns true on success, false if @node is full
+ */
+static bool omap_append(omap_node_t *node, const omap_entry_t *entry, omap_work_t *work) {
+    const size_t count = node->h.count;
+    const size_t prefix_len = node->h.prefix_len;
+
+    if (count == OMAP_FANOUT) {
+        return false;
+    }
+
+    if (count > 0 && entry->len >= prefix_len && !memcmp(entry->key, node->data, prefix_len)) {
+        const size_t bytes = entry->long_key != NULL ? sizeof(entry->long_key) : entry->len - prefix_len;
+        if (node->h.data_used + bytes > OMAP_DATA_SIZE) {
+            return false;
+        }
+
+        const size_t used = node->h.data_used;
+        node->h.offsets[count] = (uint16_t)used;
+        if (entry->long_key != NULL) {
+            node->h.lengths[count] = OMAP_LONG_KEY;
+            memcpy(node->data + used, &entry->long_key, sizeof(entry->long_key));
+        } else {
+            node->h.lengths[count] = (uint16_t)(entry->len - prefix_len);
+            memcpy(node->data + used, entry->key + prefix_len, entry->len - prefix_len);
+        }
+
+        node->h.ptrs[node->h.leaf ? count : count + 1] = entry->ptr;
+        node->h.data_used = (uint16_t)(used + bytes);
+        node->h.count++;
+
+        return true;
+    }
+
+    omap_load(node, work, 0);
+    work->entries[count] = *entry;
+    if (!omap_fits(work->entries, count + 1)) {
+        return false;
+    }
+
+    omap_store(node, work->entries, count + 1);
+
+    return true;
+}
+
+/**
+ * omap_new_long_key
+ *  @key: a sequence of bytes
+ *  @key_len: length of @key
+ *
+ *  Returns a NUL-terminated copy of @key or NULL on allocation failure
+ */
+static omap_long_key_t *omap_new_long_key(const uint8_t *key, size_t key_len) {
+    omap_long_key_t *long_key = malloc(sizeof(omap_long_key_t) + key_len + 1);
+
+    if (long_key != NULL) {
+        long_key->len = key_len;
+        memcpy(long_key->bytes, key, key_len);
+        long_key->bytes[key_len] = '\0';
+    }
+
+    return long_key;
+}
+
+/**
+ * omap_alloc_node
+ *  @map: a non-null ordered map
+ *
+ *  Returns a new empty node aligned to a cache line or NULL on allocation failure
+ */
+static omap_node_t *omap_alloc_node(omap_t *map) {
+    void *memory = NULL;
+
+    if (posix_memalign(&memory, OMAP_CACHE_LINE, sizeof(omap_node_t)) != 0) {
+        return NULL;
+    }
+
+    omap_node_t *node = memory;
+    memset(&node->h, 0, sizeof(node->h));
+    map->node_count++;
+
+    return node;
+}
+
+/**
+ * omap_free_node
+ *  @map: a non-null ordered map
+ *  @node: a node
+ *
+ *  Frees @node together with its long keys and, recursively, its children
+ */
+static void omap_free_node(omap_t *map, omap_node_t *node) {
+    if (node == NULL) {
+        return;
+    }
+
+    for (size_t idx = 0; idx < node->h.count; idx++) {
+        free(omap_long_key_at(node, idx));
+    }
+
+    if (!node->h.leaf) {
+        for (size_t idx = 0; idx <= node->h.count; idx++) {
+            omap_free_node(map, node->h.ptrs[idx]);
+        }
+    }
+
+    free(node);
+    map->node_count--;
+}
+
+/**
+ * omap_reserve
+ *  @map: a non-null ordered map
+ *
+ *  Makes sure that enough spare nodes are available to split every
+ *  level of the tree and to add a new root, so that an insertion
+ *  never fails halfway
+ *
+ *  Returns true on success, false on allocation failure
+ */
+static bool omap_reserve(omap_t *map) {
+    while (map->spare_count < map->height + 1) {
+        omap_node_t *node = omap_alloc_node(map);
+        if (node == NULL) {
+            return false;
+        }
+
+        node->h.next = map->spare;
+        map->spare = node;
+        map->spare_count++;
+    }
+
+    return true;
+}
+
+/**
+ * omap_take_node
+ *  @map: a non-null ordered map with spare nodes
+ *  @leaf: whether the node is a leaf
+ *
+ *  Returns an empty node taken from the reserve
+ */
+static omap_node_t *omap_take_node(omap_t *map, bool leaf) {
+    omap_node_t *node = map->spare;
+
+    map->spare = node->h.next;
+    map->spare_count--;
+    memset(&node->h, 0, sizeof(node->h));
+    node->h.leaf = leaf;
+
+    return node;
+}
+
+/**
+ * omap_split_point
+ *  @entries: sorted entries that do not fit in a node
+ *  @count: number of entries
+ *  @skip: 1 if the entry at the split point moves to the parent, 0 otherwise
+ *
+ *  Looks for the split point closest to the middle such that
+ *  both halves fit in a node
+ *
+ *  Returns the index of the first entry of the right half, 0 if none exists
+ */
+static size_t omap_split_point(const omap_entry_t *entries, size_t count, size_t skip) {
+    const size_t middle = count / 2;
+
+    for (size_t distance = 0; distance <= middle; distance++) {
+        const size_t candidates[2] = { middle + distance, middle - distance };
+
+        for (size_t idx = 0; idx < 2; idx++) {
+            const size_t split = candidates[idx];
+
+            if (split >= 1 && split + skip <= count &&
+                omap_fits(entries, split) && omap_fits(entries + split + skip, count - split - skip)) {
+                return split;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * omap_set_separator
+ *  @split: the split to fill
+ *  @key: the bytes of the separator
+ *  @key_len: length of @key
+ *  @long_key: an owned copy of @key if it is a long key, NULL otherwise
+ *  @right: the new node on the right of the separator
+ */
+static void omap_set_separator(omap_split_t *split, const uint8_t *key, size_t key_len,
+                               omap_long_key_t *long_key, omap_node_t *right) {
+    split->happened = true;
+    split->separator.len = key_len;
+    split->separator.long_key = long_key;
+    split->separator.ptr = right;
+
+    if (long_key != NULL) {
+        split->separator.key = (const uint8_t*)long_key->bytes;
+    } else {
+        memcpy(split->buffer, key, key_len);
+        split->separator.key = split->buffer;
+    }
+}
+
+/**
+ * omap_insert
+ *  @map: a non-null ordered map with enough spare nodes
+ *  @node: the root of the subtree
+ *  @entry: the entry to insert (its long key, if any, is already allocated)
+ *  @work: a work area
+ *  @split: receives the separator and the new node if @node has been split
+ *  @replaced: set to true if the key already existed
+ *
+ *  Returns MAP_OK on success or an error status
+ */
+static map_status_t omap_insert(omap_t *map, omap_node_t *node, const omap_entry_t *entry,
+                                omap_work_t *work, omap_split_t *split, bool *replaced) {
+    split->happened = false;
+
+    if (node->h.leaf) {
+        bool exact;
+        const size_t pos = omap_node_search(node, entry->key, entry->len, &exact);
+
+        if (exact) {
+            node->h.ptrs[pos] = entry->ptr;
+            *replaced = true;
+
+            return MAP_OK;
+        }
+
+        const size_t count = omap_load(node, work, 0);
+        memmove(&work->entries[pos + 1], &work->entries[pos], (count - pos) * sizeof(omap_entry_t));
+        work->entries[pos] = *entry;
+
+        if (omap_fits(work->entries, count + 1)) {
+            omap_store(node, work->entries, count + 1);
+
+            return MAP_OK;
+        }
+
+        const size_t half = omap_split_point(work->entries, count + 1, 0);
+        if (half == 0) {
+            return MAP_ERR_OVERFLOW;
+        }
+
+        // Shortest key that separates both halves
+        const omap_entry_t *last = &work->entries[half - 1];
+        const omap_entry_t *first = &work->entries[half];
+        const size_t sep_len = omap_common_prefix(last->key, last->len, first->key, first->len) + 1;
+        omap_long_key_t *sep_key = NULL;
+
+        if (sep_len > OMAP_INLINE_KEY_MAX) {
+            sep_key = omap_new_long_key(first->key, sep_len);
+            if (sep_key == NULL) {
+                return MAP_ERR_ALLOCATE;
+            }
+        }
+
+        omap_node_t *right = omap_take_node(map, true);
+        omap_store(right, work->entries + half, count + 1 - half);
+        omap_store(node, work->entries, half);
+        right->h.next = node->h.next;
+        node->h.next = right;
+
+        omap_set_separator(split, first->key, sep_len, sep_key, right);
+
+        return MAP_OK;
+    }
+
+    const size_t child_idx = omap_child_index(node, entry->key, entry->len);
+    omap_split_t child_split;
+    const map_status_t status = omap_insert(map, node->h.ptrs[child_idx], entry, work, &child_split, replaced);
+
+    if (status != MAP_OK || !child_split.happened) {
+        return status;
+    }
+
+    const size_t count = omap_load(node, work, 0);
+    memmove(&work->entries[child_idx + 1], &work->entries[child_idx], (count - child_idx) * sizeof(omap_entry_t));
+    work->entries[child_idx] = child_split.separator;
+
+    if (omap_fits(work->entries, count + 1)) {
+        omap_store(node, work->entries, count + 1);
+
+        return MAP_OK;
+    }
+
+    // The middle separator moves up to the parent
+    const size_t half = omap_split_point(work->entries, count + 1, 1);
+    if (half == 0) {
+        return MAP_ERR_OVERFLOW;
+    }
+
+    const omap_entry_t middle = work->entries[half];
+    omap_node_t *right = omap_take_node(map, false);
+    right->h.ptrs[0] = middle.ptr;
+    omap_store(right, work->entries + half + 1, count - half);
+    omap_store(node, work->entries, half);
+
+    omap_set_separator(split, middle.key, middle.len, middle.long_key, right);
+
+    return MAP_OK;
+}
+
+/**
+ * omap_merge
+ *  @map: a non-null ordered map
+ *  @node: a non-null inner node
+ *  @child_idx: the index of a child of @node with few keys
+ *  @work: a work area
+ *
+ *  Merges the child at @child_idx with one of its siblings if
+ *  their keys fit in a single node
+ */
+static void omap_merge(omap_t *map, omap_node_t *node, size_t child_idx, omap_work_t *work) {
+    if (node->h.count == 0) {
+        return;
+    }
+
+    // Separator between the left and the right child
+    const size_t sep_idx = child_idx < node->h.count ? child_idx : child_idx - 1;
+    omap_node_t *left = node->h.ptrs[sep_idx];
+    omap_node_t *right = node->h.ptrs[sep_idx + 1];
+    omap_work_t *parent = work;
+    omap_work_t *merged = work + 1;
+
+    const size_t parent_count = omap_load(node, parent, 0);
+    size_t count = omap_load(left, merged, 0);
+
+    if (!left->h.leaf) {
+        // The separator moves down, on the left of the first child of the right node
+        merged->entries[count] = parent->entries[sep_idx];
+        merged->entries[count].ptr = right->h.ptrs[0];
+        count++;
+    }
+    count += omap_load(right, merged, count);
+
+    if (!omap_fits(merged->entries, count)) {
+        return;
+    }
+
+    omap_store(left, merged->entries, count);
+    if (left->h.leaf) {
+        left->h.next = right->h.next;
+        free(parent->entries[sep_idx].long_key);
+    }
+
+    // The long keys of the right node now belong to the left one
+    free(right);
+    map->node_count--;
+
+    memmove(&parent->entries[sep_idx], &parent->entries[sep_idx + 1],
+            (parent_count - sep_idx - 1) * sizeof(omap_entry_t));
+    omap_store(node, parent->entries, parent_count - 1);
+}
+
+/**
+ * omap_delete
+ *  @map: a non-null ordered map
+ *  @node: the root of the subtree
+ *  @key: a sequence of bytes
+ *  @key_len: length of @key
+ *  @work: two work areas
+ *
+ *  Returns MAP_OK on success, MAP_ERR_NOT_FOUND if @key does not exist
+ */
+static map_status_t omap_delete(omap_t *map, omap_node_t *node, const uint8_t *key, size_t key_len, omap_work_t *work) {
+    if (node->h.leaf) {
+        bool exact;
+        const size_t pos = omap_node_search(node, key, key_len, &exact);
+
+        if (!exact) {
+            return MAP_ERR_NOT_FOUND;
+        }
+
+        const size_t count = omap_load(node, work, 0);
+        free(work->entries[pos].long_key);
+        memmove(&work->entries[pos], &work->entries[pos + 1], (count - pos - 1) * sizeof(omap_entry_t));
+        omap_store(node, work->entries, count - 1);
+
+        return MAP_OK;
+    }
+
+    const size_t child_idx = omap_child_index(node, key, key_len);
+    omap_node_t *child = node->h.ptrs[child_idx];
+    const map_status_t status = omap_delete(map, child, key, key_len, work);
+
+    if (status == MAP_OK && child->h.count <= OMAP_MERGE_THRESHOLD) {
+        omap_merge(map, node, child_idx, work);
+    }
+
+    return status;
+}
+
+/**
+ * omap_encode_int
+ *  @key: an integer key
+ *  @buffer: receives the big-endian representation of @key
+ *
+ *  Big-endian bytes sort in the same order as the integers
+ */
+static inline void omap_encode_int(uint64_t key, uint8_t buffer[8]) {
+    for (size_t idx = 0; idx < 8; idx++) {
+        buffer[idx] = (uint8_t)(key >> (56 - (8 * idx)));
+    }
+}
+
+/**
+ * omap_new
+ *
+ *  Returns an omap_result_t data type containing a new empty ordered map
+ */
+omap_result_t omap_new(void) {
+    omap_result_t result = {0};
+
+    omap_t *map = malloc(sizeof(omap_t));
+    if (map == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map");
+
+        return result;
+    }
+
+    map->size = 0;
+    map->height = 1;
+    map->node_count = 0;
+    map->spare = NULL;
+    map->spare_count = 0;
+    map->root = omap_alloc_node(map);
+
+    if (map->root == NULL) {
+        free(map);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map nodes");
+
+        return result;
+    }
+
+    map->root->h.leaf = true;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully created");
+    result.value.map = map;
+
+    return result;
+}
+
+/**
+ * omap_bulk_push
+ *  @map: a non-null ordered map being bulk loaded, with enough spare nodes
+ *  @path: the rightmost node of each level
+ *  @level: the level of the entry, 0 for leaves
+ *  @entry: an entry greater than every key of the map
+ *  @work: a work area
+ *
+ *  Appends @entry to the rightmost node of @level. When the node is full,
+ *  @entry opens a new node and a separator is pushed to the level above
+ *
+ *  Returns MAP_OK on success or MAP_ERR_ALLOCATE if nothing has been added
+ */
+static map_status_t omap_bulk_push(omap_t *map, omap_node_t **path, size_t level,
+                                   const omap_entry_t *entry, omap_work_t *work) {
+    omap_node_t *prev = path[level];
+
+    if (omap_append(prev, entry, work)) {
+        return MAP_OK;
+    }
+
+    // Above the leaves, the key moves up along with its ownership
+    omap_entry_t separator = *entry;
+
+    if (level == 0) {
+        // Shortest key that separates the new leaf from the previous one
+        const size_t prefix_len = prev->h.prefix_len;
+        size_t sep_len = omap_common_prefix(prev->data, prefix_len, entry->key, entry->len);
+
+        if (sep_len == prefix_len) {
+            size_t last_len;
+            const uint8_t *last = omap_suffix(prev, prev->h.count - 1, &last_len);
+            sep_len += omap_common_prefix(last, last_len, entry->key + prefix_len, entry->len - prefix_len);
+        }
+        sep_len++;
+
+        separator.len = sep_len;
+        separator.long_key = NULL;
+        if (sep_len > OMAP_INLINE_KEY_MAX) {
+            separator.long_key = omap_new_long_key(entry->key, sep_len);
+            if (separator.long_key == NULL) {
+                return MAP_ERR_ALLOCATE;
+            }
+            separator.key = (const uint8_t*)separator.long_key->bytes;
+        }
+    }
+
+    omap_node_t *node = omap_take_node(map, level == 0);
+    if (level == 0) {
+        omap_store(node, entry, 1);
+        prev->h.next = node;
+    } else {
+        node->h.ptrs[0] = entry->ptr;
+    }
+
+    path[level] = node;
+    separator.ptr = node;
+
+    if (level + 1 == map->height) {
+        omap_node_t *root = omap_take_node(map, false);
+        root->h.ptrs[0] = map->root;
+        map->root = root;
+        path[level + 1] = root;
+        map->height++;
+    }
+
+    return omap_bulk_push(map, path, level + 1, &separator, work);
+}
+
+/**
+ * omap_bulk_load
+ *  @map: a non-null empty ordered map
+ *  @keys: strictly increasing NUL-terminated keys
+ *  @values: the value of each key
+ *  @count: number of keys
+ *
+ *  Builds the tree bottom-up, filling each node before opening the next
+ *  one. Nodes are packed, so later insertions in the middle of the
+ *  keys will split them. On failure the map is left empty
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_bulk_load(omap_t *map, const char *const *keys, void *const *values, size_t count) {
+    omap_result_t result = {0};
+
+    if (map == NULL || (count > 0 && (keys == NULL || values == NULL))) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or keys");
+
+        return result;
+    }
+
+    if (map->size > 0) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Map is not empty");
+
+        return result;
+    }
+
+    for (size_t idx = 1; idx < count; idx++) {
+        if (keys[idx] == NULL || keys[idx - 1] == NULL ||
+            omap_compare((const uint8_t*)keys[idx - 1], strlen(keys[idx - 1]),
+                         (const uint8_t*)keys[idx], strlen(keys[idx])) >= 0) {
+            result.status = MAP_ERR_INVALID;
+            SET_MSG(result, "Keys are not sorted");
+
+            return result;
+        }
+    }
+
+    omap_work_t *work = malloc(sizeof(omap_work_t));
+    if (work == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map nodes");
+
+        return result;
+    }
+
+    // Removals may leave empty nodes behind, start from a single leaf
+    omap_clear(map);
+
+    omap_node_t *path[OMAP_MAX_HEIGHT];
+    path[0] = map->root;
+
+    map_status_t status = MAP_OK;
+    for (size_t idx = 0; idx < count && status == MAP_OK; idx++) {
+        if (map->height + 1 >= OMAP_MAX_HEIGHT) {
+            status = MAP_ERR_OVERFLOW;
+            break;
+        }
+
+        if (!omap_reserve(map)) {
+            status = MAP_ERR_ALLOCATE;
+            break;
+        }
+
+        omap_entry_t entry = { (const uint8_t*)keys[idx], strlen(keys[idx]), NULL, values[idx] };
+
+        if (entry.len > OMAP_INLINE_KEY_MAX) {
+            entry.long_key = omap_new_long_key(entry.key, entry.len);
+            if (entry.long_key == NULL) {
+                status = MAP_ERR_ALLOCATE;
+                break;
+            }
+            entry.key = (const uint8_t*)entry.long_key->bytes;
+        }
+
+        status = omap_bulk_push(map, path, 0, &entry, work);
+        if (status == MAP_OK) {
+            map->size++;
+        } else {
+            free(entry.long_key);
+        }
+    }
+
+    free(work);
+
+    if (status != MAP_OK) {
+        omap_clear(map);
+        result.status = status;
+        SET_MSG(result, "Failed to load the keys");
+
+        return result;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Keys successfully loaded");
+
+    return result;
+}
+
+/**
+ * omap_add_bytes
+ *  @map: a non-null ordered map
+ *  @key: a sequence of @key_len bytes
+ *  @key_len: length of @key
+ *  @value: a generic value to add to the map
+ *
+ *  Adds (@key, @value) to @map, replacing the value of an existing key.
+ *  Values are stored by reference
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_add_bytes(omap_t *map, const void *key, size_t key_len, void *value) {
+    omap_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    if (!omap_reserve(map)) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map nodes");
+
+        return result;
+    }
+
+    omap_entry_t entry = { key, key_len, NULL, value };
+    if (key_len > OMAP_INLINE_KEY_MAX) {
+        // Long keys are copied up front, so the tree is never modified halfway
+        entry.long_key = omap_new_long_key(key, key_len);
+        if (entry.long_key == NULL) {
+            result.status = MAP_ERR_ALLOCATE;
+            SET_MSG(result, "Failed to allocate memory for map key");
+
+            return result;
+        }
+        entry.key = (const uint8_t*)entry.long_key->bytes;
+    }
+
+    omap_work_t *work = malloc(sizeof(omap_work_t));
+    if (work == NULL) {
+        free(entry.long_key);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map nodes");
+
+        return result;
+    }
+
+    omap_split_t split;
+    bool replaced = false;
+    const map_status_t status = omap_insert(map, map->root, &entry, work, &split, &replaced);
+    free(work);
+
+    if (status != MAP_OK) {
+        free(entry.long_key);
+        result.status = status;
+        SET_MSG(result, "Failed to add the key");
+
+        return result;
+    }
+
+    if (replaced) {
+        free(entry.long_key);
+    } else {
+        map->size++;
+    }
+
+    if (split.happened) {
+        omap_node_t *root = omap_take_node(map, false);
+        root->h.ptrs[0] = map->root;
+        omap_store(root, &split.separator, 1);
+        map->root = root;
+        map->height++;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Key successfully added");
+
+    return result;
+}
+
+/**
+ * omap_add
+ *  @map: a non-null ordered map
+ *  @key: a string representing the index key
+ *  @value: a generic value to add to the map
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_add(omap_t *map, const char *key, void *value) {
+    if (key == NULL) {
+        return omap_add_bytes(map, NULL, 0, value);
+    }
+
+    return omap_add_bytes(map, key, strlen(key), value);
+}
+
+/**
+ * omap_add_int
+ *  @map: a non-null ordered map
+ *  @key: an integer key
+ *  @value: a generic value to add to the map
+ *
+ *  Integer keys are stored as 8 big-endian bytes and must not be
+ *  mixed with string keys in the same map
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_add_int(omap_t *map, uint64_t key, void *value) {
+    uint8_t buffer[8];
+    omap_encode_int(key, buffer);
+
+    return omap_add_bytes(map, buffer, sizeof(buffer), value);
+}
+
+/**
+ * omap_get_bytes
+ *  @map: a non-null ordered map
+ *  @key: a sequence of @key_len bytes
+ *  @key_len: length of @key
+ *
+ *  Returns an omap_result_t data type containing the element indexed by @key if available
+ */
+omap_result_t omap_get_bytes(const omap_t *map, const void *key, size_t key_len) {
+    omap_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    const omap_node_t *leaf = omap_find_leaf(map, key, key_len);
+    bool exact;
+    const size_t pos = omap_node_search(leaf, key, key_len, &exact);
+
+    if (!exact) {
+        result.status = MAP_ERR_NOT_FOUND;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Value successfully retrieved");
+    result.value.element = leaf->h.ptrs[pos];
+
+    return result;
+}
+
+/**
+ * omap_get
+ *  @map: a non-null ordered map
+ *  @key: a string representing the index key
+ *
+ *  Returns an omap_result_t data type containing the element indexed by @key if available
+ */
+omap_result_t omap_get(const omap_t *map, const char *key) {
+    if (key == NULL) {
+        return omap_get_bytes(map, NULL, 0);
+    }
+
+    return omap_get_bytes(map, key, strlen(key));
+}
+
+/**
+ * omap_get_int
+ *  @map: a non-null ordered map
+ *  @key: an integer key
+ *
+ *  Returns an omap_result_t data type containing the element indexed by @key if available
+ */
+omap_result_t omap_get_int(const omap_t *map, uint64_t key) {
+    uint8_t buffer[8];
+    omap_encode_int(key, buffer);
+
+    return omap_get_bytes(map, buffer, sizeof(buffer));
+}
+
+/**
+ * omap_remove_bytes
+ *  @map: a non-null ordered map
+ *  @key: a sequence of @key_len bytes
+ *  @key_len: length of @key
+ *
+ *  Removes @key from @map. Nodes left with few keys are merged with
+ *  a sibling when both fit in a single node
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_remove_bytes(omap_t *map, const void *key, size_t key_len) {
+    omap_result_t result = {0};
+
+    if (map == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or key");
+
+        return result;
+    }
+
+    omap_work_t *work = malloc(2 * sizeof(omap_work_t));
+    if (work == NULL) {
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for map nodes");
+
+        return result;
+    }
+
+    const map_status_t status = omap_delete(map, map->root, key, key_len, work);
+    free(work);
+
+    if (status != MAP_OK) {
+        result.status = status;
+        SET_MSG(result, "Element not found");
+
+        return result;
+    }
+
+    map->size--;
+
+    // Shrink the tree when the root is left with a single child
+    while (!map->root->h.leaf && map->root->h.count == 0) {
+        omap_node_t *root = map->root;
+        map->root = root->h.ptrs[0];
+        map->height--;
+        free(root);
+        map->node_count--;
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Key successfully removed");
+
+    return result;
+}
+
+/**
+ * omap_remove
+ *  @map: a non-null ordered map
+ *  @key: a string representing the index key
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_remove(omap_t *map, const char *key) {
+    if (key == NULL) {
+        return omap_remove_bytes(map, NULL, 0);
+    }
+
+    return omap_remove_bytes(map, key, strlen(key));
+}
+
+/**
+ * omap_remove_int
+ *  @map: a non-null ordered map
+ *  @key: an integer key
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_remove_int(omap_t *map, uint64_t key) {
+    uint8_t buffer[8];
+    omap_encode_int(key, buffer);
+
+    return omap_remove_bytes(map, buffer, sizeof(buffer));
+}
+
+/**
+ * omap_iter_begin
+ *  @map: an ordered map
+ *
+ *  Creates a cursor over the elements of @map in increasing key order.
+ *  The cursor is invalidated by any insertion, removal or clear
+ *
+ *  Returns an omap_iter_t data type positioned before the smallest key
+ */
+omap_iter_t omap_iter_begin(const omap_t *map) {
+    omap_iter_t iter = {0};
+
+    if (map == NULL) {
+        return iter;
+    }
+
+    const omap_node_t *node = map->root;
+    while (!node->h.leaf) {
+        node = node->h.ptrs[0];
+    }
+
+    iter.node = node;
+    iter.index = 0;
+
+    return iter;
+}
+
+/**
+ * omap_iter_seek
+ *  @map: an ordered map
+ *  @key: a sequence of @key_len bytes
+ *  @key_len: length of @key
+ *
+ *  Returns an omap_iter_t data type positioned before the smallest key not lower than @key
+ */
+omap_iter_t omap_iter_seek(const omap_t *map, const void *key, size_t key_len) {
+    omap_iter_t iter = {0};
+
+    if (map == NULL || key == NULL) {
+        return iter;
+    }
+
+    bool exact;
+    iter.node = omap_find_leaf(map, key, key_len);
+    iter.index = omap_node_search(iter.node, key, key_len, &exact);
+
+    return iter;
+}
+
+/**
+ * omap_iter_next
+ *  @iter: a cursor created by omap_iter_begin or omap_iter_seek
+ *
+ *  Advances @iter to the next key in increasing order and exposes the key,
+ *  NUL-terminated, its length and its value. Short keys are rebuilt in the
+ *  cursor, so the key pointer is only valid until the next call
+ *
+ *  Returns true if an element is available, false at the end of the map
+ */
+bool omap_iter_next(omap_iter_t *iter) {
+    if (iter == NULL) {
+        return false;
+    }
+
+    while (iter->node != NULL && iter->index >= iter->node->h.count) {
+        iter->node = iter->node->h.next;
+        iter->index = 0;
+    }
+
+    if (iter->node == NULL) {
+        iter->key = NULL;
+        iter->key_len = 0;
+        iter->value = NULL;
+
+        return false;
+    }
+
+    const omap_node_t *node = iter->node;
+    const size_t idx = iter->index++;
+    const omap_long_key_t *long_key = omap_long_key_at(node, idx);
+
+    if (long_key != NULL) {
+        iter->key = long_key->bytes;
+        iter->key_len = long_key->len;
+    } else {
+        memcpy(iter->buffer, node->data, node->h.prefix_len);
+        memcpy(iter->buffer + node->h.prefix_len, node->data + node->h.offsets[idx], node->h.lengths[idx]);
+        iter->key_len = node->h.prefix_len + node->h.lengths[idx];
+        iter->buffer[iter->key_len] = '\0';
+        iter->key = iter->buffer;
+    }
+
+    iter->value = node->h.ptrs[idx];
+
+    return true;
+}
+
+/**
+ * omap_key_int
+ *  @key: a key of an integer map, as exposed by the iterators and callbacks
+ *
+ *  Returns the integer encoded by @key
+ */
+uint64_t omap_key_int(const char *key) {
+    uint64_t value = 0;
+
+    for (size_t idx = 0; idx < 8; idx++) {
+        value = (value << 8) | (uint8_t)key[idx];
+    }
+
+    return value;
+}
+
+/**
+ * omap_visit_range
+ *  @map: a non-null ordered map
+ *  @lo: the lower bound or NULL
+ *  @lo_len: length of @lo
+ *  @hi: the upper bound or NULL
+ *  @hi_len: length of @hi
+ *  @callback: the function called on each key
+ *  @env: an optional environment passed to @callback
+ */
+static void omap_visit_range(const omap_t *map, const uint8_t *lo, size_t lo_len,
+                             const uint8_t *hi, size_t hi_len, omap_visit_fn callback, void *env) {
+    omap_iter_t iter = lo != NULL ? omap_iter_seek(map, lo, lo_len) : omap_iter_begin(map);
+
+    while (omap_iter_next(&iter)) {
+        if (hi != NULL && omap_compare((const uint8_t*)iter.key, iter.key_len, hi, hi_len) > 0) {
+            break;
+        }
+
+        callback(iter.key, iter.key_len, iter.value, env);
+    }
+}
+
+/**
+ * omap_range
+ *  @map: a non-null ordered map
+ *  @lo: the smallest key to visit or NULL to start from the first key
+ *  @hi: the largest key to visit or NULL to stop at the last key
+ *  @callback: the function called on each key, in increasing order
+ *  @env: an optional environment passed to @callback
+ *
+ *  Calls @callback on every key between @lo and @hi (both included)
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_range(const omap_t *map, const char *lo, const char *hi, omap_visit_fn callback, void *env) {
+    omap_result_t result = {0};
+
+    if (map == NULL || callback == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or callback");
+
+        return result;
+    }
+
+    omap_visit_range(map, (const uint8_t*)lo, lo ? strlen(lo) : 0,
+                     (const uint8_t*)hi, hi ? strlen(hi) : 0, callback, env);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Range successfully visited");
+
+    return result;
+}
+
+/**
+ * omap_range_int
+ *  @map: a non-null ordered map with integer keys
+ *  @lo: the smallest key to visit
+ *  @hi: the largest key to visit
+ *  @callback: the function called on each key, in increasing order
+ *  @env: an optional environment passed to @callback
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_range_int(const omap_t *map, uint64_t lo, uint64_t hi, omap_visit_fn callback, void *env) {
+    omap_result_t result = {0};
+
+    if (map == NULL || callback == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map or callback");
+
+        return result;
+    }
+
+    uint8_t lo_key[8], hi_key[8];
+    omap_encode_int(lo, lo_key);
+    omap_encode_int(hi, hi_key);
+    omap_visit_range(map, lo_key, sizeof(lo_key), hi_key, sizeof(hi_key), callback, env);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Range successfully visited");
+
+    return result;
+}
+
+/**
+ * omap_prefix
+ *  @map: a non-null ordered map
+ *  @prefix: a string
+ *  @callback: the function called on each key, in increasing order
+ *  @env: an optional environment passed to @callback
+ *
+ *  Calls @callback on every key starting with @prefix
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_prefix(const omap_t *map, const char *prefix, omap_visit_fn callback, void *env) {
+    omap_result_t result = {0};
+
+    if (map == NULL || prefix == NULL || callback == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map, prefix or callback");
+
+        return result;
+    }
+
+    const size_t prefix_len = strlen(prefix);
+    omap_iter_t iter = omap_iter_seek(map, prefix, prefix_len);
+
+    while (omap_iter_next(&iter)) {
+        if (iter.key_len < prefix_len || memcmp(iter.key, prefix, prefix_len)) {
+            break;
+        }
+
+        callback(iter.key, iter.key_len, iter.value, env);
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Prefix successfully visited");
+
+    return result;
+}
+
+/**
+ * omap_clear
+ *  @map: a non-null ordered map
+ *
+ *  Removes every key, leaving an empty root
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_clear(omap_t *map) {
+    omap_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    if (map->root->h.leaf) {
+        for (size_t idx = 0; idx < map->root->h.count; idx++) {
+            free(omap_long_key_at(map->root, idx));
+        }
+    } else {
+        omap_node_t *root = map->root;
+        for (size_t idx = 0; idx <= root->h.count; idx++) {
+            omap_free_node(map, root->h.ptrs[idx]);
+        }
+        for (size_t idx = 0; idx < root->h.count; idx++) {
+            free(omap_long_key_at(root, idx));
+        }
+    }
+
+    memset(&map->root->h, 0, sizeof(map->root->h));
+    map->root->h.leaf = true;
+    map->size = 0;
+    map->height = 1;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully cleared");
+
+    return result;
+}
+
+/**
+ * omap_destroy
+ *  @map: an ordered map
+ *
+ *  Returns an omap_result_t data type containing the status
+ */
+omap_result_t omap_destroy(omap_t *map) {
+    omap_result_t result = {0};
+
+    if (map == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid map");
+
+        return result;
+    }
+
+    omap_free_node(map, map->root);
+
+    while (map->spare != NULL) {
+        omap_node_t *next = map->spare->h.next;
+        free(map->spare);
+        map->spare = next;
+    }
+
+    free(map);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Map successfully deleted");
+
+    return result;
+}
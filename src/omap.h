@@ -0,0 +1,97 @@
+#ifndef OMAP_H
+#define OMAP_H
+
+#define RESULT_MSG_SIZE 64
+
+// Every node takes OMAP_NODE_SIZE bytes (a multiple of the cache line size)
+// and holds at most OMAP_FANOUT keys
+#define OMAP_NODE_SIZE 1024
+#define OMAP_FANOUT 32
+// Keys up to OMAP_INLINE_KEY_MAX bytes are stored inside the nodes,
+// longer keys are allocated separately
+#define OMAP_INLINE_KEY_MAX 64
+// Maximum length of the prefix shared by the keys of a node
+#define OMAP_PREFIX_MAX 64
+// Nodes with at most OMAP_MERGE_THRESHOLD keys are merged with a sibling when possible
+#define OMAP_MERGE_THRESHOLD (OMAP_FANOUT / 4)
+// Maximum number of levels built by omap_bulk_load
+#define OMAP_MAX_HEIGHT 64
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "map.h"
+
+// Nodes pack keys into a byte area, their layout is private to omap.c
+typedef struct omap_node omap_node_t;
+
+typedef struct {
+    omap_node_t *root;
+    size_t size;
+    size_t height; // Number of levels, leaves included
+    size_t node_count;
+    omap_node_t *spare; // Nodes reserved for the splits of the next insertion
+    size_t spare_count;
+} omap_t;
+
+typedef struct {
+    map_status_t status;
+    uint8_t message[RESULT_MSG_SIZE];
+    union {
+        omap_t *map;
+        void *element;
+    } value;
+} omap_result_t;
+
+typedef struct {
+    const omap_node_t *node; // Current leaf
+    size_t index; // Next key of the leaf
+    const char *key;
+    size_t key_len;
+    void *value;
+    char buffer[OMAP_INLINE_KEY_MAX + 1]; // Inline keys are rebuilt here
+} omap_iter_t;
+
+// Callback functions
+typedef void (*omap_visit_fn)(const char *key, size_t key_len, void *value, void *env);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+omap_result_t omap_new(void);
+omap_result_t omap_bulk_load(omap_t *map, const char *const *keys, void *const *values, size_t count);
+omap_result_t omap_add(omap_t *map, const char *key, void *value);
+omap_result_t omap_add_bytes(omap_t *map, const void *key, size_t key_len, void *value);
+omap_result_t omap_add_int(omap_t *map, uint64_t key, void *value);
+omap_result_t omap_get(const omap_t *map, const char *key);
+omap_result_t omap_get_bytes(const omap_t *map, const void *key, size_t key_len);
+omap_result_t omap_get_int(const omap_t *map, uint64_t key);
+omap_result_t omap_remove(omap_t *map, const char *key);
+omap_result_t omap_remove_bytes(omap_t *map, const void *key, size_t key_len);
+omap_result_t omap_remove_int(omap_t *map, uint64_t key);
+omap_result_t omap_range(const omap_t *map, const char *lo, const char *hi, omap_visit_fn callback, void *env);
+omap_result_t omap_range_int(const omap_t *map, uint64_t lo, uint64_t hi, omap_visit_fn callback, void *env);
+omap_result_t omap_prefix(const omap_t *map, const char *prefix, omap_visit_fn callback, void *env);
+omap_result_t omap_clear(omap_t *map);
+omap_result_t omap_destroy(omap_t *map);
+
+omap_iter_t omap_iter_begin(const omap_t *map);
+omap_iter_t omap_iter_seek(const omap_t *map, const void *key, size_t key_len);
+bool omap_iter_next(omap_iter_t *iter);
+uint64_t omap_key_int(const char *key);
+
+// Inline methods
+static inline size_t omap_size(const omap_t *map) {
+    return map ? map->size : 0;
+}
+
+static inline size_t omap_height(const omap_t *map) {
+    return map ? map->height : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,425 @@
+#define SET_MSG(result, msg) \
+    do { \
+        snprintf((char *)(result).message, RESULT_MSG_SIZE, "%s", (const char *)msg); \
+    } while (0)
+
+// Map results and set results have messages of the same size
+#define COPY_MSG(result, msg) \
+    do { \
+        memcpy((result).message, (msg), RESULT_MSG_SIZE); \
+    } while (0)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "set.h"
+
+/**
+ * set_wrap
+ *  @map_res: the result of the creation of a keys only map
+ *
+ *  Returns a set_result_t data type containing a new set backed by the map of @map_res
+ */
+static set_result_t set_wrap(map_result_t map_res) {
+    set_result_t result = {0};
+
+    if (map_res.status != MAP_OK) {
+        result.status = map_res.status;
+        COPY_MSG(result, map_res.message);
+
+        return result;
+    }
+
+    set_t *set = malloc(sizeof(set_t));
+    if (set == NULL) {
+        map_destroy(map_res.value.map);
+        result.status = MAP_ERR_ALLOCATE;
+        SET_MSG(result, "Failed to allocate memory for set");
+
+        return result;
+    }
+
+    set->map = map_res.value.map;
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Set successfully created");
+    result.value.set = set;
+
+    return result;
+}
+
+/**
+ * set_from_map
+ *  @map_res: the result of a map operation
+ *
+ *  Returns a set_result_t data type with the status and the message of @map_res
+ */
+static set_result_t set_from_map(map_result_t map_res) {
+    set_result_t result = {0};
+
+    result.status = map_res.status;
+    COPY_MSG(result, map_res.message);
+
+    return result;
+}
+
+/**
+ * set_new
+ *
+ *  Returns a set_result_t data type containing a new empty set
+ */
+set_result_t set_new(void) {
+    return set_wrap(map_new_keys());
+}
+
+/**
+ * set_from_vector
+ *  @vector: a non-null vector
+ *
+ *  Creates a set with the distinct elements of @vector. Elements are
+ *  compared by their raw bytes, each of them becomes a key of
+ *  data_size bytes
+ *
+ *  Returns a set_result_t data type containing the new set
+ */
+set_result_t set_from_vector(const vector_t *vector) {
+    set_result_t result = {0};
+
+    if (vector == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid vector");
+
+        return result;
+    }
+
+    result = set_new();
+    if (result.status != MAP_OK) {
+        return result;
+    }
+
+    set_t *set = result.value.set;
+    const uint8_t *elements = vector->elements;
+    for (size_t idx = 0; idx < vector->size; idx++) {
+        set_result_t add_res = set_add_bytes(set, elements + (idx * vector->data_size), vector->data_size);
+        if (add_res.status != MAP_OK) {
+            set_destroy(set);
+
+            return add_res;
+        }
+    }
+
+    SET_MSG(result, "Set successfully created");
+
+    return result;
+}
+
+/**
+ * set_add_bytes
+ *  @set: a non-null set
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  Adds @key to @set, if it is not already there
+ *
+ *  Returns a set_result_t data type containing the status
+ */
+set_result_t set_add_bytes(set_t *set, const void *key, size_t key_len) {
+    set_result_t result = {0};
+
+    if (set == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid set or key");
+
+        return result;
+    }
+
+    return set_from_map(map_add_bytes(set->map, key, key_len, NULL));
+}
+
+/**
+ * set_add
+ *  @set: a non-null set
+ *  @key: a string
+ *
+ *  Returns a set_result_t data type containing the status
+ */
+set_result_t set_add(set_t *set, const char *key) {
+    if (key == NULL) {
+        return set_add_bytes(set, NULL, 0);
+    }
+
+    return set_add_bytes(set, key, strlen(key));
+}
+
+/**
+ * set_contains_bytes
+ *  @set: a set
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  Returns true if @key belongs to @set, false otherwise
+ */
+bool set_contains_bytes(const set_t *set, const void *key, size_t key_len) {
+    if (set == NULL || key == NULL) {
+        return false;
+    }
+
+    return map_get_bytes(set->map, key, key_len).status == MAP_OK;
+}
+
+/**
+ * set_contains
+ *  @set: a set
+ *  @key: a string
+ *
+ *  Returns true if @key belongs to @set, false otherwise
+ */
+bool set_contains(const set_t *set, const char *key) {
+    if (key == NULL) {
+        return false;
+    }
+
+    return set_contains_bytes(set, key, strlen(key));
+}
+
+/**
+ * set_remove_bytes
+ *  @set: a non-null set
+ *  @key: an arbitrary sequence of bytes
+ *  @key_len: length of @key in bytes
+ *
+ *  Returns a set_result_t data type containing the status
+ */
+set_result_t set_remove_bytes(set_t *set, const void *key, size_t key_len) {
+    set_result_t result = {0};
+
+    if (set == NULL || key == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid set or key");
+
+        return result;
+    }
+
+    return set_from_map(map_remove_bytes(set->map, key, key_len));
+}
+
+/**
+ * set_remove
+ *  @set: a non-null set
+ *  @key: a string
+ *
+ *  Returns a set_result_t data type containing the status
+ */
+set_result_t set_remove(set_t *set, const char *key) {
+    if (key == NULL) {
+        return set_remove_bytes(set, NULL, 0);
+    }
+
+    return set_remove_bytes(set, key, strlen(key));
+}
+
+/**
+ * set_select
+ *  @source: a non-null set whose keys are scanned
+ *  @other: a non-null set
+ *  @keep: whether the keys of @source found in @other are kept (or discarded)
+ *
+ *  Returns a set_result_t data type containing a new set with the keys of
+ *  @source that do (or do not) belong to @other
+ */
+static set_result_t set_select(const set_t *source, const set_t *other, bool keep) {
+    set_result_t result = set_new();
+    if (result.status != MAP_OK) {
+        return result;
+    }
+
+    set_t *set = result.value.set;
+    map_iter_t iter = map_iter_begin(source->map);
+    while (map_iter_next(&iter)) {
+        if (set_contains_bytes(other, iter.key, iter.key_len) != keep) {
+            continue;
+        }
+
+        set_result_t add_res = set_add_bytes(set, iter.key, iter.key_len);
+        if (add_res.status != MAP_OK) {
+            set_destroy(set);
+
+            return add_res;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * set_union
+ *  @x: a non-null set
+ *  @y: a non-null set
+ *
+ *  The larger set is cloned as it is, then the keys of the other one are added
+ *
+ *  Returns a set_result_t data type containing a new set with the keys of @x and @y
+ */
+set_result_t set_union(const set_t *x, const set_t *y) {
+    set_result_t result = {0};
+
+    if (x == NULL || y == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid sets");
+
+        return result;
+    }
+
+    const set_t *large = set_size(x) >= set_size(y) ? x : y;
+    const set_t *small = large == x ? y : x;
+
+    result = set_wrap(map_clone(large->map));
+    if (result.status != MAP_OK) {
+        return result;
+    }
+
+    map_iter_t iter = map_iter_begin(small->map);
+    while (map_iter_next(&iter)) {
+        set_result_t add_res = set_add_bytes(result.value.set, iter.key, iter.key_len);
+        if (add_res.status != MAP_OK) {
+            set_destroy(result.value.set);
+
+            return add_res;
+        }
+    }
+
+    SET_MSG(result, "Union successfully computed");
+
+    return result;
+}
+
+/**
+ * set_intersection
+ *  @x: a non-null set
+ *  @y: a non-null set
+ *
+ *  Only the smaller set is scanned
+ *
+ *  Returns a set_result_t data type containing a new set with the keys in both @x and @y
+ */
+set_result_t set_intersection(const set_t *x, const set_t *y) {
+    set_result_t result = {0};
+
+    if (x == NULL || y == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid sets");
+
+        return result;
+    }
+
+    if (set_size(x) <= set_size(y)) {
+        result = set_select(x, y, true);
+    } else {
+        result = set_select(y, x, true);
+    }
+
+    if (result.status == MAP_OK) {
+        SET_MSG(result, "Intersection successfully computed");
+    }
+
+    return result;
+}
+
+/**
+ * set_difference
+ *  @x: a non-null set
+ *  @y: a non-null set
+ *
+ *  Returns a set_result_t data type containing a new set with the keys of @x not in @y
+ */
+set_result_t set_difference(const set_t *x, const set_t *y) {
+    set_result_t result = {0};
+
+    if (x == NULL || y == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid sets");
+
+        return result;
+    }
+
+    result = set_select(x, y, false);
+    if (result.status == MAP_OK) {
+        SET_MSG(result, "Difference successfully computed");
+    }
+
+    return result;
+}
+
+/**
+ * set_foreach
+ *  @set: a non-null set
+ *  @callback: the function called on each key, in no particular order
+ *  @env: an optional environment passed to @callback
+ *
+ *  Returns a set_result_t data type containing the status
+ */
+set_result_t set_foreach(const set_t *set, set_foreach_fn callback, void *env) {
+    set_result_t result = {0};
+
+    if (set == NULL || callback == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid set or callback");
+
+        return result;
+    }
+
+    map_iter_t iter = map_iter_begin(set->map);
+    while (map_iter_next(&iter)) {
+        callback(iter.key, iter.key_len, env);
+    }
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Set successfully visited");
+
+    return result;
+}
+
+/**
+ * set_clear
+ *  @set: a non-null set
+ *
+ *  Returns a set_result_t data type containing the status
+ */
+set_result_t set_clear(set_t *set) {
+    set_result_t result = {0};
+
+    if (set == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid set");
+
+        return result;
+    }
+
+    return set_from_map(map_clear(set->map));
+}
+
+/**
+ * set_destroy
+ *  @set: a set
+ *
+ *  Returns a set_result_t data type containing the status
+ */
+set_result_t set_destroy(set_t *set) {
+    set_result_t result = {0};
+
+    if (set == NULL) {
+        result.status = MAP_ERR_INVALID;
+        SET_MSG(result, "Invalid set");
+
+        return result;
+    }
+
+    map_destroy(set->map);
+    free(set);
+
+    result.status = MAP_OK;
+    SET_MSG(result, "Set successfully deleted");
+
+    return result;
+}
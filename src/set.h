@@ -0,0 +1,55 @@
+#ifndef SET_H
+#define SET_H
+
+#define RESULT_MSG_SIZE 64
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "map.h"
+#include "vector.h"
+
+typedef struct {
+    map_t *map; // Keys only map, no value is stored
+} set_t;
+
+typedef struct {
+    map_status_t status;
+    uint8_t message[RESULT_MSG_SIZE];
+    union {
+        set_t *set;
+    } value;
+} set_result_t;
+
+// Callback functions
+typedef void (*set_foreach_fn)(const char *key, size_t key_len, void *env);
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+set_result_t set_new(void);
+set_result_t set_from_vector(const vector_t *vector);
+set_result_t set_add(set_t *set, const char *key);
+set_result_t set_add_bytes(set_t *set, const void *key, size_t key_len);
+bool set_contains(const set_t *set, const char *key);
+bool set_contains_bytes(const set_t *set, const void *key, size_t key_len);
+set_result_t set_remove(set_t *set, const char *key);
+set_result_t set_remove_bytes(set_t *set, const void *key, size_t key_len);
+set_result_t set_union(const set_t *x, const set_t *y);
+set_result_t set_intersection(const set_t *x, const set_t *y);
+set_result_t set_difference(const set_t *x, const set_t *y);
+set_result_t set_foreach(const set_t *set, set_foreach_fn callback, void *env);
+set_result_t set_clear(set_t *set);
+set_result_t set_destroy(set_t *set);
+
+// Inline methods
+static inline size_t set_size(const set_t *set) {
+    return set ? map_size(set->map) : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,328 @@
+/*
+ * Unit tests for Adaptive Radix Tree data type
+ */
+
+#define TEST(NAME) do { \
+    printf("Running test_%s...", #NAME); \
+    test_##NAME(); \
+    printf(" PASSED\n"); \
+} while(0)
+
+#define KEYS 20000
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "../src/art.h"
+
+static int values[KEYS];
+
+// Hierarchical keys, some of them prefixes of others
+static void make_key(char *buffer, size_t size, int idx) {
+    const int server = (idx / 3) % 300;
+
+    switch (idx % 3) {
+        case 0: snprintf(buffer, size, "/srv/%03d/data/%d", server, idx); break;
+        case 1: snprintf(buffer, size, "/srv/%03d/data/%d/meta", server, idx - 1); break;
+        default: snprintf(buffer, size, "/srv/%03d/logs/%c%d", server, 'a' + idx % 26, idx); break;
+    }
+}
+
+typedef struct {
+    size_t count;
+    char last[128];
+    bool sorted;
+} visit_t;
+
+static void visit(const char *key, size_t key_len, void *value, void *env) {
+    visit_t *state = env;
+    (void)value;
+
+    assert(strlen(key) == key_len);
+    if (state->count > 0 && strcmp(state->last, key) >= 0) {
+        state->sorted = false;
+    }
+
+    snprintf(state->last, sizeof(state->last), "%s", key);
+    state->count++;
+}
+
+// Create a new tree
+void test_art_new(void) {
+    art_result_t res = art_new();
+
+    assert(res.status == MAP_OK);
+    assert(res.value.tree != NULL);
+    assert(art_size(res.value.tree) == 0);
+    assert(art_memory(res.value.tree) == 0);
+
+    art_destroy(res.value.tree);
+}
+
+// Add, get, update and remove a few keys
+void test_art_basic(void) {
+    art_t *tree = art_new().value.tree;
+    int x = 42, y = 84;
+
+    assert(art_add(tree, "romane", &x).status == MAP_OK);
+    assert(art_add(tree, "romanus", &y).status == MAP_OK);
+    assert(art_add(tree, "roman", &y).status == MAP_OK);
+    assert(art_add(tree, "", &x).status == MAP_OK);
+    assert(art_size(tree) == 4);
+
+    assert(*(int *)art_get(tree, "romane").value.element == 42);
+    assert(*(int *)art_get(tree, "roman").value.element == 84);
+    assert(*(int *)art_get(tree, "").value.element == 42);
+    assert(art_get(tree, "rom").status == MAP_ERR_NOT_FOUND);
+    assert(art_get(tree, "romanes").status == MAP_ERR_NOT_FOUND);
+
+    // Update an existing key
+    assert(art_add(tree, "romane", &y).status == MAP_OK);
+    assert(art_size(tree) == 4);
+    assert(*(int *)art_get(tree, "romane").value.element == 84);
+
+    assert(art_remove(tree, "roman").status == MAP_OK);
+    assert(art_remove(tree, "roman").status == MAP_ERR_NOT_FOUND);
+    assert(art_get(tree, "roman").status == MAP_ERR_NOT_FOUND);
+    assert(art_get(tree, "romanus").status == MAP_OK);
+    assert(art_size(tree) == 3);
+
+    // Binary keys may contain zeros
+    assert(art_add_bytes(tree, "a\0b", 3, &x).status == MAP_OK);
+    assert(art_add_bytes(tree, "a\0c", 3, &y).status == MAP_OK);
+    assert(*(int *)art_get_bytes(tree, "a\0b", 3).value.element == 42);
+    assert(art_get(tree, "a").status == MAP_ERR_NOT_FOUND);
+    assert(art_remove_bytes(tree, "a\0c", 3).status == MAP_OK);
+
+    assert(art_add(NULL, "x", &x).status == MAP_ERR_INVALID);
+    assert(art_get(tree, NULL).status == MAP_ERR_INVALID);
+    assert(art_remove(tree, NULL).status == MAP_ERR_INVALID);
+
+    art_destroy(tree);
+}
+
+// Insert and remove many keys in random order
+void test_art_many(void) {
+    art_t *tree = art_new().value.tree;
+    char key[128];
+    int order[KEYS];
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        values[idx] = idx;
+        order[idx] = idx;
+    }
+
+    srand(42);
+    for (int idx = KEYS - 1; idx > 0; idx--) {
+        const int other = rand() % (idx + 1);
+        const int tmp = order[idx];
+        order[idx] = order[other];
+        order[other] = tmp;
+    }
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        make_key(key, sizeof(key), order[idx]);
+        assert(art_add(tree, key, &values[order[idx]]).status == MAP_OK);
+    }
+    assert(art_size(tree) == KEYS);
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        make_key(key, sizeof(key), idx);
+        art_result_t res = art_get(tree, key);
+        assert(res.status == MAP_OK);
+        assert(*(int *)res.value.element == idx);
+    }
+
+    // Iteration visits every key in increasing order
+    visit_t state = { 0, "", true };
+    assert(art_foreach(tree, visit, &state).status == MAP_OK);
+    assert(state.count == KEYS);
+    assert(state.sorted);
+
+    // Remove all the keys but one out of ten
+    const size_t full = art_memory(tree);
+    for (int idx = 0; idx < KEYS; idx++) {
+        if (order[idx] % 10 != 0) {
+            make_key(key, sizeof(key), order[idx]);
+            assert(art_remove(tree, key).status == MAP_OK);
+        }
+    }
+    assert(art_size(tree) == KEYS / 10);
+    assert(art_memory(tree) < full / 5);
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        make_key(key, sizeof(key), idx);
+        assert(art_get(tree, key).status == (idx % 10 == 0 ? MAP_OK : MAP_ERR_NOT_FOUND));
+    }
+
+    state = (visit_t){ 0, "", true };
+    art_foreach(tree, visit, &state);
+    assert(state.count == KEYS / 10);
+    assert(state.sorted);
+
+    // Empty the tree, then reuse it
+    for (int idx = 0; idx < KEYS; idx += 10) {
+        make_key(key, sizeof(key), idx);
+        assert(art_remove(tree, key).status == MAP_OK);
+    }
+    assert(art_size(tree) == 0);
+    assert(art_memory(tree) == 0);
+
+    assert(art_add(tree, "x", &values[0]).status == MAP_OK);
+    assert(art_clear(tree).status == MAP_OK);
+    assert(art_size(tree) == 0);
+    assert(art_memory(tree) == 0);
+    assert(art_get(tree, "x").status == MAP_ERR_NOT_FOUND);
+
+    art_destroy(tree);
+}
+
+// Nodes grow and shrink through every type
+void test_art_fanout(void) {
+    art_t *tree = art_new().value.tree;
+    unsigned char key[2] = { 'k', 0 };
+
+    for (int byte = 255; byte >= 0; byte--) {
+        key[1] = (unsigned char)byte;
+        assert(art_add_bytes(tree, key, 2, &values[byte]).status == MAP_OK);
+    }
+    assert(art_size(tree) == 256);
+
+    for (int byte = 0; byte < 256; byte++) {
+        key[1] = (unsigned char)byte;
+        assert(art_get_bytes(tree, key, 2).value.element == &values[byte]);
+    }
+
+    for (int byte = 0; byte < 256; byte++) {
+        key[1] = (unsigned char)byte;
+        assert(art_remove_bytes(tree, key, 2).status == MAP_OK);
+        if (byte < 255) {
+            key[1] = 255;
+            assert(art_get_bytes(tree, key, 2).value.element == &values[255]);
+        }
+    }
+    assert(art_memory(tree) == 0);
+
+    art_destroy(tree);
+}
+
+// Leaves are stored in their parent and moved back up by removals
+void test_art_leaves(void) {
+    art_t *tree = art_new().value.tree;
+    int x = 1, y = 2;
+
+    assert(art_add(tree, "/srv/a", &x).status == MAP_OK);
+    const size_t single = art_memory(tree);
+
+    // The only key is split from the root and becomes a leaf
+    assert(art_add(tree, "/srv/b", &y).status == MAP_OK);
+    assert(*(int *)art_get(tree, "/srv/a").value.element == 1);
+    assert(*(int *)art_get(tree, "/srv/b").value.element == 2);
+
+    // Replacing leaves leaves garbage behind, which is reclaimed
+    for (int round = 0; round < 100; round++) {
+        assert(art_add(tree, "/srv/ab", &x).status == MAP_OK);
+        assert(art_remove(tree, "/srv/ab").status == MAP_OK);
+    }
+    assert(art_size(tree) == 2);
+    assert(art_memory(tree) < 4 * single);
+    assert(*(int *)art_get(tree, "/srv/a").value.element == 1);
+
+    assert(art_remove(tree, "/srv/b").status == MAP_OK);
+    assert(*(int *)art_get(tree, "/srv/a").value.element == 1);
+    assert(art_get(tree, "/srv/").status == MAP_ERR_NOT_FOUND);
+    assert(art_remove(tree, "/srv/a").status == MAP_OK);
+    assert(art_memory(tree) == 0);
+
+    art_destroy(tree);
+}
+
+// Longest prefix match
+void test_art_longest_prefix(void) {
+    art_t *tree = art_new().value.tree;
+    int routes[4] = { 0, 1, 2, 3 };
+    size_t len = 0;
+
+    art_add(tree, "10.", &routes[0]);
+    art_add(tree, "10.1.", &routes[1]);
+    art_add(tree, "10.1.2.", &routes[2]);
+    art_add(tree, "10.1.2.30", &routes[3]);
+
+    assert(*(int *)art_longest_prefix(tree, "10.1.2.3", &len).value.element == 2);
+    assert(len == 7);
+    assert(*(int *)art_longest_prefix(tree, "10.1.2.30", &len).value.element == 3);
+    assert(len == 9);
+    assert(*(int *)art_longest_prefix(tree, "10.1.3.4", &len).value.element == 1);
+    assert(*(int *)art_longest_prefix(tree, "10.2", NULL).value.element == 0);
+    assert(art_longest_prefix(tree, "11.1", &len).status == MAP_ERR_NOT_FOUND);
+    assert(art_longest_prefix(tree, "10", &len).status == MAP_ERR_NOT_FOUND);
+
+    art_add(tree, "", &routes[0]);
+    assert(art_longest_prefix(tree, "11.1", &len).status == MAP_OK);
+    assert(len == 0);
+
+    art_destroy(tree);
+}
+
+// Prefix iteration
+void test_art_prefix(void) {
+    art_t *tree = art_new().value.tree;
+    char key[128];
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        values[idx] = idx;
+        make_key(key, sizeof(key), idx);
+        assert(art_add(tree, key, &values[idx]).status == MAP_OK);
+    }
+
+    // Every key of server 005 is visited in order
+    size_t expected = 0;
+    for (int idx = 0; idx < KEYS; idx++) { expected += ((idx / 3) % 300 == 5); }
+
+    visit_t state = { 0, "", true };
+    assert(art_prefix(tree, "/srv/005/", visit, &state).status == MAP_OK);
+    assert(state.count == expected);
+    assert(state.sorted);
+
+    // A prefix ending within a compressed path
+    state = (visit_t){ 0, "", true };
+    art_prefix(tree, "/srv/005/da", visit, &state);
+    assert(state.count == expected - expected / 3);
+
+    // Keys 900 and 9000 with their extensions
+    state = (visit_t){ 0, "", true };
+    art_prefix(tree, "/srv/000/data/900", visit, &state);
+    assert(state.count == 4);
+    assert(strcmp(state.last, "/srv/000/data/9000/meta") == 0);
+
+    state = (visit_t){ 0, "", true };
+    art_prefix(tree, "/srv/000/data/900/", visit, &state);
+    assert(state.count == 1);
+
+    state = (visit_t){ 0, "", true };
+    art_prefix(tree, "/srv/999", visit, &state);
+    assert(state.count == 0);
+
+    assert(art_prefix(tree, NULL, visit, &state).status == MAP_ERR_INVALID);
+    assert(art_prefix(tree, "", NULL, NULL).status == MAP_ERR_INVALID);
+
+    art_destroy(tree);
+}
+
+int main(void) {
+    printf("=== Running Adaptive Radix Tree unit tests ===\n\n");
+
+    TEST(art_new);
+    TEST(art_basic);
+    TEST(art_many);
+    TEST(art_fanout);
+    TEST(art_leaves);
+    TEST(art_longest_prefix);
+    TEST(art_prefix);
+
+    printf("\n=== All tests passed! ===\n");
+
+    return 0;
+}
@@ -12,6 +12,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <limits.h>
 
 #include "../src/bigint.h"
 
@@ -62,6 +63,83 @@ void test_bigint_from_string(void) {
     bigint_destroy(res.value.number);
 }
 
+// Test conversion to string around the limb boundaries
+void test_bigint_to_string(void) {
+    const char *numbers[] = {
+        "0", "-1", "18446744073709551615", "18446744073709551616", "9999999999999999999",
+        "10000000000000000000", "-340282366920938463463374607431768211456",
+        "100000000000000000000000000000000000000000000000000000000000000000000000000001"
+    };
+
+    for (size_t idx = 0; idx < sizeof(numbers) / sizeof(numbers[0]); idx++) {
+        bigint_result_t res = bigint_from_string(numbers[idx]);
+        assert(res.status == BIGINT_OK);
+
+        bigint_result_t str_res = bigint_to_string(res.value.number);
+        assert(str_res.status == BIGINT_OK);
+        assert(!strcmp(str_res.value.string_num, numbers[idx]));
+
+        free(str_res.value.string_num);
+        bigint_destroy(res.value.number);
+    }
+}
+
+// Test conversion to other bases
+void test_bigint_to_string_base(void) {
+    const struct {
+        const char *number;
+        unsigned base;
+        const char *expected;
+    } cases[] = {
+        { "255", 2, "11111111" }, { "255", 8, "377" }, { "-255", 16, "-ff" }, { "255", 36, "73" },
+        { "0", 2, "0" }, { "35", 36, "z" }, { "-36", 36, "-10" },
+        { "18446744073709551616", 16, "10000000000000000" },
+        { "340282366920938463463374607431768211455", 8, "3777777777777777777777777777777777777777777" },
+        { "340282366920938463463374607431768211456", 36, "f5lxx1zz5pnorynqglhzmsp34" }
+    };
+
+    for (size_t idx = 0; idx < sizeof(cases) / sizeof(cases[0]); idx++) {
+        bigint_t *number = bigint_from_string(cases[idx].number).value.number;
+
+        bigint_result_t str_res = bigint_to_string_base(number, cases[idx].base);
+        assert(str_res.status == BIGINT_OK);
+        assert(!strcmp(str_res.value.string_num, cases[idx].expected));
+        free(str_res.value.string_num);
+        bigint_destroy(number);
+    }
+
+    bigint_t *number = bigint_from_int(10).value.number;
+    assert(bigint_to_string_base(number, 1).status == BIGINT_ERR_INVALID);
+    assert(bigint_to_string_base(number, 37).status == BIGINT_ERR_INVALID);
+    bigint_destroy(number);
+}
+
+// Test decimal round trips long enough for the recursive conversions
+void test_bigint_to_string_large(void) {
+    const size_t length = 100000;
+    char *digits = malloc(length + 1);
+    uint64_t seed = 11;
+
+    for (size_t pattern = 0; pattern < 3; pattern++) {
+        for (size_t pos = 0; pos < length; pos++) {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            // Random digits, then 10^(length - 1) and 10^length - 1
+            digits[pos] = pattern == 0 ? (char)('0' + ((seed >> 33) % 10)) : (pattern == 1 ? '0' : '9');
+        }
+        digits[0] = pattern == 2 ? '9' : '1';
+        digits[length] = '\0';
+
+        bigint_t *number = bigint_from_string(digits).value.number;
+        bigint_result_t str_res = bigint_to_string(number);
+        assert(str_res.status == BIGINT_OK);
+        assert(!strcmp(str_res.value.string_num, digits));
+        free(str_res.value.string_num);
+        bigint_destroy(number);
+    }
+
+    free(digits);
+}
+
 // Test sum between big integers
 void test_bigint_add(void) {
     bigint_result_t x = bigint_from_int(123);
@@ -213,6 +291,97 @@ void test_bigint_prod_neg(void) {
     bigint_destroy(prod.value.number);
 }
 
+// Test product and division of large numbers made of nines, above the Karatsuba threshold
+void test_bigint_prod_nines(void) {
+    // (10^n - 1) * (10^k - 1) = 9...9 8 9...9 0...0 1
+    const size_t sizes[][2] = { { 360, 360 }, { 900, 450 }, { 2000, 667 }, { 2705, 2000 }, { 3000, 50 }, { 20000, 1000 } };
+
+    for (size_t idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); idx++) {
+        const size_t n = sizes[idx][0], k = sizes[idx][1];
+        char *x_str = malloc(n + 1);
+        char *y_str = malloc(k + 1);
+        char *expected = malloc(n + k + 1);
+
+        memset(x_str, '9', n); x_str[n] = '\0';
+        memset(y_str, '9', k); y_str[k] = '\0';
+
+        char *ptr = expected;
+        memset(ptr, '9', k - 1); ptr += k - 1;
+        *ptr++ = '8';
+        memset(ptr, '9', n - k); ptr += n - k;
+        memset(ptr, '0', k - 1); ptr += k - 1;
+        *ptr++ = '1';
+        *ptr = '\0';
+
+        bigint_t *x = bigint_from_string(x_str).value.number;
+        bigint_t *y = bigint_from_string(y_str).value.number;
+
+        bigint_result_t prod = bigint_prod(x, y);
+        assert(prod.status == BIGINT_OK);
+        bigint_eq(prod.value.number, expected);
+
+        bigint_result_t div = bigint_divmod(prod.value.number, y);
+        assert(div.status == BIGINT_OK);
+        bigint_eq(div.value.division.quotient, x_str);
+        bigint_eq(div.value.division.remainder, "0");
+
+        bigint_destroy(div.value.division.quotient);
+        bigint_destroy(div.value.division.remainder);
+        bigint_destroy(prod.value.number);
+        bigint_destroy(x); bigint_destroy(y);
+        free(x_str); free(y_str); free(expected);
+    }
+}
+
+// Test that every multiplication algorithm computes the same products
+void test_bigint_prod_tiers(void) {
+    const bigint_thresholds_t tiers[] = { { 4, 4, 100000 }, { 4, 9, 100000 }, { 4, 4, 1 }, { 8, 16, 24 } };
+    const size_t sizes[][2] = { { 40, 40 }, { 400, 400 }, { 1000, 990 }, { 2000, 1500 }, { 3000, 700 }, { 5000, 19 } };
+    uint64_t seed = 42;
+
+    for (size_t idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); idx++) {
+        char *digits[2];
+        for (size_t op = 0; op < 2; op++) {
+            digits[op] = malloc(sizes[idx][op] + 1);
+            for (size_t pos = 0; pos < sizes[idx][op]; pos++) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                digits[op][pos] = (char)('0' + ((seed >> 33) % 10));
+            }
+            digits[op][0] = '9';
+            digits[op][sizes[idx][op]] = '\0';
+        }
+
+        bigint_t *x = bigint_from_string(digits[0]).value.number;
+        bigint_t *y = bigint_from_string(digits[1]).value.number;
+        bigint_t *expected = bigint_prod(x, y).value.number;
+
+        for (size_t tier = 0; tier < sizeof(tiers) / sizeof(tiers[0]); tier++) {
+            assert(bigint_set_thresholds(&tiers[tier]).status == BIGINT_OK);
+
+            bigint_result_t prod = bigint_prod(x, y);
+            assert(prod.status == BIGINT_OK);
+            assert(bigint_compare(prod.value.number, expected).value.compare_status == 0);
+            bigint_destroy(prod.value.number);
+
+            // Squares
+            bigint_t *square = bigint_prod(x, x).value.number;
+            bigint_set_thresholds(NULL);
+            bigint_t *plain = bigint_prod(x, x).value.number;
+            assert(bigint_compare(square, plain).value.compare_status == 0);
+            bigint_destroy(square); bigint_destroy(plain);
+        }
+
+        bigint_destroy(expected);
+        bigint_destroy(x); bigint_destroy(y);
+        free(digits[0]); free(digits[1]);
+    }
+
+    const bigint_thresholds_t invalid = { 2, 4, 8 }, unordered = { 32, 16, 64 };
+    assert(bigint_set_thresholds(&invalid).status == BIGINT_ERR_INVALID);
+    assert(bigint_set_thresholds(&unordered).status == BIGINT_ERR_INVALID);
+    assert(bigint_set_thresholds(NULL).status == BIGINT_OK);
+}
+
 // Test division between big numbers where divisor is a single limb big number
 void test_bigint_div_single_limb(void) {
     bigint_result_t x = bigint_from_int(100);
@@ -258,6 +427,53 @@ void test_bigint_div_knuth(void) {
     bigint_destroy(x.value.number); bigint_destroy(y.value.number);
 }
 
+// Test the recursive division, rebuilding the dividend out of the quotient and the remainder
+void test_bigint_div_large(void) {
+    // Decimal digits of the divisor and of the quotient
+    const size_t sizes[][2] = { { 700, 700 }, { 700, 2100 }, { 3000, 1300 }, { 1300, 6000 } };
+    uint64_t seed = 7;
+
+    for (size_t idx = 0; idx < sizeof(sizes) / sizeof(sizes[0]); idx++) {
+        char *digits[2];
+        for (size_t op = 0; op < 2; op++) {
+            digits[op] = malloc(sizes[idx][op] + 1);
+            for (size_t pos = 0; pos < sizes[idx][op]; pos++) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                digits[op][pos] = (char)('0' + ((seed >> 33) % 10));
+            }
+            digits[op][0] = '1';
+            digits[op][sizes[idx][op]] = '\0';
+        }
+
+        // x = y * q + r with r = y - 1, the largest remainder
+        bigint_t *y = bigint_from_string(digits[0]).value.number;
+        bigint_t *q = bigint_from_string(digits[1]).value.number;
+        bigint_t *one = bigint_from_int(1).value.number;
+        bigint_t *r = bigint_sub(y, one).value.number;
+        bigint_t *y_times_q = bigint_prod(y, q).value.number;
+        bigint_t *x = bigint_add(y_times_q, r).value.number;
+
+        bigint_result_t div = bigint_divmod(x, y);
+        assert(div.status == BIGINT_OK);
+        assert(bigint_compare(div.value.division.quotient, q).value.compare_status == 0);
+        assert(bigint_compare(div.value.division.remainder, r).value.compare_status == 0);
+        bigint_destroy(div.value.division.quotient);
+        bigint_destroy(div.value.division.remainder);
+
+        // An exact division leaves no remainder
+        div = bigint_divmod(y_times_q, q);
+        assert(div.status == BIGINT_OK);
+        assert(bigint_compare(div.value.division.quotient, y).value.compare_status == 0);
+        bigint_eq(div.value.division.remainder, "0");
+        bigint_destroy(div.value.division.quotient);
+        bigint_destroy(div.value.division.remainder);
+
+        bigint_destroy(x); bigint_destroy(y_times_q); bigint_destroy(r);
+        bigint_destroy(one); bigint_destroy(q); bigint_destroy(y);
+        free(digits[0]); free(digits[1]);
+    }
+}
+
 // Test division between big numbers with negative dividend
 // This library follows C-style divison such that sign(remainder) = sign(dividend)
 void test_bigint_div_dividend(void) {
@@ -344,6 +560,326 @@ void test_bigint_div_by_zero(void) {
     bigint_destroy(y.value.number);
 }
 
+// Test in-place sums and differences across signs and limb boundaries
+void test_bigint_add_inplace(void) {
+    const char *cases[][3] = {
+        // x, y, x + y
+        { "18446744073709551615", "1", "18446744073709551616" },
+        { "-18446744073709551616", "1", "-18446744073709551615" },
+        { "5", "-18446744073709551621", "-18446744073709551616" },
+        { "-7", "7", "0" },
+        { "0", "-340282366920938463463374607431768211456", "-340282366920938463463374607431768211456" }
+    };
+
+    for (size_t idx = 0; idx < sizeof(cases) / sizeof(cases[0]); idx++) {
+        bigint_t *x = bigint_from_string(cases[idx][0]).value.number;
+        bigint_t *y = bigint_from_string(cases[idx][1]).value.number;
+
+        bigint_result_t res = bigint_add_inplace(x, y);
+        assert(res.status == BIGINT_OK && res.value.number == x);
+        bigint_eq(x, cases[idx][2]);
+
+        // (x + y) - y = x
+        res = bigint_sub_from(x, y);
+        assert(res.status == BIGINT_OK);
+        bigint_eq(x, cases[idx][0]);
+
+        bigint_destroy(x);
+        bigint_destroy(y);
+    }
+
+    // Aliased operands
+    bigint_t *x = bigint_from_string("-9223372036854775808").value.number;
+    assert(bigint_add_inplace(x, x).status == BIGINT_OK);
+    bigint_eq(x, "-18446744073709551616");
+    assert(bigint_sub_from(x, x).status == BIGINT_OK);
+    bigint_eq(x, "0");
+    assert(!x->is_negative);
+    bigint_destroy(x);
+}
+
+// Test an accumulator of products that reuses its limbs
+void test_bigint_mul_into(void) {
+    bigint_t *acc = bigint_from_int(0).value.number;
+    bigint_t *product = bigint_from_int(0).value.number;
+    bigint_t *x = bigint_from_string("-123456789012345678901234567890").value.number;
+    bigint_t *y = bigint_from_string("987654321098765432109876543210").value.number;
+
+    // acc = 3 * x * y, then acc = acc * acc
+    for (size_t idx = 0; idx < 3; idx++) {
+        assert(bigint_mul_into(product, x, y).status == BIGINT_OK);
+        assert(bigint_add_inplace(acc, product).status == BIGINT_OK);
+    }
+    bigint_eq(acc, "-365797893411065385678555098200868769996712391403333790580700");
+
+    assert(bigint_mul_into(acc, acc, acc).status == BIGINT_OK);
+    bigint_eq(acc, "1338080988239731531018704117156310245003408972454023432140763383603288179373"
+                   "00004014250463040843697531595964043212490000");
+
+    // The product shrinks back into the limbs of a larger value
+    assert(bigint_mul_into(acc, x, x).status == BIGINT_OK);
+    bigint_eq(acc, "15241578753238836750495351562536198787501905199875019052100");
+
+    bigint_destroy(y);
+    bigint_destroy(x);
+    bigint_destroy(product);
+    bigint_destroy(acc);
+}
+
+// Test multiply-accumulate by a small factor and swapping
+void test_bigint_addmul_small(void) {
+    bigint_t *acc = bigint_from_int(0).value.number;
+    bigint_t *x = bigint_from_string("18446744073709551615").value.number;
+
+    // Horner's scheme: digits of 2^64 - 1 in base 10 from the factor 10
+    const char *digits = "18446744073709551615";
+    bigint_t *digit = bigint_from_int(0).value.number;
+    for (const char *ptr = digits; *ptr != '\0'; ptr++) {
+        bigint_t *ten_acc = bigint_from_int(0).value.number;
+        assert(bigint_addmul_small(ten_acc, acc, 10).status == BIGINT_OK);
+        bigint_swap(acc, ten_acc);
+        bigint_destroy(ten_acc);
+
+        bigint_destroy(digit);
+        digit = bigint_from_int(*ptr - '0').value.number;
+        assert(bigint_addmul_small(acc, digit, 1).status == BIGINT_OK);
+    }
+    bigint_eq(acc, digits);
+
+    // acc - x * 4294967295 changes sign
+    bigint_t *neg_x = bigint_from_string("-18446744073709551615").value.number;
+    assert(bigint_addmul_small(acc, neg_x, 4294967295U).status == BIGINT_OK);
+    bigint_eq(acc, "-79228162477370849441829879810");
+
+    // acc = acc + acc * 3
+    assert(bigint_addmul_small(acc, acc, 3).status == BIGINT_OK);
+    bigint_eq(acc, "-316912649909483397767319519240");
+
+    assert(bigint_swap(acc, x).status == BIGINT_OK);
+    bigint_eq(acc, "18446744073709551615");
+    bigint_eq(x, "-316912649909483397767319519240");
+
+    bigint_destroy(neg_x);
+    bigint_destroy(digit);
+    bigint_destroy(x);
+    bigint_destroy(acc);
+}
+
+// Test numbers stored inline and their promotion to limbs on overflow
+void test_bigint_small(void) {
+    bigint_t *x = bigint_from_int(LLONG_MIN).value.number;
+    bigint_t *y = bigint_from_string("18446744073709551615").value.number;
+    assert(x->digits == NULL && y->digits == NULL);
+    bigint_eq(x, "-9223372036854775808");
+
+    // |x| + |y| overflows a limb and is promoted
+    bigint_t *sum = bigint_sub(y, x).value.number;
+    assert(sum->digits != NULL);
+    bigint_eq(sum, "27670116110564327423");
+    bigint_destroy(sum);
+
+    // Opposite signs stay inline
+    sum = bigint_add(x, y).value.number;
+    assert(sum->digits == NULL);
+    bigint_eq(sum, "9223372036854775807");
+    bigint_destroy(sum);
+
+    // 2^32 * 2^32 = 2^64 needs two limbs, 2^32 * (2^32 - 1) does not
+    bigint_t *p = bigint_from_int(4294967296LL).value.number;
+    bigint_t *q = bigint_from_int(-4294967295LL).value.number;
+    bigint_t *product = bigint_prod(p, p).value.number;
+    assert(product->digits != NULL);
+    bigint_eq(product, "18446744073709551616");
+    bigint_destroy(product);
+    product = bigint_prod(p, q).value.number;
+    assert(product->digits == NULL);
+    bigint_eq(product, "-18446744069414584320");
+    bigint_destroy(product);
+
+    // Truncated division of inline numbers
+    bigint_result_t div_res = bigint_divmod(x, q);
+    assert(div_res.status == BIGINT_OK);
+    bigint_eq(div_res.value.division.quotient, "2147483648");
+    bigint_eq(div_res.value.division.remainder, "-2147483648");
+    bigint_destroy(div_res.value.division.quotient);
+    bigint_destroy(div_res.value.division.remainder);
+
+    // In place: y + 1 is promoted, y + 1 - 2 fits a limb again and keeps the vector
+    bigint_t *one = bigint_from_int(1).value.number;
+    assert(bigint_add_inplace(y, one).status == BIGINT_OK);
+    assert(y->digits != NULL);
+    bigint_eq(y, "18446744073709551616");
+    assert(bigint_sub_from(y, one).status == BIGINT_OK);
+    assert(bigint_sub_from(y, one).status == BIGINT_OK);
+    bigint_eq(y, "18446744073709551614");
+
+    // A promoted number and an inline one multiply into an inline destination
+    assert(bigint_mul_into(one, y, p).status == BIGINT_OK);
+    assert(one->digits != NULL);
+    bigint_eq(one, "79228162514264337584954015744");
+    assert(bigint_addmul_small(p, p, 4294967295U).status == BIGINT_OK);
+    bigint_eq(p, "18446744073709551616");
+
+    bigint_destroy(one);
+    bigint_destroy(q);
+    bigint_destroy(p);
+    bigint_destroy(y);
+    bigint_destroy(x);
+}
+
+// Test exponentiation
+void test_bigint_pow(void) {
+    const struct { const char *base; uint64_t exponent; const char *power; } cases[] = {
+        { "0", 0, "1" },
+        { "-5", 1, "-5" },
+        { "7", 45, "107006904423598033356356300384937784807" },
+        { "-3", 41, "-36472996377170786403" },
+        { "-1606938044258990275541962092341162602522202993782792835313721", 3,
+          "-4149515568880992958512407863691161151012446232242436900091290953925601471030815112934838593712904448325628179409718945825419466653236718059375049936816407105603591847044840157504361" }
+    };
+
+    for (size_t idx = 0; idx < sizeof(cases) / sizeof(cases[0]); idx++) {
+        bigint_t *base = bigint_from_string(cases[idx].base).value.number;
+
+        bigint_result_t res = bigint_pow(base, cases[idx].exponent);
+        assert(res.status == BIGINT_OK);
+        bigint_eq(res.value.number, cases[idx].power);
+
+        bigint_destroy(res.value.number);
+        bigint_destroy(base);
+    }
+}
+
+// Test modular exponentiation with odd and even moduli
+void test_bigint_modpow(void) {
+    const char *cases[][4] = {
+        // base, exponent, modulus, base^exponent mod modulus
+        { "65", "17", "3233", "2790" },
+        { "2790", "2753", "3233", "65" },
+        { "12345", "0", "1", "0" },
+        { "-12345", "0", "10", "1" },
+        { "-7", "3", "10", "7" },
+        { "1606938044258990275541962092341162602522202993782792835313721",
+          "515377520732011331036461129765621272702107522001",
+          "57896044618658097711785492504343953926634992332820282019728792003956564819949",
+          "51937381593780145823479504802867931478193890697481523381948238575085588134904" },
+        { "-1606938044258990275541962092341162602522202993782792835313721",
+          "515377520732011331036461129765621272702107522001",
+          "57896044618658097711785492504343953926634992332820282019728792003956564819949",
+          "5958663024877951888305987701476022448441101635338758637780553428870976685045" },
+        { "-1606938044258990275541962092341162602522202993782792835313721",
+          "515377520732011331036461129765621272702107522001",
+          "18831305206160042291507368269622999248325513077465813090304",
+          "8697103767497632775635822341752306640774183122383974879303" }
+    };
+
+    for (size_t idx = 0; idx < sizeof(cases) / sizeof(cases[0]); idx++) {
+        bigint_t *base = bigint_from_string(cases[idx][0]).value.number;
+        bigint_t *exponent = bigint_from_string(cases[idx][1]).value.number;
+        bigint_t *modulus = bigint_from_string(cases[idx][2]).value.number;
+
+        bigint_result_t res = bigint_modpow(base, exponent, modulus);
+        assert(res.status == BIGINT_OK);
+        bigint_eq(res.value.number, cases[idx][3]);
+        bigint_destroy(res.value.number);
+
+        // The contexts agree with each other
+        bigint_result_t barrett_res = bigint_barrett_ctx_new(modulus);
+        assert(barrett_res.status == BIGINT_OK);
+        res = bigint_barrett_modpow(barrett_res.value.barrett_ctx, base, exponent);
+        assert(res.status == BIGINT_OK);
+        bigint_eq(res.value.number, cases[idx][3]);
+        bigint_destroy(res.value.number);
+        bigint_barrett_ctx_destroy(barrett_res.value.barrett_ctx);
+
+        bigint_result_t mont_res = bigint_mont_ctx_new(modulus);
+        if (mont_res.status == BIGINT_OK) {
+            for (int constant_time = 0; constant_time < 2; constant_time++) {
+                res = bigint_mont_modpow(mont_res.value.mont_ctx, base, exponent, constant_time);
+                assert(res.status == BIGINT_OK);
+                bigint_eq(res.value.number, cases[idx][3]);
+                bigint_destroy(res.value.number);
+            }
+            bigint_mont_ctx_destroy(mont_res.value.mont_ctx);
+        } else {
+            // Even modulus
+            assert(mont_res.status == BIGINT_ERR_INVALID);
+        }
+
+        bigint_destroy(modulus);
+        bigint_destroy(exponent);
+        bigint_destroy(base);
+    }
+
+    // Moduli of 42 limbs (odd) and 41 limbs (even) agree with bigint_pow and bigint_mod
+    char digits[801];
+    for (size_t idx = 0; idx < 800; idx++) {
+        digits[idx] = (char)('1' + (idx * 7) % 9);
+    }
+    digits[800] = '\0';
+    bigint_t *base = bigint_from_string(digits + 100).value.number;
+    bigint_t *exponent = bigint_from_int(37).value.number;
+    bigint_t *power = bigint_pow(base, 37).value.number;
+    for (size_t idx = 0; idx < 2; idx++) {
+        // Ends with 5, then with 6
+        digits[799] = (char)('5' + idx);
+        bigint_t *modulus = bigint_from_string(idx == 0 ? digits : digits + 15).value.number;
+        bigint_t *expected = bigint_mod(power, modulus).value.number;
+
+        bigint_result_t res = bigint_modpow(base, exponent, modulus);
+        assert(res.status == BIGINT_OK);
+        assert(bigint_compare(res.value.number, expected).value.compare_status == 0);
+        bigint_destroy(res.value.number);
+
+        bigint_destroy(expected);
+        bigint_destroy(modulus);
+    }
+    bigint_destroy(power);
+    bigint_destroy(exponent);
+    bigint_destroy(base);
+
+    // Zero modulus and negative exponent
+    bigint_t *zero = bigint_from_int(0).value.number;
+    bigint_t *minus_one = bigint_from_int(-1).value.number;
+    assert(bigint_modpow(minus_one, minus_one, minus_one).status == BIGINT_ERR_INVALID);
+    assert(bigint_modpow(minus_one, zero, zero).status == BIGINT_ERR_DIV_BY_ZERO);
+    assert(bigint_barrett_ctx_new(zero).status == BIGINT_ERR_INVALID);
+    bigint_destroy(minus_one);
+    bigint_destroy(zero);
+}
+
+// Test reductions through a Barrett context
+void test_bigint_barrett_mod(void) {
+    const char *cases[][3] = {
+        // x, modulus, x mod modulus
+        { "18446744073709551621", "18446744073709551557", "64" },
+        { "-10000000000000000000000000000000000000007",
+          "18831305206160042291507368269622999248325513077465813090304",
+          "-10000000000000000000000000000000000000007" },
+        { "10000000000000000000000000000000000000000000000000000000000000000000007",
+          "18831305206160042291507368269622999248325513077465813090304",
+          "2838988922860676762186755447769640195176353524432580378631" },
+        { "-10000000000000000000000000000000000000000000000000000000000000000000007",
+          "18831305206160042291507368269622999248325513077465813090304",
+          "-2838988922860676762186755447769640195176353524432580378631" }
+    };
+
+    for (size_t idx = 0; idx < sizeof(cases) / sizeof(cases[0]); idx++) {
+        bigint_t *x = bigint_from_string(cases[idx][0]).value.number;
+        bigint_t *modulus = bigint_from_string(cases[idx][1]).value.number;
+        bigint_barrett_ctx_t *ctx = bigint_barrett_ctx_new(modulus).value.barrett_ctx;
+
+        bigint_result_t res = bigint_barrett_mod(ctx, x);
+        assert(res.status == BIGINT_OK);
+        bigint_eq(res.value.number, cases[idx][2]);
+        bigint_destroy(res.value.number);
+
+        bigint_barrett_ctx_destroy(ctx);
+        bigint_destroy(modulus);
+        bigint_destroy(x);
+    }
+}
+
 // Test cloning of big numbers
 void test_bigint_clone(void) {
     bigint_result_t x = bigint_from_string("0010101010");
@@ -419,6 +955,9 @@ int main(void) {
 
     TEST(bigint_from_int);
     TEST(bigint_from_string);
+    TEST(bigint_to_string);
+    TEST(bigint_to_string_base);
+    TEST(bigint_to_string_large);
     TEST(bigint_add);
     TEST(bigint_sub);
     TEST(bigint_sub_neg);
@@ -427,12 +966,22 @@ int main(void) {
     TEST(bigint_very_large_prod);
     TEST(bigint_prod_mixed);
     TEST(bigint_prod_neg);
+    TEST(bigint_prod_nines);
+    TEST(bigint_prod_tiers);
     TEST(bigint_div_single_limb);
     TEST(bigint_div_knuth);
+    TEST(bigint_div_large);
     TEST(bigint_div_dividend);
     TEST(bigint_div_neg_divisor);
     TEST(bigint_div_neg);
     TEST(bigint_div_by_zero);
+    TEST(bigint_add_inplace);
+    TEST(bigint_mul_into);
+    TEST(bigint_addmul_small);
+    TEST(bigint_small);
+    TEST(bigint_pow);
+    TEST(bigint_modpow);
+    TEST(bigint_barrett_mod);
     TEST(bigint_clone);
     TEST(bigint_compare_eq);
     TEST(bigint_compare_lt);
@@ -0,0 +1,190 @@
+/*
+ * Unit tests for Cache data type
+ */
+
+#define TEST(NAME) do { \
+    printf("Running test_%s...", #NAME); \
+    test_##NAME(); \
+    printf(" PASSED\n"); \
+} while(0)
+
+#define KEYS 20000
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "../src/cache.h"
+
+static int values[KEYS];
+static const cache_policy_t policies[] = { CACHE_LRU, CACHE_CLOCK, CACHE_S3FIFO };
+
+typedef struct {
+    size_t count;
+    size_t sum;
+} evicted_t;
+
+static void on_evict(const char *key, size_t key_len, void *value, void *env) {
+    evicted_t *evicted = env;
+
+    assert(key != NULL && key_len > 0);
+    evicted->count++;
+    evicted->sum += (size_t)*(int *)value;
+}
+
+// Create a new cache
+void test_cache_new(void) {
+    cache_result_t res = cache_new(CACHE_LRU, 10, 0);
+
+    assert(res.status == MAP_OK);
+    assert(res.value.cache != NULL);
+    assert(cache_size(res.value.cache) == 0);
+    assert(cache_bytes(res.value.cache) == 0);
+
+    cache_destroy(res.value.cache);
+
+    assert(cache_new(CACHE_LRU, 0, 0).status == MAP_ERR_INVALID);
+    assert(cache_new((cache_policy_t)42, 10, 0).status == MAP_ERR_INVALID);
+}
+
+// Put, get, replace and remove entries
+void test_cache_basic(void) {
+    for (size_t policy = 0; policy < 3; policy++) {
+        cache_t *cache = cache_new(policies[policy], 10, 0).value.cache;
+        evicted_t evicted = { 0, 0 };
+        int x = 42, y = 84;
+
+        cache_set_evict(cache, on_evict, &evicted);
+        assert(cache_put(cache, "x", &x, 1).status == MAP_OK);
+        assert(cache_put(cache, "y", &y, 1).status == MAP_OK);
+        assert(cache_size(cache) == 2);
+
+        assert(*(int *)cache_get(cache, "x").value.element == 42);
+        assert(cache_get(cache, "z").status == MAP_ERR_NOT_FOUND);
+        assert(cache_hits(cache) == 1);
+        assert(cache_misses(cache) == 1);
+
+        // Replacing a value hands the old one to the callback
+        assert(cache_put(cache, "x", &y, 1).status == MAP_OK);
+        assert(cache_size(cache) == 2);
+        assert(evicted.count == 1 && evicted.sum == 42);
+        assert(*(int *)cache_get(cache, "x").value.element == 84);
+
+        assert(cache_remove(cache, "y").status == MAP_OK);
+        assert(cache_remove(cache, "y").status == MAP_ERR_NOT_FOUND);
+        assert(evicted.count == 2);
+
+        assert(cache_put_bytes(cache, "a\0b", 3, &x, 1).status == MAP_OK);
+        assert(cache_get_bytes(cache, "a\0b", 3).value.element == &x);
+
+        assert(cache_put(NULL, "x", &x, 1).status == MAP_ERR_INVALID);
+        assert(cache_get(cache, NULL).status == MAP_ERR_INVALID);
+
+        // Destroy hands the remaining values to the callback
+        cache_destroy(cache);
+        assert(evicted.count == 4);
+    }
+}
+
+// The number of entries never exceeds the capacity
+void test_cache_capacity(void) {
+    char key[32];
+
+    for (size_t policy = 0; policy < 3; policy++) {
+        cache_t *cache = cache_new(policies[policy], 100, 0).value.cache;
+        evicted_t evicted = { 0, 0 };
+        cache_set_evict(cache, on_evict, &evicted);
+
+        for (int idx = 0; idx < KEYS; idx++) {
+            values[idx] = idx;
+            snprintf(key, sizeof(key), "key_%d", idx);
+            assert(cache_put(cache, key, &values[idx], 1).status == MAP_OK);
+            assert(cache_size(cache) <= 100);
+
+            // Key 0 is read on every insertion and must survive
+            assert(cache_get(cache, "key_0").status == MAP_OK);
+        }
+
+        assert(cache_size(cache) == 100);
+        assert(evicted.count == KEYS - 100);
+
+        // The map does not grow with the evictions
+        assert(map_capacity(cache->map) <= 512);
+
+        assert(cache_clear(cache).status == MAP_OK);
+        assert(cache_size(cache) == 0);
+        assert(evicted.count == KEYS);
+        assert(cache_get(cache, "key_0").status == MAP_ERR_NOT_FOUND);
+
+        cache_destroy(cache);
+    }
+}
+
+// The sum of the charges never exceeds the byte budget
+void test_cache_budget(void) {
+    char key[32];
+
+    for (size_t policy = 0; policy < 3; policy++) {
+        cache_t *cache = cache_new(policies[policy], 0, 1000).value.cache;
+
+        for (int idx = 0; idx < KEYS; idx++) {
+            snprintf(key, sizeof(key), "key_%d", idx);
+            assert(cache_put(cache, key, &values[idx], (size_t)(idx % 50) + 1).status == MAP_OK);
+            assert(cache_bytes(cache) <= 1000);
+        }
+        assert(cache_size(cache) > 20);
+
+        // Growing an entry evicts the others
+        assert(cache_put(cache, "big", &values[0], 900).status == MAP_OK);
+        assert(cache_bytes(cache) <= 1000);
+        assert(cache_put(cache, "big", &values[0], 1000).status == MAP_OK);
+        assert(cache_size(cache) == 1);
+        assert(cache_put(cache, "huge", &values[0], 1001).status == MAP_ERR_OVERFLOW);
+
+        cache_destroy(cache);
+    }
+}
+
+// S3-FIFO keeps a frequently read working set through a scan of unique keys
+void test_cache_scan(void) {
+    cache_t *cache = cache_new(CACHE_S3FIFO, 1000, 0).value.cache;
+    char key[32];
+
+    for (int round = 0; round < 3; round++) {
+        for (int idx = 0; idx < 500; idx++) {
+            snprintf(key, sizeof(key), "hot_%d", idx);
+            if (cache_get(cache, key).status != MAP_OK) {
+                cache_put(cache, key, &values[idx], 1);
+            }
+        }
+    }
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        snprintf(key, sizeof(key), "scan_%d", idx);
+        cache_put(cache, key, &values[idx], 1);
+    }
+
+    size_t survivors = 0;
+    for (int idx = 0; idx < 500; idx++) {
+        snprintf(key, sizeof(key), "hot_%d", idx);
+        survivors += cache_get(cache, key).status == MAP_OK;
+    }
+    assert(survivors > 400);
+
+    cache_destroy(cache);
+}
+
+int main(void) {
+    printf("=== Running Cache unit tests ===\n\n");
+
+    TEST(cache_new);
+    TEST(cache_basic);
+    TEST(cache_capacity);
+    TEST(cache_budget);
+    TEST(cache_scan);
+
+    printf("\n=== All tests passed! ===\n");
+
+    return 0;
+}
@@ -0,0 +1,274 @@
+/*
+ * Unit tests for concurrent Map data type
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#define TEST(NAME) do { \
+    printf("Running test_%s...", #NAME); \
+    test_##NAME(); \
+    printf(" PASSED\n"); \
+} while(0)
+
+#define THREADS 8
+#define KEYS_PER_THREAD 2000
+
+#include <stdio.h>
+#include <assert.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "../src/cmap.h"
+
+typedef struct {
+    cmap_t *map;
+    size_t id;
+    int values[KEYS_PER_THREAD];
+} worker_t;
+
+// Create a new concurrent map
+void test_cmap_new(void) {
+    cmap_result_t res = cmap_new(0);
+
+    assert(res.status == MAP_OK);
+    assert(res.value.map != NULL);
+    assert(res.value.map->shard_count == CMAP_DEFAULT_SHARDS);
+    assert(cmap_size(res.value.map) == 0);
+
+    cmap_destroy(res.value.map);
+
+    // Shard count is rounded up to a power of two
+    res = cmap_new(5);
+    assert(res.status == MAP_OK);
+    assert(res.value.map->shard_count == 8);
+    cmap_destroy(res.value.map);
+
+    res = cmap_new((size_t)1 << 20);
+    assert(res.status == MAP_ERR_OVERFLOW);
+}
+
+// Add, get and remove elements from a single thread
+void test_cmap_basic(void) {
+    cmap_result_t res = cmap_new(4);
+
+    assert(res.status == MAP_OK);
+    cmap_t *map = res.value.map;
+
+    int x = 42, y = 84;
+
+    assert(cmap_add(map, "x", &x).status == MAP_OK);
+    assert(cmap_add(map, "y", &y).status == MAP_OK);
+    assert(cmap_size(map) == 2);
+
+    cmap_result_t get_res = cmap_get(map, "x");
+    assert(get_res.status == MAP_OK);
+    assert(*(int *)get_res.value.element == 42);
+
+    // Update an existing key
+    assert(cmap_add(map, "x", &y).status == MAP_OK);
+    assert(cmap_size(map) == 2);
+    assert(*(int *)cmap_get(map, "x").value.element == 84);
+
+    assert(cmap_remove(map, "x").status == MAP_OK);
+    assert(cmap_get(map, "x").status == MAP_ERR_NOT_FOUND);
+    assert(cmap_remove(map, "x").status == MAP_ERR_NOT_FOUND);
+    assert(cmap_size(map) == 1);
+
+    assert(cmap_clear(map).status == MAP_OK);
+    assert(cmap_size(map) == 0);
+    assert(cmap_get(map, "y").status == MAP_ERR_NOT_FOUND);
+
+    assert(cmap_add(NULL, "x", &x).status == MAP_ERR_INVALID);
+    assert(cmap_get(map, NULL).status == MAP_ERR_INVALID);
+
+    cmap_destroy(map);
+}
+
+static void *writer(void *arg) {
+    worker_t *worker = arg;
+    char key[32];
+
+    for (size_t idx = 0; idx < KEYS_PER_THREAD; idx++) {
+        snprintf(key, sizeof(key), "t%zu_k%zu", worker->id, idx);
+        worker->values[idx] = (int)(worker->id * KEYS_PER_THREAD + idx);
+        assert(cmap_add(worker->map, key, &worker->values[idx]).status == MAP_OK);
+
+        // Read back a key of our own while the other threads keep writing
+        snprintf(key, sizeof(key), "t%zu_k%zu", worker->id, idx / 2);
+        cmap_result_t get_res = cmap_get(worker->map, key);
+        assert(get_res.status == MAP_OK);
+        assert(*(int *)get_res.value.element == (int)(worker->id * KEYS_PER_THREAD + idx / 2));
+    }
+
+    // Remove odd keys
+    for (size_t idx = 1; idx < KEYS_PER_THREAD; idx += 2) {
+        snprintf(key, sizeof(key), "t%zu_k%zu", worker->id, idx);
+        assert(cmap_remove(worker->map, key).status == MAP_OK);
+    }
+
+    return NULL;
+}
+
+// Concurrent writers and readers on disjoint keys
+void test_cmap_threads(void) {
+    cmap_result_t res = cmap_new(16);
+
+    assert(res.status == MAP_OK);
+    cmap_t *map = res.value.map;
+
+    static worker_t workers[THREADS];
+    pthread_t threads[THREADS];
+
+    for (size_t idx = 0; idx < THREADS; idx++) {
+        workers[idx].map = map;
+        workers[idx].id = idx;
+        assert(pthread_create(&threads[idx], NULL, writer, &workers[idx]) == 0);
+    }
+
+    for (size_t idx = 0; idx < THREADS; idx++) {
+        pthread_join(threads[idx], NULL);
+    }
+
+    assert(cmap_size(map) == THREADS * KEYS_PER_THREAD / 2);
+
+    char key[32];
+    for (size_t t = 0; t < THREADS; t++) {
+        for (size_t idx = 0; idx < KEYS_PER_THREAD; idx++) {
+            snprintf(key, sizeof(key), "t%zu_k%zu", t, idx);
+            cmap_result_t get_res = cmap_get(map, key);
+
+            if (idx % 2 == 0) {
+                assert(get_res.status == MAP_OK);
+                assert(*(int *)get_res.value.element == (int)(t * KEYS_PER_THREAD + idx));
+            } else {
+                assert(get_res.status == MAP_ERR_NOT_FOUND);
+            }
+        }
+    }
+
+    cmap_destroy(map);
+}
+
+// Read-mostly map from a single thread
+void test_rmap_basic(void) {
+    cmap_result_t res = rmap_new();
+
+    assert(res.status == MAP_OK);
+    rmap_t *map = res.value.rmap;
+
+    cmap_result_t reg_res = rmap_register(map);
+    assert(reg_res.status == MAP_OK);
+    const size_t reader = reg_res.value.reader;
+
+    int x = 42, y = 84;
+    const char *keys[] = { "x", "y" };
+    void *values[] = { &x, &y };
+
+    assert(rmap_add(map, "x", &x).status == MAP_OK);
+    assert(*(int *)rmap_get(map, reader, "x").value.element == 42);
+
+    // A snapshot is not affected by later writes
+    const map_t *snapshot = rmap_read_begin(map, reader);
+    assert(rmap_add_batch(map, keys, values, 2).status == MAP_OK);
+    assert(map_size(snapshot) == 1);
+    assert(map_get(snapshot, "y").status == MAP_ERR_NOT_FOUND);
+    rmap_read_end(map, reader);
+
+    assert(*(int *)rmap_get(map, reader, "y").value.element == 84);
+
+    assert(rmap_remove(map, "x").status == MAP_OK);
+    assert(rmap_remove(map, "x").status == MAP_ERR_NOT_FOUND);
+    assert(rmap_get(map, reader, "x").status == MAP_ERR_NOT_FOUND);
+
+    snapshot = rmap_read_begin(map, reader);
+    assert(map_size(snapshot) == 1);
+    rmap_read_end(map, reader);
+
+    assert(rmap_get(map, RMAP_MAX_READERS, "y").status == MAP_ERR_INVALID);
+    assert(rmap_unregister(map, reader).status == MAP_OK);
+
+    // Reader slots are limited
+    for (size_t idx = 0; idx < RMAP_MAX_READERS; idx++) {
+        assert(rmap_register(map).status == MAP_OK);
+    }
+    assert(rmap_register(map).status == MAP_ERR_OVERFLOW);
+
+    rmap_destroy(map);
+}
+
+#define RMAP_VERSIONS 200
+
+static int versions[RMAP_VERSIONS];
+
+static void *rmap_reader(void *arg) {
+    rmap_t *map = arg;
+    const size_t reader = rmap_register(map).value.reader;
+    int last = 0;
+
+    while (last < RMAP_VERSIONS - 1) {
+        const map_t *table = rmap_read_begin(map, reader);
+
+        // Both keys are always updated together
+        map_result_t a_res = map_get(table, "a");
+        map_result_t b_res = map_get(table, "b");
+        assert(a_res.status == MAP_OK && b_res.status == MAP_OK);
+        assert(a_res.value.element == b_res.value.element);
+
+        const int version = *(int *)a_res.value.element;
+        rmap_read_end(map, reader);
+
+        // Published versions never go back in time
+        assert(version >= last);
+        last = version;
+    }
+
+    rmap_unregister(map, reader);
+
+    return NULL;
+}
+
+// Lock-free readers while a writer publishes new tables
+void test_rmap_threads(void) {
+    rmap_t *map = rmap_new().value.rmap;
+    const char *keys[] = { "a", "b" };
+    pthread_t threads[THREADS];
+
+    for (int idx = 0; idx < RMAP_VERSIONS; idx++) { versions[idx] = idx; }
+
+    void *values[] = { &versions[0], &versions[0] };
+    assert(rmap_add_batch(map, keys, values, 2).status == MAP_OK);
+
+    for (size_t idx = 0; idx < THREADS; idx++) {
+        assert(pthread_create(&threads[idx], NULL, rmap_reader, map) == 0);
+    }
+
+    char key[32];
+    for (int version = 1; version < RMAP_VERSIONS; version++) {
+        // Grow the table from time to time
+        snprintf(key, sizeof(key), "filler_%d", version);
+        assert(rmap_add(map, key, &versions[version]).status == MAP_OK);
+
+        values[0] = values[1] = &versions[version];
+        assert(rmap_add_batch(map, keys, values, 2).status == MAP_OK);
+    }
+
+    for (size_t idx = 0; idx < THREADS; idx++) {
+        pthread_join(threads[idx], NULL);
+    }
+
+    rmap_destroy(map);
+}
+
+int main(void) {
+    printf("=== Running concurrent Map unit tests ===\n\n");
+
+    TEST(cmap_new);
+    TEST(cmap_basic);
+    TEST(cmap_threads);
+    TEST(rmap_basic);
+    TEST(rmap_threads);
+
+    printf("\n=== All tests passed! ===\n");
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * Unit tests for Bloom and binary fuse filters
+ */
+
+#define TEST(NAME) do { \
+    printf("Running test_%s...", #NAME); \
+    test_##NAME(); \
+    printf(" PASSED\n"); \
+} while(0)
+
+#define KEYS 50000
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "../src/filter.h"
+
+// Count the keys in [first, last) reported by @contains
+static size_t count_positives(const void *filter, bool (*contains)(const void*, const char*), int first, int last) {
+    char key[32];
+    size_t count = 0;
+
+    for (int idx = first; idx < last; idx++) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        count += contains(filter, key);
+    }
+
+    return count;
+}
+
+static bool bloom_query(const void *filter, const char *key) {
+    return bloom_contains(filter, key);
+}
+
+static bool fuse_query(const void *filter, const char *key) {
+    return fuse_contains(filter, key);
+}
+
+// Bits per key for a target false positive rate
+void test_bloom_bits_for_fpr(void) {
+    const double bits = bloom_bits_for_fpr(0.01);
+
+    assert(bits > 9.5 && bits < 10.5);
+    assert(bloom_bits_for_fpr(0.001) > bits);
+    assert(bloom_bits_for_fpr(0.0) == 0.0);
+    assert(bloom_bits_for_fpr(1.0) == 0.0);
+
+    // The measured rate of a full filter stays within the target
+    const double targets[] = { 0.01, 0.001 };
+    for (size_t idx = 0; idx < sizeof(targets) / sizeof(targets[0]); idx++) {
+        bloom_t *bloom = bloom_new(KEYS, bloom_bits_for_fpr(targets[idx])).value.bloom;
+        char key[32];
+
+        for (int key_idx = 0; key_idx < KEYS; key_idx++) {
+            snprintf(key, sizeof(key), "key_%d", key_idx);
+            assert(bloom_add(bloom, key).status == MAP_OK);
+        }
+
+        const size_t queries = 20 * KEYS;
+        const size_t false_positives = count_positives(bloom, bloom_query, KEYS, KEYS + (int)queries);
+        assert(false_positives <= queries * targets[idx]);
+
+        bloom_destroy(bloom);
+    }
+}
+
+// Add and query keys
+void test_bloom_basic(void) {
+    filter_result_t res = bloom_new(KEYS, bloom_bits_for_fpr(0.01));
+    assert(res.status == MAP_OK);
+    bloom_t *bloom = res.value.bloom;
+    char key[32];
+
+    assert(bloom_size(bloom) == 0);
+    assert(bloom_memory(bloom) >= KEYS * 10 / 8);
+    assert(!bloom_contains(bloom, "key_0"));
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        assert(bloom_add(bloom, key).status == MAP_OK);
+    }
+    assert(bloom_size(bloom) == KEYS);
+
+    // No false negatives, about 1% of false positives
+    assert(count_positives(bloom, bloom_query, 0, KEYS) == KEYS);
+    const size_t false_positives = count_positives(bloom, bloom_query, KEYS, 3 * KEYS);
+    assert(false_positives < 2 * KEYS * 0.02);
+
+    assert(bloom_add_bytes(bloom, "a\0b", 3).status == MAP_OK);
+    assert(bloom_contains_bytes(bloom, "a\0b", 3));
+
+    assert(bloom_clear(bloom).status == MAP_OK);
+    assert(bloom_size(bloom) == 0);
+    assert(count_positives(bloom, bloom_query, 0, KEYS) == 0);
+
+    assert(bloom_new(10, 0.0).status == MAP_ERR_INVALID);
+    assert(bloom_add(NULL, "x").status == MAP_ERR_INVALID);
+    assert(bloom_add(bloom, NULL).status == MAP_ERR_INVALID);
+    assert(!bloom_contains(NULL, "x"));
+
+    bloom_destroy(bloom);
+}
+
+// Build a fuse filter out of the keys of a map
+void test_fuse_from_map(void) {
+    map_t *map = map_new().value.map;
+    char key[32];
+    int value = 0;
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        map_add(map, key, &value);
+    }
+
+    for (uint32_t bits = 8; bits <= 16; bits += 8) {
+        filter_result_t res = fuse_from_map(map, bits);
+        assert(res.status == MAP_OK);
+        fuse_t *fuse = res.value.fuse;
+
+        assert(fuse_size(fuse) == KEYS);
+        assert(fuse_memory(fuse) < KEYS * 1.25 * bits / 8);
+
+        // No false negatives, a false positive rate of about 2^-bits
+        assert(count_positives(fuse, fuse_query, 0, KEYS) == KEYS);
+        const size_t false_positives = count_positives(fuse, fuse_query, KEYS, 5 * KEYS);
+        assert(false_positives < 2 * (4.0 * KEYS) / (1 << bits) + 10);
+
+        fuse_destroy(fuse);
+    }
+
+    assert(fuse_from_map(map, 12).status == MAP_ERR_INVALID);
+    assert(fuse_from_map(NULL, 8).status == MAP_ERR_INVALID);
+
+    map_destroy(map);
+}
+
+// Build a fuse filter out of the elements of a vector, with duplicates
+void test_fuse_from_vector(void) {
+    vector_t *vector = vector_new(16, sizeof(int)).value.vector;
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        int element = idx % (KEYS / 2);
+        vector_push(vector, &element);
+    }
+
+    filter_result_t res = fuse_from_vector(vector, 16);
+    assert(res.status == MAP_OK);
+    fuse_t *fuse = res.value.fuse;
+    assert(fuse_size(fuse) == KEYS / 2);
+
+    for (int idx = 0; idx < KEYS / 2; idx++) {
+        assert(fuse_contains_bytes(fuse, &idx, sizeof(int)));
+        assert(fuse_contains_hash(fuse, map_hash(&idx, sizeof(int))));
+    }
+
+    size_t false_positives = 0;
+    for (int idx = KEYS / 2; idx < KEYS * 3; idx++) {
+        false_positives += fuse_contains_bytes(fuse, &idx, sizeof(int));
+    }
+    assert(false_positives < 10);
+
+    fuse_destroy(fuse);
+    vector_destroy(vector);
+}
+
+// Filters with a handful of keys
+void test_fuse_small(void) {
+    fuse_t *empty = fuse_from_hashes(NULL, 0, 8).value.fuse;
+    assert(empty != NULL);
+    assert(fuse_size(empty) == 0);
+    assert(!fuse_contains(empty, "key_0"));
+    fuse_destroy(empty);
+
+    for (size_t size = 1; size <= 64; size++) {
+        uint64_t hashes[64];
+        char key[32];
+
+        for (size_t idx = 0; idx < size; idx++) {
+            snprintf(key, sizeof(key), "key_%zu", idx);
+            hashes[idx] = map_hash(key, strlen(key));
+        }
+
+        filter_result_t res = fuse_from_hashes(hashes, size, 8);
+        assert(res.status == MAP_OK);
+        assert(count_positives(res.value.fuse, fuse_query, 0, (int)size) == size);
+
+        fuse_destroy(res.value.fuse);
+    }
+
+    assert(fuse_from_hashes(NULL, 1, 8).status == MAP_ERR_INVALID);
+    assert(!fuse_contains(NULL, "x"));
+    assert(fuse_destroy(NULL).status == MAP_ERR_INVALID);
+}
+
+int main(void) {
+    printf("=== Running Filter unit tests ===\n\n");
+
+    TEST(bloom_bits_for_fpr);
+    TEST(bloom_basic);
+    TEST(fuse_from_map);
+    TEST(fuse_from_vector);
+    TEST(fuse_small);
+
+    printf("\n=== All tests passed! ===\n");
+
+    return 0;
+}
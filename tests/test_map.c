@@ -228,6 +228,82 @@ void test_map_remove(void) {
     map_destroy(map);
 }
 
+// Insertions and removals of distinct keys do not grow a map of constant size
+void test_map_churn(void) {
+    map_t *map = map_new().value.map;
+    char key[32];
+    int value = 0;
+
+    for (int idx = 0; idx < 100; idx++) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        map_add(map, key, &value);
+    }
+    const size_t capacity = map_capacity(map);
+
+    for (int idx = 100; idx < 100000; idx++) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        assert(map_add(map, key, &value).status == MAP_OK);
+        snprintf(key, sizeof(key), "key_%d", idx - 100);
+        assert(map_remove(map, key).status == MAP_OK);
+    }
+
+    assert(map_size(map) == 100);
+    assert(map_capacity(map) <= 2 * capacity);
+    assert(map_get(map, "key_99999").status == MAP_OK);
+    assert(map_get(map, "key_99899").status == MAP_ERR_NOT_FOUND);
+
+    // Incremental maps purge tombstones by migrating to a table of the same size
+    assert(map_set_incremental(map, true).status == MAP_OK);
+    bool migrated = false;
+    for (int idx = 100000; idx < 200000; idx++) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        assert(map_add(map, key, &value).status == MAP_OK);
+        snprintf(key, sizeof(key), "key_%d", idx - 100);
+        assert(map_remove(map, key).status == MAP_OK);
+        assert(map->old_ctrl == NULL || map->old_capacity == map_capacity(map));
+        migrated |= map->old_ctrl != NULL;
+    }
+    assert(migrated);
+
+    assert(map_size(map) == 100);
+    assert(map_capacity(map) <= 2 * capacity);
+    for (int idx = 199900; idx < 200000; idx++) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        assert(map_get(map, key).status == MAP_OK);
+    }
+    assert(map_get(map, "key_199899").status == MAP_ERR_NOT_FOUND);
+
+    map_destroy(map);
+}
+
+// Iterate and freeze a small map migrating to a table of the same capacity
+void test_map_churn_small(void) {
+    map_t *map = map_new().value.map;
+    int value = 0;
+
+    assert(map_set_incremental(map, true).status == MAP_OK);
+    assert(map_add(map, "a", &value).status == MAP_OK);
+    assert(map_add(map, "b", &value).status == MAP_OK);
+    assert(map_add(map, "c", &value).status == MAP_OK);
+    assert(map_remove(map, "a").status == MAP_OK);
+    assert(map_remove(map, "b").status == MAP_OK);
+    assert(map_add(map, "d", &value).status == MAP_OK);
+    assert(map_remove(map, "d").status == MAP_OK);
+    assert(map_size(map) == 1);
+
+    size_t count = 0;
+    map_iter_t iter = map_iter_begin(map);
+    while (map_iter_next(&iter)) { count++; }
+    assert(count == 1);
+
+    map_result_t res = map_freeze(map);
+    assert(res.status == MAP_OK);
+    assert(frozen_map_get(res.value.frozen, "c").status == MAP_OK);
+    frozen_map_destroy(res.value.frozen);
+
+    map_destroy(map);
+}
+
 // Remove non-existing key from map
 void test_map_remove_invalid(void) {
     map_result_t res = map_new();
@@ -368,6 +444,679 @@ void test_map_cap(void) {
     map_destroy(map);
 }
 
+// Test keys stored inline and in the key arena
+void test_map_long_keys(void) {
+    map_result_t res = map_new();
+
+    assert(res.status == MAP_OK);
+    map_t *map = res.value.map;
+
+    const char *short_key = "fifteen_chars__"; // Longest inline key
+    const char *long_key = "a_key_that_is_too_long_to_fit_inside_a_slot";
+    const int x = 1, y = 2;
+
+    map_add(map, short_key, (void*)&x);
+    map_add(map, long_key, (void*)&y);
+
+    assert(map->arena_size == strlen(long_key) + 1);
+
+    map_result_t get_res = map_get(map, short_key);
+    assert(get_res.status == MAP_OK);
+    assert(*(const int*)get_res.value.element == 1);
+
+    get_res = map_get(map, long_key);
+    assert(get_res.status == MAP_OK);
+    assert(*(const int*)get_res.value.element == 2);
+
+    // Keys sharing a long prefix must not collide
+    get_res = map_get(map, "a_key_that_is_too_long_to_fit_inside_a_slo");
+    assert(get_res.status == MAP_ERR_NOT_FOUND);
+
+    // Removing a long key leaves garbage in the arena that
+    // is reclaimed when the map is resized
+    map_remove(map, long_key);
+    assert(map->arena_garbage == strlen(long_key) + 1);
+
+    char key[64];
+    for (int i = 0; i < 64; i++) {
+        snprintf(key, sizeof(key), "this_is_a_long_key_number_%d", i);
+        assert(map_add(map, key, (void*)&x).status == MAP_OK);
+    }
+
+    assert(map->arena_garbage == 0);
+
+    for (int i = 0; i < 64; i++) {
+        snprintf(key, sizeof(key), "this_is_a_long_key_number_%d", i);
+        assert(map_get(map, key).status == MAP_OK);
+    }
+
+    assert(map_get(map, long_key).status == MAP_ERR_NOT_FOUND);
+    assert(map_get(map, short_key).status == MAP_OK);
+
+    map_destroy(map);
+}
+
+// Test that the map owns a copy of its keys
+void test_map_key_copy(void) {
+    map_result_t res = map_new();
+
+    assert(res.status == MAP_OK);
+    map_t *map = res.value.map;
+
+    char short_key[] = "short";
+    char long_key[] = "a_somewhat_longer_key_for_the_arena";
+    const int x = 10, y = 20;
+
+    map_add(map, short_key, (void*)&x);
+    map_add(map, long_key, (void*)&y);
+
+    // Overwrite the caller's buffers
+    short_key[0] = 'S';
+    long_key[0] = 'A';
+
+    assert(map_get(map, "short").status == MAP_OK);
+    assert(map_get(map, "a_somewhat_longer_key_for_the_arena").status == MAP_OK);
+    assert(map_get(map, short_key).status == MAP_ERR_NOT_FOUND);
+    assert(map_get(map, long_key).status == MAP_ERR_NOT_FOUND);
+
+    map_destroy(map);
+}
+
+// Test map that stores a copy of its values
+void test_map_sized(void) {
+    map_result_t res = map_new_sized(sizeof(Person));
+
+    assert(res.status == MAP_OK);
+    map_t *map = res.value.map;
+    assert(map_value_size(map) == sizeof(Person));
+
+    Person bob = { "Bob", "Miller", 23 };
+    map_add(map, "bob", &bob);
+
+    // The map holds its own copy of the value
+    bob.age = 99;
+
+    map_result_t get_res = map_get(map, "bob");
+    assert(get_res.status == MAP_OK);
+
+    Person *retr = (Person*)get_res.value.element;
+    assert(!strcmp(retr->name, "Bob"));
+    assert(retr->age == 23);
+
+    // Values can be modified in place through the returned pointer
+    retr->age = 24;
+    assert(((const Person*)map_get(map, "bob").value.element)->age == 24);
+
+    // Values must survive resizing
+    for (int i = 0; i < 100; i++) {
+        char key[16];
+        snprintf(key, sizeof(key), "key%d", i);
+        map_add(map, key, &bob);
+    }
+
+    retr = (Person*)map_get(map, "bob").value.element;
+    assert(retr->age == 24);
+    assert(map_size(map) == 101);
+
+    // Updating a key overwrites the stored copy
+    map_add(map, "bob", &bob);
+    assert(((const Person*)map_get(map, "bob").value.element)->age == 99);
+
+    // A map owning its values cannot store NULL
+    assert(map_add(map, "null", NULL).status == MAP_ERR_INVALID);
+
+    map_destroy(map);
+
+    assert(map_new_sized(0).status == MAP_ERR_INVALID);
+}
+
+// Test binary keys that are not NUL-terminated
+void test_map_bytes(void) {
+    map_result_t res = map_new();
+
+    assert(res.status == MAP_OK);
+    map_t *map = res.value.map;
+
+    const uint8_t key1[] = { 0x00, 0x01, 0x02 };
+    const uint8_t key2[] = { 0x00, 0x01, 0x03 };
+    const uint64_t key3 = 0xDEADBEEFCAFEBABEULL;
+    const uint8_t long_key[32] = { 0x00, 0xFF };
+    const int x = 1, y = 2, z = 3, w = 4;
+
+    assert(map_add_bytes(map, key1, sizeof(key1), (void*)&x).status == MAP_OK);
+    assert(map_add_bytes(map, key2, sizeof(key2), (void*)&y).status == MAP_OK);
+    assert(map_add_bytes(map, &key3, sizeof(key3), (void*)&z).status == MAP_OK);
+    assert(map_add_bytes(map, long_key, sizeof(long_key), (void*)&w).status == MAP_OK);
+    assert(map_size(map) == 4);
+
+    assert(*(const int*)map_get_bytes(map, key1, sizeof(key1)).value.element == 1);
+    assert(*(const int*)map_get_bytes(map, key2, sizeof(key2)).value.element == 2);
+    assert(*(const int*)map_get_bytes(map, &key3, sizeof(key3)).value.element == 3);
+    assert(*(const int*)map_get_bytes(map, long_key, sizeof(long_key)).value.element == 4);
+
+    // A prefix of a key is a different key
+    assert(map_get_bytes(map, key1, 2).status == MAP_ERR_NOT_FOUND);
+
+    // String keys and byte keys share the same key space
+    assert(map_add_bytes(map, "abc", 3, (void*)&x).status == MAP_OK);
+    assert(*(const int*)map_get(map, "abc").value.element == 1);
+
+    assert(map_remove_bytes(map, key1, sizeof(key1)).status == MAP_OK);
+    assert(map_get_bytes(map, key1, sizeof(key1)).status == MAP_ERR_NOT_FOUND);
+    assert(map_get_bytes(map, key2, sizeof(key2)).status == MAP_OK);
+
+    // Callers that already hashed the key pass its digest along
+    const uint64_t digest = map_hash(key1, sizeof(key1));
+    assert(map_add_digest(map, key1, sizeof(key1), digest, (void*)&z).status == MAP_OK);
+    assert(*(const int*)map_get_bytes(map, key1, sizeof(key1)).value.element == 3);
+    assert(*(const int*)map_get_digest(map, key1, sizeof(key1), digest).value.element == 3);
+    assert(map_remove_digest(map, key1, sizeof(key1), digest).status == MAP_OK);
+    assert(map_get_digest(map, key1, sizeof(key1), digest).status == MAP_ERR_NOT_FOUND);
+
+    map_destroy(map);
+}
+
+// Test map indexed by 64-bit integers
+void test_intmap(void) {
+    map_result_t res = intmap_new_sized(sizeof(uint64_t));
+
+    assert(res.status == MAP_OK);
+    intmap_t *map = res.value.intmap;
+
+    for (uint64_t key = 0; key < 1000; key++) {
+        const uint64_t value = key * 3;
+        assert(intmap_add(map, key * 0x9E3779B97F4A7C15ULL, (void*)&value).status == MAP_OK);
+    }
+
+    const uint64_t max_value = 42;
+    assert(intmap_add(map, UINT64_MAX, (void*)&max_value).status == MAP_OK);
+
+    assert(intmap_size(map) == 1001);
+    assert(intmap_capacity(map) >= 1001);
+
+    for (uint64_t key = 0; key < 1000; key++) {
+        map_result_t get_res = intmap_get(map, key * 0x9E3779B97F4A7C15ULL);
+        assert(get_res.status == MAP_OK);
+        assert(*(const uint64_t*)get_res.value.element == key * 3);
+    }
+
+    assert(*(const uint64_t*)intmap_get(map, UINT64_MAX).value.element == 42);
+    assert(intmap_get(map, 12345).status == MAP_ERR_NOT_FOUND);
+
+    // Update and remove
+    const uint64_t new_value = 7;
+    intmap_add(map, 0, (void*)&new_value);
+    assert(*(const uint64_t*)intmap_get(map, 0).value.element == 7);
+    assert(intmap_size(map) == 1001);
+
+    for (uint64_t key = 0; key < 1000; key += 2) {
+        assert(intmap_remove(map, key * 0x9E3779B97F4A7C15ULL).status == MAP_OK);
+    }
+
+    assert(intmap_size(map) == 501);
+    assert(intmap_get(map, 2 * 0x9E3779B97F4A7C15ULL).status == MAP_ERR_NOT_FOUND);
+    assert(*(const uint64_t*)intmap_get(map, 3 * 0x9E3779B97F4A7C15ULL).value.element == 9);
+    assert(intmap_remove(map, 2 * 0x9E3779B97F4A7C15ULL).status == MAP_ERR_NOT_FOUND);
+
+    intmap_clear(map);
+    assert(intmap_size(map) == 0);
+    assert(intmap_get(map, UINT64_MAX).status == MAP_ERR_NOT_FOUND);
+
+    intmap_destroy(map);
+
+    // Values stored by reference
+    res = intmap_new();
+    assert(res.status == MAP_OK);
+    map = res.value.intmap;
+
+    const char *hello = "Hello";
+    intmap_add(map, 1, (void*)hello);
+    assert(intmap_get(map, 1).value.element == hello);
+
+    intmap_destroy(map);
+}
+
+// Test map iteration through cursor, callbacks and bulk exports
+static void sum_values(const char *key, size_t key_len, void *value, void *env) {
+    assert(strlen(key) == key_len);
+    *(int*)env += *(const int*)value;
+}
+
+void test_map_iter(void) {
+    map_result_t res = map_new_sized(sizeof(int));
+
+    assert(res.status == MAP_OK);
+    map_t *map = res.value.map;
+
+    // Empty map
+    map_iter_t iter = map_iter_begin(map);
+    assert(!map_iter_next(&iter));
+
+    char key[32];
+    for (int i = 0; i < 100; i++) {
+        snprintf(key, sizeof(key), i % 2 ? "key%d" : "a_long_key_for_the_arena_%d", i);
+        map_add(map, key, &i);
+    }
+
+    // Remove some keys to leave tombstones behind
+    for (int i = 0; i < 100; i += 10) {
+        snprintf(key, sizeof(key), i % 2 ? "key%d" : "a_long_key_for_the_arena_%d", i);
+        map_remove(map, key);
+    }
+
+    int expected_sum = 0;
+    for (int i = 0; i < 100; i++) {
+        if (i % 10) { expected_sum += i; }
+    }
+
+    // Cursor
+    int count = 0, sum = 0;
+    iter = map_iter_begin(map);
+    while (map_iter_next(&iter)) {
+        assert(strlen(iter.key) == iter.key_len);
+        assert(map_get(map, iter.key).value.element == iter.value);
+        sum += *(const int*)iter.value;
+        count++;
+    }
+
+    assert(count == 90);
+    assert(sum == expected_sum);
+    assert(!map_iter_next(&iter));
+
+    // Callback
+    sum = 0;
+    assert(map_foreach(map, sum_values, &sum).status == MAP_OK);
+    assert(sum == expected_sum);
+
+    // Bulk exports
+    map_result_t keys_res = map_keys(map);
+    map_result_t values_res = map_values(map);
+    assert(keys_res.status == MAP_OK && values_res.status == MAP_OK);
+
+    vector_t *keys = keys_res.value.vector;
+    vector_t *values = values_res.value.vector;
+    assert(vector_size(keys) == 90 && vector_size(values) == 90);
+
+    sum = 0;
+    for (size_t idx = 0; idx < vector_size(keys); idx++) {
+        const char *k = *(const char**)vector_get(keys, idx).value.element;
+        const int v = *(const int*)vector_get(values, idx).value.element;
+
+        assert(*(const int*)map_get(map, k).value.element == v);
+        sum += v;
+    }
+
+    assert(sum == expected_sum);
+
+    vector_destroy(keys);
+    vector_destroy(values);
+    map_destroy(map);
+}
+
+// Test batched insertions and lookups
+void test_map_batch(void) {
+    map_result_t res = map_new_sized(sizeof(int));
+
+    assert(res.status == MAP_OK);
+    map_t *map = res.value.map;
+
+    enum { COUNT = 100 };
+    char key_buf[COUNT][32];
+    const char *keys[COUNT];
+    int numbers[COUNT];
+    void *values[COUNT];
+    map_status_t status[COUNT];
+
+    for (int i = 0; i < COUNT; i++) {
+        snprintf(key_buf[i], sizeof(key_buf[i]), i % 3 ? "key%d" : "a_long_batch_key_number_%d", i);
+        keys[i] = key_buf[i];
+        numbers[i] = i * 2;
+        values[i] = &numbers[i];
+    }
+
+    assert(map_add_batch(map, keys, values, COUNT, status).status == MAP_OK);
+    assert(map_size(map) == COUNT);
+    for (int i = 0; i < COUNT; i++) {
+        assert(status[i] == MAP_OK);
+        assert(*(const int*)map_get(map, keys[i]).value.element == i * 2);
+    }
+
+    // Replace some keys with missing ones
+    keys[5] = "missing";
+    keys[77] = "another_missing_key_from_the_batch";
+
+    void *out[COUNT];
+    map_result_t get_res = map_get_batch(map, keys, COUNT, out, status);
+    assert(get_res.status == MAP_ERR_NOT_FOUND);
+
+    for (int i = 0; i < COUNT; i++) {
+        if (i == 5 || i == 77) {
+            assert(status[i] == MAP_ERR_NOT_FOUND);
+            assert(out[i] == NULL);
+        } else {
+            assert(status[i] == MAP_OK);
+            assert(*(const int*)out[i] == i * 2);
+        }
+    }
+
+    // Output statuses are optional
+    assert(map_get_batch(map, keys + 6, 10, out, NULL).status == MAP_OK);
+    assert(map_get_batch(map, keys, 0, out, NULL).status == MAP_OK);
+
+    map_destroy(map);
+}
+
+// Clone a map
+void test_map_clone(void) {
+    map_t *map = map_new_sized(sizeof(int)).value.map;
+    char key[32];
+
+    for (int idx = 0; idx < 100; idx++) {
+        snprintf(key, sizeof(key), "a_rather_long_key_%d", idx);
+        assert(map_add(map, key, &idx).status == MAP_OK);
+    }
+    assert(map_remove(map, "a_rather_long_key_7").status == MAP_OK);
+
+    map_result_t res = map_clone(map);
+    assert(res.status == MAP_OK);
+    map_t *clone = res.value.map;
+
+    assert(map_size(clone) == 99);
+    assert(map_capacity(clone) == map_capacity(map));
+
+    // Updating the clone leaves the original untouched
+    int val = -1;
+    assert(map_add(clone, "a_rather_long_key_3", &val).status == MAP_OK);
+    assert(map_remove(clone, "a_rather_long_key_4").status == MAP_OK);
+
+    assert(*(int *)map_get(map, "a_rather_long_key_3").value.element == 3);
+    assert(*(int *)map_get(clone, "a_rather_long_key_3").value.element == -1);
+    assert(map_get(map, "a_rather_long_key_4").status == MAP_OK);
+    assert(map_get(clone, "a_rather_long_key_4").status == MAP_ERR_NOT_FOUND);
+    assert(map_get(clone, "a_rather_long_key_7").status == MAP_ERR_NOT_FOUND);
+
+    map_destroy(map);
+
+    for (int idx = 10; idx < 100; idx++) {
+        snprintf(key, sizeof(key), "a_rather_long_key_%d", idx);
+        assert(*(int *)map_get(clone, key).value.element == idx);
+    }
+
+    map_destroy(clone);
+
+    assert(map_clone(NULL).status == MAP_ERR_INVALID);
+}
+
+// Grow a map incrementally
+void test_map_incremental(void) {
+    map_t *map = map_new_sized(sizeof(int)).value.map;
+    char key[48];
+    bool migrated = false;
+
+    assert(map_set_incremental(map, true).status == MAP_OK);
+
+    for (int idx = 0; idx < 1000; idx++) {
+        snprintf(key, sizeof(key), idx % 2 ? "key_%d" : "a_key_stored_in_the_arena_%d", idx);
+        assert(map_add(map, key, &idx).status == MAP_OK);
+        assert(map_size(map) == (size_t)idx + 1);
+
+        if (map->old_ctrl == NULL) {
+            continue;
+        }
+        migrated = true;
+
+        // Every key is reachable while the migration is in progress
+        for (int prev = 0; prev <= idx; prev += 7) {
+            snprintf(key, sizeof(key), prev % 2 ? "key_%d" : "a_key_stored_in_the_arena_%d", prev);
+            assert(*(int *)map_get(map, key).value.element == prev);
+        }
+
+        size_t count = 0;
+        map_iter_t iter = map_iter_begin(map);
+        while (map_iter_next(&iter)) { count++; }
+        assert(count == map_size(map));
+    }
+    assert(migrated);
+
+    // Start a new migration, then update and remove keys of the old table
+    while (map->old_ctrl == NULL) {
+        snprintf(key, sizeof(key), "filler_%zu", map_size(map));
+        assert(map_add(map, key, &(int){ 0 }).status == MAP_OK);
+    }
+
+    const size_t size = map_size(map);
+    const int updated = -1;
+    assert(map_add(map, "key_999", (void*)&updated).status == MAP_OK);
+    assert(map_remove(map, "a_key_stored_in_the_arena_998").status == MAP_OK);
+    assert(map_remove(map, "a_key_stored_in_the_arena_998").status == MAP_ERR_NOT_FOUND);
+    assert(map_size(map) == size - 1);
+    assert(*(int *)map_get(map, "key_999").value.element == -1);
+
+    map_result_t keys_res = map_keys(map);
+    assert(keys_res.status == MAP_OK);
+    assert(vector_size(keys_res.value.vector) == size - 1);
+    vector_destroy(keys_res.value.vector);
+
+    // A clone carries the ongoing migration
+    map_t *clone = map_clone(map).value.map;
+    assert(clone->old_ctrl != NULL);
+    assert(*(int *)map_get(clone, "key_1").value.element == 1);
+
+    // Leaving incremental mode completes the migration
+    assert(map_set_incremental(map, false).status == MAP_OK);
+    assert(map->old_ctrl == NULL);
+    assert(map_size(map) == size - 1);
+
+    for (int idx = 0; idx < 998; idx++) {
+        snprintf(key, sizeof(key), idx % 2 ? "key_%d" : "a_key_stored_in_the_arena_%d", idx);
+        assert(*(int *)map_get(map, key).value.element == idx);
+        assert(*(int *)map_get(clone, key).value.element == idx);
+    }
+
+    assert(map_clear(clone).status == MAP_OK);
+    assert(clone->old_ctrl == NULL && map_size(clone) == 0);
+
+    map_destroy(clone);
+    map_destroy(map);
+}
+
+// Save a map and map it back from disk
+void test_map_save(void) {
+    const char *path = "test_map_snapshot.bin";
+    map_t *map = map_new_sized(sizeof(int)).value.map;
+    char key[48];
+
+    for (int idx = 0; idx < 500; idx++) {
+        snprintf(key, sizeof(key), idx % 3 ? "k%d" : "a_key_stored_in_the_arena_%d", idx);
+        assert(map_add(map, key, &idx).status == MAP_OK);
+    }
+    assert(map_remove(map, "k1").status == MAP_OK);
+    assert(map_save(map, path).status == MAP_OK);
+
+    map_result_t res = map_open_mmap(path);
+    assert(res.status == MAP_OK);
+    map_t *mapped = res.value.map;
+
+    assert(map_size(mapped) == 499);
+    assert(map_capacity(mapped) == map_capacity(map));
+    assert(map_get(mapped, "k1").status == MAP_ERR_NOT_FOUND);
+    for (int idx = 2; idx < 500; idx++) {
+        snprintf(key, sizeof(key), idx % 3 ? "k%d" : "a_key_stored_in_the_arena_%d", idx);
+        assert(*(int *)map_get(mapped, key).value.element == idx);
+    }
+
+    size_t count = 0;
+    map_iter_t iter = map_iter_begin(mapped);
+    while (map_iter_next(&iter)) { count++; }
+    assert(count == 499);
+
+    // Mapped maps are read-only, but they can be cloned
+    int val = 0;
+    assert(map_add(mapped, "k2", &val).status == MAP_ERR_INVALID);
+    assert(map_remove(mapped, "k2").status == MAP_ERR_INVALID);
+    assert(map_clear(mapped).status == MAP_ERR_INVALID);
+
+    map_t *clone = map_clone(mapped).value.map;
+    assert(map_add(clone, "k2", &val).status == MAP_OK);
+    assert(*(int *)map_get(clone, "a_key_stored_in_the_arena_3").value.element == 3);
+    map_destroy(clone);
+
+    map_destroy(mapped);
+    map_destroy(map);
+
+    // Maps storing values by reference cannot be saved
+    map = map_new().value.map;
+    assert(map_save(map, path).status == MAP_ERR_INVALID);
+    map_destroy(map);
+
+    // Reject files that are not snapshots
+    FILE *file = fopen(path, "wb");
+    assert(file != NULL);
+    fputs("this is not a snapshot, but it is long enough to hold a header. this is not a snapshot", file);
+    fclose(file);
+    assert(map_open_mmap(path).status == MAP_ERR_IO);
+
+    remove(path);
+    assert(map_open_mmap(path).status == MAP_ERR_IO);
+}
+
+// Reject snapshots whose sections or keys point outside the file
+void test_map_open_corrupted(void) {
+    const char *path = "test_map_corrupted.bin";
+    map_t *map = map_new_sized(sizeof(int)).value.map;
+    int val = 42;
+
+    assert(map_add(map, "a_key_stored_in_the_arena", &val).status == MAP_OK);
+    assert(map_save(map, path).status == MAP_OK);
+    map_destroy(map);
+
+    // Locate the slot of the key and an empty slot in the file
+    map_t *mapped = map_open_mmap(path).value.map;
+    const uint8_t *base = mapped->mapping;
+    long element_pos = -1;
+    long empty_pos = -1;
+    for (size_t idx = 0; idx < map_capacity(mapped); idx++) {
+        if (mapped->ctrl[idx] & MAP_CTRL_OCCUPIED) {
+            element_pos = (long)((const uint8_t *)&mapped->elements[idx] - base);
+        } else if (empty_pos < 0) {
+            empty_pos = (long)(mapped->ctrl + idx - base);
+        }
+    }
+    assert(element_pos >= 0 && empty_pos >= 0);
+    map_destroy(mapped);
+
+    // An occupied control byte that is not accounted for by the header
+    FILE *file = fopen(path, "r+b");
+    assert(file != NULL);
+    assert(fseek(file, empty_pos, SEEK_SET) == 0);
+    assert(fputc(MAP_CTRL_OCCUPIED, file) != EOF);
+    fclose(file);
+    assert(map_open_mmap(path).status == MAP_ERR_IO);
+
+    file = fopen(path, "r+b");
+    assert(file != NULL);
+    assert(fseek(file, empty_pos, SEEK_SET) == 0);
+    assert(fputc(MAP_CTRL_EMPTY, file) != EOF);
+    fclose(file);
+    mapped = map_open_mmap(path).value.map;
+    assert(mapped != NULL);
+    map_destroy(mapped);
+
+    // A long key whose terminator is overwritten. The arena ends the file
+    file = fopen(path, "r+b");
+    assert(file != NULL);
+    assert(fseek(file, -1, SEEK_END) == 0);
+    assert(fputc('x', file) != EOF);
+    fclose(file);
+    assert(map_open_mmap(path).status == MAP_ERR_IO);
+
+    // A long key referencing bytes past the key arena
+    file = fopen(path, "r+b");
+    assert(file != NULL);
+    const size_t offset = (size_t)1 << 40;
+    assert(fseek(file, element_pos, SEEK_SET) == 0);
+    assert(fwrite(&offset, sizeof(offset), 1, file) == 1);
+    fclose(file);
+    assert(map_open_mmap(path).status == MAP_ERR_IO);
+
+    remove(path);
+}
+
+// Freeze a map into a perfect hash table
+void test_map_freeze(void) {
+    map_t *map = map_new_sized(sizeof(int)).value.map;
+    char key[48];
+
+    for (int idx = 0; idx < 10000; idx++) {
+        snprintf(key, sizeof(key), idx % 4 ? "k%d" : "a_key_stored_in_the_arena_%d", idx);
+        assert(map_add(map, key, &idx).status == MAP_OK);
+    }
+
+    map_result_t res = map_freeze(map);
+    assert(res.status == MAP_OK);
+    frozen_map_t *frozen = res.value.frozen;
+    assert(frozen_map_size(frozen) == 10000);
+
+    // The frozen map is independent from its source
+    map_destroy(map);
+
+    for (int idx = 0; idx < 10000; idx++) {
+        snprintf(key, sizeof(key), idx % 4 ? "k%d" : "a_key_stored_in_the_arena_%d", idx);
+        assert(*(int *)frozen_map_get(frozen, key).value.element == idx);
+    }
+
+    for (int idx = 10000; idx < 11000; idx++) {
+        snprintf(key, sizeof(key), "k%d", idx);
+        assert(frozen_map_get(frozen, key).status == MAP_ERR_NOT_FOUND);
+    }
+    assert(frozen_map_get(frozen, "").status == MAP_ERR_NOT_FOUND);
+    assert(frozen_map_get(frozen, NULL).status == MAP_ERR_INVALID);
+
+    // Pilots take less than 4 bits per key and about 3% of the slots are empty
+    assert(frozen->bucket_count * 16 < 4 * frozen_map_size(frozen));
+    assert(frozen->table_size * 100 <= frozen_map_size(frozen) * 104);
+
+    frozen_map_destroy(frozen);
+
+    // Values stored by reference and empty maps
+    map = map_new().value.map;
+    frozen = map_freeze(map).value.frozen;
+    assert(frozen_map_size(frozen) == 0);
+    assert(frozen_map_get(frozen, "x").status == MAP_ERR_NOT_FOUND);
+    frozen_map_destroy(frozen);
+
+    const char *value = "Hello";
+    map_add(map, "x", (void*)value);
+    frozen = map_freeze(map).value.frozen;
+    assert(frozen_map_get(frozen, "x").value.element == value);
+    frozen_map_destroy(frozen);
+
+    map_destroy(map);
+}
+
+// Freeze keys whose FNV-1a digests collide
+void test_map_freeze_collisions(void) {
+    map_t *map = map_new_sized(sizeof(int)).value.map;
+    const char *first = "gkhcfpbaaagdcbhn";
+    const char *second = "llmmgnobmkhabfbg";
+    int values[] = { 1, 2 };
+
+    assert(map_hash(first, strlen(first)) == map_hash(second, strlen(second)));
+    assert(map_add(map, first, &values[0]).status == MAP_OK);
+    assert(map_add(map, second, &values[1]).status == MAP_OK);
+
+    map_result_t res = map_freeze(map);
+    assert(res.status == MAP_OK);
+    frozen_map_t *frozen = res.value.frozen;
+
+    assert(frozen_map_size(frozen) == 2);
+    assert(*(int *)frozen_map_get(frozen, first).value.element == 1);
+    assert(*(int *)frozen_map_get(frozen, second).value.element == 2);
+
+    frozen_map_destroy(frozen);
+    map_destroy(map);
+}
+
 int main(void) {
     printf("=== Running Map unit tests ===\n\n");
 
@@ -380,12 +1129,27 @@ int main(void) {
     TEST(map_mixed);
     TEST(map_update);
     TEST(map_remove);
+    TEST(map_churn);
+    TEST(map_churn_small);
     TEST(map_remove_invalid);
     TEST(map_clear);
     TEST(map_clear_empty);
     TEST(map_sequence);
     TEST(map_struct);
     TEST(map_cap);
+    TEST(map_long_keys);
+    TEST(map_key_copy);
+    TEST(map_sized);
+    TEST(map_bytes);
+    TEST(intmap);
+    TEST(map_iter);
+    TEST(map_batch);
+    TEST(map_clone);
+    TEST(map_incremental);
+    TEST(map_save);
+    TEST(map_open_corrupted);
+    TEST(map_freeze);
+    TEST(map_freeze_collisions);
 
     printf("\n=== All tests passed! ===\n");
 
@@ -0,0 +1,325 @@
+/*
+ * Unit tests for ordered Map data type
+ */
+
+#define TEST(NAME) do { \
+    printf("Running test_%s...", #NAME); \
+    test_##NAME(); \
+    printf(" PASSED\n"); \
+} while(0)
+
+#define KEYS 20000
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "../src/omap.h"
+
+static int values[KEYS];
+
+// Keys sharing long prefixes, some of them longer than OMAP_INLINE_KEY_MAX
+static void make_key(char *buffer, size_t size, int idx) {
+    if (idx % 7 == 0) {
+        snprintf(buffer, size, "tenant/%03d/region/eu-west/service/storage/metric/latency/%06d", idx % 13, idx);
+    } else {
+        snprintf(buffer, size, "tenant/%03d/metric/%06d", idx % 13, idx);
+    }
+}
+
+static int compare_keys(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+typedef struct {
+    size_t count;
+    char last[128];
+    bool sorted;
+} visit_t;
+
+static void visit(const char *key, size_t key_len, void *value, void *env) {
+    visit_t *state = env;
+    (void)value;
+
+    assert(strlen(key) == key_len);
+    if (state->count > 0 && strcmp(state->last, key) >= 0) {
+        state->sorted = false;
+    }
+
+    snprintf(state->last, sizeof(state->last), "%s", key);
+    state->count++;
+}
+
+// Create a new ordered map
+void test_omap_new(void) {
+    omap_result_t res = omap_new();
+
+    assert(res.status == MAP_OK);
+    assert(res.value.map != NULL);
+    assert(omap_size(res.value.map) == 0);
+    assert(omap_height(res.value.map) == 1);
+
+    omap_destroy(res.value.map);
+}
+
+// Add, get, update and remove a few keys
+void test_omap_basic(void) {
+    omap_t *map = omap_new().value.map;
+    int x = 42, y = 84;
+
+    assert(omap_add(map, "x", &x).status == MAP_OK);
+    assert(omap_add(map, "y", &y).status == MAP_OK);
+    assert(omap_add(map, "", &y).status == MAP_OK);
+    assert(omap_size(map) == 3);
+
+    assert(*(int *)omap_get(map, "x").value.element == 42);
+    assert(*(int *)omap_get(map, "").value.element == 84);
+    assert(omap_get(map, "z").status == MAP_ERR_NOT_FOUND);
+
+    // Update an existing key
+    assert(omap_add(map, "x", &y).status == MAP_OK);
+    assert(omap_size(map) == 3);
+    assert(*(int *)omap_get(map, "x").value.element == 84);
+
+    assert(omap_remove(map, "x").status == MAP_OK);
+    assert(omap_remove(map, "x").status == MAP_ERR_NOT_FOUND);
+    assert(omap_get(map, "x").status == MAP_ERR_NOT_FOUND);
+    assert(omap_size(map) == 2);
+
+    assert(omap_add(NULL, "x", &x).status == MAP_ERR_INVALID);
+    assert(omap_get(map, NULL).status == MAP_ERR_INVALID);
+    assert(omap_remove(map, NULL).status == MAP_ERR_INVALID);
+
+    omap_destroy(map);
+}
+
+// Insert and remove many keys in random order
+void test_omap_many(void) {
+    omap_t *map = omap_new().value.map;
+    char key[128];
+    int order[KEYS];
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        values[idx] = idx;
+        order[idx] = idx;
+    }
+
+    srand(42);
+    for (int idx = KEYS - 1; idx > 0; idx--) {
+        const int other = rand() % (idx + 1);
+        const int tmp = order[idx];
+        order[idx] = order[other];
+        order[other] = tmp;
+    }
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        make_key(key, sizeof(key), order[idx]);
+        assert(omap_add(map, key, &values[order[idx]]).status == MAP_OK);
+    }
+    assert(omap_size(map) == KEYS);
+    assert(omap_height(map) > 1);
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        make_key(key, sizeof(key), idx);
+        omap_result_t res = omap_get(map, key);
+        assert(res.status == MAP_OK);
+        assert(*(int *)res.value.element == idx);
+    }
+
+    // Iteration visits every key in increasing order
+    visit_t state = { 0, "", true };
+    omap_iter_t iter = omap_iter_begin(map);
+    while (omap_iter_next(&iter)) {
+        visit(iter.key, iter.key_len, iter.value, &state);
+    }
+    assert(state.count == KEYS);
+    assert(state.sorted);
+
+    // Remove all the keys but one out of ten
+    for (int idx = 0; idx < KEYS; idx++) {
+        if (order[idx] % 10 != 0) {
+            make_key(key, sizeof(key), order[idx]);
+            assert(omap_remove(map, key).status == MAP_OK);
+        }
+    }
+    assert(omap_size(map) == KEYS / 10);
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        make_key(key, sizeof(key), idx);
+        assert(omap_get(map, key).status == (idx % 10 == 0 ? MAP_OK : MAP_ERR_NOT_FOUND));
+    }
+
+    // Empty the map, then reuse it
+    for (int idx = 0; idx < KEYS; idx += 10) {
+        make_key(key, sizeof(key), idx);
+        assert(omap_remove(map, key).status == MAP_OK);
+    }
+    assert(omap_size(map) == 0);
+    assert(omap_height(map) == 1);
+
+    iter = omap_iter_begin(map);
+    assert(!omap_iter_next(&iter));
+
+    assert(omap_add(map, "x", &values[0]).status == MAP_OK);
+    assert(omap_clear(map).status == MAP_OK);
+    assert(omap_size(map) == 0);
+    assert(omap_get(map, "x").status == MAP_ERR_NOT_FOUND);
+
+    omap_destroy(map);
+}
+
+// Range and prefix queries
+void test_omap_range(void) {
+    omap_t *map = omap_new().value.map;
+    char key[128];
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        values[idx] = idx;
+        make_key(key, sizeof(key), idx);
+        assert(omap_add(map, key, &values[idx]).status == MAP_OK);
+    }
+
+    // Every key of tenant 005 is visited in order
+    size_t expected = 0;
+    for (int idx = 0; idx < KEYS; idx++) { expected += (idx % 13 == 5); }
+
+    visit_t state = { 0, "", true };
+    assert(omap_prefix(map, "tenant/005/", visit, &state).status == MAP_OK);
+    assert(state.count == expected);
+    assert(state.sorted);
+
+    state = (visit_t){ 0, "", true };
+    assert(omap_range(map, "tenant/005/", "tenant/005/\xff", visit, &state).status == MAP_OK);
+    assert(state.count == expected);
+
+    // Bounds are inclusive
+    state = (visit_t){ 0, "", true };
+    omap_range(map, "tenant/001/metric/000001", "tenant/001/metric/000027", visit, &state);
+    assert(state.count == 2); // 1 and 27, key 14 uses the long format
+    assert(strcmp(state.last, "tenant/001/metric/000027") == 0);
+
+    state = (visit_t){ 0, "", true };
+    omap_range(map, NULL, NULL, visit, &state);
+    assert(state.count == KEYS);
+
+    state = (visit_t){ 0, "", true };
+    omap_range(map, "z", NULL, visit, &state);
+    assert(state.count == 0);
+
+    state = (visit_t){ 0, "", true };
+    omap_prefix(map, "tenant/999", visit, &state);
+    assert(state.count == 0);
+
+    // Seek to the first key not lower than a bound
+    omap_iter_t iter = omap_iter_seek(map, "tenant/000/metric/00000", 23);
+    assert(omap_iter_next(&iter));
+    assert(strcmp(iter.key, "tenant/000/metric/000013") == 0);
+
+    assert(omap_prefix(map, NULL, visit, &state).status == MAP_ERR_INVALID);
+    assert(omap_range(map, NULL, NULL, NULL, NULL).status == MAP_ERR_INVALID);
+
+    omap_destroy(map);
+}
+
+static void sum_ints(const char *key, size_t key_len, void *value, void *env) {
+    assert(key_len == 8);
+    assert(omap_key_int(key) == (uint64_t)*(int *)value);
+    *(uint64_t *)env += omap_key_int(key);
+}
+
+// Integer keys are ordered numerically
+void test_omap_int(void) {
+    omap_t *map = omap_new().value.map;
+
+    for (int idx = KEYS - 1; idx >= 0; idx--) {
+        values[idx] = idx * 3;
+        assert(omap_add_int(map, (uint64_t)idx * 3, &values[idx]).status == MAP_OK);
+    }
+
+    assert(*(int *)omap_get_int(map, 300).value.element == 300);
+    assert(omap_get_int(map, 301).status == MAP_ERR_NOT_FOUND);
+
+    uint64_t sum = 0;
+    assert(omap_range_int(map, 10, 20, sum_ints, &sum).status == MAP_OK);
+    assert(sum == 12 + 15 + 18);
+
+    // 255 and 256 differ in their lowest byte only
+    sum = 0;
+    omap_range_int(map, 250, 260, sum_ints, &sum);
+    assert(sum == 252 + 255 + 258);
+
+    assert(omap_remove_int(map, 300).status == MAP_OK);
+    assert(omap_get_int(map, 300).status == MAP_ERR_NOT_FOUND);
+
+    omap_destroy(map);
+}
+
+// Bulk load from sorted input
+void test_omap_bulk_load(void) {
+    omap_t *map = omap_new().value.map;
+    char *keys[KEYS];
+    void *ptrs[KEYS];
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        keys[idx] = malloc(128);
+        make_key(keys[idx], 128, idx);
+    }
+    qsort(keys, KEYS, sizeof(char *), compare_keys);
+    for (int idx = 0; idx < KEYS; idx++) {
+        values[idx] = idx;
+        ptrs[idx] = &values[idx];
+    }
+
+    // Unsorted input is rejected
+    const char *unsorted[] = { "b", "a" };
+    assert(omap_bulk_load(map, unsorted, ptrs, 2).status == MAP_ERR_INVALID);
+
+    assert(omap_bulk_load(map, (const char *const *)keys, ptrs, KEYS).status == MAP_OK);
+    assert(omap_size(map) == KEYS);
+
+    // Packed nodes need fewer levels than incremental insertions
+    omap_t *incremental = omap_new().value.map;
+    for (int idx = 0; idx < KEYS; idx++) {
+        omap_add(incremental, keys[idx], ptrs[idx]);
+    }
+    assert(map->node_count < incremental->node_count);
+    omap_destroy(incremental);
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        assert(*(int *)omap_get(map, keys[idx]).value.element == idx);
+    }
+
+    omap_iter_t iter = omap_iter_begin(map);
+    for (int idx = 0; idx < KEYS; idx++) {
+        assert(omap_iter_next(&iter));
+        assert(strcmp(iter.key, keys[idx]) == 0);
+    }
+    assert(!omap_iter_next(&iter));
+
+    // The map can be updated after a bulk load
+    assert(omap_add(map, "tenant/000/metric/", &values[0]).status == MAP_OK);
+    assert(omap_remove(map, keys[KEYS / 2]).status == MAP_OK);
+    assert(omap_size(map) == KEYS);
+
+    // Only empty maps can be bulk loaded
+    assert(omap_bulk_load(map, (const char *const *)keys, ptrs, KEYS).status == MAP_ERR_INVALID);
+
+    for (int idx = 0; idx < KEYS; idx++) { free(keys[idx]); }
+    omap_destroy(map);
+}
+
+int main(void) {
+    printf("=== Running ordered Map unit tests ===\n\n");
+
+    TEST(omap_new);
+    TEST(omap_basic);
+    TEST(omap_many);
+    TEST(omap_range);
+    TEST(omap_int);
+    TEST(omap_bulk_load);
+
+    printf("\n=== All tests passed! ===\n");
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Unit tests for Set data type
+ */
+
+#define TEST(NAME) do { \
+    printf("Running test_%s...", #NAME); \
+    test_##NAME(); \
+    printf(" PASSED\n"); \
+} while(0)
+
+#define KEYS 10000
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+#include "../src/set.h"
+
+static set_t *make_range(int first, int last) {
+    set_t *set = set_new().value.set;
+    char key[32];
+
+    for (int idx = first; idx < last; idx++) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        assert(set_add(set, key).status == MAP_OK);
+    }
+
+    return set;
+}
+
+static void count_keys(const char *key, size_t key_len, void *env) {
+    assert(strlen(key) == key_len);
+    (*(size_t *)env)++;
+}
+
+// Create a new set
+void test_set_new(void) {
+    set_result_t res = set_new();
+
+    assert(res.status == MAP_OK);
+    assert(res.value.set != NULL);
+    assert(set_size(res.value.set) == 0);
+    assert(map_value_size(res.value.set->map) == 0);
+
+    set_destroy(res.value.set);
+}
+
+// Add, check and remove keys
+void test_set_basic(void) {
+    set_t *set = set_new().value.set;
+
+    assert(set_add(set, "x").status == MAP_OK);
+    assert(set_add(set, "y").status == MAP_OK);
+    assert(set_add(set, "x").status == MAP_OK);
+    assert(set_size(set) == 2);
+
+    assert(set_contains(set, "x"));
+    assert(!set_contains(set, "z"));
+
+    // Long and binary keys
+    assert(set_add(set, "a key longer than the inline storage of a slot").status == MAP_OK);
+    assert(set_add_bytes(set, "a\0b", 3).status == MAP_OK);
+    assert(set_contains(set, "a key longer than the inline storage of a slot"));
+    assert(set_contains_bytes(set, "a\0b", 3));
+    assert(!set_contains(set, "a"));
+
+    assert(set_remove(set, "x").status == MAP_OK);
+    assert(set_remove(set, "x").status == MAP_ERR_NOT_FOUND);
+    assert(!set_contains(set, "x"));
+    assert(set_size(set) == 3);
+
+    assert(set_add(NULL, "x").status == MAP_ERR_INVALID);
+    assert(set_add(set, NULL).status == MAP_ERR_INVALID);
+    assert(!set_contains(set, NULL));
+
+    assert(set_clear(set).status == MAP_OK);
+    assert(set_size(set) == 0);
+    assert(!set_contains(set, "y"));
+
+    set_destroy(set);
+}
+
+// Grow the set past several resizes
+void test_set_many(void) {
+    set_t *set = make_range(0, KEYS);
+    char key[32];
+
+    assert(set_size(set) == KEYS);
+    for (int idx = 0; idx < KEYS; idx += 2) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        assert(set_remove(set, key).status == MAP_OK);
+    }
+
+    for (int idx = 0; idx < KEYS; idx++) {
+        snprintf(key, sizeof(key), "key_%d", idx);
+        assert(set_contains(set, key) == (idx % 2 == 1));
+    }
+
+    size_t count = 0;
+    assert(set_foreach(set, count_keys, &count).status == MAP_OK);
+    assert(count == KEYS / 2);
+
+    set_destroy(set);
+}
+
+// Union, intersection and difference
+void test_set_algebra(void) {
+    set_t *x = make_range(0, 1000);
+    set_t *y = make_range(500, 3000);
+
+    set_t *both = set_union(x, y).value.set;
+    assert(set_size(both) == 3000);
+    assert(set_contains(both, "key_0") && set_contains(both, "key_2999"));
+
+    set_t *common = set_intersection(x, y).value.set;
+    assert(set_size(common) == 500);
+    assert(set_contains(common, "key_500") && !set_contains(common, "key_499"));
+
+    set_t *only_x = set_difference(x, y).value.set;
+    assert(set_size(only_x) == 500);
+    assert(set_contains(only_x, "key_499") && !set_contains(only_x, "key_500"));
+
+    set_t *only_y = set_difference(y, x).value.set;
+    assert(set_size(only_y) == 2000);
+
+    // The operands are left untouched
+    assert(set_size(x) == 1000 && set_size(y) == 2500);
+
+    set_t *empty = set_new().value.set;
+    set_t *none = set_intersection(x, empty).value.set;
+    assert(set_size(none) == 0);
+
+    assert(set_union(x, NULL).status == MAP_ERR_INVALID);
+
+    set_destroy(x); set_destroy(y); set_destroy(both); set_destroy(common);
+    set_destroy(only_x); set_destroy(only_y); set_destroy(empty); set_destroy(none);
+}
+
+// Deduplicate the elements of a vector
+void test_set_from_vector(void) {
+    vector_t *vector = vector_new(16, sizeof(int)).value.vector;
+
+    for (int idx = 0; idx < 1000; idx++) {
+        int value = idx % 37;
+        vector_push(vector, &value);
+    }
+
+    set_t *set = set_from_vector(vector).value.set;
+    assert(set_size(set) == 37);
+
+    int value = 36;
+    assert(set_contains_bytes(set, &value, sizeof(int)));
+    value = 37;
+    assert(!set_contains_bytes(set, &value, sizeof(int)));
+
+    assert(set_from_vector(NULL).status == MAP_ERR_INVALID);
+
+    set_destroy(set);
+    vector_destroy(vector);
+}
+
+int main(void) {
+    printf("=== Running Set unit tests ===\n\n");
+
+    TEST(set_new);
+    TEST(set_basic);
+    TEST(set_many);
+    TEST(set_algebra);
+    TEST(set_from_vector);
+
+    printf("\n=== All tests passed! ===\n");
+
+    return 0;
+}